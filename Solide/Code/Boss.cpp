@@ -6,6 +6,7 @@
 #include <cereal/types/string.hpp>
 #include <cereal/types/vector.hpp>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Constant.h"		// For DEBUG_MODE macro.
 #include "Donya/Loader.h"
 #include "Donya/Model.h"
@@ -586,6 +587,9 @@ namespace
 		CollisionParam		collider;
 		std::vector<int>	initialHPs;
 		FirstParam			forFirst;
+	#if DEBUG_MODE
+		ParameterHelper::CopyCounter copyCounter;
+	#endif // DEBUG_MODE
 	private:
 		friend class cereal::access;
 		template<class Archive>
@@ -638,12 +642,10 @@ CEREAL_CLASS_VERSION( FirstParam::Walk,			1 )
 CEREAL_CLASS_VERSION( FirstParam::Damage,		0 )
 CEREAL_CLASS_VERSION( FirstParam::Die,			1 )
 
-class ParamBoss : public ParameterBase<ParamBoss>
+class ParamBoss : public ParameterBase<ParamBoss, Member>
 {
 public:
 	static constexpr const char *ID = "Boss";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -657,7 +659,6 @@ public:
 
 		ResizeVectorIfNeeded();
 	}
-	Member Data() const { return m; }
 private:
 	void ResizeVectorIfNeeded()
 	{
@@ -841,6 +842,21 @@ public:
 				ImGui::TreePop();
 			}
 
+			if ( ImGui::TreeNode( u8"Aj[V]̔r" ) )
+			{
+				std::string caption{};
+				const size_t modelCount = std::min( TYPE_COUNT, BossModel::modelPtrs.size() );
+				for ( size_t i = 0; i < modelCount; ++i )
+				{
+					if ( !BossModel::modelPtrs[i] ) { continue; }
+					// else
+					caption = "[" + std::to_string( i ) + ":" + BossModel::MODEL_NAMES[i] + "]";
+					Donya::Model::ShowAnimationBenchmarkNode( caption, BossModel::modelPtrs[i]->motionHolder );
+				}
+
+				ImGui::TreePop();
+			}
+
 			if ( ImGui::TreeNode( u8"P̖ڂ̃p[^" ) )
 			{
 				auto &data = m.forFirst;
@@ -1152,7 +1168,7 @@ public:
 // Internal utility.
 namespace
 {
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamBoss::Get().Data();
 	}
@@ -1316,7 +1332,7 @@ void BossBase::Init( const BossInitializer &param )
 	orientation		= param.GetInitialOrientation();
 
 	const int intType = scast<int>( GetType() );
-	const auto hpData = FetchMember().initialHPs;
+	const auto &hpData = FetchMember().initialHPs;
 	hp = ( intType < scast<int>( hpData.size() ) ) ? hpData[intType] : 1;
 
 	model.pResource	= BossModel::GetModelPtr( GetType() );
@@ -1339,7 +1355,7 @@ void BossBase::PhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya
 	if ( IsDead() ) { return; }
 	// else
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	
 	const auto result = Actor::Move( velocity, {}, solids, pTerrain, pTerrainMat );
 	const Donya::Vector3 standingNormal = result.lastNormal;
@@ -1356,7 +1372,7 @@ void BossBase::Draw( RenderingHelper *pRenderer ) const
 	if ( !model.pResource ) { return; }
 	// else
 
-	const auto drawData = FetchMember().drawer;
+	const auto &drawData = FetchMember().drawer;
 	Donya::Model::Constants::PerModel::Common modelConstant{};
 	modelConstant.drawColor		= CalcDrawColor();
 	modelConstant.worldMatrix	= CalcWorldMatrix( /* useForDrawing = */ true );
@@ -1399,6 +1415,10 @@ void BossBase::DrawHitBox( RenderingHelper *pRenderer, const Donya::Vector4x4 &m
 	}
 #endif // DEBUG_MODE
 }
+void BossBase::SetDeferredAnimationBatch( Donya::Model::AnimationBatch *pBatch )
+{
+	model.pDeferredBatch = pBatch;
+}
 void BossBase::MakeDamage( const Element &effect, const Donya::Vector3 &othersVelocity ) const
 {
 	element.Add( effect.Get() );
@@ -1420,6 +1440,10 @@ std::vector<Donya::AABB>	BossBase::AcquireHurtBoxes() const
 	ToWorldSpace( &hurtBoxes, GetPosition() );
 	return hurtBoxes;
 }
+Donya::AABB				BossBase::CalcSweptRegion() const
+{
+	return Donya::AABBGrid::MakeSweptRegion( GetHitBox(), velocity );
+}
 void BossBase::AssignSpecifyPose( int motionIndex )
 {
 	if ( !model.pResource ) { return; }
@@ -1430,20 +1454,22 @@ void BossBase::AssignSpecifyPose( int motionIndex )
 
 	const auto &applyMotion = model.pResource->motionHolder.GetMotion( motionIndex );
 	model.animator.SetRepeatRange( applyMotion );
-	model.pose.AssignSkeletal
-	(
-		model.animator.CalcCurrentPose
-		(
-			applyMotion
-		)
-	);
+
+	if ( model.pDeferredBatch )
+	{
+		model.pDeferredBatch->Append( model.animator, applyMotion, &model.pose );
+		return;
+	}
+	// else
+
+	model.animator.CalcCurrentPose( applyMotion, &model.pose );
 }
 void BossBase::UpdateMotion( float elapsedTime, int motionIndex )
 {
 	if ( !model.pResource ) { return; }
 	// else
 
-	const auto data			= FetchMember();
+	const auto &data			= FetchMember();
 	const auto &speedSource = data.drawer.accelerations;
 
 	const size_t intType	= scast<size_t>( GetType() );
@@ -1457,7 +1483,7 @@ void BossBase::UpdateMotion( float elapsedTime, int motionIndex )
 }
 Donya::Vector4				BossBase::CalcDrawColor() const
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	Donya::Vector4 baseColor{ 1.0f, 1.0f, 1.0f, 1.0f };
 
 	if ( element.Has( Element::Type::Oil ) ) { baseColor.Product( data.drawer.oilColor ); }
@@ -1466,7 +1492,7 @@ Donya::Vector4				BossBase::CalcDrawColor() const
 }
 Donya::Vector4x4			BossBase::CalcWorldMatrix( bool useForDrawing ) const
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	Donya::Vector4x4 W{};
 
 	if ( useForDrawing )
@@ -1501,7 +1527,7 @@ Donya::Vector4x4			BossBase::CalcWorldMatrix( bool useForDrawing ) const
 }
 std::vector<Donya::AABB>	BossBase::FetchOwnHitBoxes( bool wantHurtBoxes ) const
 {
-	const auto data			= FetchMember();
+	const auto &data			= FetchMember();
 	const auto &collisions	= data.collider.collisions;
 	const int  intType		= scast<int>( GetType() );
 
@@ -1540,7 +1566,7 @@ void BossFirst::MotionManager::Init( BossFirst &inst )
 }
 void BossFirst::MotionManager::Update( BossFirst &inst, float elapsedTime )
 {
-	const auto data = FetchMember().forFirst;
+	const auto &data = FetchMember().forFirst;
 	const auto &motionSpeeds = data.motionSpeeds;
 
 	const int intKind = scast<int>( currentKind );
@@ -1627,6 +1653,7 @@ bool BossFirst::MoverBase::IsDead( const BossFirst &inst ) const
 bool BossFirst::MoverBase::AcceptDamage( const BossFirst &inst ) const { return true; }
 bool BossFirst::MoverBase::AcceptDraw( const BossFirst &inst ) const { return true; }
 bool BossFirst::MoverBase::NowDiePerformance( const BossFirst &inst ) const { return false; }
+bool BossFirst::MoverBase::ShouldSweepSolids( const BossFirst &inst ) const { return false; }
 
 void BossFirst::Ready::Init( BossFirst &inst )
 {
@@ -1641,7 +1668,7 @@ void BossFirst::Ready::Init( BossFirst &inst )
 void BossFirst::Ready::Uninit( BossFirst &inst ) {}
 void BossFirst::Ready::Update( BossFirst &inst, float elapsedTime, const Donya::Vector3 &targetPos )
 {
-	const auto data		= ( 0 < inst.remainFeintCount )
+	const auto &data		= ( 0 < inst.remainFeintCount )
 						? FetchMember().forFirst.readyInFeint
 						: FetchMember().forFirst.ready;
 	const int preFrame	= data.preAimingFrame;
@@ -1683,7 +1710,7 @@ void BossFirst::Rush::Init( BossFirst &inst )
 	if ( inst.remainFeintCount == dontUseFeintSign )
 	{
 		// Set the count if first time.
-		const auto data		= FetchMember();
+		const auto &data		= FetchMember();
 		const int  maxHP	= data.FetchInitialHP( inst.GetType() );
 		const int  index	= maxHP - inst.hp;
 		const auto &source	= data.forFirst.rush.feintCountPerHP;
@@ -1712,7 +1739,7 @@ void BossFirst::Rush::Update( BossFirst &inst, float elapsedTime, const Donya::V
 	if ( shouldStop ) { return; }
 	// else
 
-	const auto data = FetchMember().forFirst.rush;
+	const auto &data = FetchMember().forFirst.rush;
 
 	SETimer++;
 	if ( ( SETimer % data.playStepSEInterval ) == 1 )
@@ -1767,6 +1794,11 @@ void BossFirst::Rush::PhysicUpdate( BossFirst &inst, const std::vector<Donya::AA
 		inst.pos.z = inst.aimingPos.z;
 	}
 }
+bool BossFirst::Rush::ShouldSweepSolids( const BossFirst &inst ) const
+{
+	// The rushing speed is enough to pass through the thin obstacles.
+	return true;
+}
 bool BossFirst::Rush::ShouldChangeMover( BossFirst &inst ) const
 {
 	return shouldStop;
@@ -1789,7 +1821,7 @@ void BossFirst::Brake::Init( BossFirst &inst )
 void BossFirst::Brake::Uninit( BossFirst &inst ) {}
 void BossFirst::Brake::Update( BossFirst &inst, float elapsedTime, const Donya::Vector3 &targetPos )
 {
-	const auto data	= ( 0 < inst.remainFeintCount )
+	const auto &data	= ( 0 < inst.remainFeintCount )
 					? FetchMember().forFirst.brakeInFeint
 					: FetchMember().forFirst.brake;
 
@@ -1870,7 +1902,7 @@ void BossFirst::Breath::Update( BossFirst &inst, float elapsedTime, const Donya:
 
 	const int	maxHP	= FetchMember().FetchInitialHP( inst.GetType() );
 	const int	index	= maxHP - inst.hp;
-	const auto	data	= FetchMember().forFirst.breath.paramPerHP;
+	const auto	&data	= FetchMember().forFirst.breath.paramPerHP;
 	if ( data.empty() ) { gotoNext = true; return; }
 	// else
 	const auto	&source	= ( scast<int>( data.size() ) <= index )
@@ -1961,7 +1993,7 @@ void BossFirst::Wait::Update( BossFirst &inst, float elapsedTime, const Donya::V
 {
 	inst.timer++;
 
-	const auto data = FetchMember().forFirst.wait;
+	const auto &data = FetchMember().forFirst.wait;
 	const Donya::Vector3 aimingVector = inst.CalcAimingVector( targetPos, data.maxAimDegree );
 	inst.orientation = Donya::Quaternion::LookAt( Donya::Vector3::Front(), aimingVector.Unit(), Donya::Quaternion::Freeze::Up );
 }
@@ -1989,7 +2021,7 @@ void BossFirst::Walk::Init( BossFirst &inst )
 void BossFirst::Walk::Uninit( BossFirst &inst ) {}
 void BossFirst::Walk::Update( BossFirst &inst, float elapsedTime, const Donya::Vector3 &targetPos )
 {
-	const auto data = FetchMember().forFirst.walk;
+	const auto &data = FetchMember().forFirst.walk;
 
 	inst.timer++;
 	if ( ( inst.timer % data.playStepSEInterval ) == 1 )
@@ -2033,7 +2065,7 @@ void BossFirst::Damage::Update( BossFirst &inst, float elapsedTime, const Donya:
 {
 	inst.timer++;
 
-	const auto data = FetchMember().forFirst.damage;
+	const auto &data = FetchMember().forFirst.damage;
 
 	if ( inst.hp <= 0 )
 	{
@@ -2056,7 +2088,7 @@ bool BossFirst::Damage::AcceptDamage( const BossFirst &inst ) const
 }
 bool BossFirst::Damage::AcceptDraw( const BossFirst &inst ) const
 {
-	const auto data = FetchMember().forFirst.damage;
+	const auto &data = FetchMember().forFirst.damage;
 	const int &interval = data.flushInterval;
 	if ( interval <= 0 ) { return true; }
 	// else
@@ -2099,7 +2131,7 @@ void BossFirst::Die::Init( BossFirst &inst )
 void BossFirst::Die::Uninit( BossFirst &inst ) {}
 void BossFirst::Die::Update( BossFirst &inst, float elapsedTime, const Donya::Vector3 &targetPos )
 {
-	const auto data = FetchMember().forFirst.die;
+	const auto &data = FetchMember().forFirst.die;
 
 	const float oldHSpeed = inst.velocity.y;
 
@@ -2136,7 +2168,7 @@ std::function<void()> BossFirst::Die::GetChangeStateMethod( BossFirst &inst ) co
 std::string BossFirst::Die::GetStateName() const { return "Die"; }
 Donya::Vector3 BossFirst::Die::CalcVelocity( BossFirst &inst, float elapsedTime, const Donya::Vector3 &targetPos ) const
 {
-	const auto data = FetchMember().forFirst.die;
+	const auto &data = FetchMember().forFirst.die;
 
 	const float rotDegree = Donya::Random::GenerateFloat( -1.0f, 1.0f ) * data.randomRotateRangeDeg;
 
@@ -2269,7 +2301,7 @@ bool BossFirst::NowDiePerformance() const
 }
 void BossFirst::AssignMoverByAction( ActionType type )
 {
-	const auto data = FetchMember().forFirst;
+	const auto &data = FetchMember().forFirst;
 
 	switch ( type )
 	{
@@ -2326,7 +2358,7 @@ Donya::Vector3 BossFirst::CalcAimingVector( const Donya::Vector3 &targetPos, flo
 }
 std::vector<BossFirst::ActionType> BossFirst::FetchActionPatterns() const
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	const auto &patterns = data.forFirst.actionPatterns;
 	if ( patterns.empty() ) { return {}; }
 	// else
@@ -2352,12 +2384,17 @@ bool BossFirst::IsDead() const
 	return ( pMover ) ? pMover->IsDead( *this ) : BossBase::IsDead();
 }
 BossType BossFirst::GetType() const { return BossType::First; }
-std::vector<Element::Type> BossFirst::GetUncollidableTypes() const
+Element::Mask BossFirst::GetUncollidableMask() const
 {
 	// Prevent to the boss collides my fired bullet.
-	std::vector<Element::Type> tmp{};
-	tmp.emplace_back( Element::Type::Flame );
-	return tmp;
+	constexpr Element::Mask mask = Element::MakeMask( Element::Type::Flame );
+	return mask;
+}
+Actor::ResolveMode BossFirst::GetResolveMode() const
+{
+	return	( pMover && pMover->ShouldSweepSolids( *this ) )
+			? ResolveMode::Sweep
+			: ResolveMode::PushOut;
 }
 #if USE_IMGUI
 void BossFirst::ShowImGuiNode( const std::string &nodeCaption )
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "Donya/Model.h"
+#include "Donya/ModelAnimationBatch.h"
 #include "Donya/ModelMotion.h"
 #include "Donya/ModelPolygon.h"
 #include "Donya/ModelPose.h"
@@ -95,6 +96,7 @@ protected:
 		std::shared_ptr<ModelResource>	pResource;
 		Donya::Model::Pose				pose;
 		Donya::Model::Animator			animator;
+		Donya::Model::AnimationBatch	*pDeferredBatch = nullptr;	// The pose is evaluated by this if it is not nullptr.
 	} model;
 public:
 	virtual void Init( const BossInitializer &parameter );
@@ -106,6 +108,10 @@ public:
 	virtual void Draw( RenderingHelper *pRenderer ) const;
 	virtual void DrawHitBox( RenderingHelper *pRenderer, const Donya::Vector4x4 &matVP ) const;
 public:
+	/// <summary>
+	/// The pose is appended to the "pBatch" at the update instead of evaluating at there. Pass nullptr to evaluate at the update.
+	/// </summary>
+	virtual void SetDeferredAnimationBatch( Donya::Model::AnimationBatch *pBatch );
 	virtual void MakeDamage( const Element &effect, const Donya::Vector3 &othersVelocity ) const;
 	virtual bool NowDiePerformance() const;
 public:
@@ -117,7 +123,14 @@ public:
 	}
 	virtual std::vector<Donya::AABB>	AcquireHitBoxes() const;
 	virtual std::vector<Donya::AABB>	AcquireHurtBoxes() const;
-	virtual std::vector<Element::Type>	GetUncollidableTypes() const { return {}; }
+	/// <summary>
+	/// Returns the world-space region that my body may reach by the PhysicUpdate() of this frame. It is used for querying the solids.
+	/// </summary>
+	Donya::AABB							CalcSweptRegion() const;
+	/// <summary>
+	/// The bullets that have the element in this mask do not collide to me.
+	/// </summary>
+	virtual Element::Mask				GetUncollidableMask() const { return 0; }
 private:
 	using Actor::GetHitBox;
 protected:
@@ -189,6 +202,7 @@ private:
 		virtual bool AcceptDamage( const BossFirst &instance ) const;
 		virtual bool AcceptDraw( const BossFirst &instance ) const;
 		virtual bool NowDiePerformance( const BossFirst &instance ) const;
+		virtual bool ShouldSweepSolids( const BossFirst &instance ) const;
 		virtual bool ShouldChangeMover( BossFirst &instance ) const = 0;
 		virtual std::function<void()> GetChangeStateMethod( BossFirst &instance ) const = 0;
 		virtual std::string GetStateName() const = 0;
@@ -215,6 +229,7 @@ private:
 		void Uninit( BossFirst &instance ) override;
 		void Update( BossFirst &instance, float elapsedTime, const Donya::Vector3 &targetPos ) override;
 		void PhysicUpdate( BossFirst &instance, const std::vector<Donya::AABB> &solids = {}, const Donya::Model::PolygonGroup *pTerrain = nullptr, const Donya::Vector4x4 *pTerrainWorldMatrix = nullptr ) override;
+		bool ShouldSweepSolids( const BossFirst &instance ) const override;
 		bool ShouldChangeMover( BossFirst &instance ) const override;
 		std::function<void()> GetChangeStateMethod( BossFirst &instance ) const override;
 		std::string GetStateName() const override;
@@ -357,7 +372,8 @@ private:
 private:
 	bool IsDead() const override;
 	BossType GetType() const override;
-	std::vector<Element::Type>	GetUncollidableTypes() const override;
+	Element::Mask				GetUncollidableMask() const override;
+	ResolveMode					GetResolveMode() const override;
 public:
 #if USE_IMGUI
 	void ShowImGuiNode( const std::string &nodeCaption ) override;
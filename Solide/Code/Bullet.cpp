@@ -9,6 +9,11 @@
 #include "Donya/Sound.h"
 #include "Donya/Useful.h"
 
+#if USE_IMGUI
+#include "Donya/Benchmark.h"
+#include "Donya/Random.h"
+#endif // USE_IMGUI
+
 #include "Effect.h"
 #include "FilePath.h"
 #include "Music.h"
@@ -32,6 +37,9 @@ namespace Bullet
 			"Burning",
 		};
 
+		// The distance that the resolvers of the bullets leave between the bullet and the solid. It is smaller than the Donya::AABB::RESOLVE_MARGIN of the actors.
+		constexpr float RESOLVE_MARGIN = 0.0001f;
+
 		struct StorageBundle
 		{
 			Donya::Model::StaticModel	model;
@@ -39,7 +47,7 @@ namespace Bullet
 		};
 		static std::array<std::shared_ptr<StorageBundle>, KIND_COUNT> models{};
 
-		bool LoadModels()
+		bool LoadModels( Donya::JobSystem *pJobSystem, const std::function<void( float fraction )> &reportProgress )
 		{
 			auto  HasLoaded = []( const std::array<std::shared_ptr<StorageBundle>, KIND_COUNT> &models)
 			{
@@ -55,15 +63,8 @@ namespace Bullet
 			if ( !HasLoaded( models ) ) { return true; }
 			// else
 
-			Donya::Loader loader{};
-			auto Load = [&loader]( const std::string &filePath, StorageBundle *pDest )->bool
+			auto Create = []( const Donya::Loader &loader, StorageBundle *pDest )->bool
 			{
-				bool result = true;
-
-				loader.ClearData();
-				if ( !loader.Load( filePath ) ) { return false; }
-				// else
-
 				const auto &source = loader.GetModelSource();
 
 				pDest->model = Donya::Model::StaticModel::Create( source, loader.GetFileDirectory() );
@@ -72,14 +73,12 @@ namespace Bullet
 				return pDest->model.WasInitializeSucceeded();
 			};
 
-			bool result		= true;
-			bool succeeded	= true;
-
-			std::string filePath{};
+			std::vector<std::string>	filePaths{};
+			std::vector<size_t>			kinds{};
 			const std::string prefix = MODEL_DIRECTORY;
 			for ( size_t i = 0; i < KIND_COUNT; ++i )
 			{
-				filePath = prefix + MODEL_NAMES[i] + EXTENSION;
+				const std::string filePath = prefix + MODEL_NAMES[i] + EXTENSION;
 				if ( !Donya::IsExistFile( filePath ) )
 				{
 					const std::string outputMsgBase{ "Error : The model file does not exist. That is : " };
@@ -88,20 +87,23 @@ namespace Bullet
 				}
 				// else
 
-				models[i] = std::make_shared<StorageBundle>();
-				result = Load( filePath, &( *models[i] ) ); // std::shared_ptr<T> -> T -> T *
-				if ( !result )
-				{
-					const std::wstring errMsgBase{ L"Failed : Loading a model. That is : " };
-					const std::wstring errMsg = errMsgBase + Donya::MultiToWide( filePath );
-					_ASSERT_EXPR( 0, errMsg.c_str() );
-
-					succeeded = false;
-					models[i].reset(); // Indicates that it has not been loaded.
-				}
+				filePaths.emplace_back( filePath );
+				kinds.emplace_back( i );
 			}
 
-			return succeeded;
+			auto CreateModel = [&]( size_t index, const Donya::Loader &loader )->bool
+			{
+				auto &pModel = models[kinds[index]];
+				pModel = std::make_shared<StorageBundle>();
+				if ( !Create( loader, &( *pModel ) ) ) // std::shared_ptr<T> -> T -> T *
+				{
+					pModel.reset(); // Indicates that it has not been loaded.
+					return false;
+				}
+				// else
+				return true;
+			};
+			return Donya::Loader::LoadManyThenCreate( filePaths, CreateModel, pJobSystem, reportProgress );
 		}
 
 		bool IsOutOfRange( Kind kind )
@@ -558,12 +560,10 @@ CEREAL_CLASS_VERSION( Bullet::BreathMember,			0 )
 CEREAL_CLASS_VERSION( Bullet::BurningMember,		0 )
 CEREAL_CLASS_VERSION( Bullet::Member,				2 )
 
-class ParamBullet : public ParameterBase<ParamBullet>
+class ParamBullet : public ParameterBase<ParamBullet, Bullet::Member>
 {
 public:
 	static constexpr const char *ID = "Bullet";
-private:
-	Bullet::Member m;
 public:
 	void Init() override
 	{
@@ -575,7 +575,6 @@ public:
 
 		Load( m, fromBinary );
 	}
-	Bullet::Member Data() const { return m; }
 private:
 	std::string GetSerializeIdentifier()			override { return ID; }
 	std::string GetSerializePath( bool isBinary )	override { return GenerateSerializePath( ID, isBinary ); }
@@ -625,11 +624,11 @@ namespace
 
 namespace Bullet
 {
-	bool LoadBulletsResource()
+	bool LoadBulletsResource( Donya::JobSystem *pJobSystem, const std::function<void( float fraction )> &reportProgress )
 	{
 		bool succeeded = true;
 
-		if ( !LoadModels() ) { succeeded = false; }
+		if ( !LoadModels( pJobSystem, reportProgress ) ) { succeeded = false; }
 
 		ParamBullet::Get().Init();
 
@@ -650,6 +649,12 @@ namespace Bullet
 	void UseBulletsImGui()
 	{
 		ParamBullet::Get().UseImGui();
+
+		if ( ImGui::BeginIfAllowed() )
+		{
+			BulletAdmin::Get().ShowImGuiNode( u8"e̊Ǘ" );
+			ImGui::End();
+		}
 	}
 
 	void BulletAdmin::FireDesc::ShowImGuiNode( const std::string &nodeCaption, bool generatePosIsRelative )
@@ -684,10 +689,14 @@ namespace Bullet
 	void BulletAdmin::Init()
 	{
 		bulletPtrs.clear();
+		boundsCache.clear();
+		boundsAreDirty = true;
 	}
 	void BulletAdmin::Uninit()
 	{
 		bulletPtrs.clear();
+		boundsCache.clear();
+		boundsAreDirty = true;
 	}
 	void BulletAdmin::Update( float elapsedTime )
 	{
@@ -724,15 +733,26 @@ namespace Bullet
 			}
 		);
 		bulletPtrs.erase( result, bulletPtrs.end() );
+
+		boundsAreDirty = true;
 	}
-	void BulletAdmin::PhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
+	void BulletAdmin::PhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
 	{
 		for ( auto &pIt : bulletPtrs )
 		{
 			if ( !pIt ) { continue; }
 			// else
-			pIt->PhysicUpdate( solids, pTerrain, pTerrainMatrix );
+
+			const Donya::AABB region = Donya::AABBGrid::MakeSweptRegion( pIt->GetHitBoxAABB(), pIt->GetVelocity() );
+			pIt->PhysicUpdate
+			(
+				( querySolids ) ? querySolids( region ) : std::vector<Donya::AABB>{},
+				pTerrain, pTerrainMatrix
+			);
 		}
+
+		// The positions are fixed in this frame.
+		UpdateBounds();
 	}
 	void BulletAdmin::Draw( RenderingHelper *pRenderer, const Donya::Vector4 &color )
 	{
@@ -762,6 +782,8 @@ namespace Bullet
 
 		tmp->Init( param );
 		bulletPtrs.emplace_back( std::move( tmp ) );
+
+		boundsAreDirty = true;
 	}
 	size_t BulletAdmin::GetBulletCount() const
 	{
@@ -777,6 +799,327 @@ namespace Bullet
 		// else
 		return bulletPtrs[index];
 	}
+	void BulletAdmin::FindCandidatePairs( std::vector<CandidatePair> *pPairs )
+	{
+		if ( !pPairs ) { return; }
+		// else
+
+		if ( boundsAreDirty || boundsCache.size() != bulletPtrs.size() )
+		{
+			UpdateBounds();
+		}
+
+		FindOverlappingPairs( boundsCache, pPairs );
+	}
+	void BulletAdmin::FindOverlappingPairs( const std::vector<Bounds> &bounds, std::vector<CandidatePair> *pPairs )
+	{
+		if ( !pPairs ) { return; }
+		// else
+		pPairs->clear();
+
+		const size_t count = bounds.size();
+		if ( count < 2 ) { return; }
+		// else
+
+		std::vector<size_t> sweepOrder{};	// The indices of bounded ones.
+		std::vector<size_t> unboundeds{};
+		sweepOrder.reserve( count );
+		for ( size_t i = 0; i < count; ++i )
+		{
+			( bounds[i].unbounded )
+			? unboundeds.emplace_back( i )
+			: sweepOrder.emplace_back( i );
+		}
+
+		// Sweep along the axis that the bounds are spread most widely, for reducing the overlapping intervals.
+		int sweepAxis = 0;
+		if ( !sweepOrder.empty() )
+		{
+			Donya::Vector3 lowest  = bounds[sweepOrder.front()].min;
+			Donya::Vector3 highest = bounds[sweepOrder.front()].max;
+			for ( const auto &i : sweepOrder )
+			{
+				for ( int axis = 0; axis < 3; ++axis )
+				{
+					lowest[axis]  = std::min( lowest[axis],  bounds[i].min[axis] );
+					highest[axis] = std::max( highest[axis], bounds[i].max[axis] );
+				}
+			}
+			const Donya::Vector3 spread = highest - lowest;
+			sweepAxis	= ( spread.y < spread.x )
+						? ( ( spread.z < spread.x ) ? 0 : 2 )
+						: ( ( spread.z < spread.y ) ? 1 : 2 );
+		}
+
+		auto IsLessMin = [&bounds, &sweepAxis]( size_t lhs, size_t rhs )
+		{
+			const float &lhsMin = bounds[lhs].min[sweepAxis];
+			const float &rhsMin = bounds[rhs].min[sweepAxis];
+			return ( lhsMin < rhsMin ) || ( lhsMin == rhsMin && lhs < rhs );
+		};
+		std::sort( sweepOrder.begin(), sweepOrder.end(), IsLessMin );
+
+		auto IsOverlapping = []( const Bounds &a, const Bounds &b )
+		{
+			for ( int axis = 0; axis < 3; ++axis )
+			{
+				if ( a.max[axis] < b.min[axis] ) { return false; }
+				if ( b.max[axis] < a.min[axis] ) { return false; }
+			}
+			return true;
+		};
+		auto Append = [&pPairs]( size_t a, size_t b )
+		{
+			CandidatePair pair{};
+			pair.lhs = std::min( a, b );
+			pair.rhs = std::max( a, b );
+			pPairs->emplace_back( pair );
+		};
+
+		const size_t sweepCount = sweepOrder.size();
+		for ( size_t k = 0; k < sweepCount; ++k )
+		{
+			const Bounds &current = bounds[sweepOrder[k]];
+			for ( size_t m = k + 1; m < sweepCount; ++m )
+			{
+				const Bounds &other = bounds[sweepOrder[m]];
+				// The later ones start at more far, so the current does not reach to them also.
+				if ( current.max[sweepAxis] < other.min[sweepAxis] ) { break; }
+				// else
+
+				if ( IsOverlapping( current, other ) )
+				{
+					Append( sweepOrder[k], sweepOrder[m] );
+				}
+			}
+		}
+
+		// The unbounded ones are paired with all the others.
+		for ( const auto &u : unboundeds )
+		{
+			for ( size_t i = 0; i < count; ++i )
+			{
+				if ( i == u ) { continue; }
+				// else
+
+				// Prevent the duplication of the pair of unbounded ones.
+				if ( bounds[i].unbounded && i < u ) { continue; }
+				// else
+
+				Append( u, i );
+			}
+		}
+
+		auto IsLessPair = []( const CandidatePair &lhs, const CandidatePair &rhs )
+		{
+			return ( lhs.lhs < rhs.lhs ) || ( lhs.lhs == rhs.lhs && lhs.rhs < rhs.rhs );
+		};
+		std::sort( pPairs->begin(), pPairs->end(), IsLessPair );
+	}
+	void BulletAdmin::FindOverlappingPairsBruteForce( const std::vector<Bounds> &bounds, std::vector<CandidatePair> *pPairs )
+	{
+		if ( !pPairs ) { return; }
+		// else
+		pPairs->clear();
+
+		auto IsOverlapping = []( const Bounds &a, const Bounds &b )
+		{
+			if ( a.unbounded || b.unbounded ) { return true; }
+			// else
+
+			for ( int axis = 0; axis < 3; ++axis )
+			{
+				if ( a.max[axis] < b.min[axis] ) { return false; }
+				if ( b.max[axis] < a.min[axis] ) { return false; }
+			}
+			return true;
+		};
+
+		const size_t count = bounds.size();
+		for ( size_t i = 0; i < count; ++i )
+		{
+			for ( size_t j = i + 1; j < count; ++j )
+			{
+				if ( !IsOverlapping( bounds[i], bounds[j] ) ) { continue; }
+				// else
+
+				CandidatePair pair{};
+				pair.lhs = i;
+				pair.rhs = j;
+				pPairs->emplace_back( pair );
+			}
+		}
+	}
+	BulletAdmin::Bounds BulletAdmin::MakeBounds( const BulletBase &bullet )
+	{
+		// Expand slightly, for absorbing the rounding error of the actual collision methods.
+		constexpr float MARGIN = 0.001f;
+		const Donya::Vector3 margin{ MARGIN, MARGIN, MARGIN };
+
+		Bounds bounds{};
+
+		// The bullets hit-box is either an AABB or a Sphere.
+
+		const Donya::Sphere sphere = bullet.GetHitBoxSphere();
+		if ( sphere != Donya::Sphere::Nil() )
+		{
+			const Donya::Vector3 radius{ sphere.radius, sphere.radius, sphere.radius };
+			bounds.min = sphere.pos - radius - margin;
+			bounds.max = sphere.pos + radius + margin;
+			return bounds;
+		}
+		// else
+
+		const Donya::AABB aabb = bullet.GetHitBoxAABB();
+		if ( aabb != Donya::AABB::Nil() )
+		{
+			bounds.min = aabb.pos - aabb.size - margin;
+			bounds.max = aabb.pos + aabb.size + margin;
+			return bounds;
+		}
+		// else
+
+		bounds.unbounded = true;
+		return bounds;
+	}
+	void BulletAdmin::UpdateBounds()
+	{
+		const size_t count = bulletPtrs.size();
+		boundsCache.resize( count );
+		for ( size_t i = 0; i < count; ++i )
+		{
+			if ( !bulletPtrs[i] )
+			{
+				// The null bullet is skipped in the actual collision process, so any bounds are harmless.
+				boundsCache[i] = Bounds{};
+				boundsCache[i].unbounded = true;
+				continue;
+			}
+			// else
+
+			boundsCache[i] = MakeBounds( *bulletPtrs[i] );
+		}
+
+		boundsAreDirty = false;
+	}
+#if USE_IMGUI
+	void BulletAdmin::ShowImGuiNode( const std::string &nodeCaption )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		ImGui::Text( u8"e̐F%d", scast<int>( bulletPtrs.size() ) );
+
+		std::vector<CandidatePair> pairs{};
+		FindCandidatePairs( &pairs );
+		ImGui::Text( u8"̃yAF%d", scast<int>( pairs.size() ) );
+
+		ShowPairFinderBenchmarkNode( u8"yAǒv" );
+
+		ImGui::TreePop();
+	}
+	void BulletAdmin::ShowPairFinderBenchmarkNode( const std::string &nodeCaption )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		struct Result
+		{
+			int		bulletCount		= 0;
+			int		pairCount		= 0;
+			int		mismatchCount	= 0;
+			double	secondsSweep	= 0.0;
+			double	secondsBrute	= 0.0;
+		};
+		constexpr std::array<int, 3> BULLET_COUNTS{ 100, 500, 2000 };
+		static std::array<Result, BULLET_COUNTS.size()> results{};
+		static float fieldRange		= 20.0f;	// Half size.
+		static float maxHalfSize	= 2.0f;
+		static int   loopCount		= 10;
+
+		ImGui::DragFloat( u8"zú͈iaj",	&fieldRange,	0.1f, 1.0f	);
+		ImGui::DragFloat( u8"ȇ傫̍ő",	&maxHalfSize,	0.01f, 0.01f	);
+		ImGui::DragInt  ( u8"JԂ",		&loopCount,		1.0f, 1, 1000	);
+		fieldRange	= std::max( 1.0f,  fieldRange	);
+		maxHalfSize	= std::max( 0.01f, maxHalfSize	);
+		loopCount	= std::max( 1,     loopCount	);
+
+		if ( ImGui::Button( u8"v" ) )
+		{
+			for ( size_t n = 0; n < BULLET_COUNTS.size(); ++n )
+			{
+				// Scatter the bounds like the smokes, that are the spheres or the boxes.
+				std::vector<Bounds> bounds( BULLET_COUNTS[n] );
+				for ( auto &it : bounds )
+				{
+					const Donya::Vector3 center
+					{
+						Donya::Random::GenerateFloat( -fieldRange, fieldRange ),
+						Donya::Random::GenerateFloat( -fieldRange, fieldRange ),
+						Donya::Random::GenerateFloat( -fieldRange, fieldRange )
+					};
+					const Donya::Vector3 halfSize
+					{
+						Donya::Random::GenerateFloat( 0.01f, maxHalfSize ),
+						Donya::Random::GenerateFloat( 0.01f, maxHalfSize ),
+						Donya::Random::GenerateFloat( 0.01f, maxHalfSize )
+					};
+					it.min = center - halfSize;
+					it.max = center + halfSize;
+				}
+
+				std::vector<CandidatePair> pairsSweep{};
+				std::vector<CandidatePair> pairsBrute{};
+
+				Benchmark timer{};
+				timer.Begin();
+				for ( int i = 0; i < loopCount; ++i )
+				{
+					FindOverlappingPairs( bounds, &pairsSweep );
+				}
+				const double sweep = timer.End();
+
+				timer.Begin();
+				for ( int i = 0; i < loopCount; ++i )
+				{
+					FindOverlappingPairsBruteForce( bounds, &pairsBrute );
+				}
+				const double brute = timer.End();
+
+				Result &result		= results[n];
+				result.bulletCount	= BULLET_COUNTS[n];
+				result.pairCount	= scast<int>( pairsBrute.size() );
+				result.secondsSweep	= sweep / loopCount;
+				result.secondsBrute	= brute / loopCount;
+
+				const size_t compareCount = std::min( pairsSweep.size(), pairsBrute.size() );
+				result.mismatchCount = scast<int>( std::max( pairsSweep.size(), pairsBrute.size() ) - compareCount );
+				for ( size_t i = 0; i < compareCount; ++i )
+				{
+					const bool isSame = ( pairsSweep[i].lhs == pairsBrute[i].lhs && pairsSweep[i].rhs == pairsBrute[i].rhs );
+					if ( !isSame ) { result.mismatchCount++; }
+				}
+			}
+		}
+
+		for ( const auto &result : results )
+		{
+			if ( !result.bulletCount ) { continue; }
+			// else
+
+			ImGui::Text( u8"eF%dCyAF%d", result.bulletCount, result.pairCount );
+			ImGui::Text( u8"@XC[vF%.3f[ms]", result.secondsSweep * 1000.0 );
+			ImGui::Text( u8"@F%.3f[ms]", result.secondsBrute * 1000.0 );
+			if ( 0.0 < result.secondsSweep )
+			{
+				ImGui::Text( u8"@xF%.2f{", result.secondsBrute / result.secondsSweep );
+			}
+			ImGui::Text( u8"@ʂ̕svF%d", result.mismatchCount );
+		}
+
+		ImGui::TreePop();
+	}
+#endif // USE_IMGUI
 
 
 	void BulletBase::Init( const BulletAdmin::FireDesc &param )
@@ -833,8 +1176,11 @@ namespace Bullet
 		defaultResult.correctedVector = vector;
 		defaultResult.wasHit = false;
 
-		return	( solids.empty() )
-				? defaultResult
+		if ( solids.empty() ) { return defaultResult; }
+		// else
+
+		return	( GetResolveMode() == ResolveMode::Sweep )
+				? CalcSweptVectorImpl( vector, solids )
 				: CalcCorrectedVectorImpl( vector, solids );
 	}
 	BulletBase::RecursionResult	BulletBase::CalcCorrectedVector( int recursionLimit, const Donya::Vector3 &vector, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix ) const
@@ -915,8 +1261,7 @@ namespace Bullet
 		};
 		auto CalcResolver		= []( const Donya::Vector3 &penetration, const Donya::Vector3 &myMoveSign )
 		{
-			// Prevent the two edges onto same place(the collision detective allows same(equal) value).
-			constexpr float ERROR_MARGIN = 0.0001f;
+			constexpr float ERROR_MARGIN = RESOLVE_MARGIN;
 
 			Donya::Vector3 resolver
 			{
@@ -1029,6 +1374,21 @@ namespace Bullet
 		result.correctedVector = destination - pos;
 		return result;
 	}
+	BulletBase::AABBResult		BulletBase::CalcSweptVectorImpl( const Donya::Vector3 &vector, const std::vector<Donya::AABB> &solids ) const
+	{
+		const auto slid = Donya::AABB::CalcSlidMovement( GetHitBoxAABB(), vector, solids, RESOLVE_MARGIN );
+		if ( slid.wasBuried )
+		{
+			// I was already buried at the start. The sweep can not resolve it, so I entrust it to the push-out way.
+			return CalcCorrectedVectorImpl( vector, solids );
+		}
+		// else
+
+		AABBResult result{};
+		result.correctedVector	= slid.movement;
+		result.wasHit			= slid.wasHit;
+		return result;
+	}
 	BulletBase::RecursionResult BulletBase::CalcCorrectedVectorImpl( int recursionLimit, int recursionCount, RecursionResult inheritedResult, const Donya::Model::PolygonGroup &terrain, const Donya::Vector4x4 &terrainMatrix ) const
 	{
 		constexpr float ERROR_ADJUST = 0.001f;
@@ -1051,7 +1411,7 @@ namespace Bullet
 		// else
 
 		const Donya::Vector3 internalVec	=  wsRayEnd - currentResult.intersection;
-		const Donya::Vector3 wsFaceNormal	=  currentResult.nearestPolygon.normal;
+		const Donya::Vector3 wsFaceNormal	=  currentResult.normal;
 		const Donya::Vector3 projVelocity	= -wsFaceNormal * Dot( internalVec, -wsFaceNormal );
 
 		constexpr float ERROR_MAGNI = 1.0f + ERROR_ADJUST;
@@ -1186,7 +1546,7 @@ namespace Bullet
 		}
 		Donya::Vector4x4 OilBullet::GetWorldMatrix() const
 		{
-			const auto data = ParamBullet::Get().Data().oil;
+			const auto &data = ParamBullet::Get().Data().oil;
 			Donya::Vector4x4 world{};
 			world._11 = data.drawScale;
 			world._22 = data.drawScale;
@@ -1239,7 +1599,7 @@ namespace Bullet
 		}
 		Donya::Vector4x4 FlameSmoke::GetWorldMatrix() const
 		{
-			const auto data = ParamBullet::Get().Data().smoke.flame.general;
+			const auto &data = ParamBullet::Get().Data().smoke.flame.general;
 			Donya::Vector4x4 world{};
 			world._11 = data.drawScale;
 			world._22 = data.drawScale;
@@ -1273,7 +1633,7 @@ namespace Bullet
 		}
 		Donya::Vector4x4 IceSmoke::GetWorldMatrix() const
 		{
-			const auto data = ParamBullet::Get().Data().smoke.ice.general;
+			const auto &data = ParamBullet::Get().Data().smoke.ice.general;
 			Donya::Vector4x4 world{};
 			world._11 = data.drawScale;
 			world._22 = data.drawScale;
@@ -1369,7 +1729,7 @@ namespace Bullet
 		}
 		Donya::Vector4x4 Arrow::GetWorldMatrix() const
 		{
-			const auto data = ParamBullet::Get().Data().arrow;
+			const auto &data = ParamBullet::Get().Data().arrow;
 			Donya::Vector4x4 world{};
 			world._11 = data.drawScale;
 			world._22 = data.drawScale;
@@ -1462,7 +1822,7 @@ namespace Bullet
 		}
 		Donya::Vector4x4 Breath::GetWorldMatrix() const
 		{
-			const auto data = ParamBullet::Get().Data().breath;
+			const auto &data = ParamBullet::Get().Data().breath;
 			Donya::Vector4x4 world{};
 			world._11 = data.drawScale;
 			world._22 = data.drawScale;
@@ -1562,7 +1922,7 @@ namespace Bullet
 		}
 		Donya::Vector4x4 Burning::GetWorldMatrix() const
 		{
-			const auto data = ParamBullet::Get().Data().burning;
+			const auto &data = ParamBullet::Get().Data().burning;
 			Donya::Vector4x4 world{};
 			world._11 = data.drawScale;
 			world._22 = data.drawScale;
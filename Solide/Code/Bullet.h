@@ -1,9 +1,11 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Collision.h"
 #include "Donya/ModelPolygon.h"
 #include "Donya/Quaternion.h"
@@ -16,6 +18,10 @@
 #include "Renderer.h"
 
 class EffectHandle;
+namespace Donya
+{
+	class JobSystem;
+}
 
 namespace Bullet
 {
@@ -31,7 +37,11 @@ namespace Bullet
 		KindCount
 	};
 
-	bool LoadBulletsResource();
+	/// <summary>
+	/// The files of models are loaded in parallel on the "pJobSystem" if it is not nullptr.<para></para>
+	/// The "reportProgress" receives the fraction of the loaded models. It can be nullptr.
+	/// </summary>
+	bool LoadBulletsResource( Donya::JobSystem *pJobSystem = nullptr, const std::function<void( float fraction )> &reportProgress = nullptr );
 	std::string GetBulletName( Kind bulletKind );
 	#if USE_IMGUI
 	void UseBulletsImGui();
@@ -40,8 +50,28 @@ namespace Bullet
 	class BulletBase;
 	class BulletAdmin : public Donya::Singleton<BulletAdmin>
 	{
+	public:
+		/// <summary>
+		/// The bounding box of a bullet's hit-box, for the broadphase.
+		/// </summary>
+		struct Bounds
+		{
+			Donya::Vector3	min;
+			Donya::Vector3	max;
+			bool			unbounded = false; // True if the bullet has no hit-box. It is regarded as overlapping with any bullets.
+		};
+		/// <summary>
+		/// The indices of two bullets. The "lhs" is always less than the "rhs".
+		/// </summary>
+		struct CandidatePair
+		{
+			size_t lhs = 0;
+			size_t rhs = 0;
+		};
 	private:
 		std::vector<std::shared_ptr<BulletBase>> bulletPtrs;
+		std::vector<Bounds>	boundsCache;	// Parallel to bulletPtrs. Updated in PhysicUpdate().
+		bool				boundsAreDirty = true;
 	public:
 		struct FireDesc
 		{
@@ -82,7 +112,10 @@ namespace Bullet
 		void Uninit();
 
 		void Update( float elapsedTime );
-		void PhysicUpdate( const std::vector<Donya::AABB> &solids = {}, const Donya::Model::PolygonGroup *pTerrain = nullptr, const Donya::Vector4x4 *pTerrainWorldMatrix = nullptr );
+		/// <summary>
+		/// Each bullet collides to the solids that were queried by the swept region of its hit-box.
+		/// </summary>
+		void PhysicUpdate( const Donya::AABBQuery &querySolids = {}, const Donya::Model::PolygonGroup *pTerrain = nullptr, const Donya::Vector4x4 *pTerrainWorldMatrix = nullptr );
 
 		void Draw( RenderingHelper *pRenderer, const Donya::Vector4 &color );
 		void DrawHitBoxes( RenderingHelper *pRenderer, const Donya::Vector4x4 &VP, const Donya::Vector4 &color );
@@ -92,6 +125,27 @@ namespace Bullet
 		size_t GetBulletCount() const;
 		bool   IsOutOfRange( size_t index ) const;
 		const  std::shared_ptr<BulletBase> GetBulletPtrOrNull( size_t index ) const;
+	public:
+		/// <summary>
+		/// Collects the pairs of bullets that their bounds are overlapping, by using the bounds of this frame.<para></para>
+		/// The pairs are sorted in ascending order of (lhs, rhs), it is the same as the order of checking all combinations.<para></para>
+		/// This is a broadphase, so the actual hit-boxes of each pair should be checked by the caller.
+		/// </summary>
+		void FindCandidatePairs( std::vector<CandidatePair> *pPairs );
+		/// <summary>
+		/// Sort and sweep. The result is the same as FindOverlappingPairsBruteForce().
+		/// </summary>
+		static void FindOverlappingPairs( const std::vector<Bounds> &bounds, std::vector<CandidatePair> *pPairs );
+		static void FindOverlappingPairsBruteForce( const std::vector<Bounds> &bounds, std::vector<CandidatePair> *pPairs );
+	private:
+		static Bounds MakeBounds( const BulletBase &bullet );
+		void UpdateBounds();
+	#if USE_IMGUI
+	public:
+		void ShowImGuiNode( const std::string &nodeCaption );
+	private:
+		void ShowPairFinderBenchmarkNode( const std::string &nodeCaption );
+	#endif // USE_IMGUI
 	};
 
 	class BulletBase
@@ -124,6 +178,19 @@ namespace Bullet
 	protected:
 		virtual void AttachSelfKind() = 0;
 
+		/// <summary>
+		/// The way of resolving the collision between my hit-box and the solids.
+		/// </summary>
+		enum class ResolveMode
+		{
+			PushOut,	// Pushes out the moved hit-box to the shallowest side, iteratively. The thin solids may be passed through by a fast movement.
+			Sweep,		// Stops the hit-box at the time of impact and slides along the hit face. This never passes through.
+		};
+		/// <summary>
+		/// The resolve mode of CalcCorrectedVector() of AABB version.
+		/// </summary>
+		virtual ResolveMode GetResolveMode() const { return ResolveMode::PushOut; }
+
 		struct AABBResult
 		{
 			Donya::Vector3 correctedVector;
@@ -138,6 +205,7 @@ namespace Bullet
 		RecursionResult	CalcCorrectedVector( int recursionLimit, const Donya::Vector3 &targetVector, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainWorldMatrix ) const;
 	private:
 		AABBResult		CalcCorrectedVectorImpl( const Donya::Vector3 &targetVector, const std::vector<Donya::AABB> &solids ) const;
+		AABBResult		CalcSweptVectorImpl( const Donya::Vector3 &targetVector, const std::vector<Donya::AABB> &solids ) const;
 		RecursionResult	CalcCorrectedVectorImpl( int recursionLimit, int recursionCount, RecursionResult prevResult, const Donya::Model::PolygonGroup &terrain, const Donya::Vector4x4 &terrainWorldMatrix ) const;
 	public:
 		virtual bool					ShouldRemove()		const = 0;
@@ -254,6 +322,7 @@ namespace Bullet
 			void DrawHitBox( RenderingHelper *pRenderer, const Donya::Vector4x4 &VP, const Donya::Vector4 &color ) override;
 		private:
 			void AttachSelfKind() override;
+			ResolveMode GetResolveMode() const override { return ResolveMode::Sweep; } // The arrow is fast and should stick to the surface of obstacles.
 		public:
 			bool				ShouldRemove()		const override;
 			Donya::AABB			GetHitBoxAABB()		const override;
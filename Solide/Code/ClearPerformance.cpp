@@ -239,12 +239,10 @@ CEREAL_CLASS_VERSION( Member::ShowTime,		1 )
 CEREAL_CLASS_VERSION( Member::ShowRank,		1 )
 CEREAL_CLASS_VERSION( Member::Wait,			0 )
 
-class ParamClearPerformance : public ParameterBase<ParamClearPerformance>
+class ParamClearPerformance : public ParameterBase<ParamClearPerformance, Member>
 {
 public:
 	static constexpr const char *ID = "ClearPerformance";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -256,7 +254,6 @@ public:
 
 		Load( m, fromBinary );
 	}
-	Member Data() const { return m; }
 private:
 	std::string GetSerializeIdentifier()			override { return ID; }
 	std::string GetSerializePath( bool isBinary )	override { return GenerateSerializePath( ID, isBinary ); }
@@ -397,7 +394,7 @@ public:
 
 namespace
 {
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamClearPerformance::Get().Data();
 	}
@@ -466,7 +463,7 @@ void ClearPerformance::ProcessBase::UpdateEaseFactor( float wholeEaseSecond )
 
 ClearPerformance::Result ClearPerformance::ShowFrame::Update( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showFrame;
+	const auto &data = FetchMember().showFrame;
 
 	UpdateEaseFactor( data.item.easeTakeSecond );
 
@@ -487,13 +484,13 @@ void ClearPerformance::ShowFrame::Draw( ClearPerformance &inst )
 }
 void ClearPerformance::ShowFrame::AssignDrawData( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showFrame;
+	const auto &data = FetchMember().showFrame;
 	AssignLerpedItem( &inst.sprFrame, data.item, factor );
 }
 
 ClearPerformance::Result ClearPerformance::ShowDesc::Update( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showDesc;
+	const auto &data = FetchMember().showDesc;
 
 	UpdateEaseFactor( data.itemTime.easeTakeSecond );
 
@@ -523,7 +520,7 @@ void ClearPerformance::ShowDesc::Draw( ClearPerformance &inst )
 }
 void ClearPerformance::ShowDesc::AssignDrawData( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showDesc;
+	const auto &data = FetchMember().showDesc;
 
 	AssignLerpedItem( &inst.sprDesc, data.itemTime, factor );
 	paramTime = inst.sprDesc;
@@ -534,7 +531,7 @@ void ClearPerformance::ShowDesc::AssignDrawData( ClearPerformance &inst )
 
 ClearPerformance::Result ClearPerformance::ShowTime::Update( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showTime;
+	const auto &data = FetchMember().showTime;
 
 	UpdateEaseFactor( data.item.easeTakeSecond );
 	
@@ -564,13 +561,13 @@ void ClearPerformance::ShowTime::Draw( ClearPerformance &inst )
 }
 void ClearPerformance::ShowTime::AssignDrawData( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showTime;
+	const auto &data = FetchMember().showTime;
 	AssignLerpedItem( &parameter, data.item, factor );
 }
 
 ClearPerformance::Result ClearPerformance::ShowRank::Update( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showRank;
+	const auto &data = FetchMember().showRank;
 
 	UpdateEaseFactor( data.item.easeTakeSecond );
 
@@ -601,13 +598,13 @@ void ClearPerformance::ShowRank::Draw( ClearPerformance &inst )
 }
 void ClearPerformance::ShowRank::AssignDrawData( ClearPerformance &inst )
 {
-	const auto data = FetchMember().showRank;
+	const auto &data = FetchMember().showRank;
 	AssignLerpedItem( &parameter, data.item, factor );
 }
 
 ClearPerformance::Result ClearPerformance::Wait::Update( ClearPerformance &inst )
 {
-	const auto data = FetchMember().wait;
+	const auto &data = FetchMember().wait;
 
 	timer++;
 	inst.timer = timer; // For visualize
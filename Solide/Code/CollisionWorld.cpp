@@ -0,0 +1,214 @@
+#include "CollisionWorld.h"
+
+#include <algorithm>
+
+#undef max
+#undef min
+
+namespace
+{
+	// Expand the bounds slightly, for absorbing the rounding error of the actual collision methods.
+	constexpr float BOUNDS_MARGIN = 0.001f;
+}
+
+void CollisionWorld::Clear()
+{
+	categories.clear();
+	ownerIndices.clear();
+	shapes.clear();
+	aabbs.clear();
+	spheres.clear();
+	layers.clear();
+	boundMins.clear();
+	boundMaxs.clear();
+
+	sortedIDs.clear();
+	sortedMinXs.clear();
+	maxWidthX = 0.0f;
+	wasBuilt  = false;
+}
+
+CollisionWorld::ID CollisionWorld::Add( Category category, size_t ownerIndex, const Donya::AABB &wsHitBox, const Element &element )
+{
+	const ID id = AddImpl( category, ownerIndex, Shape::AABB, wsHitBox.pos - wsHitBox.size, wsHitBox.pos + wsHitBox.size, element );
+	aabbs[id] = wsHitBox;
+	return id;
+}
+CollisionWorld::ID CollisionWorld::Add( Category category, size_t ownerIndex, const Donya::Sphere &wsHitBox, const Element &element )
+{
+	const Donya::Vector3 radius{ wsHitBox.radius, wsHitBox.radius, wsHitBox.radius };
+	const ID id = AddImpl( category, ownerIndex, Shape::Sphere, wsHitBox.pos - radius, wsHitBox.pos + radius, element );
+	spheres[id] = wsHitBox;
+	return id;
+}
+CollisionWorld::ID CollisionWorld::AddImpl( Category category, size_t ownerIndex, Shape shape, const Donya::Vector3 &boundMin, const Donya::Vector3 &boundMax, const Element &element )
+{
+	const Donya::Vector3 margin{ BOUNDS_MARGIN, BOUNDS_MARGIN, BOUNDS_MARGIN };
+
+	const ID id = categories.size();
+	categories.emplace_back( category );
+	ownerIndices.emplace_back( ownerIndex );
+	shapes.emplace_back( shape );
+	aabbs.emplace_back( Donya::AABB::Nil() );
+	spheres.emplace_back( Donya::Sphere::Nil() );
+	layers.emplace_back( element.GetLayer() );
+	boundMins.emplace_back( boundMin - margin );
+	boundMaxs.emplace_back( boundMax + margin );
+
+	wasBuilt = false;
+	return id;
+}
+
+void CollisionWorld::Build()
+{
+	const size_t count = GetBoxCount();
+
+	sortedIDs.resize( count );
+	for ( size_t i = 0; i < count; ++i )
+	{
+		sortedIDs[i] = i;
+	}
+
+	auto IsLessMinX = [&]( ID lhs, ID rhs )
+	{
+		const float &lhsMin = boundMins[lhs].x;
+		const float &rhsMin = boundMins[rhs].x;
+		return ( lhsMin < rhsMin ) || ( lhsMin == rhsMin && lhs < rhs );
+	};
+	std::sort( sortedIDs.begin(), sortedIDs.end(), IsLessMinX );
+
+	sortedMinXs.resize( count );
+	maxWidthX = 0.0f;
+	for ( size_t i = 0; i < count; ++i )
+	{
+		const ID &id	= sortedIDs[i];
+		sortedMinXs[i]	= boundMins[id].x;
+		maxWidthX		= std::max( maxWidthX, boundMaxs[id].x - boundMins[id].x );
+	}
+
+	wasBuilt = true;
+}
+
+template<typename Function>
+void CollisionWorld::ForEachCandidate( const Donya::AABB &wsBox, Category categoryFilter, Function &&function ) const
+{
+	_ASSERT_EXPR( wasBuilt, L"Error : The CollisionWorld is queried before Build()!" );
+	if ( !wasBuilt ) { return; }
+	// else
+
+	const Donya::Vector3 boxMin = wsBox.pos - wsBox.size;
+	const Donya::Vector3 boxMax = wsBox.pos + wsBox.size;
+
+	// The candidates start from the range of [boxMin.x - maxWidthX, boxMax.x] in x axis.
+	const auto begin	= std::lower_bound( sortedMinXs.begin(), sortedMinXs.end(), boxMin.x - maxWidthX );
+	const auto end		= std::upper_bound( begin, sortedMinXs.end(), boxMax.x );
+	for ( auto it = begin; it != end; ++it )
+	{
+		const ID &id = sortedIDs[it - sortedMinXs.begin()];
+		if ( !IsMatched( id, categoryFilter ) ) { continue; }
+		// else
+
+		const Donya::Vector3 &otherMin = boundMins[id];
+		const Donya::Vector3 &otherMax = boundMaxs[id];
+		if ( otherMax.x < boxMin.x || otherMax.y < boxMin.y || otherMax.z < boxMin.z ) { continue; }
+		if ( boxMax.x < otherMin.x || boxMax.y < otherMin.y || boxMax.z < otherMin.z ) { continue; }
+		// else
+
+		function( id );
+	}
+}
+
+void CollisionWorld::QueryOverlaps( const Donya::AABB &wsBox, Category categoryFilter, std::vector<ID> *pIDs ) const
+{
+	if ( !pIDs ) { return; }
+	// else
+
+	const size_t firstFound = pIDs->size();
+	ForEachCandidate
+	(
+		wsBox, categoryFilter,
+		[&]( ID id )
+		{
+			if ( IsHit( id, wsBox ) )
+			{
+				pIDs->emplace_back( id );
+			}
+		}
+	);
+
+	// Arrange in the registration order.
+	std::sort( pIDs->begin() + firstFound, pIDs->end() );
+}
+CollisionWorld::ID CollisionWorld::FindFirstOverlap( const Donya::AABB &wsBox, Category categoryFilter, Element::Mask exceptMask ) const
+{
+	ID found = INVALID_ID;
+	ForEachCandidate
+	(
+		wsBox, categoryFilter,
+		[&]( ID id )
+		{
+			// The later one can not be the first.
+			if ( found != INVALID_ID && found < id ) { return; }
+			// else
+
+			if ( layers[id] & exceptMask ) { return; }
+			if ( !IsHit( id, wsBox ) ) { return; }
+			// else
+
+			found = id;
+		}
+	);
+
+	return found;
+}
+void CollisionWorld::CollectIDs( Category categoryFilter, std::vector<ID> *pIDs ) const
+{
+	if ( !pIDs ) { return; }
+	// else
+
+	const size_t count = GetBoxCount();
+	for ( size_t i = 0; i < count; ++i )
+	{
+		if ( IsMatched( i, categoryFilter ) )
+		{
+			pIDs->emplace_back( i );
+		}
+	}
+}
+
+bool CollisionWorld::IsValidID( ID id ) const
+{
+	return ( id < GetBoxCount() );
+}
+CollisionWorld::Category CollisionWorld::GetCategory( ID id ) const
+{
+	return ( IsValidID( id ) ) ? categories[id] : Category::Nil;
+}
+size_t CollisionWorld::GetOwnerIndex( ID id ) const
+{
+	return ( IsValidID( id ) ) ? ownerIndices[id] : 0;
+}
+Element::Mask CollisionWorld::GetLayer( ID id ) const
+{
+	return ( IsValidID( id ) ) ? layers[id] : 0;
+}
+Donya::AABB CollisionWorld::GetAABB( ID id ) const
+{
+	return ( IsValidID( id ) && shapes[id] == Shape::AABB ) ? aabbs[id] : Donya::AABB::Nil();
+}
+
+bool CollisionWorld::IsMatched( ID id, Category categoryFilter ) const
+{
+	return ( categories[id] & categoryFilter ) != Category::Nil;
+}
+bool CollisionWorld::IsHit( ID id, const Donya::AABB &wsBox ) const
+{
+	switch ( shapes[id] )
+	{
+	case Shape::AABB:	return Donya::AABB::IsHitAABB( aabbs[id], wsBox );
+	case Shape::Sphere:	return Donya::Sphere::IsHitAABB( spheres[id], wsBox );
+	default: break;
+	}
+
+	return false;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+
+#include "Donya/Collision.h"
+#include "Donya/Vector.h"
+
+#include "Element.h"
+
+/// <summary>
+/// Gathers the hit-boxes and hurt-boxes of the current frame into flat arrays, and answers the overlap queries through one broadphase.<para></para>
+/// The boxes are identified by the registration order, and the queries return them in that order.
+/// So if you register the boxes in the order of the owner's container, the result is the same as walking the container.
+/// </summary>
+class CollisionWorld
+{
+public:
+	/// <summary>
+	/// The role of a box. You can use bitwise operation for filtering the queries.
+	/// </summary>
+	enum class Category : unsigned int
+	{
+		Nil				= 0,
+		BulletHitBox	= 1 << 0,
+		EnemyHitBox		= 1 << 1,
+		EnemyHurtBox	= 1 << 2,
+		BossHitBox		= 1 << 3,
+		BossHurtBox		= 1 << 4,
+		Water			= 1 << 5,
+	};
+	enum class Shape
+	{
+		AABB,
+		Sphere
+	};
+	using ID = size_t;
+	static constexpr ID INVALID_ID = ~ID( 0 );
+private:
+	// Flat arrays, these are indexed by ID.
+
+	std::vector<Category>		categories;
+	std::vector<size_t>			ownerIndices;	// The index in the owner's container(e.g. the index of bullet). Zero if the owner is unique.
+	std::vector<Shape>			shapes;
+	std::vector<Donya::AABB>	aabbs;			// Valid when the shape is AABB.
+	std::vector<Donya::Sphere>	spheres;		// Valid when the shape is Sphere.
+	std::vector<Element::Mask>	layers;			// Element::GetLayer() of the owner.
+	std::vector<Donya::Vector3>	boundMins;
+	std::vector<Donya::Vector3>	boundMaxs;
+
+	// Broadphase. The ids are sorted by the lower x of bounds.
+
+	std::vector<ID>				sortedIDs;
+	std::vector<float>			sortedMinXs;	// Parallel to sortedIDs.
+	float						maxWidthX = 0.0f;
+	bool						wasBuilt  = false;
+public:
+	/// <summary>
+	/// Discards all boxes. Call this at first of every frame.
+	/// </summary>
+	void Clear();
+	/// <summary>
+	/// Registers a box of world space, and returns its id. The ids are issued in ascending order.
+	/// </summary>
+	ID   Add( Category category, size_t ownerIndex, const Donya::AABB &wsHitBox, const Element &element = Element::Type::Nil );
+	/// <summary>
+	/// Registers a box of world space, and returns its id. The ids are issued in ascending order.
+	/// </summary>
+	ID   Add( Category category, size_t ownerIndex, const Donya::Sphere &wsHitBox, const Element &element = Element::Type::Nil );
+	/// <summary>
+	/// Prepares the broadphase. Call this after registering all boxes, and before querying.
+	/// </summary>
+	void Build();
+public:
+	/// <summary>
+	/// Appends the ids of boxes that are colliding with the "wsBox", in ascending order.<para></para>
+	/// The "categoryFilter" can be combined categories.
+	/// </summary>
+	void QueryOverlaps( const Donya::AABB &wsBox, Category categoryFilter, std::vector<ID> *pIDs ) const;
+	/// <summary>
+	/// Returns the smallest id of boxes that are colliding with the "wsBox", or INVALID_ID.<para></para>
+	/// The box that its element is contained in the "exceptMask" is ignored.
+	/// </summary>
+	ID   FindFirstOverlap( const Donya::AABB &wsBox, Category categoryFilter, Element::Mask exceptMask = 0 ) const;
+	/// <summary>
+	/// Appends the ids of all boxes of the category, in ascending order.
+	/// </summary>
+	void CollectIDs( Category categoryFilter, std::vector<ID> *pIDs ) const;
+public:
+	size_t			GetBoxCount() const { return categories.size(); }
+	bool			IsValidID( ID id ) const;
+	Category		GetCategory( ID id ) const;
+	size_t			GetOwnerIndex( ID id ) const;
+	Element::Mask	GetLayer( ID id ) const;
+	/// <summary>
+	/// Returns Donya::AABB::Nil() if the shape is not AABB.
+	/// </summary>
+	Donya::AABB		GetAABB( ID id ) const;
+private:
+	ID   AddImpl( Category category, size_t ownerIndex, Shape shape, const Donya::Vector3 &boundMin, const Donya::Vector3 &boundMax, const Element &element );
+	bool IsMatched( ID id, Category categoryFilter ) const;
+	bool IsHit( ID id, const Donya::AABB &wsBox ) const;
+	template<typename Function>
+	void ForEachCandidate( const Donya::AABB &wsBox, Category categoryFilter, Function &&function ) const;
+};
+DEFINE_ENUM_FLAG_OPERATORS( CollisionWorld::Category );
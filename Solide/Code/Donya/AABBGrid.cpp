@@ -0,0 +1,212 @@
+#include "AABBGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Constant.h"
+
+#undef max
+#undef min
+
+namespace
+{
+	// Packs three cell coordinates into one key. Each coordinate is stored in 21 bits(about -1 million ~ +1 million cells).
+	std::int64_t MakeCellKey( int x, int y, int z )
+	{
+		constexpr std::int64_t MASK = ( 1LL << 21 ) - 1;
+		return	( ( scast<std::int64_t>( x ) & MASK )		) |
+				( ( scast<std::int64_t>( y ) & MASK ) << 21	) |
+				( ( scast<std::int64_t>( z ) & MASK ) << 42	);
+	}
+	int ToCellCoord( float worldCoord, float cellSize )
+	{
+		return scast<int>( std::floor( worldCoord / cellSize ) );
+	}
+}
+
+namespace Donya
+{
+	AABBGrid::AABBGrid( float cellSize ) :
+		cellSize( 1.0f ), elements(), cells(), visitedMarks(), queryMark( 0 ), aliveCount( 0 )
+	{
+		Reset( cellSize );
+	}
+
+	void AABBGrid::Reset( float newCellSize )
+	{
+		_ASSERT_EXPR( 0.0f < newCellSize, L"Error : The cell size of AABBGrid must be greater than zero!" );
+		cellSize = ( 0.0f < newCellSize ) ? newCellSize : 1.0f;
+		Clear();
+	}
+	void AABBGrid::Clear()
+	{
+		elements.clear();
+		cells.clear();
+		visitedMarks.clear();
+		queryMark  = 0;
+		aliveCount = 0;
+	}
+
+	AABBGrid::ID AABBGrid::Add( const Donya::AABB &wsBox )
+	{
+		const ID id = scast<ID>( elements.size() );
+
+		Element element{};
+		element.box		= wsBox;
+		element.range	= CalcCellRange( wsBox );
+		element.alive	= true;
+		elements.emplace_back( element );
+		visitedMarks.emplace_back( 0U );
+
+		AssignToCells( id, element.range );
+		aliveCount++;
+		return id;
+	}
+	bool AABBGrid::Update( ID id, const Donya::AABB &wsBox )
+	{
+		if ( !IsValidID( id ) ) { return false; }
+		// else
+
+		Element &element = elements[id];
+		element.box = wsBox;
+
+		const CellRange newRange = CalcCellRange( wsBox );
+		if ( newRange != element.range )
+		{
+			RemoveFromCells( id, element.range );
+			AssignToCells( id, newRange );
+			element.range = newRange;
+		}
+
+		return true;
+	}
+	bool AABBGrid::Remove( ID id )
+	{
+		if ( !IsValidID( id ) ) { return false; }
+		// else
+
+		Element &element = elements[id];
+		RemoveFromCells( id, element.range );
+		element.alive = false;
+		aliveCount--;
+		return true;
+	}
+
+	void AABBGrid::QueryRegion( const Donya::AABB &wsRegion, std::vector<ID> *pIDs ) const
+	{
+		if ( !pIDs ) { return; }
+		// else
+
+		// Refresh the marks when the counter is wrapped around.
+		if ( ++queryMark == 0 )
+		{
+			std::fill( visitedMarks.begin(), visitedMarks.end(), 0U );
+			queryMark = 1;
+		}
+
+		const size_t	firstFound	= pIDs->size();
+		const CellRange	range		= CalcCellRange( wsRegion );
+		for ( int z = range.minZ; z <= range.maxZ; ++z )
+		{
+			for ( int y = range.minY; y <= range.maxY; ++y )
+			{
+				for ( int x = range.minX; x <= range.maxX; ++x )
+				{
+					const auto found = cells.find( MakeCellKey( x, y, z ) );
+					if ( found == cells.end() ) { continue; }
+					// else
+
+					for ( const ID &id : found->second )
+					{
+						if ( visitedMarks[id] == queryMark ) { continue; }
+						// else
+						visitedMarks[id] = queryMark;
+
+						if ( !Donya::AABB::IsHitAABB( wsRegion, elements[id].box, /* ignoreExistFlag = */ true ) ) { continue; }
+						// else
+						pIDs->emplace_back( id );
+					}
+				}
+			}
+		}
+
+		std::sort( pIDs->begin() + firstFound, pIDs->end() );
+	}
+	std::vector<AABBGrid::ID> AABBGrid::QueryRegion( const Donya::AABB &wsRegion ) const
+	{
+		std::vector<ID> ids{};
+		QueryRegion( wsRegion, &ids );
+		return ids;
+	}
+	Donya::AABB AABBGrid::MakeSweptRegion( const Donya::AABB &wsBody, const Donya::Vector3 &movement )
+	{
+		const Donya::Vector3 absMovement{ fabsf( movement.x ), fabsf( movement.y ), fabsf( movement.z ) };
+
+		Donya::AABB region = wsBody;
+		region.pos  += movement * 0.5f;
+		region.size += absMovement * 0.5f + wsBody.size + absMovement;
+		region.exist = true;
+		return region;
+	}
+
+	bool AABBGrid::IsValidID( ID id ) const
+	{
+		if ( id < 0 || scast<int>( elements.size() ) <= id ) { return false; }
+		// else
+		return elements[id].alive;
+	}
+	Donya::AABB AABBGrid::GetBox( ID id ) const
+	{
+		return ( IsValidID( id ) ) ? elements[id].box : Donya::AABB::Nil();
+	}
+
+	AABBGrid::CellRange AABBGrid::CalcCellRange( const Donya::AABB &wsBox ) const
+	{
+		const Donya::Vector3 min = wsBox.pos - wsBox.size;
+		const Donya::Vector3 max = wsBox.pos + wsBox.size;
+
+		CellRange range{};
+		range.minX = ToCellCoord( min.x, cellSize );
+		range.minY = ToCellCoord( min.y, cellSize );
+		range.minZ = ToCellCoord( min.z, cellSize );
+		range.maxX = ToCellCoord( max.x, cellSize );
+		range.maxY = ToCellCoord( max.y, cellSize );
+		range.maxZ = ToCellCoord( max.z, cellSize );
+		return range;
+	}
+	void AABBGrid::AssignToCells( ID id, const CellRange &range )
+	{
+		for ( int z = range.minZ; z <= range.maxZ; ++z )
+		{
+			for ( int y = range.minY; y <= range.maxY; ++y )
+			{
+				for ( int x = range.minX; x <= range.maxX; ++x )
+				{
+					cells[MakeCellKey( x, y, z )].emplace_back( id );
+				}
+			}
+		}
+	}
+	void AABBGrid::RemoveFromCells( ID id, const CellRange &range )
+	{
+		for ( int z = range.minZ; z <= range.maxZ; ++z )
+		{
+			for ( int y = range.minY; y <= range.maxY; ++y )
+			{
+				for ( int x = range.minX; x <= range.maxX; ++x )
+				{
+					auto found = cells.find( MakeCellKey( x, y, z ) );
+					if ( found == cells.end() ) { continue; }
+					// else
+
+					auto &ids = found->second;
+					ids.erase( std::remove( ids.begin(), ids.end(), id ), ids.end() );
+					if ( ids.empty() )
+					{
+						cells.erase( found );
+					}
+				}
+			}
+		}
+	}
+}
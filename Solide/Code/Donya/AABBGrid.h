@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Donya/Collision.h"
+#include "Donya/Vector.h"
+
+namespace Donya
+{
+	/// <summary>
+	/// Uniform grid of world-space AABBs, for the broadphase of static(or rarely moving) boxes.<para></para>
+	/// A registered box is stored into every cell that it covers, and is identified by an id that Add() returned.<para></para>
+	/// The ids are issued in ascending order and never reused until Clear(), so the order of the query result is the same as the order of registration.
+	/// </summary>
+	class AABBGrid
+	{
+	public:
+		using ID = int;
+		static constexpr ID INVALID_ID = -1;
+	private:
+		struct CellRange
+		{
+			int minX{}, minY{}, minZ{};
+			int maxX{}, maxY{}, maxZ{};
+		public:
+			bool operator == ( const CellRange &R ) const
+			{
+				return	minX == R.minX && minY == R.minY && minZ == R.minZ &&
+						maxX == R.maxX && maxY == R.maxY && maxZ == R.maxZ;
+			}
+			bool operator != ( const CellRange &R ) const { return !( *this == R ); }
+		};
+		struct Element
+		{
+			Donya::AABB	box{};
+			CellRange	range{};
+			bool		alive{ false };
+		};
+	private:
+		float									cellSize;
+		std::vector<Element>					elements;	// Indexed by ID.
+		std::unordered_map<std::int64_t, std::vector<ID>> cells;
+		mutable std::vector<std::uint32_t>		visitedMarks;	// Indexed by ID. Prevents the duplication of the query result.
+		mutable std::uint32_t					queryMark;
+		size_t									aliveCount;
+	public:
+		explicit AABBGrid( float cellSize = 4.0f );
+	public:
+		/// <summary>
+		/// Discards all boxes and resets the issuing of ids. The "cellSize" must be greater than zero.
+		/// </summary>
+		void Reset( float cellSize );
+		/// <summary>
+		/// Discards all boxes and resets the issuing of ids.
+		/// </summary>
+		void Clear();
+		/// <summary>
+		/// Registers the box and returns its id. The box must be in world-space.
+		/// </summary>
+		ID   Add( const Donya::AABB &wsBox );
+		/// <summary>
+		/// Replaces the registered box. The cells are re-assigned only when the covered cell range was changed.<para></para>
+		/// Returns false if the id is invalid.
+		/// </summary>
+		bool Update( ID id, const Donya::AABB &wsBox );
+		/// <summary>
+		/// Unregisters the box. Returns false if the id is invalid.
+		/// </summary>
+		bool Remove( ID id );
+	public:
+		/// <summary>
+		/// Appends the ids of boxes that overlap with the region, in ascending order.<para></para>
+		/// The "exist" flags are ignored, so the boxes that are not exist are also appended.
+		/// </summary>
+		void QueryRegion( const Donya::AABB &wsRegion, std::vector<ID> *pIDs ) const;
+		std::vector<ID> QueryRegion( const Donya::AABB &wsRegion ) const;
+		/// <summary>
+		/// Returns the region that the body can reach by the movement, for querying the boxes that the moving body may collide.<para></para>
+		/// It has the margin of the body size, because the body may be pushed back beyond the movement by the correction.
+		/// </summary>
+		static Donya::AABB MakeSweptRegion( const Donya::AABB &wsBody, const Donya::Vector3 &movement );
+	public:
+		bool				IsValidID( ID id ) const;
+		/// <summary>
+		/// Returns Donya::AABB::Nil() if the id is invalid.
+		/// </summary>
+		Donya::AABB			GetBox( ID id ) const;
+		size_t				GetBoxCount()	const { return aliveCount;	}
+		size_t				GetCellCount()	const { return cells.size();	}
+		float				GetCellSize()	const { return cellSize;	}
+	private:
+		CellRange			CalcCellRange( const Donya::AABB &wsBox ) const;
+		void				AssignToCells( ID id, const CellRange &range );
+		void				RemoveFromCells( ID id, const CellRange &range );
+	};
+
+	/// <summary>
+	/// Returns the boxes that overlap with the region. This passes a broadphase to the users that do not know the owner of the boxes.<para></para>
+	/// An empty query is regarded as there is no box.
+	/// </summary>
+	using AABBQuery = std::function<std::vector<Donya::AABB>( const Donya::AABB &wsRegion )>;
+}
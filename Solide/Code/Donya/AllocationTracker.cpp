@@ -0,0 +1,314 @@
+#include "AllocationTracker.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>		// Use _msize().
+#include <mutex>
+#include <new>
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace AllocationTracker
+	{
+		namespace
+		{
+			// These must not allocate, because those are used in operator new.
+
+			constexpr int	MAX_TAG_COUNT	= 64;
+			constexpr int	UNTAGGED		= 0;
+
+			struct AtomicCounter
+			{
+				std::atomic<size_t> count{ 0 };
+				std::atomic<size_t> bytes{ 0 };
+			};
+			struct Budget
+			{
+				size_t	maxCount			= 0;
+				bool	assertIfExceeded	= false;
+			};
+
+			std::atomic<bool>								enableTracking{ false };
+			std::array<const char *, MAX_TAG_COUNT>			tagNames{ "Untagged" };
+			std::atomic<int>								tagCount{ 1 };
+			std::mutex										tagMutex{};
+			std::array<AtomicCounter, MAX_TAG_COUNT>		currentCounters{};
+			std::array<Counter, MAX_TAG_COUNT>				lastCounters{};
+			std::array<Budget, MAX_TAG_COUNT>				budgets{};
+			size_t											exceededFrameCount = 0;
+			std::atomic<long long>							liveBytes{ 0 };
+			std::atomic<long long>							peakLiveBytes{ 0 };
+			thread_local int								currentTag = UNTAGGED;
+
+			int FindTag( const char *tagName )
+			{
+				const int count = tagCount.load( std::memory_order_acquire );
+				for ( int i = 0; i < count; ++i )
+				{
+					if ( tagNames[i] == tagName || !strcmp( tagNames[i], tagName ) )
+					{
+						return i;
+					}
+				}
+
+				return -1;
+			}
+			/// <summary>
+			/// Returns UNTAGGED if the table is full.
+			/// </summary>
+			int FindOrRegisterTag( const char *tagName )
+			{
+				if ( !tagName ) { return UNTAGGED; }
+				// else
+
+				const int found = FindTag( tagName );
+				if ( 0 <= found ) { return found; }
+				// else
+
+				std::lock_guard<std::mutex> lock( tagMutex );
+
+				// Someone may register it while waiting the lock.
+				const int registered = FindTag( tagName );
+				if ( 0 <= registered ) { return registered; }
+				// else
+
+				const int newTag = tagCount.load( std::memory_order_relaxed );
+				if ( MAX_TAG_COUNT <= newTag )
+				{
+					_ASSERT_EXPR( 0, L"Error: The tags of allocation tracker are full!" );
+					return UNTAGGED;
+				}
+				// else
+
+				tagNames[newTag] = tagName;
+				tagCount.store( newTag + 1, std::memory_order_release );
+				return newTag;
+			}
+
+			void Record( size_t size )
+			{
+				if ( !enableTracking.load( std::memory_order_relaxed ) ) { return; }
+				// else
+
+				auto &counter = currentCounters[currentTag];
+				counter.count.fetch_add( 1,		std::memory_order_relaxed );
+				counter.bytes.fetch_add( size,	std::memory_order_relaxed );
+			}
+			void *Allocate( size_t size )
+			{
+				Record( size );
+
+				void *p = malloc( ( size ) ? size : 1 );
+				if ( !p ) { throw std::bad_alloc{}; }
+				// else
+
+				// The _msize() is not free, so the live bytes are counted only while enabled.
+				if ( !enableTracking.load( std::memory_order_relaxed ) ) { return p; }
+				// else
+
+				const long long blockSize	= scast<long long>( _msize( p ) );
+				const long long current		= liveBytes.fetch_add( blockSize, std::memory_order_relaxed ) + blockSize;
+				long long peak = peakLiveBytes.load( std::memory_order_relaxed );
+				while ( peak < current && !peakLiveBytes.compare_exchange_weak( peak, current, std::memory_order_relaxed ) ) {}
+
+				return p;
+			}
+			void Deallocate( void *p )
+			{
+				if ( !p ) { return; }
+				// else
+
+				if ( enableTracking.load( std::memory_order_relaxed ) )
+				{
+					liveBytes.fetch_sub( scast<long long>( _msize( p ) ), std::memory_order_relaxed );
+				}
+				free( p );
+			}
+		}
+
+		void SetEnable( bool enable )
+		{
+			enableTracking.store( enable, std::memory_order_relaxed );
+		}
+		bool IsEnabled()
+		{
+			return enableTracking.load( std::memory_order_relaxed );
+		}
+
+		TagId GetCurrentTag()
+		{
+			return TagId{ currentTag };
+		}
+
+		Scope::Scope( const char *tagName ) : prevTag( currentTag )
+		{
+			Change( tagName );
+		}
+		Scope::Scope( TagId tag ) : prevTag( currentTag )
+		{
+			currentTag = ( 0 <= tag.index && tag.index < tagCount.load( std::memory_order_acquire ) ) ? tag.index : UNTAGGED;
+		}
+		Scope::~Scope()
+		{
+			currentTag = prevTag;
+		}
+		void Scope::Change( const char *tagName )
+		{
+			currentTag = FindOrRegisterTag( tagName );
+		}
+
+		void BeginFrame()
+		{
+			bool wasExceeded = false;
+
+			const int count = tagCount.load( std::memory_order_acquire );
+			for ( int i = 0; i < count; ++i )
+			{
+				Counter &last = lastCounters[i];
+				last.count = currentCounters[i].count.exchange( 0, std::memory_order_relaxed );
+				last.bytes = currentCounters[i].bytes.exchange( 0, std::memory_order_relaxed );
+
+				const Budget &budget = budgets[i];
+				if ( !budget.maxCount || last.count <= budget.maxCount ) { continue; }
+				// else
+
+				wasExceeded = true;
+				_ASSERT_EXPR( !budget.assertIfExceeded, L"Error: The allocation count exceeded the budget!" );
+			}
+
+			if ( wasExceeded ) { exceededFrameCount++; }
+		}
+
+		void SetBudget( const char *tagName, size_t maxCountPerFrame, bool assertIfExceeded )
+		{
+			const int tag = FindOrRegisterTag( tagName );
+			budgets[tag].maxCount			= maxCountPerFrame;
+			budgets[tag].assertIfExceeded	= assertIfExceeded;
+		}
+
+		Counter GetLastFrameCounter( const char *tagName )
+		{
+			const int tag = FindTag( tagName );
+			return ( 0 <= tag ) ? lastCounters[tag] : Counter{};
+		}
+		Counter GetLastFrameTotal()
+		{
+			Counter total{};
+			const int count = tagCount.load( std::memory_order_acquire );
+			for ( int i = 0; i < count; ++i )
+			{
+				total.count += lastCounters[i].count;
+				total.bytes += lastCounters[i].bytes;
+			}
+			return total;
+		}
+		size_t GetExceededFrameCount()
+		{
+			return exceededFrameCount;
+		}
+		void ResetExceededFrameCount()
+		{
+			exceededFrameCount = 0;
+		}
+
+		long long GetLiveBytes()
+		{
+			return liveBytes.load( std::memory_order_relaxed );
+		}
+		long long GetPeakLiveBytes()
+		{
+			return peakLiveBytes.load( std::memory_order_relaxed );
+		}
+		void ResetPeakLiveBytes()
+		{
+			peakLiveBytes.store( liveBytes.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+		}
+
+	#if USE_IMGUI
+		void ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			bool enable = IsEnabled();
+		#if USE_ALLOCATION_TRACKER
+			if ( ImGui::Checkbox( "Enable tracking", &enable ) )
+			{
+				SetEnable( enable );
+			}
+		#else
+			ImGui::Text( "The tracker is disabled by USE_ALLOCATION_TRACKER." );
+		#endif // USE_ALLOCATION_TRACKER
+
+			const Counter total = GetLastFrameTotal();
+			ImGui::Text( "Last frame total : Count[%d], Bytes[%d]", scast<int>( total.count ), scast<int>( total.bytes ) );
+
+			const int count = tagCount.load( std::memory_order_acquire );
+			for ( int i = 0; i < count; ++i )
+			{
+				const Counter	&last	= lastCounters[i];
+				const Budget	&budget	= budgets[i];
+				const bool		isOver	= ( budget.maxCount && budget.maxCount < last.count );
+				const ImVec4	color	= ( isOver ) ? ImVec4{ 1.0f, 0.3f, 0.3f, 1.0f } : ImVec4{ 1.0f, 1.0f, 1.0f, 1.0f };
+				ImGui::TextColored
+				(
+					color,
+					"%s : Count[%d], Bytes[%d], Budget[%d]",
+					tagNames[i], scast<int>( last.count ), scast<int>( last.bytes ), scast<int>( budget.maxCount )
+				);
+			}
+
+			ImGui::Text( "Exceeded frames : %d", scast<int>( exceededFrameCount ) );
+			if ( ImGui::Button( "Reset exceeded frames" ) )
+			{
+				ResetExceededFrameCount();
+			}
+
+			auto ToKB = []( long long bytes )
+			{
+				return scast<float>( bytes ) / 1024.0f;
+			};
+			ImGui::Text( "Live(while enabled) : %.1f[KB], Peak : %.1f[KB]", ToKB( GetLiveBytes() ), ToKB( GetPeakLiveBytes() ) );
+			if ( ImGui::Button( "Reset peak" ) )
+			{
+				ResetPeakLiveBytes();
+			}
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+	}
+}
+
+#if USE_ALLOCATION_TRACKER
+
+// Replaces the global allocation functions. The deallocations are not counted per frame, but are subtracted from the live bytes while enabled.
+
+void *operator new  ( size_t size ) { return Donya::AllocationTracker::Allocate( size ); }
+void *operator new[]( size_t size ) { return Donya::AllocationTracker::Allocate( size ); }
+void *operator new  ( size_t size, const std::nothrow_t & ) noexcept
+{
+	try { return Donya::AllocationTracker::Allocate( size ); }
+	catch ( ... ) { return nullptr; }
+}
+void *operator new[]( size_t size, const std::nothrow_t & ) noexcept
+{
+	try { return Donya::AllocationTracker::Allocate( size ); }
+	catch ( ... ) { return nullptr; }
+}
+
+void operator delete  ( void *p ) noexcept { Donya::AllocationTracker::Deallocate( p ); }
+void operator delete[]( void *p ) noexcept { Donya::AllocationTracker::Deallocate( p ); }
+void operator delete  ( void *p, size_t ) noexcept { Donya::AllocationTracker::Deallocate( p ); }
+void operator delete[]( void *p, size_t ) noexcept { Donya::AllocationTracker::Deallocate( p ); }
+void operator delete  ( void *p, const std::nothrow_t & ) noexcept { Donya::AllocationTracker::Deallocate( p ); }
+void operator delete[]( void *p, const std::nothrow_t & ) noexcept { Donya::AllocationTracker::Deallocate( p ); }
+
+#endif // USE_ALLOCATION_TRACKER
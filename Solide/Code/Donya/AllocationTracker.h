@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+
+#include "Constant.h"	// Use DEBUG_MODE.
+#include "UseImGui.h"
+
+#ifndef USE_ALLOCATION_TRACKER
+#define USE_ALLOCATION_TRACKER	( DEBUG_MODE )
+#endif // USE_ALLOCATION_TRACKER
+
+namespace Donya
+{
+	/// <summary>
+	/// Counts the allocations of global operator new per frame and per tag. The operator new is replaced only if the USE_ALLOCATION_TRACKER is true.<para></para>
+	/// The counting is disabled until SetEnable( true ) is called. The allocations out of any Scope are counted as "Untagged".
+	/// </summary>
+	namespace AllocationTracker
+	{
+		struct Counter
+		{
+			size_t count = 0;
+			size_t bytes = 0;
+		};
+
+		/// <summary>
+		/// The registered tag. Use it for carrying the tag of a thread to another thread.
+		/// </summary>
+		struct TagId
+		{
+			int index = 0;
+		};
+
+		void SetEnable( bool enable );
+		bool IsEnabled();
+
+		/// <summary>
+		/// Returns the tag of the current thread. The tag is "Untagged" if out of any Scope.
+		/// </summary>
+		TagId GetCurrentTag();
+
+		/// <summary>
+		/// Tags the allocations of the current thread while this is alive. The inner scope takes priority.<para></para>
+		/// The tag name is kept as the pointer, so please pass a string literal.<para></para>
+		/// The tag is per thread, so the job that runs on another thread should be wrapped by a Scope of the TagId that was got by GetCurrentTag() at the submission.
+		/// </summary>
+		class Scope
+		{
+		private:
+			int prevTag = 0;
+		public:
+			explicit Scope( const char *tagName );
+			explicit Scope( TagId tag );
+			~Scope();
+			Scope( const Scope & )				= delete;
+			Scope &operator = ( const Scope & )	= delete;
+		public:
+			/// <summary>
+			/// Changes the tag of this scope. This is useful for separating the phases of a function.
+			/// </summary>
+			void Change( const char *tagName );
+		};
+
+		/// <summary>
+		/// Moves the counts of the current frame to the last frame, and checks those with the budgets. Please call this once per frame.
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// Sets the maximum allocation count per frame of the tag. Zero means unlimited.<para></para>
+		/// The frame that exceeds the budget is counted, and asserts if the "assertIfExceeded" is true.
+		/// </summary>
+		void SetBudget( const char *tagName, size_t maxCountPerFrame, bool assertIfExceeded = false );
+
+		Counter GetLastFrameCounter( const char *tagName );
+		Counter GetLastFrameTotal();
+		/// <summary>
+		/// Returns the count of frames that exceeded the budget of any tag.
+		/// </summary>
+		size_t  GetExceededFrameCount();
+		void ResetExceededFrameCount();
+
+		/// <summary>
+		/// Returns the bytes that were allocated by operator new minus the deleted bytes, while the tracking is enabled.<para></para>
+		/// The blocks that were allocated while disabled are also subtracted when deleted, so this may be negative. Please use the difference of two values. Always zero if the USE_ALLOCATION_TRACKER is false.
+		/// </summary>
+		long long GetLiveBytes();
+		/// <summary>
+		/// Returns the maximum of GetLiveBytes() since the last ResetPeakLiveBytes(). Useful for measuring the temporary memory of a process.
+		/// </summary>
+		long long GetPeakLiveBytes();
+		void ResetPeakLiveBytes();
+
+	#if USE_IMGUI
+		void ShowImGuiNode( const std::string &nodeCaption );
+	#endif // USE_IMGUI
+	}
+}
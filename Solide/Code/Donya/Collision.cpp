@@ -1,6 +1,8 @@
 #include "Collision.h"
 
+#include <algorithm>
 #include <array>
+#include <limits>
 
 #include "Constant.h"
 #include "Useful.h"	// Use ZeroEqual().
@@ -312,6 +314,147 @@ namespace Donya
 		float distanceSq = CalcShortestDistanceSq( L, R.pos );
 		return ( distanceSq < ( R.radius * R.radius ) );
 	}
+	AABB::SweepResult AABB::CalcSweptHit( const AABB &movingBox, const Donya::Vector3 &movement, const AABB &staticBox, bool ignoreExistFlag )
+	{
+		SweepResult result{};
+		if ( !ignoreExistFlag && ( !movingBox.exist || !staticBox.exist ) ) { return result; }
+		// else
+
+		// Judge by "ray of the center of moving box" vs "static box extended by size of moving box".
+		// The range of the ray on each axis is the slab, and the ray hits if all slabs overlap in [0, 1].
+
+		const Donya::Vector3 extSize = staticBox.size + movingBox.size;
+
+		constexpr int NO_AXIS = -1;
+		float	enterTime	= -std::numeric_limits<float>::max();
+		float	exitTime	=  std::numeric_limits<float>::max();
+		int		enterAxis	= NO_AXIS;
+		for ( int i = 0; i < 3; ++i )
+		{
+			const float min		= staticBox.pos[i] - extSize[i];
+			const float max		= staticBox.pos[i] + extSize[i];
+			const float start	= movingBox.pos[i];
+			const float move	= movement[i];
+
+			if ( move == 0.0f )
+			{
+				// Never enters the slab if it is outside(or on the face) now.
+				if ( start <= min || max <= start ) { return result; }
+				// else
+				continue;
+			}
+			// else
+
+			float slabEnter	= ( min - start ) / move;
+			float slabExit	= ( max - start ) / move;
+			if ( slabExit < slabEnter ) { std::swap( slabEnter, slabExit ); }
+
+			if ( enterTime < slabEnter )
+			{
+				enterTime = slabEnter;
+				enterAxis = i;
+			}
+			exitTime = std::min( exitTime, slabExit );
+		}
+
+		if ( exitTime < enterTime ) { return result; }
+		if ( exitTime <= 0.0f     ) { return result; } // Behind of the ray, or leaving from the touching face.
+		if ( 1.0f < enterTime     ) { return result; } // Ahead of the movement.
+		// else
+
+		result.wasHit = true;
+		if ( enterAxis == NO_AXIS || enterTime < 0.0f )
+		{
+			// These were overlapping at the start.
+			result.time		= 0.0f;
+			result.normal	= Donya::Vector3::Zero();
+			return result;
+		}
+		// else
+
+		result.time					= enterTime;
+		result.normal				= Donya::Vector3::Zero();
+		result.normal[enterAxis]	= ( 0.0f < movement[enterAxis] ) ? -1.0f : 1.0f;
+		return result;
+	}
+	constexpr float AABB::RESOLVE_MARGIN; // The definition for odr-use in C++14.
+	AABB::SlideResult AABB::CalcSlidMovement( const AABB &body, const Donya::Vector3 &movement, const std::vector<AABB> &solids, float resolveMargin )
+	{
+		SlideResult result{};
+		result.movement = movement;
+
+		if ( movement.IsZero() || !body.exist ) { return result; }
+		// else
+
+		// The slid movements never go out of the swept region of the whole movement, so the candidates are collected once.
+		AABB sweptRegion{};
+		sweptRegion.pos		= body.pos + ( movement * 0.5f );
+		sweptRegion.size	= body.size + Donya::Vector3{ fabsf( movement.x ), fabsf( movement.y ), fabsf( movement.z ) } * 0.5f;
+		sweptRegion.exist	= true;
+
+		std::vector<const AABB *> candidates{};
+		for ( const auto &it : solids )
+		{
+			if ( it == body ) { continue; } // Except myself.
+			// else
+
+			if ( IsHitAABB( sweptRegion, it ) )
+			{
+				candidates.emplace_back( &it );
+			}
+		}
+		if ( candidates.empty() ) { return result; }
+		// else
+
+		AABB			movedBody	= body;
+		Donya::Vector3	remaining	= movement;
+
+		constexpr unsigned int MAX_LOOP_COUNT = 3U;
+		while ( result.loopCount < MAX_LOOP_COUNT && !remaining.IsZero() )
+		{
+			result.loopCount++;
+
+			SweepResult nearest{};
+			for ( const auto &pIt : candidates )
+			{
+				const auto sweep = CalcSweptHit( movedBody, remaining, *pIt );
+				if ( sweep.wasHit && ( !nearest.wasHit || sweep.time < nearest.time ) )
+				{
+					nearest = sweep;
+				}
+			}
+
+			if ( !nearest.wasHit )
+			{
+				movedBody.pos += remaining;
+				break;
+			}
+			// else
+
+			result.wasHit = true;
+
+			if ( nearest.normal.IsZero() )
+			{
+				result.movement		= movement;
+				result.wasBuried	= true;
+				return result;
+			}
+			// else
+
+			// Stop in front of the hit face, then slide along it by the rest.
+			movedBody.pos += remaining * nearest.time;
+			movedBody.pos += nearest.normal * resolveMargin;
+
+			remaining *= 1.0f - nearest.time;
+			for ( int i = 0; i < 3; ++i )
+			{
+				if ( !ZeroEqual( nearest.normal[i] ) ) { remaining[i] = 0.0f; }
+			}
+		}
+
+		result.movement = movedBody.pos - body.pos;
+		return result;
+	}
 	
 	bool Sphere::IsHitPoint	( const Sphere &L, const Donya::Vector3 &R, bool ignoreExistFlag )
 	{
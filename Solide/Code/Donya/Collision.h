@@ -2,6 +2,7 @@
 #define INCLUDED_DONYA_COLLISION_H_
 
 #include <cstdint> // use for std::uint32_t
+#include <vector>
 
 #include <cereal/cereal.hpp>
 
@@ -188,6 +189,39 @@ namespace Donya
 		/// The "ignoreExistFlag" is specify disable of exist flag.
 		/// </summary>
 		static bool IsHitSphere( const AABB &worldSpaceBox, const Sphere &worldSpaceSphere, bool ignoreExistFlag = false );
+	public:
+		struct SweepResult
+		{
+			float			time = 1.0f;	// The time of impact, 0.0f ~ 1.0f. The contact position is "movingBox.pos + movement * time".
+			Donya::Vector3	normal;			// The unit normal of the hit face of "staticBox". It is zero if the boxes were overlapping at the start.
+			bool			wasHit = false;
+		};
+		/// <summary>
+		/// Moving AABB vs AABB, assumes that these belong in world-space when collision checking.<para></para>
+		/// Returns the earliest time that the "movingBox" touches the "staticBox" while moving by the "movement".<para></para>
+		/// If these are overlapping at the start, returns the time of zero and the normal of zero, except the case of leaving(or sliding on) the touching face.<para></para>
+		/// The "ignoreExistFlag" is specify disable of exist flag.
+		/// </summary>
+		static SweepResult CalcSweptHit( const AABB &movingBox, const Donya::Vector3 &movement, const AABB &staticBox, bool ignoreExistFlag = false );
+		/// <summary>
+		/// The distance that the resolvers of the collision leave between the resolved box and the solid.<para></para>
+		/// It prevents the two edges onto same place(the collision detective allows same(equal) value).
+		/// </summary>
+		static constexpr float RESOLVE_MARGIN = 0.001f;
+		struct SlideResult
+		{
+			Donya::Vector3	movement;				// The corrected movement.
+			unsigned int	loopCount	= 0;		// The iteration count of the sliding, for profiling.
+			bool			wasHit		= false;
+			bool			wasBuried	= false;	// The "movingBox" overlapped with a solid at the start. The "movement" is not corrected in this case.
+		};
+		/// <summary>
+		/// Moves the "movingBox" by the "movement" with stopping in front of the earliest hit face of the "solids", then slides along the face by the rest.<para></para>
+		/// Each slide removes the movement of one axis, so the iteration count is up to three. The solids that are equal to the "movingBox" are ignored.<para></para>
+		/// This never passes through the solids, but can not resolve the overlapping at the start. Please check the "wasBuried" and resolve by another way.<para></para>
+		/// The "resolveMargin" is the distance that is left in front of the hit face.
+		/// </summary>
+		static SlideResult CalcSlidMovement( const AABB &movingBox, const Donya::Vector3 &movement, const std::vector<AABB> &solids, float resolveMargin = RESOLVE_MARGIN );
 	public:
 		static AABB Nil()
 		{
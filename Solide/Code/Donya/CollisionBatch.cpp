@@ -0,0 +1,510 @@
+#include "CollisionBatch.h"
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __SSE2__ )
+#define DONYA_COLLISION_BATCH_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define DONYA_COLLISION_BATCH_USE_SSE 0
+#endif
+
+#if USE_IMGUI
+#include <array>
+#include "Benchmark.h"
+#include "Random.h"
+#endif // USE_IMGUI
+
+#include "Constant.h"
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace
+	{
+		constexpr std::uint32_t EXIST_BITS = 0xFFFFFFFF;
+		constexpr size_t		BITS_PER_MASK = 32;
+		constexpr size_t		LANE_COUNT = 4;
+
+		void PrepareHitMask( size_t colliderCount, std::vector<std::uint32_t> *pHitMask )
+		{
+			pHitMask->assign( ( colliderCount + BITS_PER_MASK - 1 ) / BITS_PER_MASK, 0U );
+		}
+		void SetHitBit( size_t index, std::vector<std::uint32_t> *pHitMask )
+		{
+			( *pHitMask )[index / BITS_PER_MASK] |= ( 1U << ( index % BITS_PER_MASK ) );
+		}
+		// The "bits" must be the result of LANE_COUNT lanes, and the "firstIndex" must be a multiple of LANE_COUNT.
+		void SetHitBits( size_t firstIndex, std::uint32_t bits, std::vector<std::uint32_t> *pHitMask )
+		{
+			( *pHitMask )[firstIndex / BITS_PER_MASK] |= ( bits << ( firstIndex % BITS_PER_MASK ) );
+		}
+	}
+
+	void AABBSet::Clear()
+	{
+		posX.clear();	posY.clear();	posZ.clear();
+		sizeX.clear();	sizeY.clear();	sizeZ.clear();
+		exists.clear();
+	}
+	void AABBSet::Reserve( size_t count )
+	{
+		posX.reserve( count );	posY.reserve( count );	posZ.reserve( count );
+		sizeX.reserve( count );	sizeY.reserve( count );	sizeZ.reserve( count );
+		exists.reserve( count );
+	}
+	void AABBSet::Add( const AABB &box )
+	{
+		posX.emplace_back( box.pos.x );		posY.emplace_back( box.pos.y );		posZ.emplace_back( box.pos.z );
+		sizeX.emplace_back( box.size.x );	sizeY.emplace_back( box.size.y );	sizeZ.emplace_back( box.size.z );
+		exists.emplace_back( ( box.exist ) ? EXIST_BITS : 0U );
+	}
+	void AABBSet::Assign( const std::vector<AABB> &boxes )
+	{
+		Clear();
+		Reserve( boxes.size() );
+		for ( const auto &it : boxes )
+		{
+			Add( it );
+		}
+	}
+	AABB AABBSet::Get( size_t index ) const
+	{
+		AABB tmp{};
+		tmp.pos		= Donya::Vector3{ posX[index],  posY[index],  posZ[index]  };
+		tmp.size	= Donya::Vector3{ sizeX[index], sizeY[index], sizeZ[index] };
+		tmp.exist	= ( exists[index] != 0U );
+		return tmp;
+	}
+
+	void SphereSet::Clear()
+	{
+		posX.clear();	posY.clear();	posZ.clear();
+		radius.clear();
+		exists.clear();
+	}
+	void SphereSet::Reserve( size_t count )
+	{
+		posX.reserve( count );	posY.reserve( count );	posZ.reserve( count );
+		radius.reserve( count );
+		exists.reserve( count );
+	}
+	void SphereSet::Add( const Sphere &sphere )
+	{
+		posX.emplace_back( sphere.pos.x );	posY.emplace_back( sphere.pos.y );	posZ.emplace_back( sphere.pos.z );
+		radius.emplace_back( sphere.radius );
+		exists.emplace_back( ( sphere.exist ) ? EXIST_BITS : 0U );
+	}
+	void SphereSet::Assign( const std::vector<Sphere> &spheres )
+	{
+		Clear();
+		Reserve( spheres.size() );
+		for ( const auto &it : spheres )
+		{
+			Add( it );
+		}
+	}
+	Sphere SphereSet::Get( size_t index ) const
+	{
+		Sphere tmp{};
+		tmp.pos		= Donya::Vector3{ posX[index], posY[index], posZ[index] };
+		tmp.radius	= radius[index];
+		tmp.exist	= ( exists[index] != 0U );
+		return tmp;
+	}
+
+	namespace Batch
+	{
+	#if DONYA_COLLISION_BATCH_USE_SSE
+		namespace
+		{
+			// These kernels replicate the operation order of the scalar versions, so the results are bit-exact.
+
+			__m128 LoadExists( const std::vector<std::uint32_t> &exists, size_t i, bool ignoreExistFlag )
+			{
+				return	( ignoreExistFlag )
+						? _mm_castsi128_ps( _mm_set1_epi32( -1 ) )
+						: _mm_castsi128_ps( _mm_loadu_si128( reinterpret_cast<const __m128i *>( &exists[i] ) ) );
+			}
+
+			/// <summary>
+			/// Returns the count of checked colliders. It is a multiple of LANE_COUNT.
+			/// </summary>
+			size_t AABBVsAABBs( const AABB &query, const AABBSet &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag )
+			{
+				const __m128 qPosX  = _mm_set1_ps( query.pos.x  ), qPosY  = _mm_set1_ps( query.pos.y  ), qPosZ  = _mm_set1_ps( query.pos.z  );
+				const __m128 qSizeX = _mm_set1_ps( query.size.x ), qSizeY = _mm_set1_ps( query.size.y ), qSizeZ = _mm_set1_ps( query.size.z );
+
+				// Same as AABB::IsHitPoint( query extended by the size of other, position of other ).
+				auto Reject = []( const __m128 &qPos, const __m128 &qSize, const float *pOtherPos, const float *pOtherSize )
+				{
+					const __m128 point	= _mm_loadu_ps( pOtherPos );
+					const __m128 ext	= _mm_add_ps( qSize, _mm_loadu_ps( pOtherSize ) );
+					return _mm_or_ps
+					(
+						_mm_cmplt_ps( point, _mm_sub_ps( qPos, ext ) ),
+						_mm_cmpgt_ps( point, _mm_add_ps( qPos, ext ) )
+					);
+				};
+
+				const size_t count = set.Size() - ( set.Size() % LANE_COUNT );
+				for ( size_t i = 0; i < count; i += LANE_COUNT )
+				{
+					__m128 reject =			Reject( qPosX, qSizeX, &set.posX[i], &set.sizeX[i] );
+					reject = _mm_or_ps( reject,	Reject( qPosY, qSizeY, &set.posY[i], &set.sizeY[i] ) );
+					reject = _mm_or_ps( reject,	Reject( qPosZ, qSizeZ, &set.posZ[i], &set.sizeZ[i] ) );
+
+					const __m128 hit = _mm_andnot_ps( reject, LoadExists( set.exists, i, ignoreExistFlag ) );
+					SetHitBits( i, scast<std::uint32_t>( _mm_movemask_ps( hit ) ), pHitMask );
+				}
+				return count;
+			}
+
+			// Same as the lambda of AABB::IsHitSphere(), the one axis of distance from the box to the point.
+			__m128 CalcDistance( const __m128 &point, const __m128 &boxMin, const __m128 &boxMax )
+			{
+				const __m128 zero		= _mm_setzero_ps();
+				const __m128 overMax	= _mm_cmpgt_ps( point, boxMax );
+				const __m128 underMin	= _mm_cmplt_ps( point, boxMin );
+
+				__m128 distance = _mm_or_ps( _mm_and_ps( overMax, _mm_sub_ps( point, boxMax ) ), _mm_andnot_ps( overMax, zero ) );
+				distance = _mm_or_ps( _mm_and_ps( underMin, _mm_sub_ps( point, boxMin ) ), _mm_andnot_ps( underMin, distance ) );
+				return distance;
+			}
+			__m128 CalcLengthSq( const __m128 &x, const __m128 &y, const __m128 &z )
+			{
+				// ( x * x ) + ( y * y ) + ( z * z ), as Vector3::LengthSq().
+				return _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ), _mm_mul_ps( z, z ) );
+			}
+
+			size_t AABBVsSpheres( const AABB &query, const SphereSet &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag )
+			{
+				const __m128 maxX = _mm_set1_ps( query.pos.x + query.size.x );
+				const __m128 maxY = _mm_set1_ps( query.pos.y + query.size.y );
+				const __m128 maxZ = _mm_set1_ps( query.pos.z + query.size.z );
+				const __m128 minX = _mm_set1_ps( query.pos.x - query.size.x );
+				const __m128 minY = _mm_set1_ps( query.pos.y - query.size.y );
+				const __m128 minZ = _mm_set1_ps( query.pos.z - query.size.z );
+
+				const size_t count = set.Size() - ( set.Size() % LANE_COUNT );
+				for ( size_t i = 0; i < count; i += LANE_COUNT )
+				{
+					const __m128 distX = CalcDistance( _mm_loadu_ps( &set.posX[i] ), minX, maxX );
+					const __m128 distY = CalcDistance( _mm_loadu_ps( &set.posY[i] ), minY, maxY );
+					const __m128 distZ = CalcDistance( _mm_loadu_ps( &set.posZ[i] ), minZ, maxZ );
+					const __m128 radius = _mm_loadu_ps( &set.radius[i] );
+
+					const __m128 inside	= _mm_cmplt_ps( CalcLengthSq( distX, distY, distZ ), _mm_mul_ps( radius, radius ) );
+					const __m128 hit	= _mm_and_ps( inside, LoadExists( set.exists, i, ignoreExistFlag ) );
+					SetHitBits( i, scast<std::uint32_t>( _mm_movemask_ps( hit ) ), pHitMask );
+				}
+				return count;
+			}
+
+			size_t SphereVsAABBs( const Sphere &query, const AABBSet &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag )
+			{
+				const __m128 pointX = _mm_set1_ps( query.pos.x );
+				const __m128 pointY = _mm_set1_ps( query.pos.y );
+				const __m128 pointZ = _mm_set1_ps( query.pos.z );
+				const __m128 radiusSq = _mm_set1_ps( query.radius * query.radius );
+
+				auto CalcAxisDistance = []( const __m128 &point, const float *pBoxPos, const float *pBoxSize )
+				{
+					const __m128 pos  = _mm_loadu_ps( pBoxPos );
+					const __m128 size = _mm_loadu_ps( pBoxSize );
+					return CalcDistance( point, _mm_sub_ps( pos, size ), _mm_add_ps( pos, size ) );
+				};
+
+				const size_t count = set.Size() - ( set.Size() % LANE_COUNT );
+				for ( size_t i = 0; i < count; i += LANE_COUNT )
+				{
+					const __m128 distX = CalcAxisDistance( pointX, &set.posX[i], &set.sizeX[i] );
+					const __m128 distY = CalcAxisDistance( pointY, &set.posY[i], &set.sizeY[i] );
+					const __m128 distZ = CalcAxisDistance( pointZ, &set.posZ[i], &set.sizeZ[i] );
+
+					const __m128 inside	= _mm_cmplt_ps( CalcLengthSq( distX, distY, distZ ), radiusSq );
+					const __m128 hit	= _mm_and_ps( inside, LoadExists( set.exists, i, ignoreExistFlag ) );
+					SetHitBits( i, scast<std::uint32_t>( _mm_movemask_ps( hit ) ), pHitMask );
+				}
+				return count;
+			}
+		}
+	#endif // DONYA_COLLISION_BATCH_USE_SSE
+
+		bool IsSIMDSupported()
+		{
+			return ( DONYA_COLLISION_BATCH_USE_SSE ) ? true : false;
+		}
+
+		void IsHitAABB	( const AABB &query, const AABBSet &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag, bool allowSIMD )
+		{
+			if ( !pHitMask ) { return; }
+			// else
+
+			const size_t count = set.Size();
+			PrepareHitMask( count, pHitMask );
+			if ( !ignoreExistFlag && !query.exist ) { return; }
+			// else
+
+			size_t checkedCount = 0;
+		#if DONYA_COLLISION_BATCH_USE_SSE
+			if ( allowSIMD ) { checkedCount = AABBVsAABBs( query, set, pHitMask, ignoreExistFlag ); }
+		#endif // DONYA_COLLISION_BATCH_USE_SSE
+
+			for ( size_t i = checkedCount; i < count; ++i )
+			{
+				if ( AABB::IsHitAABB( query, set.Get( i ), ignoreExistFlag ) )
+				{
+					SetHitBit( i, pHitMask );
+				}
+			}
+		}
+		void IsHitSphere( const AABB &query, const SphereSet &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag, bool allowSIMD )
+		{
+			if ( !pHitMask ) { return; }
+			// else
+
+			const size_t count = set.Size();
+			PrepareHitMask( count, pHitMask );
+			if ( !ignoreExistFlag && !query.exist ) { return; }
+			// else
+
+			size_t checkedCount = 0;
+		#if DONYA_COLLISION_BATCH_USE_SSE
+			if ( allowSIMD ) { checkedCount = AABBVsSpheres( query, set, pHitMask, ignoreExistFlag ); }
+		#endif // DONYA_COLLISION_BATCH_USE_SSE
+
+			for ( size_t i = checkedCount; i < count; ++i )
+			{
+				if ( AABB::IsHitSphere( query, set.Get( i ), ignoreExistFlag ) )
+				{
+					SetHitBit( i, pHitMask );
+				}
+			}
+		}
+		void IsHitAABB	( const Sphere &query, const AABBSet &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag, bool allowSIMD )
+		{
+			if ( !pHitMask ) { return; }
+			// else
+
+			const size_t count = set.Size();
+			PrepareHitMask( count, pHitMask );
+			// Sphere::IsHitAABB() always checks the exist flags at the inside, even if the "ignoreExistFlag" is true.
+			if ( !query.exist ) { return; }
+			// else
+
+			size_t checkedCount = 0;
+		#if DONYA_COLLISION_BATCH_USE_SSE
+			if ( allowSIMD ) { checkedCount = SphereVsAABBs( query, set, pHitMask, /* ignoreExistFlag = */ false ); }
+		#endif // DONYA_COLLISION_BATCH_USE_SSE
+
+			for ( size_t i = checkedCount; i < count; ++i )
+			{
+				if ( Sphere::IsHitAABB( query, set.Get( i ), ignoreExistFlag ) )
+				{
+					SetHitBit( i, pHitMask );
+				}
+			}
+		}
+
+		void ToIndices( const std::vector<std::uint32_t> &hitMask, size_t count, std::vector<size_t> *pIndices )
+		{
+			if ( !pIndices ) { return; }
+			// else
+
+			const size_t maskCount = std::min( hitMask.size(), ( count + BITS_PER_MASK - 1 ) / BITS_PER_MASK );
+			for ( size_t m = 0; m < maskCount; ++m )
+			{
+				std::uint32_t bits = hitMask[m];
+				while ( bits )
+				{
+					// Find the lowest set bit.
+					size_t bit = 0;
+					while ( !( bits & ( 1U << bit ) ) ) { ++bit; }
+					bits &= bits - 1U;
+
+					const size_t index = m * BITS_PER_MASK + bit;
+					if ( count <= index ) { return; }
+					// else
+					pIndices->emplace_back( index );
+				}
+			}
+		}
+
+	#if USE_IMGUI
+		void ShowBenchmarkNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			enum KernelKind
+			{
+				AABB_VS_AABB = 0,
+				AABB_VS_SPHERE,
+				SPHERE_VS_AABB,
+
+				KERNEL_COUNT
+			};
+			struct Result
+			{
+				int		colliderCount	= 0;
+				int		hitCount		= 0;
+				int		mismatchCount	= 0;
+				double	secondsPair		= 0.0; // The existing one-pair version.
+				double	secondsScalar	= 0.0;
+				double	secondsSIMD		= 0.0;
+			};
+			constexpr std::array<const char *, KERNEL_COUNT> KERNEL_NAMES
+			{
+				"AABB vs AABBs",
+				"AABB vs Spheres",
+				"Sphere vs AABBs",
+			};
+			static std::array<Result, KERNEL_COUNT> results{};
+			static int		colliderCount	= 1000;
+			static int		queryCount		= 100;
+			static float	fieldRange		= 20.0f;
+			static float	maxHalfSize		= 2.0f;
+
+			ImGui::Text( "SIMD : %s", ( IsSIMDSupported() ) ? "SSE" : "Not supported" );
+			ImGui::DragInt  ( "Collider count",	&colliderCount,	10.0f,	1, 100000	);
+			ImGui::DragInt  ( "Query count",	&queryCount,	1.0f,	1, 10000	);
+			ImGui::DragFloat( "Field range",	&fieldRange,	0.1f,	1.0f		);
+			ImGui::DragFloat( "Max half size",	&maxHalfSize,	0.01f,	0.01f		);
+			colliderCount	= std::max( 1,		colliderCount	);
+			queryCount		= std::max( 1,		queryCount		);
+			fieldRange		= std::max( 1.0f,	fieldRange		);
+			maxHalfSize		= std::max( 0.01f,	maxHalfSize		);
+
+			if ( ImGui::Button( "Validate and measure" ) )
+			{
+				auto RandomPos	= [&]()
+				{
+					return Donya::Vector3
+					{
+						Donya::Random::GenerateFloat( -fieldRange, fieldRange ),
+						Donya::Random::GenerateFloat( -fieldRange, fieldRange ),
+						Donya::Random::GenerateFloat( -fieldRange, fieldRange )
+					};
+				};
+				auto RandomSize	= [&]()
+				{
+					return Donya::Random::GenerateFloat( 0.0f, maxHalfSize );
+				};
+				// Some colliders are not exist, for validating the exist flag also.
+				auto RandomExist = []()
+				{
+					return ( Donya::Random::GenerateInt( 0, 10 ) != 0 );
+				};
+				auto RandomAABB	= [&]()
+				{
+					AABB tmp{};
+					tmp.pos		= RandomPos();
+					tmp.size	= Donya::Vector3{ RandomSize(), RandomSize(), RandomSize() };
+					tmp.exist	= RandomExist();
+					return tmp;
+				};
+				auto RandomSphere = [&]()
+				{
+					Sphere tmp{};
+					tmp.pos		= RandomPos();
+					tmp.radius	= RandomSize();
+					tmp.exist	= RandomExist();
+					return tmp;
+				};
+
+				std::vector<AABB>	aabbs( colliderCount );
+				std::vector<Sphere>	spheres( colliderCount );
+				for ( auto &it : aabbs   ) { it = RandomAABB();   }
+				for ( auto &it : spheres ) { it = RandomSphere(); }
+				AABBSet		aabbSet{};
+				SphereSet	sphereSet{};
+				aabbSet.Assign( aabbs );
+				sphereSet.Assign( spheres );
+
+				std::vector<AABB>	queryAABBs( queryCount );
+				std::vector<Sphere>	querySpheres( queryCount );
+				for ( auto &it : queryAABBs   ) { it = RandomAABB();   it.exist = true; }
+				for ( auto &it : querySpheres ) { it = RandomSphere(); it.exist = true; }
+
+				const size_t count = scast<size_t>( colliderCount );
+				std::vector<std::vector<std::uint32_t>> masksPair  ( queryCount );
+				std::vector<std::vector<std::uint32_t>> masksScalar( queryCount );
+				std::vector<std::vector<std::uint32_t>> masksSIMD  ( queryCount );
+
+				Benchmark timer{};
+				for ( int k = 0; k < KERNEL_COUNT; ++k )
+				{
+					auto RunPair	= [&]( int q, std::vector<std::uint32_t> *pMask )
+					{
+						PrepareHitMask( count, pMask );
+						for ( size_t i = 0; i < count; ++i )
+						{
+							const bool hit
+								= ( k == AABB_VS_AABB	) ? AABB::IsHitAABB		( queryAABBs[q],   aabbs[i]   )
+								: ( k == AABB_VS_SPHERE	) ? AABB::IsHitSphere	( queryAABBs[q],   spheres[i] )
+								:							Sphere::IsHitAABB	( querySpheres[q], aabbs[i]   );
+							if ( hit ) { SetHitBit( i, pMask ); }
+						}
+					};
+					auto RunBatch	= [&]( int q, std::vector<std::uint32_t> *pMask, bool allowSIMD )
+					{
+						switch ( k )
+						{
+						case AABB_VS_AABB:		IsHitAABB	( queryAABBs[q],   aabbSet,   pMask, false, allowSIMD ); return;
+						case AABB_VS_SPHERE:	IsHitSphere	( queryAABBs[q],   sphereSet, pMask, false, allowSIMD ); return;
+						case SPHERE_VS_AABB:	IsHitAABB	( querySpheres[q], aabbSet,   pMask, false, allowSIMD ); return;
+						default: return;
+						}
+					};
+
+					Result &result = results[k];
+
+					timer.Begin();
+					for ( int q = 0; q < queryCount; ++q ) { RunPair( q, &masksPair[q] ); }
+					result.secondsPair = timer.End();
+
+					timer.Begin();
+					for ( int q = 0; q < queryCount; ++q ) { RunBatch( q, &masksScalar[q], /* allowSIMD = */ false ); }
+					result.secondsScalar = timer.End();
+
+					timer.Begin();
+					for ( int q = 0; q < queryCount; ++q ) { RunBatch( q, &masksSIMD[q], /* allowSIMD = */ true ); }
+					result.secondsSIMD = timer.End();
+
+					result.colliderCount	= colliderCount;
+					result.hitCount			= 0;
+					result.mismatchCount	= 0;
+					std::vector<size_t> indices{};
+					for ( int q = 0; q < queryCount; ++q )
+					{
+						if ( masksPair[q] != masksScalar[q] || masksPair[q] != masksSIMD[q] )
+						{
+							result.mismatchCount++;
+						}
+
+						indices.clear();
+						ToIndices( masksPair[q], count, &indices );
+						result.hitCount += scast<int>( indices.size() );
+					}
+				}
+			}
+
+			for ( int k = 0; k < KERNEL_COUNT; ++k )
+			{
+				const Result &result = results[k];
+				if ( !result.colliderCount ) { continue; }
+				// else
+
+				ImGui::Text( "%s : %d colliders, %d hits", KERNEL_NAMES[k], result.colliderCount, result.hitCount );
+				ImGui::Text( "  One pair : %.3f[ms]", result.secondsPair   * 1000.0 );
+				ImGui::Text( "  Scalar   : %.3f[ms]", result.secondsScalar * 1000.0 );
+				ImGui::Text( "  SIMD     : %.3f[ms]", result.secondsSIMD   * 1000.0 );
+				ImGui::Text( "  Mismatched queries : %d", result.mismatchCount );
+			}
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+	}
+}
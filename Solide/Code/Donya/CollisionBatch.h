@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Collision.h"
+#include "UseImGui.h"
+
+namespace Donya
+{
+	/// <summary>
+	/// AABBs as structure of arrays, for the batch collision checks.<para></para>
+	/// The "exists" stores 0xFFFFFFFF if the exist flag is true, 0 otherwise.
+	/// </summary>
+	class AABBSet
+	{
+	public:
+		std::vector<float>			posX,  posY,  posZ;
+		std::vector<float>			sizeX, sizeY, sizeZ;
+		std::vector<std::uint32_t>	exists;
+	public:
+		void	Clear();
+		void	Reserve( size_t count );
+		void	Add( const AABB &box );
+		void	Assign( const std::vector<AABB> &boxes );
+		size_t	Size() const { return posX.size(); }
+		AABB	Get( size_t index ) const;
+	};
+	/// <summary>
+	/// Spheres as structure of arrays, for the batch collision checks.<para></para>
+	/// The "exists" stores 0xFFFFFFFF if the exist flag is true, 0 otherwise.
+	/// </summary>
+	class SphereSet
+	{
+	public:
+		std::vector<float>			posX, posY, posZ;
+		std::vector<float>			radius;
+		std::vector<std::uint32_t>	exists;
+	public:
+		void	Clear();
+		void	Reserve( size_t count );
+		void	Add( const Sphere &sphere );
+		void	Assign( const std::vector<Sphere> &spheres );
+		size_t	Size() const { return posX.size(); }
+		Sphere	Get( size_t index ) const;
+	};
+
+	/// <summary>
+	/// The collision checks between one query and many colliders. These use SSE if available, and the scalar code for the remainder.<para></para>
+	/// The result of each collider is the same as the one-pair version(e.g. AABB::IsHitAABB( query, set.Get( i ) )).<para></para>
+	/// The hit-mask stores the result of index "i" into the bit ( i % 32 ) of element ( i / 32 ).
+	/// The "allowSIMD" is false, the all of colliders are checked by the scalar code.
+	/// </summary>
+	namespace Batch
+	{
+		/// <summary>
+		/// Returns true if the SIMD kernels are compiled in.
+		/// </summary>
+		bool IsSIMDSupported();
+
+		/// <summary>
+		/// Same as AABB::IsHitAABB( query, set[i] ).
+		/// </summary>
+		void IsHitAABB	( const AABB   &query, const AABBSet   &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag = false, bool allowSIMD = true );
+		/// <summary>
+		/// Same as AABB::IsHitSphere( query, set[i] ).
+		/// </summary>
+		void IsHitSphere( const AABB   &query, const SphereSet &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag = false, bool allowSIMD = true );
+		/// <summary>
+		/// Same as Sphere::IsHitAABB( query, set[i] ).
+		/// </summary>
+		void IsHitAABB	( const Sphere &query, const AABBSet   &set, std::vector<std::uint32_t> *pHitMask, bool ignoreExistFlag = false, bool allowSIMD = true );
+
+		/// <summary>
+		/// Appends the indices of the set bits in ascending order. The "count" is the collider count of the mask.
+		/// </summary>
+		void ToIndices( const std::vector<std::uint32_t> &hitMask, size_t count, std::vector<size_t> *pIndices );
+
+	#if USE_IMGUI
+		/// <summary>
+		/// Validates the batch versions against the one-pair versions by random colliders, and measures these.
+		/// </summary>
+		void ShowBenchmarkNode( const std::string &nodeCaption );
+	#endif // USE_IMGUI
+	}
+}
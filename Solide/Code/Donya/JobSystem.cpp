@@ -0,0 +1,207 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+#include "AllocationTracker.h"
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace
+	{
+		// Set by the workers, for ParallelFor() that is called from a job.
+		thread_local const JobSystem	*pCurrentSystem		= nullptr;
+		thread_local size_t				currentQueueIndex	= 0;
+	}
+
+	JobSystem::JobSystem( size_t workerCount )
+	{
+		queues.reserve( workerCount + 1 );
+		for ( size_t i = 0; i < workerCount + 1; ++i )
+		{
+			queues.emplace_back( std::make_unique<Queue>() );
+		}
+
+		workers.reserve( workerCount );
+		for ( size_t i = 0; i < workerCount; ++i )
+		{
+			workers.emplace_back( &JobSystem::WorkerLoop, this, i + 1 );
+		}
+	}
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock( sleepMutex );
+			isRunning = false;
+		}
+		wakeCondition.notify_all();
+
+		for ( auto &it : workers )
+		{
+			if ( it.joinable() ) { it.join(); }
+		}
+	}
+
+	size_t JobSystem::CalcDefaultWorkerCount()
+	{
+		const size_t hardwareCount = std::thread::hardware_concurrency();
+		return ( hardwareCount <= 1 ) ? 0 : hardwareCount - 1;
+	}
+
+	void JobSystem::ParallelFor( size_t count, size_t grainSize, const RangeJob &job )
+	{
+		if ( !count ) { return; }
+		// else
+
+		grainSize = std::max<size_t>( 1, grainSize );
+		if ( workers.empty() || count <= grainSize )
+		{
+			job( 0, count );
+			return;
+		}
+		// else
+
+		const size_t ownQueueIndex = FindOwnQueueIndex();
+		// The workers count their allocations as the caller's.
+		const AllocationTracker::TagId callerTag = AllocationTracker::GetCurrentTag();
+
+		const size_t rangeCount = ( count + grainSize - 1 ) / grainSize;
+		std::atomic<size_t> remainingCount{ rangeCount };
+		for ( size_t i = 0; i < rangeCount; ++i )
+		{
+			const size_t begin	= i * grainSize;
+			const size_t end	= std::min( count, begin + grainSize );
+			Push
+			(
+				i % queues.size(),
+				[&job, &remainingCount, begin, end, callerTag]()
+				{
+					AllocationTracker::Scope tagScope( callerTag );
+					job( begin, end );
+					remainingCount--;
+				}
+			);
+		}
+		{
+			// Prevent the lost wake-up of a worker that is going to sleep.
+			std::lock_guard<std::mutex> lock( sleepMutex );
+		}
+		wakeCondition.notify_all();
+
+		// The caller also works until all ranges are finished.
+		Job current{};
+		while ( 0 < remainingCount )
+		{
+			if ( TryPop( ownQueueIndex, &current ) )
+			{
+				current();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::Submit( Job job )
+	{
+		if ( workers.empty() )
+		{
+			job();
+			return;
+		}
+		// else
+
+		const size_t workerIndex = submittedCount.fetch_add( 1 ) % workers.size();
+		const AllocationTracker::TagId callerTag = AllocationTracker::GetCurrentTag();
+		Push
+		(
+			workerIndex + 1,
+			[job = std::move( job ), callerTag]()
+			{
+				AllocationTracker::Scope tagScope( callerTag );
+				job();
+			}
+		);
+		{
+			// Prevent the lost wake-up of a worker that is going to sleep.
+			std::lock_guard<std::mutex> lock( sleepMutex );
+		}
+		wakeCondition.notify_all();
+	}
+
+	size_t JobSystem::FindOwnQueueIndex() const
+	{
+		return ( pCurrentSystem == this ) ? currentQueueIndex : 0;
+	}
+	void JobSystem::Push( size_t queueIndex, Job &&job )
+	{
+		Queue &queue = *queues[queueIndex];
+		{
+			std::lock_guard<std::mutex> lock( queue.mutex );
+			queue.jobs.emplace_back( std::move( job ) );
+		}
+		queuedCount++;
+	}
+	bool JobSystem::TryPop( size_t queueIndex, Job *pOutput )
+	{
+		const size_t queueCount = queues.size();
+		for ( size_t i = 0; i < queueCount; ++i )
+		{
+			const bool isOwn = ( i == 0 );
+			Queue &queue = *queues[( queueIndex + i ) % queueCount];
+
+			std::lock_guard<std::mutex> lock( queue.mutex );
+			if ( queue.jobs.empty() ) { continue; }
+			// else
+
+			// The own queue is used as a stack for the locality, and the stealing takes the oldest job.
+			if ( isOwn )
+			{
+				*pOutput = std::move( queue.jobs.back() );
+				queue.jobs.pop_back();
+			}
+			else
+			{
+				*pOutput = std::move( queue.jobs.front() );
+				queue.jobs.pop_front();
+			}
+
+			queuedCount--;
+			return true;
+		}
+
+		return false;
+	}
+	void JobSystem::WorkerLoop( size_t queueIndex )
+	{
+		pCurrentSystem		= this;
+		currentQueueIndex	= queueIndex;
+
+		Job current{};
+		while ( true )
+		{
+			if ( TryPop( queueIndex, &current ) )
+			{
+				current();
+				current = nullptr; // Release the captures before sleeping.
+				continue;
+			}
+			// else
+
+			std::unique_lock<std::mutex> lock( sleepMutex );
+			wakeCondition.wait
+			(
+				lock,
+				[&]()
+				{
+					return !isRunning || 0 < queuedCount;
+				}
+			);
+
+			if ( !isRunning ) { return; }
+		}
+	}
+}
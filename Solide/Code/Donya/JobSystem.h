@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Donya
+{
+	/// <summary>
+	/// A fixed pool of worker threads. Each thread has own deque of jobs, and steals the jobs from the other deques when own deque is empty.<para></para>
+	/// The thread that calls ParallelFor() also runs the jobs until those are finished. ParallelFor() can be called from a job too, then the waiting worker also runs the other jobs.<para></para>
+	/// So a job must not wait for a lock that is held by another job while calling ParallelFor().
+	/// </summary>
+	class JobSystem
+	{
+	public:
+		using Job		= std::function<void()>;
+		using RangeJob	= std::function<void( size_t begin, size_t end )>;
+	private:
+		struct Queue
+		{
+			std::mutex		mutex;
+			std::deque<Job>	jobs;
+		};
+	private:
+		std::vector<std::thread>				workers;
+		std::vector<std::unique_ptr<Queue>>		queues;			// [0] is for the caller of ParallelFor(), [i + 1] is for workers[i].
+		std::mutex								sleepMutex;
+		std::condition_variable					wakeCondition;
+		std::atomic<size_t>						queuedCount{ 0 };
+		std::atomic<size_t>						submittedCount{ 0 };	// For distributing the submitted jobs to the workers.
+		std::atomic<bool>						isRunning{ true };
+	public:
+		/// <summary>
+		/// The "workerCount" does not contain the caller thread. Zero means all jobs run on the caller thread.
+		/// </summary>
+		explicit JobSystem( size_t workerCount );
+		~JobSystem();
+		JobSystem( const JobSystem & ) = delete;
+		JobSystem &operator = ( const JobSystem & ) = delete;
+	public:
+		/// <summary>
+		/// Returns the count of hardware threads except the caller thread.
+		/// </summary>
+		static size_t CalcDefaultWorkerCount();
+		size_t GetWorkerCount() const { return workers.size(); }
+	public:
+		/// <summary>
+		/// Divides [0, count) into the ranges of "grainSize" elements, calls "job( begin, end )" for each range in parallel, then waits for all of those.<para></para>
+		/// The allocations in the jobs are counted with the AllocationTracker tag of the caller.
+		/// </summary>
+		void ParallelFor( size_t count, size_t grainSize, const RangeJob &job );
+		/// <summary>
+		/// Pushes the "job" to a worker and returns without waiting. The job runs on the caller thread immediately if there is no worker.<para></para>
+		/// The allocations in the job are counted with the AllocationTracker tag of the caller.<para></para>
+		/// The jobs that are not started are discarded at the destruction, so please wait for those before it.
+		/// </summary>
+		void Submit( Job job );
+	private:
+		/// <summary>
+		/// Returns the index of the queue of the calling thread. It is zero if the thread is not a worker of this.
+		/// </summary>
+		size_t FindOwnQueueIndex() const;
+		void Push( size_t queueIndex, Job &&job );
+		/// <summary>
+		/// Pops from the back of own queue, or steals from the front of the other queues.
+		/// </summary>
+		bool TryPop( size_t queueIndex, Job *pOutput );
+		void WorkerLoop( size_t queueIndex );
+	};
+}
@@ -1,6 +1,7 @@
 #include "Loader.h"
 
 #include <algorithm>		// Use std::sort.
+#include <cmath>
 #include <crtdbg.h>
 #include <Windows.h>
 
@@ -12,6 +13,16 @@
 #include "Donya/Donya.h"	// Use GetHWnd().
 #include "Donya/Useful.h"	// Use OutputDebugStr().
 
+#include "JobSystem.h"
+#include "ModelContainer.h"
+
+#if USE_IMGUI
+#include "Donya/Benchmark.h"
+#include "Donya/Random.h"
+#include "Donya/SerializerBenchmark.h"
+#include "ModelMotion.h"	// Use Animator and Pose for measuring the decode.
+#endif // USE_IMGUI
+
 #undef min
 #undef max
 
@@ -30,12 +41,58 @@ namespace
 		const std::string postfix{ "\n" };
 		Donya::OutputDebugStr( ( prefix + str + postfix ).c_str() );
 	}
+
+#if USE_IMGUI
+	// The files that have motions and were loaded until now. Used for the reports of compression.
+	std::mutex					loadedPathMutex{};
+	std::vector<std::string>	loadedMotionPaths{};
+	void RegisterLoadedPath( const std::string &fullPath, const Donya::Model::Source &source )
+	{
+		if ( source.motions.empty() && source.compressedMotions.empty() ) { return; }
+		// else
+
+		std::lock_guard<std::mutex> lock( loadedPathMutex );
+
+		const auto found = std::find( loadedMotionPaths.begin(), loadedMotionPaths.end(), fullPath );
+		if ( found != loadedMotionPaths.end() ) { return; }
+		// else
+
+		loadedMotionPaths.emplace_back( fullPath );
+	}
+
+	// The ".bin" files that were loaded until now. Used for the benchmark of container.
+	std::vector<std::string>	loadedBinaryPaths{};
+	void RegisterLoadedBinaryPath( const std::string &fullPath )
+	{
+		std::lock_guard<std::mutex> lock( loadedPathMutex );
+
+		const auto found = std::find( loadedBinaryPaths.begin(), loadedBinaryPaths.end(), fullPath );
+		if ( found != loadedBinaryPaths.end() ) { return; }
+		// else
+
+		loadedBinaryPaths.emplace_back( fullPath );
+	}
+#endif // USE_IMGUI
+
+	/// <summary>
+	/// Returns true if the container exists and is not older than the source. The container is also usable if the source was removed.
+	/// </summary>
+	bool IsUsableContainer( const std::string &containerPath, const std::string &sourcePath )
+	{
+		WIN32_FILE_ATTRIBUTE_DATA containerAttr{};
+		if ( !GetFileAttributesExA( containerPath.c_str(), GetFileExInfoStandard, &containerAttr ) ) { return false; }
+		// else
+
+		WIN32_FILE_ATTRIBUTE_DATA sourceAttr{};
+		if ( !GetFileAttributesExA( sourcePath.c_str(), GetFileExInfoStandard, &sourceAttr ) ) { return true; }
+		// else
+
+		return ( CompareFileTime( &sourceAttr.ftLastWriteTime, &containerAttr.ftLastWriteTime ) <= 0 );
+	}
 }
 
 namespace Donya
 {
-	std::mutex Loader::cerealMutex{};
-
 #if USE_FBX_SDK
 	std::mutex Loader::fbxMutex{};
 
@@ -867,6 +924,7 @@ namespace Donya
 		source.coordinateConversion = Donya::Vector4x4::Identity();
 		source.meshes.clear();
 		source.motions.clear();
+		source.compressedMotions.clear();
 		source.skeletal.clear();
 		polyGroup.Assign( std::move( std::vector<Donya::Model::Polygon>{} ) );
 	}
@@ -904,12 +962,38 @@ namespace Donya
 			const std::string resultString = ( succeeded ) ? "Load By FBX Successful:" : "Load By FBX Failed:";
 			OutputDebugProgress( resultString + filePath, outputProgress );
 
+		#if USE_IMGUI
+			if ( succeeded ) { RegisterLoadedPath( fullPath, source ); }
+		#endif // USE_IMGUI
+
 			return succeeded;
 		}
 		// else
 
 	#endif // USE_FBX_SDK
 
+		const std::string containerExtension{ Model::Container::EXTENSION };
+		auto ShouldLoadByContainer = [&containerExtension]( const std::string &filePath )
+		{
+			return ( filePath.find( containerExtension ) != std::string::npos );
+		};
+		if ( ShouldLoadByContainer( fullPath ) )
+		{
+			OutputDebugProgress( std::string{ "Start By Container:" + filePath }, outputProgress );
+
+			bool succeeded = LoadByContainer( fullPath, outputProgress );
+
+			const std::string resultString = ( succeeded ) ? "Load By Container Successful:" : "Load By Container Failed:";
+			OutputDebugProgress( resultString + filePath, outputProgress );
+
+		#if USE_IMGUI
+			if ( succeeded ) { RegisterLoadedPath( fullPath, source ); }
+		#endif // USE_IMGUI
+
+			return succeeded;
+		}
+		// else
+
 		auto ShouldLoadByCereal = []( const std::string &filePath )
 		{
 			constexpr std::array<const char *, 1> EXTENSIONS
@@ -929,6 +1013,29 @@ namespace Donya
 		};
 		if ( ShouldLoadByCereal( fullPath ) )
 		{
+		#if USE_IMGUI
+			RegisterLoadedBinaryPath( fullPath );
+		#endif // USE_IMGUI
+
+			// Prefer the container that was converted from this file. Use the cereal if the container is broken.
+			const std::string containerPath = ToContainerPath( fullPath );
+			if ( IsUsableContainer( containerPath, fullPath ) )
+			{
+				if ( LoadByContainer( containerPath, outputProgress ) )
+				{
+					OutputDebugProgress( "Load By Container Successful:" + containerPath, outputProgress );
+
+				#if USE_IMGUI
+					RegisterLoadedPath( fullPath, source );
+				#endif // USE_IMGUI
+
+					return true;
+				}
+				// else
+
+				OutputDebugProgress( "Load By Container Failed, Use Cereal:" + containerPath, outputProgress );
+			}
+
 			OutputDebugProgress( std::string{ "Start By Cereal:" + filePath }, outputProgress );
 
 			bool succeeded = LoadByCereal( fullPath, outputProgress );
@@ -936,6 +1043,10 @@ namespace Donya
 			const std::string resultString = ( succeeded ) ? "Load By Cereal Successful:" : "Load By Cereal Failed:";
 			OutputDebugProgress( resultString + filePath, outputProgress );
 
+		#if USE_IMGUI
+			if ( succeeded ) { RegisterLoadedPath( fullPath, source ); }
+		#endif // USE_IMGUI
+
 			return succeeded;
 		}
 		// else
@@ -945,22 +1056,149 @@ namespace Donya
 		return false;
 	}
 
+	bool Loader::LoadMany( const std::vector<std::string> &filePaths, std::vector<Loader> *pOutput, std::vector<bool> *pSucceeded, JobSystem *pJobSystem, bool outputProgress, const std::function<void( float )> &reportProgress )
+	{
+		if ( !pOutput ) { return false; }
+		// else
+
+		const size_t fileCount = filePaths.size();
+		pOutput->clear();
+		pOutput->resize( fileCount );
+
+		// The elements of std::vector<bool> can not be written in parallel.
+		std::unique_ptr<bool[]> results = std::make_unique<bool[]>( fileCount );
+
+		// The lock keeps the reported fractions in order.
+		std::mutex	reportMutex{};
+		size_t		finishedCount = 0;
+		auto ReportFinished = [&]()
+		{
+			if ( !reportProgress ) { return; }
+			// else
+
+			std::lock_guard<std::mutex> lock( reportMutex );
+			finishedCount++;
+			reportProgress( scast<float>( finishedCount ) / scast<float>( fileCount ) );
+		};
+
+		auto LoadRange = [&]( size_t begin, size_t end )
+		{
+			for ( size_t i = begin; i < end; ++i )
+			{
+				Loader &loader = ( *pOutput )[i];
+				results[i] = loader.Load( filePaths[i], outputProgress );
+				if ( !results[i] ) { loader.ClearData(); }
+
+				ReportFinished();
+			}
+		};
+
+		// One file per job, because the sizes of files are not even.
+		constexpr size_t FILE_COUNT_PER_JOB = 1;
+		if ( pJobSystem )
+		{
+			pJobSystem->ParallelFor( fileCount, FILE_COUNT_PER_JOB, LoadRange );
+		}
+		else if ( 1 < fileCount )
+		{
+			JobSystem temporary{ std::min( JobSystem::CalcDefaultWorkerCount(), fileCount - 1 ) };
+			temporary.ParallelFor( fileCount, FILE_COUNT_PER_JOB, LoadRange );
+		}
+		else
+		{
+			LoadRange( 0, fileCount );
+		}
+
+		bool allSucceeded = true;
+		for ( size_t i = 0; i < fileCount; ++i )
+		{
+			if ( !results[i] ) { allSucceeded = false; }
+		}
+		if ( pSucceeded )
+		{
+			pSucceeded->assign( results.get(), results.get() + fileCount );
+		}
+
+		return allSucceeded;
+	}
+	bool Loader::LoadManyThenCreate( const std::vector<std::string> &filePaths, const std::function<bool( size_t index, const Loader &loader )> &create, JobSystem *pJobSystem, const std::function<void( float )> &reportProgress )
+	{
+		auto Report = [&reportProgress]( float fraction )
+		{
+			if ( reportProgress ) { reportProgress( fraction ); }
+		};
+
+		std::vector<Loader>	loaders{};
+		std::vector<bool>	loaded{};
+		LoadMany
+		(
+			filePaths, &loaders, &loaded, pJobSystem, /* outputDebugProgress = */ true,
+			[&Report]( float fraction ) { Report( fraction * 0.5f ); }
+		);
+
+		const size_t fileCount = filePaths.size();
+		bool succeeded = true;
+		for ( size_t i = 0; i < fileCount; ++i )
+		{
+			if ( !loaded[i] || !create( i, loaders[i] ) )
+			{
+				const std::wstring errMsgBase{ L"Failed : Loading a model. That is : " };
+				const std::wstring errMsg = errMsgBase + Donya::MultiToWide( filePaths[i] );
+				_ASSERT_EXPR( 0, errMsg.c_str() );
+
+				succeeded = false;
+			}
+
+			Report( 0.5f + 0.5f * scast<float>( i + 1 ) / scast<float>( fileCount ) );
+		}
+
+		return succeeded;
+	}
+
 	void Loader::SaveByCereal( const std::string &filePath ) const
 	{
 		Donya::Serializer::Extension bin  = Donya::Serializer::Extension::BINARY;
 
-		std::lock_guard<std::mutex> lock( cerealMutex );
-
 		Donya::Serializer seria;
 		seria.Save( bin, filePath.c_str(),  SERIAL_ID, *this );
 	}
 
+	bool Loader::SaveByContainer( const std::string &filePath ) const
+	{
+		return Model::Container::Write( filePath, source, &polyGroup );
+	}
+	bool Loader::ConvertToContainer( const std::string &binaryFilePath, const Model::Animation::CompressionOption *pCompression )
+	{
+		const std::string fullPath = ToFullPath( binaryFilePath );
+
+		Loader loader{};
+		if ( !loader.LoadByCereal( fullPath, /* outputProgress = */ false ) ) { return false; }
+		// else
+
+		if ( pCompression && !loader.CompressMotions( *pCompression ) )
+		{
+			OutputDebugProgress( "The motions are not compressed:" + fullPath, /* isAllowOutput = */ true );
+		}
+
+		return loader.SaveByContainer( ToContainerPath( fullPath ) );
+	}
+	std::string Loader::ToContainerPath( const std::string &binaryFilePath )
+	{
+		const std::string binaryExtension{ ".bin" };
+		const size_t found = binaryFilePath.rfind( binaryExtension );
+		if ( found == std::string::npos ) { return binaryFilePath + Model::Container::EXTENSION; }
+		// else
+
+		std::string containerPath = binaryFilePath;
+		containerPath.replace( found, binaryExtension.size(), Model::Container::EXTENSION );
+		return containerPath;
+	}
+
 	bool Loader::LoadByCereal( const std::string &filePath, bool outputProgress )
 	{
 		Donya::Serializer::Extension ext = Donya::Serializer::Extension::BINARY;
 
-		std::lock_guard<std::mutex> lock( cerealMutex );
-
+		// The archive is made per call, so this does not need any lock.
 		Donya::Serializer seria;
 		bool succeeded	= seria.Load( ext, filePath.c_str(), SERIAL_ID, *this );
 
@@ -971,6 +1209,58 @@ namespace Donya
 		return succeeded;
 	}
 
+	bool Loader::LoadByContainer( const std::string &filePath, bool outputProgress )
+	{
+		Model::Container::MappedModel mapped{};
+		if ( !mapped.Open( filePath ) ) { return false; }
+		// else
+
+		Model::Source newSource{};
+		if ( !mapped.BuildSource( &newSource ) ) { return false; }
+		// else
+
+		source = std::move( newSource );
+		if ( !mapped.BuildPolygonGroup( &polyGroup ) )
+		{
+			polyGroup.Assign( std::move( std::vector<Donya::Model::Polygon>{} ) );
+		}
+
+		fileDirectory	= ExtractFileDirectoryFromFullPath( filePath );
+		fileName		= filePath.substr( fileDirectory.size() );
+
+		return true;
+	}
+
+	bool Loader::CompressMotions( const Model::Animation::CompressionOption &option )
+	{
+		// The motions are referred by the index, so I should not change the order by compressing only a part of those.
+		// The compressed motions are appended after the motions by MotionHolder::AppendSource().
+		if ( !source.compressedMotions.empty() ) { return source.motions.empty(); }
+		// else
+
+		const Model::Skeleton skeleton{ source.skeletal };
+
+		std::vector<Model::Animation::CompressedMotion> compressedMotions{};
+		compressedMotions.reserve( source.motions.size() );
+		for ( const auto &it : source.motions )
+		{
+			for ( const auto &keyFrame : it.keyFrames )
+			{
+				if ( !skeleton.IsCompatibleWith( keyFrame.keyPose ) ) { return false; }
+			}
+
+			Model::Animation::CompressedMotion compressed{};
+			if ( !Model::Animation::CompressedMotion::Compress( it, option, &compressed ) ) { return false; }
+			// else
+
+			compressedMotions.emplace_back( std::move( compressed ) );
+		}
+
+		source.motions.clear();
+		source.compressedMotions = std::move( compressedMotions );
+		return true;
+	}
+
 #if USE_FBX_SDK
 
 #define USE_TRIANGULATE ( true )
@@ -1244,5 +1534,516 @@ namespace Donya
 
 		ImGui::TreePop();
 	}
+
+	namespace
+	{
+		size_t CalcStringBytes( const std::string &str )
+		{
+			// The short string is stored into the object itself.
+			static const size_t localCapacity = std::string{}.capacity();
+			return ( str.capacity() <= localCapacity ) ? 0 : str.capacity() + 1;
+		}
+		/// <summary>
+		/// Returns the heap bytes of the key-frame representation.
+		/// </summary>
+		size_t CalcMotionBytes( const Model::Animation::Motion &motion )
+		{
+			size_t sum = motion.keyFrames.capacity() * sizeof( Model::Animation::KeyFrame );
+			for ( const auto &keyFrame : motion.keyFrames )
+			{
+				sum += keyFrame.keyPose.capacity() * sizeof( Model::Animation::Node );
+				for ( const auto &node : keyFrame.keyPose )
+				{
+					sum += CalcStringBytes( node.bone.name );
+					sum += CalcStringBytes( node.bone.parentName );
+				}
+			}
+			return sum;
+		}
+	}
+	void Loader::ShowMotionCompressionNode( const std::string &nodeCaption )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		struct Result
+		{
+			std::string	fileName;
+			int		motionCount			= 0;
+			int		failedCount			= 0;	// The count of motions that could not be compressed.
+			size_t	sourceKeyCount		= 0;	// The sum of "key count * bone count * 3 components".
+			size_t	keptKeyCount		= 0;
+			size_t	keyFrameBytes		= 0;	// Zero if the file stores the compressed motions only.
+			size_t	clipBytes			= 0;
+			size_t	compressedBytes		= 0;
+			double	compressSeconds		= 0.0;
+			float	maxTranslationError	= 0.0f;
+			float	maxRotationError	= 0.0f;	// Radian.
+			size_t	decodedBoneCount	= 0;
+			double	decodeSeconds		= 0.0;
+		};
+		static std::vector<Result>						results{};
+		static Model::Animation::CompressionOption		option{};
+		static int										sampleCount = 1000;
+
+		ImGui::DragFloat( "Tolerance of scale",				&option.scaleTolerance,			0.0001f, 0.0f, 1.0f, "%.5f" );
+		ImGui::DragFloat( "Tolerance of rotation(radian)",	&option.rotationTolerance,		0.0001f, 0.0f, 1.0f, "%.5f" );
+		ImGui::DragFloat( "Tolerance of translation",		&option.translationTolerance,	0.0001f, 0.0f, 1.0f, "%.5f" );
+		ImGui::DragInt  ( "Decode count per motion",		&sampleCount, 10.0f, 1, 100000 );
+		option.scaleTolerance		= std::max( 0.0f, option.scaleTolerance			);
+		option.rotationTolerance	= std::max( 0.0f, option.rotationTolerance		);
+		option.translationTolerance	= std::max( 0.0f, option.translationTolerance	);
+		sampleCount = std::max( 1, sampleCount );
+
+		if ( ImGui::Button( "Measure" ) )
+		{
+			std::vector<std::string> paths{};
+			{
+				std::lock_guard<std::mutex> lock( loadedPathMutex );
+				paths = loadedMotionPaths;
+			}
+
+			results.clear();
+			Benchmark timer{};
+			for ( const auto &path : paths )
+			{
+				Loader loader{};
+				if ( !loader.Load( path, /* outputProgress = */ false ) ) { continue; }
+				// else
+
+				const Model::Source &source = loader.GetModelSource();
+				const auto pSkeleton = std::make_shared<const Model::Skeleton>( source.skeletal );
+
+				Result result{};
+				result.fileName = loader.GetFileName();
+
+				std::vector<Model::Animation::CompressedMotion> compressedMotions = source.compressedMotions;
+				for ( const auto &motion : source.motions )
+				{
+					result.keyFrameBytes += CalcMotionBytes( motion );
+
+					bool compatible = true;
+					for ( const auto &keyFrame : motion.keyFrames )
+					{
+						if ( !pSkeleton->IsCompatibleWith( keyFrame.keyPose ) ) { compatible = false; break; }
+					}
+
+					Model::Animation::CompressedMotion compressed{};
+					timer.Begin();
+					const bool succeeded = compatible && Model::Animation::CompressedMotion::Compress( motion, option, &compressed );
+					result.compressSeconds += timer.End();
+					if ( !succeeded ) { result.failedCount++; continue; }
+					// else
+
+					result.clipBytes += Model::MotionClip{ motion, pSkeleton }.GetByteSize();
+
+					// Measure the errors at the source keys.
+					const Model::CompressedClip clip{ compressed, pSkeleton };
+					const size_t boneCount = clip.GetBoneCount();
+					std::vector<Model::Animation::Transform>	transforms( boneCount );
+					std::vector<Donya::Vector4x4>				locals( boneCount );
+					std::vector<Donya::Vector4x4>				globals( boneCount );
+					const size_t keyCount = motion.keyFrames.size();
+					for ( size_t k = 0; k < keyCount; ++k )
+					{
+						clip.Sample( k, transforms.data(), locals.data(), globals.data() );
+
+						const auto &keyPose = motion.keyFrames[k].keyPose;
+						for ( size_t b = 0; b < boneCount; ++b )
+						{
+							const auto &expected	= keyPose[b].bone.transform;
+							const auto &actual		= transforms[b];
+
+							const float translationError	= ( actual.translation - expected.translation ).Length();
+							const float dot					= std::min( 1.0f, fabsf( Donya::Quaternion::Dot( actual.rotation, expected.rotation.Unit() ) ) );
+							const float rotationError		= 2.0f * acosf( dot );
+							result.maxTranslationError	= std::max( result.maxTranslationError,	translationError	);
+							result.maxRotationError		= std::max( result.maxRotationError,	rotationError		);
+						}
+					}
+
+					compressedMotions.emplace_back( std::move( compressed ) );
+				}
+
+				Model::Animator	animator{};
+				Model::Pose		pose{};
+				std::vector<float> times( sampleCount );
+				for ( const auto &motion : compressedMotions )
+				{
+					if ( motion.GetBoneCount() != pSkeleton->GetBoneCount() ) { result.failedCount++; continue; }
+					// else
+
+					const Model::CompressedClip clip{ motion, pSkeleton };
+					result.motionCount++;
+					result.compressedBytes	+= clip.GetByteSize();
+					result.sourceKeyCount	+= clip.GetKeyCount() * clip.GetBoneCount() * 3;
+					for ( size_t b = 0; b < motion.GetBoneCount(); ++b )
+					{
+						result.keptKeyCount += motion.scales[b].keyIndices.size();
+						result.keptKeyCount += motion.rotations[b].keyIndices.size();
+						result.keptKeyCount += motion.translations[b].keyIndices.size();
+					}
+					if ( clip.IsEmpty() ) { continue; }
+					// else
+
+					const float wholeSeconds = clip.GetWholeSeconds();
+					for ( auto &it : times )
+					{
+						it = Donya::Random::GenerateFloat( 0.0f, wholeSeconds );
+					}
+
+					animator.EnableLoop();
+					animator.ResetRepeatRange();
+					if ( 0.0f < wholeSeconds ) { animator.SetRepeatRange( clip ); }
+
+					// Prepare the buffers before the measurement.
+					pose.AssignSkeletal( clip, 0 );
+
+					timer.Begin();
+					for ( const auto &it : times )
+					{
+						animator.SetInternalElapsedTime( it );
+						animator.CalcCurrentPose( clip, &pose );
+					}
+					result.decodeSeconds	+= timer.End();
+					result.decodedBoneCount	+= times.size() * clip.GetBoneCount();
+				}
+
+				results.emplace_back( std::move( result ) );
+			}
+		}
+
+		if ( results.empty() )
+		{
+			ImGui::Text( "Press the \"Measure\" button after loading the models." );
+		}
+
+		auto ToKB = []( size_t bytes )
+		{
+			return scast<float>( bytes ) / 1024.0f;
+		};
+		for ( const auto &it : results )
+		{
+			if ( !ImGui::TreeNode( Donya::MultiToUTF8( it.fileName ).c_str() ) ) { continue; }
+			// else
+
+			ImGui::Text( "%d motions, %d failed", it.motionCount, it.failedCount );
+			if ( it.keyFrameBytes )
+			{
+				ImGui::Text( "KeyFrame   : %.1f[KB]", ToKB( it.keyFrameBytes ) );
+				ImGui::Text( "Clip       : %.1f[KB]", ToKB( it.clipBytes     ) );
+			}
+			else
+			{
+				ImGui::Text( "KeyFrame   : (Stored as compressed)" );
+			}
+			ImGui::Text( "Compressed : %.1f[KB]", ToKB( it.compressedBytes ) );
+			if ( it.sourceKeyCount )
+			{
+				ImGui::Text( "Kept keys  : %.2f[%%]", 100.0f * scast<float>( it.keptKeyCount ) / scast<float>( it.sourceKeyCount ) );
+			}
+			if ( it.keyFrameBytes )
+			{
+				ImGui::Text( "Compress time : %.3f[ms]", it.compressSeconds * 1000.0 );
+				ImGui::Text( "Max error of translation : %.5f", it.maxTranslationError );
+				ImGui::Text( "Max error of rotation : %.5f[radian]", it.maxRotationError );
+			}
+			if ( it.decodedBoneCount )
+			{
+				const double bonesPerMS = ( 0.0 < it.decodeSeconds ) ? scast<double>( it.decodedBoneCount ) / ( it.decodeSeconds * 1000.0 ) : 0.0;
+				ImGui::Text( "Decode : %.3f[ms], %.1f[bones/ms]", it.decodeSeconds * 1000.0, bonesPerMS );
+			}
+
+			ImGui::TreePop();
+		}
+
+		ImGui::TreePop();
+	}
+	void Loader::ShowContainerBenchmarkNode( const std::string &nodeCaption )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		struct Result
+		{
+			std::string	fileName;
+			bool	hasContainer	= false;
+			size_t	binaryBytes		= 0;
+			size_t	containerBytes	= 0;
+			double	cerealSeconds	= 0.0;	// Average.
+			double	buildSeconds	= 0.0;	// Average of mapping and building the Source and the PolygonGroup.
+			double	mapSeconds		= 0.0;	// Average of mapping and referring the vertices only.
+			size_t	referredCount	= 0;	// The vertices and indices that were referred in place by the mapping.
+		};
+		static std::vector<Result>	results{};
+		static int					repeatCount = 10;
+
+		ImGui::DragInt( "Repeat count per file", &repeatCount, 1.0f, 1, 1000 );
+		repeatCount = std::max( 1, repeatCount );
+
+		std::vector<std::string> paths{};
+		{
+			std::lock_guard<std::mutex> lock( loadedPathMutex );
+			paths = loadedBinaryPaths;
+		}
+
+		static bool compressMotions = false;
+		static Model::Animation::CompressionOption compression{};
+		ImGui::Checkbox( "Compress the motions at the conversion", &compressMotions );
+		if ( compressMotions )
+		{
+			ImGui::DragFloat( "Tolerance of scale",				&compression.scaleTolerance,		0.0001f, 0.0f, 1.0f, "%.5f" );
+			ImGui::DragFloat( "Tolerance of rotation(radian)",	&compression.rotationTolerance,		0.0001f, 0.0f, 1.0f, "%.5f" );
+			ImGui::DragFloat( "Tolerance of translation",		&compression.translationTolerance,	0.0001f, 0.0f, 1.0f, "%.5f" );
+		}
+
+		if ( ImGui::Button( "Convert all to container" ) )
+		{
+			for ( const auto &path : paths )
+			{
+				if ( !ConvertToContainer( path, ( compressMotions ) ? &compression : nullptr ) )
+				{
+					OutputDebugProgress( "Failed the conversion to container:" + path, /* isAllowOutput = */ true );
+				}
+			}
+		}
+
+		if ( ImGui::Button( "Measure" ) )
+		{
+			auto GetFileBytes = []( const std::string &filePath )->size_t
+			{
+				WIN32_FILE_ATTRIBUTE_DATA attr{};
+				if ( !GetFileAttributesExA( filePath.c_str(), GetFileExInfoStandard, &attr ) ) { return 0; }
+				// else
+				return ( scast<size_t>( attr.nFileSizeHigh ) << 32 ) | scast<size_t>( attr.nFileSizeLow );
+			};
+
+			results.clear();
+			Benchmark timer{};
+			for ( const auto &path : paths )
+			{
+				const std::string containerPath = ToContainerPath( path );
+
+				Result result{};
+				result.fileName			= path.substr( ExtractFileDirectoryFromFullPath( path ).size() );
+				result.binaryBytes		= GetFileBytes( path );
+				result.containerBytes	= GetFileBytes( containerPath );
+				result.hasContainer		= ( result.containerBytes != 0 );
+
+				for ( int i = 0; i < repeatCount; ++i )
+				{
+					Loader loader{};
+					timer.Begin();
+					loader.LoadByCereal( path, /* outputProgress = */ false );
+					result.cerealSeconds += timer.End();
+				}
+
+				if ( result.hasContainer )
+				{
+					for ( int i = 0; i < repeatCount; ++i )
+					{
+						Loader loader{};
+						timer.Begin();
+						loader.LoadByContainer( containerPath, /* outputProgress = */ false );
+						result.buildSeconds += timer.End();
+					}
+
+					for ( int i = 0; i < repeatCount; ++i )
+					{
+						timer.Begin();
+						Model::Container::MappedModel mapped{};
+						if ( mapped.Open( containerPath ) )
+						{
+							const size_t meshCount = mapped.GetMeshCount();
+							for ( size_t m = 0; m < meshCount; ++m )
+							{
+								const auto mesh = mapped.GetMesh( m );
+								result.referredCount += mesh.indices.size() + mesh.positions.size();
+							}
+						}
+						result.mapSeconds += timer.End();
+					}
+				}
+
+				const double divisor = scast<double>( repeatCount );
+				result.referredCount	/= scast<size_t>( repeatCount );
+				result.cerealSeconds	/= divisor;
+				result.buildSeconds		/= divisor;
+				result.mapSeconds		/= divisor;
+				results.emplace_back( std::move( result ) );
+			}
+		}
+
+		if ( results.empty() )
+		{
+			ImGui::Text( "Press the \"Measure\" button after loading the models. Loaded files : %d", scast<int>( paths.size() ) );
+		}
+
+		auto ToKB = []( size_t bytes )
+		{
+			return scast<float>( bytes ) / 1024.0f;
+		};
+		for ( const auto &it : results )
+		{
+			if ( !ImGui::TreeNode( Donya::MultiToUTF8( it.fileName ).c_str() ) ) { continue; }
+			// else
+
+			ImGui::Text( "Cereal    : %.3f[ms], %.1f[KB]", it.cerealSeconds * 1000.0, ToKB( it.binaryBytes ) );
+			if ( it.hasContainer )
+			{
+				ImGui::Text( "Container : %.3f[ms], %.1f[KB]", it.buildSeconds * 1000.0, ToKB( it.containerBytes ) );
+				ImGui::Text( "Map only  : %.3f[ms], referred %d elements", it.mapSeconds * 1000.0, scast<int>( it.referredCount ) );
+				if ( 0.0 < it.buildSeconds )
+				{
+					ImGui::Text( "Speed up  : x%.2f", it.cerealSeconds / it.buildSeconds );
+				}
+			}
+			else
+			{
+				ImGui::Text( "Container : (Not converted)" );
+			}
+
+			ImGui::TreePop();
+		}
+
+		ImGui::TreePop();
+	}
+	void Loader::ShowLoadManyBenchmarkNode( const std::string &nodeCaption )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		struct Result
+		{
+			int		fileCount		= 0;
+			int		workerCount		= 0;
+			int		failedCount		= 0;
+			double	serialSeconds	= 0.0;	// Average.
+			double	parallelSeconds	= 0.0;	// Average.
+		};
+		static Result	result{};
+		static bool		measured	= false;
+		static int		repeatCount	= 5;
+
+		ImGui::DragInt( "Repeat count", &repeatCount, 1.0f, 1, 100 );
+		repeatCount = std::max( 1, repeatCount );
+
+		if ( ImGui::Button( "Measure" ) )
+		{
+			std::vector<std::string> paths{};
+			{
+				std::lock_guard<std::mutex> lock( loadedPathMutex );
+				paths = loadedBinaryPaths;
+			}
+
+			result				= Result{};
+			result.fileCount	= scast<int>( paths.size() );
+
+			JobSystem jobSystem{ JobSystem::CalcDefaultWorkerCount() };
+			result.workerCount	= scast<int>( jobSystem.GetWorkerCount() );
+
+			Benchmark timer{};
+			for ( int i = 0; i < repeatCount; ++i )
+			{
+				timer.Begin();
+				for ( const auto &path : paths )
+				{
+					Loader loader{};
+					if ( !loader.Load( path, /* outputProgress = */ false ) ) { result.failedCount++; }
+				}
+				result.serialSeconds += timer.End();
+
+				std::vector<Loader> loaders{};
+				timer.Begin();
+				LoadMany( paths, &loaders, nullptr, &jobSystem, /* outputProgress = */ false );
+				result.parallelSeconds += timer.End();
+			}
+
+			result.serialSeconds	/= scast<double>( repeatCount );
+			result.parallelSeconds	/= scast<double>( repeatCount );
+			measured = true;
+		}
+
+		if ( !measured )
+		{
+			ImGui::Text( "Press the \"Measure\" button after loading the models." );
+			ImGui::TreePop();
+			return;
+		}
+		// else
+
+		ImGui::Text( "Files : %d, Workers : %d + caller", result.fileCount, result.workerCount );
+		if ( result.failedCount )
+		{
+			ImGui::TextColored( ImVec4{ 1.0f, 0.3f, 0.3f, 1.0f }, "Failed : %d", result.failedCount );
+		}
+		ImGui::Text( "Serial   : %.3f[ms]", result.serialSeconds	* 1000.0 );
+		ImGui::Text( "Parallel : %.3f[ms]", result.parallelSeconds	* 1000.0 );
+		if ( 0.0 < result.parallelSeconds )
+		{
+			ImGui::Text( "Speed up : x%.2f", result.serialSeconds / result.parallelSeconds );
+		}
+
+		ImGui::TreePop();
+	}
+	void Loader::ShowSerializerBenchmarkNode( const std::string &nodeCaption )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		struct Result
+		{
+			std::string						fileName;
+			SerializerBenchmark::Comparison	comparison;
+		};
+		static std::vector<Result>	results{};
+		static int					repeatCount = 5;
+
+		ImGui::DragInt( "Repeat count per file", &repeatCount, 1.0f, 1, 100 );
+		repeatCount = std::max( 1, repeatCount );
+
+		if ( ImGui::Button( "Measure" ) )
+		{
+			std::vector<std::string> paths{};
+			{
+				std::lock_guard<std::mutex> lock( loadedPathMutex );
+				paths = loadedBinaryPaths;
+			}
+
+			results.clear();
+			for ( const auto &path : paths )
+			{
+				Result result{};
+				result.fileName		= path.substr( ExtractFileDirectoryFromFullPath( path ).size() );
+				result.comparison	= SerializerBenchmark::Measure
+				(
+					repeatCount,
+					[&path]()
+					{
+						Loader loader{};
+						loader.LoadByCereal( path, /* outputProgress = */ false );
+					}
+				);
+				results.emplace_back( std::move( result ) );
+			}
+		}
+
+		if ( results.empty() )
+		{
+			ImGui::Text( "Press the \"Measure\" button after loading the models." );
+		}
+
+		for ( const auto &it : results )
+		{
+			if ( !ImGui::TreeNode( Donya::MultiToUTF8( it.fileName ).c_str() ) ) { continue; }
+			// else
+
+			SerializerBenchmark::ShowComparison( it.comparison );
+
+			ImGui::TreePop();
+		}
+
+		ImGui::TreePop();
+	}
 #endif // USE_IMGUI
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -35,14 +36,15 @@ namespace fbxsdk
 
 namespace Donya
 {
+	class JobSystem;
+
 	/// <summary>
-	/// It can copy.
+	/// It can copy. The loading does not share any state between the instances, so the different instances can load in parallel.
 	/// </summary>
 	class Loader
 	{
 	private:
 		static constexpr const char *SERIAL_ID = "Loader";
-		static std::mutex cerealMutex;
 
 	#if USE_FBX_SDK
 		static std::mutex fbxMutex;
@@ -87,14 +89,46 @@ namespace Donya
 		/// We can those load file extensions:<para></para>
 		/// .fbx, .FBX(If the flag of use fbx-sdk is on),<para></para>
 		/// .obj, .OBJ(If the flag of use fbx-sdk is on),<para></para>
-		/// .bin.
+		/// .bin(If the container that was converted from it is placed beside it and is not older than it, the container is used),<para></para>
+		/// .dmdl(The container of Model::Container).
 		/// </summary>
 		bool Load( const std::string &filePath, bool outputDebugProgress = true );
+		/// <summary>
+		/// Loads the files in parallel, then the "pOutput" has the loaders in the same order as the "filePaths". The loader of failed file is cleared.<para></para>
+		/// The "pSucceeded" can be nullptr. If the "pJobSystem" is nullptr, this uses a temporary job system. Returns false if any file could not be loaded.<para></para>
+		/// The "reportProgress" is called with the fraction of the finished files whenever a file is finished. It is called from the worker threads, but never at the same time.
+		/// </summary>
+		static bool LoadMany( const std::vector<std::string> &filePaths, std::vector<Loader> *pOutput, std::vector<bool> *pSucceeded = nullptr, JobSystem *pJobSystem = nullptr, bool outputDebugProgress = true, const std::function<void( float fraction )> &reportProgress = nullptr );
+		/// <summary>
+		/// Loads the files by LoadMany(), then calls the "create" for each loaded file in the same order on the caller thread, because the creation of models uses the caches of resources.<para></para>
+		/// The "create" receives the index in the "filePaths" and the loader. It is not called for the file that could not be loaded. Asserts for each failed file, and returns false if any loading or creation failed.<para></para>
+		/// The first half of the "reportProgress" is the loading of files, and the last half is the creation.
+		/// </summary>
+		static bool LoadManyThenCreate( const std::vector<std::string> &filePaths, const std::function<bool( size_t index, const Loader &loader )> &create, JobSystem *pJobSystem = nullptr, const std::function<void( float fraction )> &reportProgress = nullptr );
 	public:
 		/// <summary>
 		/// We expect the "filePath" contain extension also.
 		/// </summary>
 		void SaveByCereal( const std::string &filePath ) const;
+		/// <summary>
+		/// Saves as the container that is loaded by mapping the file. Please save it to the ToContainerPath() of the ".bin" file for using it by Load().
+		/// </summary>
+		bool SaveByContainer( const std::string &filePath ) const;
+		/// <summary>
+		/// Loads the ".bin" file by cereal, then saves it to the ToContainerPath().<para></para>
+		/// If the "pCompression" is not nullptr, the motions are compressed by CompressMotions() before saving, and MotionHolder decodes those at the loading. The motions that can not be compressed are saved as they are.
+		/// </summary>
+		static bool ConvertToContainer( const std::string &binaryFilePath, const Model::Animation::CompressionOption *pCompression = nullptr );
+		/// <summary>
+		/// Ex. returns "C:/Foo/Bar.dmdl" from ["C:/Foo/Bar.bin"].
+		/// </summary>
+		static std::string ToContainerPath( const std::string &binaryFilePath );
+	public:
+		/// <summary>
+		/// Moves all motions into the compressed motions of the source, if all of those are compatible with the skeletal. The order of motions is kept.<para></para>
+		/// This is heavy, so this is for the conversion of the files before SaveByCereal(). Returns false if any motion can not be compressed(then the source is not changed).
+		/// </summary>
+		bool CompressMotions( const Model::Animation::CompressionOption &option );
 	public:
 		const Model::Source			&GetModelSource()	const { return source; }
 		void SetModelSource( const Model::Source &newSource ) { source = newSource; }
@@ -111,12 +145,29 @@ namespace Donya
 		std::string GetFileDirectory()					const { return fileDirectory;	}
 	private:
 		bool LoadByCereal( const std::string &filePath, bool outputDebugProgress );
+		bool LoadByContainer( const std::string &filePath, bool outputDebugProgress );
 	#if USE_FBX_SDK
 		bool LoadByFBXSDK( const std::string &filePath, bool outputDebugProgress );
 	#endif // USE_FBX_SDK
 	public:
 	#if USE_IMGUI
 		void ShowImGuiNode( const std::string &nodeCaption );
+		/// <summary>
+		/// Shows the memory of motions before and after the compression, and the decode throughput, of each model that was loaded until now.
+		/// </summary>
+		static void ShowMotionCompressionNode( const std::string &nodeCaption );
+		/// <summary>
+		/// Compares the loading time of cereal and the container, of each ".bin" file that was loaded until now. And it can convert those to the container.
+		/// </summary>
+		static void ShowContainerBenchmarkNode( const std::string &nodeCaption );
+		/// <summary>
+		/// Compares the wall-clock time of loading the ".bin" files that were loaded until now, by Load() serially and by LoadMany().
+		/// </summary>
+		static void ShowLoadManyBenchmarkNode( const std::string &nodeCaption );
+		/// <summary>
+		/// Compares the loading by cereal in the streaming mode and in the buffered mode of Serializer, of each ".bin" file that was loaded until now.
+		/// </summary>
+		static void ShowSerializerBenchmarkNode( const std::string &nodeCaption );
 	#endif // USE_IMGUI
 	};
 
@@ -0,0 +1,210 @@
+#include "ModelAnimationBatch.h"
+
+#include <algorithm>
+#include <array>
+
+#if USE_IMGUI
+#include "Donya/Benchmark.h"
+#include "Donya/Random.h"
+#endif // USE_IMGUI
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Model
+	{
+		namespace
+		{
+			constexpr size_t REQUEST_COUNT_PER_JOB = 8;
+		}
+
+		void AnimationBatch::Append( const Animator &animator, const MotionClip &motion, Pose *pDestination )
+		{
+			if ( !pDestination ) { return; }
+			// else
+
+			Request request{};
+			request.animator		= animator;
+			request.pMotion			= &motion;
+			request.pDestination	= pDestination;
+
+			const auto found = requestIndices.find( pDestination );
+			if ( found != requestIndices.end() )
+			{
+				requests[found->second] = request;
+				return;
+			}
+			// else
+
+			requestIndices.emplace( pDestination, requests.size() );
+			requests.emplace_back( request );
+		}
+		void AnimationBatch::Evaluate( JobSystem *pJobSystem )
+		{
+			// Each request writes to the different destination, so those do not need any synchronization.
+			auto EvaluateRange = [&]( size_t begin, size_t end )
+			{
+				for ( size_t i = begin; i < end; ++i )
+				{
+					const Request &request = requests[i];
+					request.animator.CalcCurrentPose( *request.pMotion, request.pDestination );
+				}
+			};
+
+			if ( pJobSystem )
+			{
+				pJobSystem->ParallelFor( requests.size(), REQUEST_COUNT_PER_JOB, EvaluateRange );
+			}
+			else
+			{
+				EvaluateRange( 0, requests.size() );
+			}
+
+			Clear();
+		}
+		void AnimationBatch::Clear()
+		{
+			// Keep the capacity for the next frame.
+			requests.clear();
+			requestIndices.clear();
+		}
+
+	#if USE_IMGUI
+		void ShowAnimationScalingBenchmarkNode( const std::string &nodeCaption, const std::vector<const MotionHolder *> &holders )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			struct Result
+			{
+				int		actorCount		= 0;
+				int		threadCount		= 0;
+				double	frameSeconds	= 0.0;	// The average of a frame.
+				int		mismatchCount	= 0;	// The count of global matrices that differ from the serial evaluation.
+			};
+			static std::vector<Result>	results{};
+			static int					frameCount		= 60;
+			static int					maxThreadCount	= scast<int>( JobSystem::CalcDefaultWorkerCount() + 1 );
+
+			ImGui::DragInt( "Frame count",			&frameCount,		1.0f, 1, 6000 );
+			ImGui::DragInt( "Max thread count",		&maxThreadCount,	1.0f, 1, 64 );
+			frameCount		= std::max( 1, frameCount		);
+			maxThreadCount	= std::max( 1, maxThreadCount	);
+
+			if ( ImGui::Button( "Measure" ) )
+			{
+				results.clear();
+
+				std::vector<const MotionClip *> clips{};
+				for ( const auto &pHolder : holders )
+				{
+					if ( !pHolder ) { continue; }
+					// else
+
+					const size_t motionCount = pHolder->GetMotionCount();
+					for ( size_t i = 0; i < motionCount; ++i )
+					{
+						const MotionClip &clip = pHolder->GetMotion( scast<int>( i ) );
+						if ( clip.IsEmpty() ) { continue; }
+						// else
+						clips.emplace_back( &clip );
+					}
+				}
+
+				constexpr std::array<int, 4> ACTOR_COUNTS{ 50, 100, 200, 500 };
+				for ( size_t a = 0; !clips.empty() && a < ACTOR_COUNTS.size(); ++a )
+				{
+					const size_t actorCount = scast<size_t>( ACTOR_COUNTS[a] );
+
+					std::vector<const MotionClip *>	actorClips( actorCount );
+					std::vector<Animator>			animators( actorCount );
+					std::vector<Pose>				expected( actorCount );
+					std::vector<Pose>				actual( actorCount );
+					for ( size_t i = 0; i < actorCount; ++i )
+					{
+						const MotionClip &clip = *clips[i % clips.size()];
+						actorClips[i] = &clip;
+
+						animators[i].SetRepeatRange( clip );
+						animators[i].SetInternalElapsedTime( Donya::Random::GenerateFloat( 0.0f, clip.GetWholeSeconds() ) );
+
+						// Prepare the buffers before the measurement.
+						expected[i].AssignSkeletal( clip, 0 );
+						actual[i].AssignSkeletal( clip, 0 );
+					}
+
+					AnimationBatch batch{};
+					for ( size_t i = 0; i < actorCount; ++i )
+					{
+						batch.Append( animators[i], *actorClips[i], &expected[i] );
+					}
+					batch.Evaluate( nullptr );
+
+					for ( int t = 1; t <= maxThreadCount; ++t )
+					{
+						JobSystem jobSystem{ scast<size_t>( t - 1 ) };
+
+						Result result{};
+						result.actorCount	= scast<int>( actorCount );
+						result.threadCount	= t;
+
+						Benchmark timer{};
+						timer.Begin();
+						for ( int f = 0; f < frameCount; ++f )
+						{
+							for ( size_t i = 0; i < actorCount; ++i )
+							{
+								batch.Append( animators[i], *actorClips[i], &actual[i] );
+							}
+							batch.Evaluate( &jobSystem );
+						}
+						result.frameSeconds = timer.End() / scast<double>( frameCount );
+
+						for ( size_t i = 0; i < actorCount; ++i )
+						{
+							const auto &lhs = expected[i].GetGlobalMatrices();
+							const auto &rhs = actual[i].GetGlobalMatrices();
+							if ( lhs.size() != rhs.size() )
+							{
+								result.mismatchCount += scast<int>( std::max( lhs.size(), rhs.size() ) );
+								continue;
+							}
+							// else
+
+							for ( size_t b = 0; b < lhs.size(); ++b )
+							{
+								if ( !( lhs[b] == rhs[b] ) ) { result.mismatchCount++; }
+							}
+						}
+
+						results.emplace_back( result );
+					}
+				}
+			}
+
+			if ( results.empty() )
+			{
+				ImGui::Text( "Press the \"Measure\" button." );
+			}
+
+			double serialSeconds = 0.0;
+			for ( const auto &it : results )
+			{
+				if ( it.threadCount == 1 ) { serialSeconds = it.frameSeconds; }
+				const double speedUp = ( 0.0 < it.frameSeconds ) ? serialSeconds / it.frameSeconds : 0.0;
+				ImGui::Text
+				(
+					"Actors[%3d], Threads[%2d] : %.4f[ms/frame], x%.2f, Mismatched[%d]",
+					it.actorCount, it.threadCount, it.frameSeconds * 1000.0, speedUp, it.mismatchCount
+				);
+			}
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "JobSystem.h"
+#include "ModelMotion.h"
+#include "ModelPose.h"
+#include "ModelSkeleton.h"
+#include "UseImGui.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		/// <summary>
+		/// Collects the pose evaluations of a frame, and evaluates those at once in parallel.<para></para>
+		/// Each request is evaluated by a copy of the animator at the appending, so the result is the same as calling Animator::CalcCurrentPose() at there.
+		/// </summary>
+		class AnimationBatch
+		{
+		private:
+			struct Request
+			{
+				Animator			animator;
+				const MotionClip	*pMotion		= nullptr;
+				Pose				*pDestination	= nullptr;
+			};
+		private:
+			std::vector<Request>						requests;
+			std::unordered_map<const Pose *, size_t>	requestIndices;	// The index of the request of each destination.
+		public:
+			/// <summary>
+			/// The motion and the destination must be alive until Evaluate() or Clear().<para></para>
+			/// The request to the same destination overwrites the previous one, as the same as the serial evaluation.
+			/// </summary>
+			void Append( const Animator &animator, const MotionClip &motion, Pose *pDestination );
+			/// <summary>
+			/// Evaluates all requests, then clears those. This evaluates serially if the "pJobSystem" is nullptr.
+			/// </summary>
+			void Evaluate( JobSystem *pJobSystem = nullptr );
+			void Clear();
+			size_t GetRequestCount() const { return requests.size(); }
+		};
+
+	#if USE_IMGUI
+		/// <summary>
+		/// Measures the time of evaluating the poses of "actorCount" actors by each thread count, and compares the results with the serial evaluation.
+		/// </summary>
+		void ShowAnimationScalingBenchmarkNode( const std::string &nodeCaption, const std::vector<const MotionHolder *> &holders );
+	#endif // USE_IMGUI
+	}
+}
@@ -0,0 +1,377 @@
+#include "ModelCompression.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Model
+	{
+		namespace
+		{
+			constexpr float			INV_SQRT_2		= 0.70710678f;	// The range of components except the largest is [-INV_SQRT_2 ~ +INV_SQRT_2].
+			constexpr std::uint16_t	VALUE_MASK		= 0x7FFF;
+			constexpr std::uint16_t	INDEX_BIT		= 0x8000;
+			constexpr float			QUANTIZE_RANGE	= scast<float>( VALUE_MASK );
+			constexpr size_t		MAX_SPAN		= 255;	// The maximum distance of the kept keys, it limits the cost of the reduction.
+
+			float Distance( const Donya::Vector3 &a, const Donya::Vector3 &b )
+			{
+				return ( a - b ).Length();
+			}
+			float Distance( const Donya::Quaternion &a, const Donya::Quaternion &b )
+			{
+				// The angle between the two rotations.
+				const float dot = std::min( 1.0f, fabsf( Donya::Quaternion::Dot( a, b ) ) );
+				return 2.0f * acosf( dot );
+			}
+			Donya::Vector3		Interpolate( const Donya::Vector3 &a, const Donya::Vector3 &b, float percent )
+			{
+				return Donya::Lerp( a, b, percent );
+			}
+			Donya::Quaternion	Interpolate( const Donya::Quaternion &a, const Donya::Quaternion &b, float percent )
+			{
+				return Donya::Quaternion::Slerp( a, b, percent );
+			}
+
+			template<typename Stored>	struct Decoded								{ using Type = Stored;				};
+			template<>					struct Decoded<Animation::PackedRotation>	{ using Type = Donya::Quaternion;	};
+
+			Donya::Vector3		Decode( const Donya::Vector3 &stored )
+			{
+				return stored;
+			}
+			Donya::Quaternion	Decode( const Animation::PackedRotation &stored )
+			{
+				return stored.Unpack();
+			}
+
+			/// <summary>
+			/// Reduces the keys that can be represented by the interpolation of the neighbor kept keys.<para></para>
+			/// The "decoded" is the values that the decoder will return at each key, and the "sources" is the values that should be represented.
+			/// </summary>
+			template<typename Value>
+			std::vector<std::uint16_t> ReduceKeys( const std::vector<float> &seconds, const std::vector<Value> &decoded, const std::vector<Value> &sources, float tolerance )
+			{
+				const size_t keyCount = sources.size();
+
+				bool isConstant = true;
+				for ( size_t i = 1; i < keyCount; ++i )
+				{
+					if ( tolerance < Distance( decoded.front(), sources[i] ) )
+					{
+						isConstant = false;
+						break;
+					}
+				}
+				if ( isConstant ) { return std::vector<std::uint16_t>{ 0 }; }
+				// else
+
+				auto CanRepresent = [&]( size_t begin, size_t end )
+				{
+					const float range = seconds[end] - seconds[begin];
+					if ( range <= 0.0f ) { return false; }
+					// else
+
+					for ( size_t i = begin + 1; i < end; ++i )
+					{
+						const float percent = ( seconds[i] - seconds[begin] ) / range;
+						const Value predicted = Interpolate( decoded[begin], decoded[end], percent );
+						if ( tolerance < Distance( predicted, sources[i] ) ) { return false; }
+					}
+					return true;
+				};
+
+				std::vector<std::uint16_t> keptIndices{ 0 };
+				size_t anchor = 0;
+				while ( anchor + 1 < keyCount )
+				{
+					size_t end = anchor + 1;
+					while ( end + 1 < keyCount && end + 1 - anchor <= MAX_SPAN && CanRepresent( anchor, end + 1 ) )
+					{
+						++end;
+					}
+
+					keptIndices.emplace_back( scast<std::uint16_t>( end ) );
+					anchor = end;
+				}
+
+				return keptIndices;
+			}
+
+			template<typename Stored>
+			Animation::CompressedTrack<Stored> MakeTrack( const std::vector<std::uint16_t> &keptIndices, const std::vector<Stored> &stores )
+			{
+				Animation::CompressedTrack<Stored> track{};
+				track.keyIndices = keptIndices;
+				track.values.reserve( keptIndices.size() );
+				for ( const auto &it : keptIndices )
+				{
+					track.values.emplace_back( stores[it] );
+				}
+				return track;
+			}
+
+			template<typename Stored>
+			size_t CalcTrackBytes( const std::vector<Animation::CompressedTrack<Stored>> &tracks )
+			{
+				size_t sum = 0;
+				for ( const auto &it : tracks )
+				{
+					sum += it.keyIndices.size()	* sizeof( std::uint16_t );
+					sum += it.values.size()		* sizeof( Stored );
+				}
+				return sum;
+			}
+
+			/// <summary>
+			/// Returns the index of the kept key that satisfies "keyIndices[i] &lt;= keyIndex".
+			/// </summary>
+			template<typename Stored>
+			size_t FindSegment( const Animation::CompressedTrack<Stored> &track, size_t keyIndex )
+			{
+				const auto &indices = track.keyIndices;
+				const auto found = std::upper_bound( indices.begin(), indices.end(), keyIndex );
+				return ( found == indices.begin() ) ? 0 : scast<size_t>( found - indices.begin() ) - 1;
+			}
+			template<typename Stored>
+			auto ValueAt( const Animation::CompressedTrack<Stored> &track, const KeyTimeline &timeline, size_t keyIndex ) -> typename Decoded<Stored>::Type
+			{
+				if ( track.values.size() == 1 ) { return Decode( track.values.front() ); }
+				// else
+
+				const size_t segment = FindSegment( track, keyIndex );
+				const size_t keyL = track.keyIndices[segment];
+				if ( keyL == keyIndex || segment + 1 == track.keyIndices.size() ) { return Decode( track.values[segment] ); }
+				// else
+
+				const size_t keyR		= track.keyIndices[segment + 1];
+				const float  secondsL	= timeline.GetKeySeconds( keyL );
+				const float  percent	= ( timeline.GetKeySeconds( keyIndex ) - secondsL ) / ( timeline.GetKeySeconds( keyR ) - secondsL );
+				return Interpolate( Decode( track.values[segment] ), Decode( track.values[segment + 1] ), percent );
+			}
+			template<typename Stored>
+			auto ValueAt( const Animation::CompressedTrack<Stored> &track, const KeyTimeline &timeline, size_t keyIndexL, size_t keyIndexR, float percent ) -> typename Decoded<Stored>::Type
+			{
+				if ( track.values.size() == 1 ) { return Decode( track.values.front() ); }
+				// else
+
+				// Between the adjacent keys, the value is on the line of the kept keys that surround those.
+				const size_t segment = FindSegment( track, keyIndexL );
+				if ( keyIndexR == keyIndexL + 1 && segment + 1 < track.keyIndices.size() )
+				{
+					const float secondsL	= timeline.GetKeySeconds( keyIndexL );
+					const float secondsR	= timeline.GetKeySeconds( keyIndexR );
+					const float current		= secondsL + ( percent * ( secondsR - secondsL ) );
+
+					const float segmentL	= timeline.GetKeySeconds( track.keyIndices[segment] );
+					const float segmentR	= timeline.GetKeySeconds( track.keyIndices[segment + 1] );
+					const float segmentPercent = ( current - segmentL ) / ( segmentR - segmentL );
+					return Interpolate( Decode( track.values[segment] ), Decode( track.values[segment + 1] ), segmentPercent );
+				}
+				// else
+
+				// e.g. between the last key and the first key.
+				return Interpolate( ValueAt( track, timeline, keyIndexL ), ValueAt( track, timeline, keyIndexR ), percent );
+			}
+		}
+
+		namespace Animation
+		{
+			PackedRotation PackedRotation::Pack( const Donya::Quaternion &rotation )
+			{
+				const Donya::Quaternion unit = rotation.Unit();
+				const std::array<float, 4> elements{ unit.x, unit.y, unit.z, unit.w };
+
+				size_t largest = 0;
+				for ( size_t i = 1; i < elements.size(); ++i )
+				{
+					if ( fabsf( elements[largest] ) < fabsf( elements[i] ) ) { largest = i; }
+				}
+
+				// The "q" and "-q" represent the same rotation, so make the largest component to positive.
+				const float sign = ( elements[largest] < 0.0f ) ? -1.0f : 1.0f;
+
+				PackedRotation packed{};
+				size_t write = 0;
+				for ( size_t i = 0; i < elements.size(); ++i )
+				{
+					if ( i == largest ) { continue; }
+					// else
+
+					const float normalized	= ( ( elements[i] * sign / INV_SQRT_2 ) + 1.0f ) * 0.5f;	// [0.0f ~ 1.0f]
+					const float clamped		= std::max( 0.0f, std::min( 1.0f, normalized ) );
+					packed.data[write] = scast<std::uint16_t>( lroundf( clamped * QUANTIZE_RANGE ) );
+					write++;
+				}
+
+				if ( largest & 1 ) { packed.data[0] |= INDEX_BIT; }
+				if ( largest & 2 ) { packed.data[1] |= INDEX_BIT; }
+
+				return packed;
+			}
+			Donya::Quaternion PackedRotation::Unpack() const
+			{
+				const size_t largest =
+					( ( data[0] & INDEX_BIT ) ? 1 : 0 ) |
+					( ( data[1] & INDEX_BIT ) ? 2 : 0 );
+
+				std::array<float, 4> elements{};
+				float sumSq = 0.0f;
+				size_t read = 0;
+				for ( size_t i = 0; i < elements.size(); ++i )
+				{
+					if ( i == largest ) { continue; }
+					// else
+
+					const float normalized = scast<float>( data[read] & VALUE_MASK ) / QUANTIZE_RANGE;
+					elements[i] = ( ( normalized * 2.0f ) - 1.0f ) * INV_SQRT_2;
+					sumSq += elements[i] * elements[i];
+					read++;
+				}
+				elements[largest] = sqrtf( std::max( 0.0f, 1.0f - sumSq ) );
+
+				return Donya::Quaternion{ elements[0], elements[1], elements[2], elements[3] }.Unit();
+			}
+
+			size_t CompressedMotion::GetByteSize() const
+			{
+				return
+					keySeconds.size() * sizeof( float )	+
+					CalcTrackBytes( scales )			+
+					CalcTrackBytes( rotations )			+
+					CalcTrackBytes( translations )		;
+			}
+
+			bool CompressedMotion::Compress( const Motion &source, const CompressionOption &option, CompressedMotion *pDest )
+			{
+				if ( !pDest ) { return false; }
+				// else
+
+				const size_t keyCount = source.keyFrames.size();
+				if ( !keyCount || MAX_KEY_COUNT < keyCount ) { return false; }
+				// else
+
+				const size_t boneCount = source.keyFrames.front().keyPose.size();
+				for ( const auto &it : source.keyFrames )
+				{
+					if ( it.keyPose.size() != boneCount ) { return false; }
+				}
+
+				CompressedMotion &dest = *pDest;
+				dest.name			= source.name;
+				dest.samplingRate	= source.samplingRate;
+				dest.animSeconds	= source.animSeconds;
+				dest.keySeconds.resize( keyCount );
+				for ( size_t k = 0; k < keyCount; ++k )
+				{
+					dest.keySeconds[k] = source.keyFrames[k].seconds;
+				}
+
+				dest.scales.resize( boneCount );
+				dest.rotations.resize( boneCount );
+				dest.translations.resize( boneCount );
+
+				std::vector<Donya::Vector3>		vectors( keyCount );
+				std::vector<Donya::Quaternion>	rotations( keyCount );
+				std::vector<Donya::Quaternion>	decodedRotations( keyCount );
+				std::vector<PackedRotation>		packedRotations( keyCount );
+				for ( size_t b = 0; b < boneCount; ++b )
+				{
+					for ( size_t k = 0; k < keyCount; ++k )
+					{
+						vectors[k] = source.keyFrames[k].keyPose[b].bone.transform.scale;
+					}
+					dest.scales[b] = MakeTrack( ReduceKeys( dest.keySeconds, vectors, vectors, option.scaleTolerance ), vectors );
+
+					for ( size_t k = 0; k < keyCount; ++k )
+					{
+						vectors[k] = source.keyFrames[k].keyPose[b].bone.transform.translation;
+					}
+					dest.translations[b] = MakeTrack( ReduceKeys( dest.keySeconds, vectors, vectors, option.translationTolerance ), vectors );
+
+					// The reduction considers the quantization error.
+					for ( size_t k = 0; k < keyCount; ++k )
+					{
+						rotations[k]		= source.keyFrames[k].keyPose[b].bone.transform.rotation.Unit();
+						packedRotations[k]	= PackedRotation::Pack( rotations[k] );
+						decodedRotations[k]	= packedRotations[k].Unpack();
+					}
+					dest.rotations[b] = MakeTrack( ReduceKeys( dest.keySeconds, decodedRotations, rotations, option.rotationTolerance ), packedRotations );
+				}
+
+				return true;
+			}
+		}
+
+		CompressedClip::CompressedClip( const Animation::CompressedMotion &argSource, const std::shared_ptr<const Skeleton> &pArgSkeleton ) :
+			source( argSource ), pSkeleton( pArgSkeleton ), timeline( argSource.keySeconds )
+		{
+			_ASSERT_EXPR( pSkeleton && pSkeleton->GetBoneCount() == source.GetBoneCount(), L"Error : The skeleton is not compatible with the compressed motion!" );
+		}
+
+		void CompressedClip::Sample( size_t keyIndex, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const
+		{
+			const size_t boneCount = GetBoneCount();
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				Animation::Transform &transform = pTransforms[b];
+				transform.scale			= ValueAt( source.scales[b],		timeline, keyIndex );
+				transform.rotation		= ValueAt( source.rotations[b],		timeline, keyIndex );
+				transform.translation	= ValueAt( source.translations[b],	timeline, keyIndex );
+
+				pLocals[b] = transform.ToWorldMatrix();
+			}
+
+			CalcGlobalMatrices( pLocals, pGlobals );
+		}
+		void CompressedClip::Sample( size_t keyIndexL, size_t keyIndexR, float percent, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const
+		{
+			const size_t boneCount = GetBoneCount();
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				Animation::Transform &transform = pTransforms[b];
+				transform.scale			= ValueAt( source.scales[b],		timeline, keyIndexL, keyIndexR, percent );
+				transform.rotation		= ValueAt( source.rotations[b],		timeline, keyIndexL, keyIndexR, percent );
+				transform.translation	= ValueAt( source.translations[b],	timeline, keyIndexL, keyIndexR, percent );
+
+				pLocals[b] = transform.ToWorldMatrix();
+			}
+
+			CalcGlobalMatrices( pLocals, pGlobals );
+		}
+		void CompressedClip::CalcGlobalMatrices( const Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const
+		{
+			if ( !pSkeleton ) { return; }
+			// else
+
+			// Same as Pose::UpdateTransformMatrices(), that was used to bake the global matrices of the source.
+			// The parent is placed before own children in the evaluation order, so the parent's global matrix is ready.
+			using namespace DirectX;
+			const auto &parentIndices	= pSkeleton->GetParentIndices();
+			const auto &evaluationOrder	= pSkeleton->GetEvaluationOrder();
+			const size_t boneCount = std::min( GetBoneCount(), parentIndices.size() );
+			for ( const size_t b : evaluationOrder )
+			{
+				if ( boneCount <= b ) { continue; }
+				// else
+
+				const int parentIndex = parentIndices[b];
+				if ( parentIndex == -1 )
+				{
+					pGlobals[b] = pLocals[b];
+					continue;
+				}
+				// else
+
+				const XMMATRIX global = XMMatrixMultiply( XMLoadFloat4x4( &pLocals[b] ), XMLoadFloat4x4( &pGlobals[parentIndex] ) );
+				XMStoreFloat4x4( &pGlobals[b], global );
+			}
+		}
+	}
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#undef max
+#undef min
+#include <cereal/types/array.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "Donya/Quaternion.h"
+#include "Donya/Serializer.h"
+#include "Donya/Vector.h"
+
+#include "ModelCommon.h"
+#include "ModelSkeleton.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		namespace Animation
+		{
+			/// <summary>
+			/// The allowed errors of the key reduction.
+			/// </summary>
+			struct CompressionOption
+			{
+				float scaleTolerance		= 0.001f;
+				float rotationTolerance		= 0.001f;	// Radian.
+				float translationTolerance	= 0.001f;
+			};
+
+			/// <summary>
+			/// A unit quaternion that packed into 48-bit by "smallest three" way.<para></para>
+			/// The largest component is dropped, and the other three components are quantized into 15-bit.
+			/// The index of the dropped component is stored into the top bits of first two elements.
+			/// </summary>
+			struct PackedRotation
+			{
+				std::array<std::uint16_t, 3> data{};
+			public:
+				static PackedRotation Pack( const Donya::Quaternion &rotation );
+				Donya::Quaternion Unpack() const;
+			private:
+				friend class cereal::access;
+				template<class Archive>
+				void serialize( Archive &archive, std::uint32_t version )
+				{
+					archive( CEREAL_NVP( data ) );
+
+					if ( 1 <= version )
+					{
+						// archive( CEREAL_NVP( x ) );
+					}
+				}
+			};
+
+			/// <summary>
+			/// The values of kept keys of a bone's component. The "keyIndices" are the indices of the source keys, and those contain the first and the last.<para></para>
+			/// The track that has only one key means the value is constant.
+			/// </summary>
+			template<typename Value>
+			struct CompressedTrack
+			{
+				std::vector<std::uint16_t>	keyIndices;
+				std::vector<Value>			values;
+			private:
+				friend class cereal::access;
+				template<class Archive>
+				void serialize( Archive &archive, std::uint32_t version )
+				{
+					archive
+					(
+						CEREAL_NVP( keyIndices	),
+						CEREAL_NVP( values		)
+					);
+
+					if ( 1 <= version )
+					{
+						// archive( CEREAL_NVP( x ) );
+					}
+				}
+			};
+
+			/// <summary>
+			/// A motion that the redundant keys of each component are removed, and the rotations are quantized.<para></para>
+			/// This does not have the names of bones and the local/global matrices. Those are provided by the Skeleton at the decoding.
+			/// </summary>
+			struct CompressedMotion
+			{
+				static constexpr size_t MAX_KEY_COUNT = 0xFFFF + 1;
+			public:
+				std::string										name;
+				float											samplingRate{ Motion::DEFAULT_SAMPLING_RATE };
+				float											animSeconds{};
+				std::vector<float>								keySeconds;		// The begin seconds of each source key.
+				std::vector<CompressedTrack<Donya::Vector3>>	scales;			// Per bone.
+				std::vector<CompressedTrack<PackedRotation>>	rotations;		// Per bone.
+				std::vector<CompressedTrack<Donya::Vector3>>	translations;	// Per bone.
+			public:
+				size_t GetBoneCount() const { return scales.size(); }
+				/// <summary>
+				/// Returns the bytes of the internal arrays. The name is not contained.
+				/// </summary>
+				size_t GetByteSize() const;
+			public:
+				/// <summary>
+				/// Returns false if the source can not be compressed, e.g. the bone count of the key-poses is not uniform, or the key count is over than MAX_KEY_COUNT.
+				/// </summary>
+				static bool Compress( const Motion &source, const CompressionOption &option, CompressedMotion *pDestination );
+			private:
+				friend class cereal::access;
+				template<class Archive>
+				void serialize( Archive &archive, std::uint32_t version )
+				{
+					archive
+					(
+						CEREAL_NVP( name			),
+						CEREAL_NVP( samplingRate	),
+						CEREAL_NVP( animSeconds		),
+						CEREAL_NVP( keySeconds		),
+						CEREAL_NVP( scales			),
+						CEREAL_NVP( rotations		),
+						CEREAL_NVP( translations	)
+					);
+
+					if ( 1 <= version )
+					{
+						// archive( CEREAL_NVP( x ) );
+					}
+				}
+			};
+		}
+
+		/// <summary>
+		/// The decoder of the compressed motion. This can be sampled as the same as the MotionClip.<para></para>
+		/// The global matrices are calculated from the local transforms by the hierarchy of the Skeleton.
+		/// </summary>
+		class CompressedClip
+		{
+		private:
+			Animation::CompressedMotion		source;
+			std::shared_ptr<const Skeleton>	pSkeleton;
+			KeyTimeline						timeline;
+		public:
+			CompressedClip() = default;
+			/// <summary>
+			/// The bone count of "pSkeleton" must be the same as the source.
+			/// </summary>
+			CompressedClip( const Animation::CompressedMotion &source, const std::shared_ptr<const Skeleton> &pSkeleton );
+		public:
+			const std::string						&GetName()			const { return source.name;			}
+			const std::shared_ptr<const Skeleton>	&GetSkeleton()		const { return pSkeleton;			}
+			const Animation::CompressedMotion		&GetSource()		const { return source;				}
+			float									GetSamplingRate()	const { return source.samplingRate;	}
+			float									GetAnimSeconds()	const { return source.animSeconds;	}
+			size_t									GetBoneCount()		const { return source.GetBoneCount();	}
+			const KeyTimeline						&GetTimeline()		const { return timeline;			}
+			float									GetLoopStepSeconds()const { return timeline.GetLoopStepSeconds();	}
+			size_t									GetKeyCount()		const { return timeline.GetKeyCount();		}
+			bool									IsEmpty()			const { return timeline.IsEmpty();			}
+			float									GetKeySeconds( size_t keyIndex ) const { return timeline.GetKeySeconds( keyIndex ); }
+			/// <summary>
+			/// Returns the begin seconds of the last key. Requires !IsEmpty().
+			/// </summary>
+			float									GetWholeSeconds()	const { return timeline.GetWholeSeconds();	}
+			size_t									GetByteSize()		const { return source.GetByteSize();		}
+		public:
+			size_t FindKeyIndex( float seconds ) const { return timeline.FindKeyIndex( seconds ); }
+		public:
+			/// <summary>
+			/// Writes the components of a key into the arrays that have GetBoneCount() elements.
+			/// </summary>
+			void Sample( size_t keyIndex, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const;
+			/// <summary>
+			/// Writes the interpolated components into the arrays that have GetBoneCount() elements.
+			/// </summary>
+			void Sample( size_t keyIndexL, size_t keyIndexR, float percent, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const;
+		private:
+			void CalcGlobalMatrices( const Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const;
+		};
+	}
+}
+
+CEREAL_CLASS_VERSION( Donya::Model::Animation::PackedRotation,							0 )
+CEREAL_CLASS_VERSION( Donya::Model::Animation::CompressedTrack<Donya::Vector3>,			0 )
+CEREAL_CLASS_VERSION( Donya::Model::Animation::CompressedTrack<Donya::Model::Animation::PackedRotation>, 0 )
+CEREAL_CLASS_VERSION( Donya::Model::Animation::CompressedMotion,						0 )
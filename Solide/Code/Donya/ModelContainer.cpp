@@ -0,0 +1,710 @@
+#include "ModelContainer.h"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <Windows.h>
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Model
+	{
+		namespace Container
+		{
+			// The arrays that are referred in place must have the same layout as the file.
+			static_assert( sizeof( Vertex::Pos  ) == sizeof( float ) * 6,						"The layout of Vertex::Pos was changed!"	);
+			static_assert( sizeof( Vertex::Tex  ) == sizeof( float ) * 2,						"The layout of Vertex::Tex was changed!"	);
+			static_assert( sizeof( Vertex::Bone ) == sizeof( float ) * 4 + sizeof( int ) * 4,	"The layout of Vertex::Bone was changed!"	);
+			static_assert( sizeof( Animation::PackedRotation ) == sizeof( std::uint16_t ) * 3,	"The layout of PackedRotation was changed!"	);
+			static_assert( sizeof( unsigned int ) == sizeof( std::uint32_t ),					"The index must be 32-bit!"					);
+			static_assert( std::is_standard_layout<Vertex::Pos>::value && std::is_standard_layout<Vertex::Tex>::value && std::is_standard_layout<Vertex::Bone>::value, "The vertices must be standard layout!" );
+
+			namespace
+			{
+				constexpr size_t SECTION_COUNT = scast<size_t>( SectionKind::KindCount );
+
+				constexpr std::uint64_t AlignUp( std::uint64_t size )
+				{
+					return ( size + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT;
+				}
+
+				DirectX::XMFLOAT3	ToFloat3( const Donya::Vector3 &v )		{ return DirectX::XMFLOAT3{ v.x, v.y, v.z };		}
+				DirectX::XMFLOAT4	ToFloat4( const Donya::Vector4 &v )		{ return DirectX::XMFLOAT4{ v.x, v.y, v.z, v.w };	}
+				DirectX::XMFLOAT4	ToFloat4( const Donya::Quaternion &q )	{ return DirectX::XMFLOAT4{ q.x, q.y, q.z, q.w };	}
+				DirectX::XMFLOAT4X4	ToFloat4x4( const Donya::Vector4x4 &m )	{ return scast<const DirectX::XMFLOAT4X4 &>( m );	}
+
+				/// <summary>
+				/// Appends the arrays with the alignment, and returns those ranges. The same strings are stored once.
+				/// </summary>
+				class Builder
+				{
+				private:
+					std::vector<std::uint8_t>				bytes;
+					std::unordered_map<std::string, Range>	storedStrings;
+				public:
+					/// <summary>
+					/// Returns the offset of the zero-filled area.
+					/// </summary>
+					std::uint64_t Reserve( size_t byteSize )
+					{
+						const std::uint64_t offset = AlignUp( bytes.size() );
+						bytes.resize( scast<size_t>( offset ) + byteSize, 0 );
+						return offset;
+					}
+					template<typename T>
+					Range Append( const T *pElements, size_t count )
+					{
+						Range range{};
+						range.count = count;
+						if ( !count ) { return range; }
+						// else
+
+						range.offset = Reserve( sizeof( T ) * count );
+						memcpy( bytes.data() + range.offset, pElements, sizeof( T ) * count );
+						return range;
+					}
+					template<typename T>
+					Range Append( const std::vector<T> &elements )
+					{
+						return Append( elements.data(), elements.size() );
+					}
+					Range AppendString( const std::string &str )
+					{
+						if ( str.empty() ) { return Range{}; }
+						// else
+
+						const auto found = storedStrings.find( str );
+						if ( found != storedStrings.end() ) { return found->second; }
+						// else
+
+						const Range range = Append( str.data(), str.size() );
+						storedStrings.emplace( str, range );
+						return range;
+					}
+					template<typename T>
+					void Overwrite( std::uint64_t offset, const T &value )
+					{
+						memcpy( bytes.data() + offset, &value, sizeof( T ) );
+					}
+					const std::vector<std::uint8_t> &GetBytes() const { return bytes; }
+				public:
+					TransformRecord MakeRecord( const Animation::Transform &source )
+					{
+						TransformRecord record{};
+						record.scale		= ToFloat3( source.scale		);
+						record.rotation		= ToFloat4( source.rotation		);
+						record.translation	= ToFloat3( source.translation	);
+						return record;
+					}
+					NodeRecord MakeRecord( const Animation::Node &source )
+					{
+						NodeRecord record{};
+						record.name					= AppendString( source.bone.name		);
+						record.parentName			= AppendString( source.bone.parentName	);
+						record.parentIndex			= source.bone.parentIndex;
+						record.transform			= MakeRecord( source.bone.transform			);
+						record.transformToParent	= MakeRecord( source.bone.transformToParent	);
+						record.local				= ToFloat4x4( source.local	);
+						record.global				= ToFloat4x4( source.global	);
+						return record;
+					}
+					Range AppendNodes( const std::vector<Animation::Node> &source )
+					{
+						std::vector<NodeRecord> records{};
+						records.reserve( source.size() );
+						for ( const auto &it : source )
+						{
+							records.emplace_back( MakeRecord( it ) );
+						}
+						return Append( records );
+					}
+					MaterialRecord MakeRecord( const Source::Material &source )
+					{
+						MaterialRecord record{};
+						record.color		= ToFloat4( source.color );
+						record.textureName	= AppendString( source.textureName );
+						return record;
+					}
+					SubsetRecord MakeRecord( const Source::Subset &source )
+					{
+						SubsetRecord record{};
+						record.name			= AppendString( source.name );
+						record.indexCount	= source.indexCount;
+						record.indexStart	= source.indexStart;
+						record.ambient		= MakeRecord( source.ambient	);
+						record.bump			= MakeRecord( source.bump		);
+						record.diffuse		= MakeRecord( source.diffuse	);
+						record.specular		= MakeRecord( source.specular	);
+						record.emissive		= MakeRecord( source.emissive	);
+						return record;
+					}
+					MeshRecord MakeRecord( const Source::Mesh &source )
+					{
+						std::vector<SubsetRecord> subsets{};
+						subsets.reserve( source.subsets.size() );
+						for ( const auto &it : source.subsets )
+						{
+							subsets.emplace_back( MakeRecord( it ) );
+						}
+
+						const std::vector<std::int32_t> boneIndices{ source.boneIndices.begin(), source.boneIndices.end() };
+
+						MeshRecord record{};
+						record.name				= AppendString( source.name );
+						record.boneIndex		= source.boneIndex;
+						record.boneIndices		= Append( boneIndices );
+						record.boneOffsets		= AppendNodes( source.boneOffsets );
+						record.positions		= Append( source.positions		);
+						record.texCoords		= Append( source.texCoords		);
+						record.boneInfluences	= Append( source.boneInfluences	);
+						record.indices			= Append( source.indices		);
+						record.subsets			= Append( subsets );
+						return record;
+					}
+					MotionRecord MakeRecord( const Animation::Motion &source )
+					{
+						std::vector<KeyFrameRecord> keyFrames{};
+						keyFrames.reserve( source.keyFrames.size() );
+						for ( const auto &it : source.keyFrames )
+						{
+							KeyFrameRecord keyFrame{};
+							keyFrame.seconds = it.seconds;
+							keyFrame.keyPose = AppendNodes( it.keyPose );
+							keyFrames.emplace_back( keyFrame );
+						}
+
+						MotionRecord record{};
+						record.name			= AppendString( source.name );
+						record.samplingRate	= source.samplingRate;
+						record.animSeconds	= source.animSeconds;
+						record.keyFrames	= Append( keyFrames );
+						return record;
+					}
+					template<typename Value, typename Converter>
+					Range AppendTracks( const std::vector<Animation::CompressedTrack<Value>> &source, Converter ToStored )
+					{
+						std::vector<TrackRecord> records{};
+						records.reserve( source.size() );
+						for ( const auto &it : source )
+						{
+							std::vector<decltype( ToStored( it.values.front() ) )> values{};
+							values.reserve( it.values.size() );
+							for ( const auto &value : it.values )
+							{
+								values.emplace_back( ToStored( value ) );
+							}
+
+							TrackRecord record{};
+							record.keyIndices	= Append( it.keyIndices );
+							record.values		= Append( values );
+							records.emplace_back( record );
+						}
+						return Append( records );
+					}
+					CompressedMotionRecord MakeRecord( const Animation::CompressedMotion &source )
+					{
+						auto ToStoredVector		= []( const Donya::Vector3 &v ) { return ToFloat3( v ); };
+						auto ToStoredRotation	= []( const Animation::PackedRotation &v ) { return v; };
+
+						CompressedMotionRecord record{};
+						record.name			= AppendString( source.name );
+						record.samplingRate	= source.samplingRate;
+						record.animSeconds	= source.animSeconds;
+						record.keySeconds	= Append( source.keySeconds );
+						record.scales		= AppendTracks( source.scales,			ToStoredVector		);
+						record.rotations	= AppendTracks( source.rotations,		ToStoredRotation	);
+						record.translations	= AppendTracks( source.translations,	ToStoredVector		);
+						return record;
+					}
+					CollisionRecord MakeRecord( const PolygonGroup &source )
+					{
+						std::vector<DirectX::XMFLOAT3> vertices{};
+						vertices.reserve( source.GetPackedVertices().size() );
+						for ( const auto &it : source.GetPackedVertices() )
+						{
+							vertices.emplace_back( ToFloat3( it ) );
+						}
+
+						std::vector<PolygonMaterialRecord> materials{};
+						materials.reserve( source.GetMaterials().size() );
+						for ( const auto &it : source.GetMaterials() )
+						{
+							PolygonMaterialRecord material{};
+							material.index	= it.index;
+							material.name	= AppendString( it.name );
+							materials.emplace_back( material );
+						}
+
+						const std::vector<std::int32_t> materialIds{ source.GetPackedMaterialIds().begin(), source.GetPackedMaterialIds().end() };
+
+						CollisionRecord record{};
+						record.cullMode				= scast<std::int32_t>( source.GetCullMode() );
+						record.coordinateConversion	= ToFloat4x4( source.GetCoordinateConversion() );
+						record.vertices				= Append( vertices		);
+						record.materialIds			= Append( materialIds	);
+						record.materials			= Append( materials		);
+						return record;
+					}
+				};
+
+				template<typename Record, typename SourceElement>
+				Range AppendRecords( Builder *pBuilder, const std::vector<SourceElement> &source )
+				{
+					std::vector<Record> records{};
+					records.reserve( source.size() );
+					for ( const auto &it : source )
+					{
+						records.emplace_back( pBuilder->MakeRecord( it ) );
+					}
+					return pBuilder->Append( records );
+				}
+			}
+
+			bool Write( const std::string &filePath, const Source &source, const PolygonGroup *pPolygonGroup )
+			{
+				Builder builder{};
+
+				// The header and the sections are overwritten after appending all records.
+				const std::uint64_t headerOffset	= builder.Reserve( sizeof( Header ) );
+				const std::uint64_t sectionOffset	= builder.Reserve( sizeof( Section ) * SECTION_COUNT );
+
+				std::vector<Section> sections( SECTION_COUNT );
+				auto Assign = [&sections]( SectionKind kind, std::uint32_t recordSize, const Range &records )
+				{
+					Section &section	= sections[scast<size_t>( kind )];
+					section.kind		= kind;
+					section.recordSize	= recordSize;
+					section.records		= records;
+				};
+
+				Assign( SectionKind::Meshes,			sizeof( MeshRecord				), AppendRecords<MeshRecord>			( &builder, source.meshes				) );
+				Assign( SectionKind::Skeleton,			sizeof( NodeRecord				), builder.AppendNodes( source.skeletal ) );
+				Assign( SectionKind::Motions,			sizeof( MotionRecord			), AppendRecords<MotionRecord>			( &builder, source.motions				) );
+				Assign( SectionKind::CompressedMotions,	sizeof( CompressedMotionRecord	), AppendRecords<CompressedMotionRecord>( &builder, source.compressedMotions	) );
+
+				std::vector<CollisionRecord> collisions{};
+				if ( pPolygonGroup && pPolygonGroup->GetPolygonCount() )
+				{
+					collisions.emplace_back( builder.MakeRecord( *pPolygonGroup ) );
+				}
+				Assign( SectionKind::Collision,			sizeof( CollisionRecord			), builder.Append( collisions ) );
+
+				// Make the file size to be aligned, so the last array can be read by the aligned loads.
+				builder.Reserve( 0 );
+
+				Header header{};
+				header.fileSize					= builder.GetBytes().size();
+				header.sectionCount				= scast<std::uint32_t>( SECTION_COUNT );
+				header.sections.offset			= sectionOffset;
+				header.sections.count			= SECTION_COUNT;
+				header.coordinateConversion		= ToFloat4x4( source.coordinateConversion );
+				builder.Overwrite( headerOffset, header );
+				for ( size_t i = 0; i < SECTION_COUNT; ++i )
+				{
+					builder.Overwrite( sectionOffset + sizeof( Section ) * i, sections[i] );
+				}
+
+				std::ofstream ofs{ filePath, std::ios::out | std::ios::binary | std::ios::trunc };
+				if ( !ofs ) { return false; }
+				// else
+
+				const auto &bytes = builder.GetBytes();
+				ofs.write( reinterpret_cast<const char *>( bytes.data() ), scast<std::streamsize>( bytes.size() ) );
+				return ofs.good();
+			}
+
+			MappedModel::~MappedModel()
+			{
+				Close();
+			}
+
+			bool MappedModel::Open( const std::string &filePath )
+			{
+				Close();
+
+				HANDLE file = CreateFileA( filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+				if ( file == INVALID_HANDLE_VALUE ) { return false; }
+				// else
+				hFile = file;
+
+				LARGE_INTEGER size{};
+				if ( !GetFileSizeEx( file, &size ) || size.QuadPart < scast<LONGLONG>( sizeof( Header ) ) )
+				{
+					Close();
+					return false;
+				}
+				// else
+				fileSize = scast<size_t>( size.QuadPart );
+
+				hMapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+				if ( !hMapping ) { Close(); return false; }
+				// else
+
+				// The mapped address is aligned by the allocation granularity(64KB), so the aligned offsets are also aligned in the memory.
+				pBase = scast<const std::uint8_t *>( MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 ) );
+				if ( !pBase ) { Close(); return false; }
+				// else
+
+				pHeader = reinterpret_cast<const Header *>( pBase );
+				if ( !Validate() ) { Close(); return false; }
+				// else
+
+				return true;
+			}
+			void MappedModel::Close()
+			{
+				if ( pBase		) { UnmapViewOfFile( pBase );	}
+				if ( hMapping	) { CloseHandle( hMapping );	}
+				if ( hFile		) { CloseHandle( hFile );		}
+
+				hFile		= nullptr;
+				hMapping	= nullptr;
+				pBase		= nullptr;
+				fileSize	= 0;
+				pHeader		= nullptr;
+				for ( auto &it : pSections ) { it = nullptr; }
+			}
+
+			size_t		MappedModel::GetMeshCount() const
+			{
+				return GetRecords<MeshRecord>( SectionKind::Meshes ).size();
+			}
+			MeshView	MappedModel::GetMesh( size_t meshIndex ) const
+			{
+				const auto &record = GetRecords<MeshRecord>( SectionKind::Meshes )[meshIndex];
+
+				MeshView view{};
+				view.pRecord		= &record;
+				view.positions		= View<Vertex::Pos>		( record.positions		);
+				view.texCoords		= View<Vertex::Tex>		( record.texCoords		);
+				view.boneInfluences	= View<Vertex::Bone>	( record.boneInfluences	);
+				view.indices		= View<std::uint32_t>	( record.indices		);
+				return view;
+			}
+
+			bool MappedModel::BuildSource( Source *pOutput ) const
+			{
+				if ( !IsOpened() || !pOutput ) { return false; }
+				// else
+
+				auto ToTransform = []( const TransformRecord &record )
+				{
+					Animation::Transform transform{};
+					transform.scale			= Donya::Vector3{ record.scale };
+					transform.rotation		= Donya::Quaternion{ record.rotation.x, record.rotation.y, record.rotation.z, record.rotation.w };
+					transform.translation	= Donya::Vector3{ record.translation };
+					return transform;
+				};
+				auto ToNodes = [&]( const Range &range )
+				{
+					const auto records = View<NodeRecord>( range );
+
+					std::vector<Animation::Node> nodes( records.size() );
+					for ( size_t i = 0; i < records.size(); ++i )
+					{
+						const NodeRecord &record = records[i];
+						Animation::Node  &node   = nodes[i];
+						node.bone.name				= ToString( record.name );
+						node.bone.parentName		= ToString( record.parentName );
+						node.bone.parentIndex		= record.parentIndex;
+						node.bone.transform			= ToTransform( record.transform );
+						node.bone.transformToParent	= ToTransform( record.transformToParent );
+						node.local					= record.local;
+						node.global					= record.global;
+					}
+					return nodes;
+				};
+				auto ToMaterial = [&]( const MaterialRecord &record )
+				{
+					Source::Material material{};
+					material.color			= Donya::Vector4{ record.color };
+					material.textureName	= ToString( record.textureName );
+					return material;
+				};
+				auto Copy = []( const auto &view, auto *pDestination )
+				{
+					pDestination->assign( view.begin(), view.end() );
+				};
+
+				Source &source = *pOutput;
+				source = Source{};
+				source.coordinateConversion = pHeader->coordinateConversion;
+
+				const auto meshRecords = GetRecords<MeshRecord>( SectionKind::Meshes );
+				source.meshes.resize( meshRecords.size() );
+				for ( size_t i = 0; i < meshRecords.size(); ++i )
+				{
+					const MeshRecord &record	= meshRecords[i];
+					const MeshView   view		= GetMesh( i );
+					Source::Mesh     &mesh		= source.meshes[i];
+
+					mesh.name		= ToString( record.name );
+					mesh.boneIndex	= record.boneIndex;
+					Copy( View<std::int32_t>( record.boneIndices ), &mesh.boneIndices );
+					mesh.boneOffsets = ToNodes( record.boneOffsets );
+					Copy( view.positions,		&mesh.positions			);
+					Copy( view.texCoords,		&mesh.texCoords			);
+					Copy( view.boneInfluences,	&mesh.boneInfluences	);
+					Copy( view.indices,			&mesh.indices			);
+
+					const auto subsetRecords = View<SubsetRecord>( record.subsets );
+					mesh.subsets.resize( subsetRecords.size() );
+					for ( size_t s = 0; s < subsetRecords.size(); ++s )
+					{
+						const SubsetRecord	&subsetRecord	= subsetRecords[s];
+						Source::Subset		&subset			= mesh.subsets[s];
+						subset.name			= ToString( subsetRecord.name );
+						subset.indexCount	= subsetRecord.indexCount;
+						subset.indexStart	= subsetRecord.indexStart;
+						subset.ambient		= ToMaterial( subsetRecord.ambient	);
+						subset.bump			= ToMaterial( subsetRecord.bump		);
+						subset.diffuse		= ToMaterial( subsetRecord.diffuse	);
+						subset.specular		= ToMaterial( subsetRecord.specular	);
+						subset.emissive		= ToMaterial( subsetRecord.emissive	);
+					}
+				}
+
+				source.skeletal = ToNodes( pSections[scast<size_t>( SectionKind::Skeleton )]->records );
+
+				const auto motionRecords = GetRecords<MotionRecord>( SectionKind::Motions );
+				source.motions.resize( motionRecords.size() );
+				for ( size_t i = 0; i < motionRecords.size(); ++i )
+				{
+					const MotionRecord	&record	= motionRecords[i];
+					Animation::Motion	&motion	= source.motions[i];
+					motion.name			= ToString( record.name );
+					motion.samplingRate	= record.samplingRate;
+					motion.animSeconds	= record.animSeconds;
+
+					const auto keyFrameRecords = View<KeyFrameRecord>( record.keyFrames );
+					motion.keyFrames.resize( keyFrameRecords.size() );
+					for ( size_t k = 0; k < keyFrameRecords.size(); ++k )
+					{
+						motion.keyFrames[k].seconds	= keyFrameRecords[k].seconds;
+						motion.keyFrames[k].keyPose	= ToNodes( keyFrameRecords[k].keyPose );
+					}
+				}
+
+				auto ToVector3Tracks = [&]( const Range &range )
+				{
+					const auto records = View<TrackRecord>( range );
+					std::vector<Animation::CompressedTrack<Donya::Vector3>> tracks( records.size() );
+					for ( size_t i = 0; i < records.size(); ++i )
+					{
+						Copy( View<std::uint16_t>		( records[i].keyIndices	), &tracks[i].keyIndices	);
+						Copy( View<DirectX::XMFLOAT3>	( records[i].values		), &tracks[i].values		);
+					}
+					return tracks;
+				};
+				auto ToRotationTracks = [&]( const Range &range )
+				{
+					const auto records = View<TrackRecord>( range );
+					std::vector<Animation::CompressedTrack<Animation::PackedRotation>> tracks( records.size() );
+					for ( size_t i = 0; i < records.size(); ++i )
+					{
+						Copy( View<std::uint16_t>				( records[i].keyIndices	), &tracks[i].keyIndices	);
+						Copy( View<Animation::PackedRotation>	( records[i].values		), &tracks[i].values		);
+					}
+					return tracks;
+				};
+
+				const auto compressedRecords = GetRecords<CompressedMotionRecord>( SectionKind::CompressedMotions );
+				source.compressedMotions.resize( compressedRecords.size() );
+				for ( size_t i = 0; i < compressedRecords.size(); ++i )
+				{
+					const CompressedMotionRecord	&record	= compressedRecords[i];
+					Animation::CompressedMotion		&motion	= source.compressedMotions[i];
+					motion.name			= ToString( record.name );
+					motion.samplingRate	= record.samplingRate;
+					motion.animSeconds	= record.animSeconds;
+					Copy( View<float>( record.keySeconds ), &motion.keySeconds );
+					motion.scales		= ToVector3Tracks	( record.scales			);
+					motion.rotations	= ToRotationTracks	( record.rotations		);
+					motion.translations	= ToVector3Tracks	( record.translations	);
+				}
+
+				return true;
+			}
+			bool MappedModel::BuildPolygonGroup( PolygonGroup *pOutput ) const
+			{
+				if ( !IsOpened() || !pOutput ) { return false; }
+				// else
+
+				const auto collisions = GetRecords<CollisionRecord>( SectionKind::Collision );
+				if ( collisions.empty() ) { return false; }
+				// else
+
+				const CollisionRecord &record = collisions[0];
+
+				const auto vertexView = View<DirectX::XMFLOAT3>( record.vertices );
+				std::vector<Donya::Vector3> vertices{ vertexView.begin(), vertexView.end() };
+
+				const auto idView = View<std::int32_t>( record.materialIds );
+				std::vector<int> materialIds{ idView.begin(), idView.end() };
+
+				const auto materialRecords = View<PolygonMaterialRecord>( record.materials );
+				std::vector<PolygonMaterial> materials( materialRecords.size() );
+				for ( size_t i = 0; i < materialRecords.size(); ++i )
+				{
+					materials[i].index	= materialRecords[i].index;
+					materials[i].name	= ToString( materialRecords[i].name );
+				}
+
+				pOutput->AssignPacked
+				(
+					scast<PolygonGroup::CullMode>( record.cullMode ),
+					Donya::Vector4x4{ record.coordinateConversion },
+					std::move( vertices ),
+					std::move( materialIds ),
+					std::move( materials )
+				);
+				return true;
+			}
+
+			bool MappedModel::Validate()
+			{
+				if ( pHeader->magic		!= MAGIC		) { return false; }
+				if ( pHeader->version	!= VERSION		) { return false; }
+				if ( pHeader->alignment	!= ALIGNMENT	) { return false; }
+				if ( pHeader->fileSize	!= fileSize		) { return false; }
+				// else
+
+				auto IsValid = [&]( const Range &range, size_t elementSize )
+				{
+					if ( !range.count ) { return true; }
+					// else
+					if ( range.offset % ALIGNMENT ) { return false; }
+					if ( fileSize <= range.offset ) { return false; }
+					// else
+					const std::uint64_t remain = fileSize - range.offset;
+					return ( range.count <= remain / elementSize );
+				};
+
+				if ( pHeader->sectionCount != SECTION_COUNT || !IsValid( pHeader->sections, sizeof( Section ) ) || pHeader->sections.count != SECTION_COUNT ) { return false; }
+				// else
+
+				// Assign the sections before the validation of the records, because the validation uses those.
+				const Section *pTable = reinterpret_cast<const Section *>( pBase + pHeader->sections.offset );
+				for ( size_t i = 0; i < SECTION_COUNT; ++i )
+				{
+					const Section &section = pTable[i];
+					if ( scast<size_t>( section.kind ) != i ) { return false; }
+					// else
+					pSections[i] = &section;
+				}
+
+				auto IsValidSection = [&]( SectionKind kind, size_t recordSize )
+				{
+					const Section &section = *pSections[scast<size_t>( kind )];
+					return ( section.recordSize == recordSize && IsValid( section.records, recordSize ) );
+				};
+				if ( !IsValidSection( SectionKind::Meshes,				sizeof( MeshRecord				) ) ) { return false; }
+				if ( !IsValidSection( SectionKind::Skeleton,			sizeof( NodeRecord				) ) ) { return false; }
+				if ( !IsValidSection( SectionKind::Motions,				sizeof( MotionRecord			) ) ) { return false; }
+				if ( !IsValidSection( SectionKind::CompressedMotions,	sizeof( CompressedMotionRecord	) ) ) { return false; }
+				if ( !IsValidSection( SectionKind::Collision,			sizeof( CollisionRecord			) ) ) { return false; }
+				// else
+
+				auto IsValidNodes = [&]( const Range &range )
+				{
+					if ( !IsValid( range, sizeof( NodeRecord ) ) ) { return false; }
+					// else
+					for ( const auto &it : View<NodeRecord>( range ) )
+					{
+						if ( !IsValid( it.name, 1 ) || !IsValid( it.parentName, 1 ) ) { return false; }
+					}
+					return true;
+				};
+				auto IsValidMaterial = [&]( const MaterialRecord &record )
+				{
+					return IsValid( record.textureName, 1 );
+				};
+
+				for ( const auto &mesh : GetRecords<MeshRecord>( SectionKind::Meshes ) )
+				{
+					if ( !IsValid( mesh.name,			1						) ) { return false; }
+					if ( !IsValid( mesh.boneIndices,	sizeof( std::int32_t )	) ) { return false; }
+					if ( !IsValidNodes( mesh.boneOffsets ) ) { return false; }
+					if ( !IsValid( mesh.positions,		sizeof( Vertex::Pos )	) ) { return false; }
+					if ( !IsValid( mesh.texCoords,		sizeof( Vertex::Tex )	) ) { return false; }
+					if ( !IsValid( mesh.boneInfluences,	sizeof( Vertex::Bone )	) ) { return false; }
+					if ( !IsValid( mesh.indices,		sizeof( std::uint32_t )	) ) { return false; }
+					if ( !IsValid( mesh.subsets,		sizeof( SubsetRecord )	) ) { return false; }
+					// else
+
+					for ( const auto &subset : View<SubsetRecord>( mesh.subsets ) )
+					{
+						if ( !IsValid( subset.name, 1 ) ) { return false; }
+						if ( !IsValidMaterial( subset.ambient ) || !IsValidMaterial( subset.bump ) || !IsValidMaterial( subset.diffuse ) || !IsValidMaterial( subset.specular ) || !IsValidMaterial( subset.emissive ) ) { return false; }
+					}
+				}
+
+				if ( !IsValidNodes( pSections[scast<size_t>( SectionKind::Skeleton )]->records ) ) { return false; }
+				// else
+
+				for ( const auto &motion : GetRecords<MotionRecord>( SectionKind::Motions ) )
+				{
+					if ( !IsValid( motion.name, 1 ) || !IsValid( motion.keyFrames, sizeof( KeyFrameRecord ) ) ) { return false; }
+					// else
+					for ( const auto &keyFrame : View<KeyFrameRecord>( motion.keyFrames ) )
+					{
+						if ( !IsValidNodes( keyFrame.keyPose ) ) { return false; }
+					}
+				}
+
+				auto IsValidTracks = [&]( const Range &range, size_t valueSize )
+				{
+					if ( !IsValid( range, sizeof( TrackRecord ) ) ) { return false; }
+					// else
+					for ( const auto &it : View<TrackRecord>( range ) )
+					{
+						if ( !IsValid( it.keyIndices, sizeof( std::uint16_t ) ) || !IsValid( it.values, valueSize ) ) { return false; }
+					}
+					return true;
+				};
+				for ( const auto &motion : GetRecords<CompressedMotionRecord>( SectionKind::CompressedMotions ) )
+				{
+					if ( !IsValid( motion.name, 1 ) || !IsValid( motion.keySeconds, sizeof( float ) ) ) { return false; }
+					if ( !IsValidTracks( motion.scales,			sizeof( DirectX::XMFLOAT3 )				) ) { return false; }
+					if ( !IsValidTracks( motion.rotations,		sizeof( Animation::PackedRotation )		) ) { return false; }
+					if ( !IsValidTracks( motion.translations,	sizeof( DirectX::XMFLOAT3 )				) ) { return false; }
+				}
+
+				for ( const auto &collision : GetRecords<CollisionRecord>( SectionKind::Collision ) )
+				{
+					if ( !IsValid( collision.vertices,		sizeof( DirectX::XMFLOAT3 )		) ) { return false; }
+					if ( !IsValid( collision.materialIds,	sizeof( std::int32_t )			) ) { return false; }
+					if ( !IsValid( collision.materials,		sizeof( PolygonMaterialRecord )	) ) { return false; }
+					if ( collision.vertices.count != collision.materialIds.count * 3U ) { return false; }
+					if ( collision.cullMode != scast<std::int32_t>( PolygonGroup::CullMode::Back ) && collision.cullMode != scast<std::int32_t>( PolygonGroup::CullMode::Front ) ) { return false; }
+					// else
+					for ( const auto &material : View<PolygonMaterialRecord>( collision.materials ) )
+					{
+						if ( !IsValid( material.name, 1 ) ) { return false; }
+					}
+				}
+
+				return true;
+			}
+			template<typename T>
+			ArrayView<T> MappedModel::GetRecords( SectionKind kind ) const
+			{
+				const Section *pSection = pSections[scast<size_t>( kind )];
+				if ( !pSection ) { return ArrayView<T>{}; }
+				// else
+				return View<T>( pSection->records );
+			}
+			std::string MappedModel::ToString( const Range &range ) const
+			{
+				if ( !range.count ) { return std::string{}; }
+				// else
+				return std::string{ reinterpret_cast<const char *>( pBase + range.offset ), scast<size_t>( range.count ) };
+			}
+		}
+	}
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <DirectXMath.h>
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#include "ModelCommon.h"
+#include "ModelPolygon.h"
+#include "ModelSource.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		/// <summary>
+		/// The binary container of a model that is used by mapping the file to memory.<para></para>
+		/// The file is: Header, the table of Section, then the records and the arrays that are referred by the offsets from the head of file.
+		/// Every array begins at a multiple of ALIGNMENT, so the arrays of vertices and indices can be referred in place without parsing.
+		/// The byte order is little endian.
+		/// </summary>
+		namespace Container
+		{
+			constexpr std::uint32_t	MAGIC		= 0x4C444D44;	// "DMDL".
+			constexpr std::uint32_t	VERSION		= 1;
+			constexpr std::uint64_t	ALIGNMENT	= 16;
+			constexpr const char	*EXTENSION	= ".dmdl";
+
+			// The structures in the file. Those must not contain any pointer.
+
+			/// <summary>
+			/// The "count" elements that begin at "offset" bytes from the head of file.
+			/// </summary>
+			struct Range
+			{
+				std::uint64_t offset	= 0;
+				std::uint64_t count		= 0;
+			};
+			enum class SectionKind : std::uint32_t
+			{
+				Meshes,				// MeshRecord[].
+				Skeleton,			// NodeRecord[].
+				Motions,			// MotionRecord[].
+				CompressedMotions,	// CompressedMotionRecord[].
+				Collision,			// CollisionRecord[0 or 1].
+
+				KindCount
+			};
+			struct Section
+			{
+				SectionKind		kind		= SectionKind::KindCount;
+				std::uint32_t	recordSize	= 0;	// The sizeof() of the record. Used for validation.
+				Range			records;
+			};
+			struct Header
+			{
+				std::uint32_t			magic			= MAGIC;
+				std::uint32_t			version			= VERSION;
+				std::uint64_t			fileSize		= 0;
+				std::uint32_t			sectionCount	= 0;
+				std::uint32_t			alignment		= scast<std::uint32_t>( ALIGNMENT );
+				Range					sections;		// Section[].
+				DirectX::XMFLOAT4X4		coordinateConversion;
+			};
+
+			struct TransformRecord
+			{
+				DirectX::XMFLOAT3	scale;
+				DirectX::XMFLOAT4	rotation;
+				DirectX::XMFLOAT3	translation;
+			};
+			struct NodeRecord
+			{
+				Range				name;			// char[], not terminated by null.
+				Range				parentName;		// char[].
+				std::int32_t		parentIndex		= -1;
+				TransformRecord		transform;
+				TransformRecord		transformToParent;
+				DirectX::XMFLOAT4X4	local;
+				DirectX::XMFLOAT4X4	global;
+			};
+			struct MaterialRecord
+			{
+				DirectX::XMFLOAT4	color;
+				Range				textureName;	// char[].
+			};
+			struct SubsetRecord
+			{
+				Range				name;			// char[].
+				std::uint32_t		indexCount		= 0;
+				std::uint32_t		indexStart		= 0;
+				MaterialRecord		ambient;
+				MaterialRecord		bump;
+				MaterialRecord		diffuse;
+				MaterialRecord		specular;
+				MaterialRecord		emissive;
+			};
+			struct MeshRecord
+			{
+				Range				name;			// char[].
+				std::int32_t		boneIndex		= 0;
+				Range				boneIndices;	// std::int32_t[].
+				Range				boneOffsets;	// NodeRecord[].
+				Range				positions;		// Vertex::Pos[].
+				Range				texCoords;		// Vertex::Tex[].
+				Range				boneInfluences;	// Vertex::Bone[].
+				Range				indices;		// std::uint32_t[].
+				Range				subsets;		// SubsetRecord[].
+			};
+			struct KeyFrameRecord
+			{
+				float				seconds			= 0.0f;
+				Range				keyPose;		// NodeRecord[].
+			};
+			struct MotionRecord
+			{
+				Range				name;			// char[].
+				float				samplingRate	= 0.0f;
+				float				animSeconds		= 0.0f;
+				Range				keyFrames;		// KeyFrameRecord[].
+			};
+			struct TrackRecord
+			{
+				Range				keyIndices;		// std::uint16_t[].
+				Range				values;			// DirectX::XMFLOAT3[] or Animation::PackedRotation[].
+			};
+			struct CompressedMotionRecord
+			{
+				Range				name;			// char[].
+				float				samplingRate	= 0.0f;
+				float				animSeconds		= 0.0f;
+				Range				keySeconds;		// float[].
+				Range				scales;			// TrackRecord[] of DirectX::XMFLOAT3.
+				Range				rotations;		// TrackRecord[] of Animation::PackedRotation.
+				Range				translations;	// TrackRecord[] of DirectX::XMFLOAT3.
+			};
+			struct PolygonMaterialRecord
+			{
+				std::int32_t		index			= -1;
+				Range				name;			// char[].
+			};
+			struct CollisionRecord
+			{
+				std::int32_t		cullMode		= 0;
+				DirectX::XMFLOAT4X4	coordinateConversion;
+				Range				vertices;		// DirectX::XMFLOAT3[].
+				Range				materialIds;	// std::int32_t[].
+				Range				materials;		// PolygonMaterialRecord[].
+			};
+
+			/// <summary>
+			/// The elements in the mapped memory. This does not own those.
+			/// </summary>
+			template<typename T>
+			struct ArrayView
+			{
+				const T	*pData	= nullptr;
+				size_t	count	= 0;
+			public:
+				const T	*begin()	const { return pData;			}
+				const T	*end()		const { return pData + count;	}
+				size_t	size()		const { return count;			}
+				bool	empty()		const { return count == 0;		}
+				const T	&operator[]( size_t index ) const { return pData[index]; }
+			};
+
+			/// <summary>
+			/// The arrays of a mesh in the mapped memory. The vertices and the indices can be passed to the GPU as it is.
+			/// </summary>
+			struct MeshView
+			{
+				const MeshRecord			*pRecord = nullptr;
+				ArrayView<Vertex::Pos>		positions;
+				ArrayView<Vertex::Tex>		texCoords;
+				ArrayView<Vertex::Bone>		boneInfluences;
+				ArrayView<std::uint32_t>	indices;
+			};
+
+			/// <summary>
+			/// Writes the source and the polygons as a container file. The "pPolygonGroup" can be nullptr if the model does not have the collision.
+			/// </summary>
+			bool Write( const std::string &filePath, const Source &source, const PolygonGroup *pPolygonGroup );
+
+			/// <summary>
+			/// Maps a container file as read only. All ranges are validated at the opening, so the views refer to the mapped memory directly.<para></para>
+			/// The views are valid while this is opened.
+			/// </summary>
+			class MappedModel
+			{
+			private:
+				void				*hFile		= nullptr;
+				void				*hMapping	= nullptr;
+				const std::uint8_t	*pBase		= nullptr;
+				size_t				fileSize	= 0;
+				const Header		*pHeader	= nullptr;
+				const Section		*pSections[scast<size_t>( SectionKind::KindCount )]{};
+			public:
+				MappedModel() = default;
+				~MappedModel();
+				MappedModel( const MappedModel & )				= delete;
+				MappedModel &operator = ( const MappedModel & )	= delete;
+			public:
+				/// <summary>
+				/// Returns false if the file is not found or is not a valid container. Then this is closed.
+				/// </summary>
+				bool Open( const std::string &filePath );
+				void Close();
+				bool IsOpened() const { return pHeader != nullptr; }
+			public:
+				size_t		GetMeshCount() const;
+				/// <summary>
+				/// Requires the "meshIndex" is less than GetMeshCount().
+				/// </summary>
+				MeshView	GetMesh( size_t meshIndex ) const;
+			public:
+				/// <summary>
+				/// Builds the Source. The arrays of plain data are copied at once, the records that have the strings are converted per element.
+				/// </summary>
+				bool BuildSource( Source *pOutput ) const;
+				/// <summary>
+				/// Returns false if the file does not have the collision.
+				/// </summary>
+				bool BuildPolygonGroup( PolygonGroup *pOutput ) const;
+			private:
+				/// <summary>
+				/// Also assigns the sections.
+				/// </summary>
+				bool Validate();
+				template<typename T>
+				ArrayView<T> GetRecords( SectionKind kind ) const;
+				template<typename T>
+				ArrayView<T> View( const Range &range ) const
+				{
+					// The range was validated at the opening. The offset of empty range is not validated.
+					if ( !range.count ) { return ArrayView<T>{}; }
+					// else
+					return ArrayView<T>{ reinterpret_cast<const T *>( pBase + range.offset ), scast<size_t>( range.count ) };
+				}
+				std::string ToString( const Range &range ) const;
+			};
+		}
+	}
+}
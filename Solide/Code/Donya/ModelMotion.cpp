@@ -1,10 +1,19 @@
 #include "ModelMotion.h"
 
+#include <algorithm>
 #include <numeric>			// Use std::accumulate.
 
+#if USE_IMGUI
+#include "Donya/Benchmark.h"
+#include "Donya/Random.h"
+#endif // USE_IMGUI
+
 #include "Donya/Constant.h"	// Use scast macro.
 #include "Donya/Useful.h"	// Use EPSILON constant, and ZeroEqual().
 
+#undef max
+#undef min
+
 namespace Donya
 {
 	namespace Model
@@ -51,6 +60,10 @@ namespace Donya
 		{
 			return motions.size();
 		}
+		const std::shared_ptr<const Skeleton> &MotionHolder::GetSkeleton() const
+		{
+			return pSkeleton;
+		}
 		bool MotionHolder::IsOutOfRange( int motionIndex ) const
 		{
 			if ( motionIndex < 0 ) { return true; }
@@ -60,7 +73,7 @@ namespace Donya
 			return false;
 		}
 
-		const Animation::Motion &MotionHolder::GetMotion( int motionIndex ) const
+		const MotionClip &MotionHolder::GetMotion( int motionIndex ) const
 		{
 			_ASSERT_EXPR( motionIndex < scast<int>( motions.size() ), L"Error : Passed index out of range!" );
 			return motions[motionIndex];
@@ -70,7 +83,7 @@ namespace Donya
 			const size_t motionCount = motions.size();
 			for ( size_t i = 0; i < motionCount; ++i )
 			{
-				if ( motions[i].name == motionName )
+				if ( motions[i].GetName() == motionName )
 				{
 					return i;
 				}
@@ -89,7 +102,7 @@ namespace Donya
 		{
 			for ( auto &&it = motions.begin(); it != motions.end(); ++it )
 			{
-				if ( it->name == motionName )
+				if ( it->GetName() == motionName )
 				{
 					// Erases only once.
 					motions.erase( it );
@@ -100,14 +113,48 @@ namespace Donya
 
 		void MotionHolder::AppendSource( const Source &source )
 		{
+			if ( !source.skeletal.empty() && ( !pSkeleton || !pSkeleton->IsCompatibleWith( source.skeletal ) ) )
+			{
+				pSkeleton = std::make_shared<const Skeleton>( source.skeletal );
+			}
+
 			for ( const auto &it : source.motions )
 			{
 				AppendMotion( it );
 			}
+			for ( const auto &it : source.compressedMotions )
+			{
+				AppendMotion( it );
+			}
 		}
 		void MotionHolder::AppendMotion( const Animation::Motion &element )
 		{
-			motions.emplace_back( element );
+			if ( !element.keyFrames.empty() )
+			{
+				const auto &keyPose = element.keyFrames.front().keyPose;
+				if ( !pSkeleton || !pSkeleton->IsCompatibleWith( keyPose ) )
+				{
+					pSkeleton = std::make_shared<const Skeleton>( keyPose );
+				}
+			}
+			else if ( !pSkeleton )
+			{
+				pSkeleton = std::make_shared<const Skeleton>();
+			}
+
+			motions.emplace_back( element, pSkeleton );
+		}
+		void MotionHolder::AppendMotion( const Animation::CompressedMotion &element )
+		{
+			// The compressed motion does not have the bone names, so it can not make a skeleton.
+			if ( !pSkeleton || pSkeleton->GetBoneCount() != element.GetBoneCount() )
+			{
+				_ASSERT_EXPR( 0, L"Error : The compressed motion is not compatible with the skeleton!" );
+				return;
+			}
+			// else
+
+			motions.emplace_back( CompressedClip{ element, pSkeleton } );
 		}
 
 
@@ -141,6 +188,16 @@ namespace Donya
 		{
 			return IsOverPlaybackTimeOf( motion.keyFrames );
 		}
+		bool  Animator::IsOverPlaybackTimeOf( const MotionClip &motion ) const
+		{
+			const float lastTime = ( motion.IsEmpty() ) ? 0.0f : motion.GetWholeSeconds();
+			return ( lastTime <= elapsedTime );
+		}
+		bool  Animator::IsOverPlaybackTimeOf( const CompressedClip &motion ) const
+		{
+			const float lastTime = ( motion.IsEmpty() ) ? 0.0f : motion.GetWholeSeconds();
+			return ( lastTime <= elapsedTime );
+		}
 
 		Animation::KeyFrame Animator::CalcCurrentPose( const std::vector<Animation::KeyFrame> &motion ) const
 		{
@@ -150,31 +207,6 @@ namespace Donya
 
 			const float wholeSeconds = CalcWholeSeconds( motion );
 
-			auto  CalcCurrentSeconds = [&]()
-			{
-				float sec =  elapsedTime;
-				if ( 0.0f <= sec ) { return sec; } // Positive value is ok.
-				// else
-
-				if ( enableRepeat )
-				{
-					// Consider as now playing to reverse.
-					// The seconds to be relative time from last time("repeatRangeR").
-
-					const float distance = repeatRangeR - repeatRangeL;
-					sec = fmodf( sec, distance );
-
-					sec = repeatRangeR - fabsf( sec );
-				}
-				else
-				{
-					// We can not usable the negative value.
-					sec = 0.0f;
-				}
-
-				return sec;
-			};
-
 			float currentSeconds = CalcCurrentSeconds();
 			if (  wholeSeconds  <= currentSeconds )
 			{
@@ -187,8 +219,10 @@ namespace Donya
 				// currentSeconds = fmodf( currentSeconds, wholeSeconds + CalcAverageStep( motion ) );
 			}
 
-			Animation::KeyFrame keyFrameL{}; // Current.
-			Animation::KeyFrame keyFrameR{}; // Next.
+			// Refer the key-frames instead of copying these, because the key-pose is large.
+			const Animation::KeyFrame *pKeyFrameL = nullptr; // Current.
+			const Animation::KeyFrame *pKeyFrameR = nullptr; // Next.
+			Animation::KeyFrame nextLoopFirst{};
 
 			// Find the current key-frame and next key-frame.
 			{
@@ -202,21 +236,23 @@ namespace Donya
 
 					assert( !L.keyPose.empty() && !R.keyPose.empty() );
 
-					keyFrameL = L;
-					keyFrameR = R;
+					pKeyFrameL = &L;
+					pKeyFrameR = &R;
 					break;
 				}
 
 				// When the currentSeconds is greater than wholeSeconds.
-				if ( keyFrameL.keyPose.empty() || keyFrameR.keyPose.empty() )
+				if ( !pKeyFrameL || !pKeyFrameR )
 				{
-					Animation::KeyFrame nextLoopFirst = motion.front();
+					nextLoopFirst = motion.front();
 					nextLoopFirst.seconds = wholeSeconds + CalcAverageStep( motion );
 
-					keyFrameL = motion.back();
-					keyFrameR = std::move( nextLoopFirst );
+					pKeyFrameL = &motion.back();
+					pKeyFrameR = &nextLoopFirst;
 				}
 			}
+			const Animation::KeyFrame &keyFrameL = *pKeyFrameL;
+			const Animation::KeyFrame &keyFrameR = *pKeyFrameR;
 
 			const float diffL	= currentSeconds    - keyFrameL.seconds;
 			const float diffR	= keyFrameR.seconds - keyFrameL.seconds;
@@ -228,6 +264,76 @@ namespace Donya
 		{
 			return CalcCurrentPose( motion.keyFrames );
 		}
+		void Animator::CalcCurrentPose( const MotionClip &motion, Pose *pDest ) const
+		{
+			CalcCurrentPoseImpl( motion, pDest );
+		}
+		void Animator::CalcCurrentPose( const CompressedClip &motion, Pose *pDest ) const
+		{
+			CalcCurrentPoseImpl( motion, pDest );
+		}
+		template<class Clip>
+		void Animator::CalcCurrentPoseImpl( const Clip &motion, Pose *pDest ) const
+		{
+			if ( !pDest || motion.IsEmpty() ) { return; }
+			// else
+
+			const size_t keyCount = motion.GetKeyCount();
+			if ( keyCount == 1 )
+			{
+				pDest->AssignSkeletal( motion, 0 );
+				return;
+			}
+			// else
+
+			const float wholeSeconds = motion.GetWholeSeconds();
+
+			float currentSeconds = CalcCurrentSeconds();
+			if (  wholeSeconds  <= currentSeconds )
+			{
+				if ( !enableLoop )
+				{
+					pDest->AssignSkeletal( motion, keyCount - 1 );
+					return;
+				}
+				// else
+
+				currentSeconds = fmodf( currentSeconds, wholeSeconds );
+			}
+
+			// When the current key is not found, interpolates between the last key and the first key of next loop.
+			size_t	indexL		= keyCount - 1;
+			size_t	indexR		= 0;
+			float	secondsL	= wholeSeconds;
+			float	secondsR	= wholeSeconds + motion.GetLoopStepSeconds();
+
+			const size_t foundIndex = motion.FindKeyIndex( currentSeconds );
+			if ( foundIndex < keyCount )
+			{
+				indexL		= foundIndex;
+				indexR		= foundIndex + 1;
+				secondsL	= motion.GetKeySeconds( indexL );
+				secondsR	= motion.GetKeySeconds( indexR );
+			}
+
+			const float diffL	= currentSeconds - secondsL;
+			const float diffR	= secondsR       - secondsL;
+			const float percent	= diffL / ( diffR + EPSILON /* Prevent zero-divide */ );
+
+			pDest->AssignSkeletal( motion, indexL, indexR, percent );
+		}
+
+		float Animator::CalcPlaybackSeconds( const MotionClip &motion ) const
+		{
+			if ( motion.GetKeyCount() < 2 ) { return 0.0f; }
+			// else
+
+			const float wholeSeconds	= motion.GetWholeSeconds();
+			const float currentSeconds	= CalcCurrentSeconds();
+			if ( currentSeconds < wholeSeconds ) { return currentSeconds; }
+			// else
+			return ( enableLoop ) ? fmodf( currentSeconds, wholeSeconds ) : wholeSeconds;
+		}
 
 		void  Animator::EnableLoop()
 		{
@@ -237,6 +343,10 @@ namespace Donya
 		{
 			enableLoop = false;
 		}
+		bool  Animator::IsEnableLoop() const
+		{
+			return enableLoop;
+		}
 
 		void  Animator::SetRepeatRange( float startTime, float endTime )
 		{
@@ -264,6 +374,14 @@ namespace Donya
 		{
 			SetRepeatRange( motion.keyFrames );
 		}
+		void  Animator::SetRepeatRange( const MotionClip &motion )
+		{
+			SetRepeatRange( 0.0f, motion.GetWholeSeconds() );
+		}
+		void  Animator::SetRepeatRange( const CompressedClip &motion )
+		{
+			SetRepeatRange( 0.0f, motion.GetWholeSeconds() );
+		}
 		void  Animator::ResetRepeatRange()
 		{
 			enableRepeat = false;
@@ -280,6 +398,30 @@ namespace Donya
 			return elapsedTime;
 		}
 
+		float Animator::CalcCurrentSeconds() const
+		{
+			float sec =  elapsedTime;
+			if ( 0.0f <= sec ) { return sec; } // Positive value is ok.
+			// else
+
+			if ( enableRepeat )
+			{
+				// Consider as now playing to reverse.
+				// The seconds to be relative time from last time("repeatRangeR").
+
+				const float distance = repeatRangeR - repeatRangeL;
+				sec = fmodf( sec, distance );
+
+				sec = repeatRangeR - fabsf( sec );
+			}
+			else
+			{
+				// We can not usable the negative value.
+				sec = 0.0f;
+			}
+
+			return sec;
+		}
 		void  Animator::WrapAround( float min, float max )
 		{
 			const float distance = max - min;
@@ -301,5 +443,289 @@ namespace Donya
 				if ( elapsedTime < min ) { elapsedTime = min; wasEnded = true; }
 			}
 		}
+
+	#if USE_IMGUI
+		void ShowAnimationBenchmarkNode( const std::string &nodeCaption, const MotionHolder &holder )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			struct Result
+			{
+				int		motionCount		= 0;
+				int		sampleCount		= 0;
+				int		mismatchCount	= 0;	// The count of global matrices that differ from the key-frame version.
+				int		lookupMismatch	= 0;	// The count of key indices that differ from the linear search.
+				size_t	maxKeyCount		= 0;
+				bool	reallocated		= false;
+				double	keyFrameSeconds	= 0.0;
+				double	clipSeconds		= 0.0;
+				double	linearSeconds	= 0.0;	// Key lookup only.
+				double	directSeconds	= 0.0;	// Key lookup only.
+			};
+			static Result	result{};
+			static int		sampleCount	= 1000;
+			static bool		enableLoop	= true;
+
+			ImGui::DragInt( "Sample count per motion", &sampleCount, 10.0f, 1, 100000 );
+			ImGui::Checkbox( "Enable loop", &enableLoop );
+			sampleCount = std::max( 1, sampleCount );
+
+			if ( ImGui::Button( "Measure" ) )
+			{
+				result = Result{};
+
+				Benchmark	timer{};
+				Animator	animator{};
+				Pose		keyFramePose{};
+				Pose		clipPose{};
+				std::vector<float> times( sampleCount );
+				std::vector<float> lookupTimes( sampleCount );
+
+				const size_t motionCount = holder.GetMotionCount();
+				for ( size_t m = 0; m < motionCount; ++m )
+				{
+					const MotionClip &clip = holder.GetMotion( scast<int>( m ) );
+					if ( clip.IsEmpty() ) { continue; }
+					// else
+
+					const Animation::Motion keyFrames = clip.ToMotion();
+					const float wholeSeconds = clip.GetWholeSeconds();
+					for ( auto &it : times )
+					{
+						// Contains the negative time and the over time.
+						it = Donya::Random::GenerateFloat( -0.5f, wholeSeconds * 1.5f + 0.5f );
+					}
+					for ( auto &it : lookupTimes )
+					{
+						// The lookup is done after the wrap-around.
+						it = Donya::Random::GenerateFloat( 0.0f, wholeSeconds );
+					}
+
+					if ( enableLoop ) { animator.EnableLoop();  }
+					else              { animator.DisableLoop(); }
+					animator.ResetRepeatRange();
+					if ( 0.0f < wholeSeconds ) { animator.SetRepeatRange( clip ); }
+
+					// Prepare the buffers before the measurement.
+					animator.SetInternalElapsedTime( 0.0f );
+					clipPose.AssignSkeletal( clip, 0 );
+					const Donya::Vector4x4 *pBeginBuffer = clipPose.GetGlobalMatrices().data();
+
+					timer.Begin();
+					for ( const auto &it : times )
+					{
+						animator.SetInternalElapsedTime( it );
+						keyFramePose.AssignSkeletal( animator.CalcCurrentPose( keyFrames ) );
+					}
+					result.keyFrameSeconds += timer.End();
+
+					timer.Begin();
+					for ( const auto &it : times )
+					{
+						animator.SetInternalElapsedTime( it );
+						animator.CalcCurrentPose( clip, &clipPose );
+					}
+					result.clipSeconds += timer.End();
+
+					if ( clipPose.GetGlobalMatrices().data() != pBeginBuffer ) { result.reallocated = true; }
+
+					// Measure the key lookup only, because the interpolation is dominant in the above.
+					// The sum prevents the optimization from removing the loops.
+					size_t linearSum = 0;
+					timer.Begin();
+					for ( const auto &it : lookupTimes )
+					{
+						linearSum += clip.FindKeyIndexLinearly( it );
+					}
+					result.linearSeconds += timer.End();
+
+					size_t directSum = 0;
+					timer.Begin();
+					for ( const auto &it : lookupTimes )
+					{
+						directSum += clip.FindKeyIndex( it );
+					}
+					result.directSeconds += timer.End();
+
+					if ( linearSum != directSum )
+					{
+						for ( const auto &it : lookupTimes )
+						{
+							if ( clip.FindKeyIndexLinearly( it ) != clip.FindKeyIndex( it ) ) { result.lookupMismatch++; }
+						}
+					}
+
+					for ( const auto &it : times )
+					{
+						animator.SetInternalElapsedTime( it );
+						keyFramePose.AssignSkeletal( animator.CalcCurrentPose( keyFrames ) );
+						animator.CalcCurrentPose( clip, &clipPose );
+
+						const auto &expected	= keyFramePose.GetGlobalMatrices();
+						const auto &actual		= clipPose.GetGlobalMatrices();
+						if ( expected.size() != actual.size() )
+						{
+							result.mismatchCount += scast<int>( std::max( expected.size(), actual.size() ) );
+							continue;
+						}
+						// else
+
+						for ( size_t i = 0; i < expected.size(); ++i )
+						{
+							if ( !( expected[i] == actual[i] ) ) { result.mismatchCount++; }
+						}
+					}
+
+					result.motionCount++;
+					result.sampleCount += sampleCount;
+					result.maxKeyCount = std::max( result.maxKeyCount, clip.GetKeyCount() );
+				}
+			}
+
+			if ( result.motionCount )
+			{
+				ImGui::Text( "%d motions, %d samples, max %d keys", result.motionCount, result.sampleCount, scast<int>( result.maxKeyCount ) );
+				ImGui::Text( "Mismatched matrices : %d", result.mismatchCount );
+				ImGui::Text( "Reallocated while sampling : %s", ( result.reallocated ) ? "True" : "False" );
+				ImGui::Text( "KeyFrame : %.3f[ms]", result.keyFrameSeconds * 1000.0 );
+				ImGui::Text( "Clip     : %.3f[ms]", result.clipSeconds     * 1000.0 );
+				ImGui::Text( "Key lookup mismatches : %d", result.lookupMismatch );
+				ImGui::Text( "Lookup(Linear) : %.3f[ms]", result.linearSeconds * 1000.0 );
+				ImGui::Text( "Lookup(Direct) : %.3f[ms]", result.directSeconds * 1000.0 );
+			}
+
+			ImGui::TreePop();
+		}
+		void ShowPosePropagationBenchmarkNode( const std::string &nodeCaption, const MotionHolder &holder )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			struct Result
+			{
+				int		motionCount			= 0;
+				int		sampleCount			= 0;
+				int		unorderedCount		= 0;	// The count of motions that the skeleton is not the source order. The previous calculation can not be used for those.
+				int		fullMismatch		= 0;	// The count of global matrices that differ from the previous calculation.
+				int		changedMismatch		= 0;	// The count of global matrices that differ from the full update.
+				double	referenceSeconds	= 0.0;
+				double	fullSeconds			= 0.0;
+				double	changedSeconds		= 0.0;
+			};
+			static Result	result{};
+			static int		sampleCount	= 1000;
+
+			ImGui::DragInt( "Sample count per motion", &sampleCount, 10.0f, 1, 100000 );
+			sampleCount = std::max( 1, sampleCount );
+
+			if ( ImGui::Button( "Measure" ) )
+			{
+				result = Result{};
+
+				Benchmark	timer{};
+				Animator	animator{};
+				Pose		pose{};
+				Pose		changedPose{};
+				std::vector<Donya::Vector4x4> referenceLocals{};
+				std::vector<Donya::Vector4x4> referenceGlobals{};
+
+				const size_t motionCount = holder.GetMotionCount();
+				for ( size_t m = 0; m < motionCount; ++m )
+				{
+					const MotionClip &clip = holder.GetMotion( scast<int>( m ) );
+					const auto &pSkeleton = clip.GetSkeleton();
+					if ( clip.IsEmpty() || !pSkeleton || !pSkeleton->GetBoneCount() ) { continue; }
+					// else
+
+					const size_t boneCount = pSkeleton->GetBoneCount();
+					const auto &parentIndices = pSkeleton->GetParentIndices();
+					referenceLocals.resize( boneCount );
+					referenceGlobals.resize( boneCount );
+
+					// The previous calculation, that assumes the parent is placed before own children.
+					auto CalcByReference = [&]( const std::vector<Animation::Transform> &transforms )
+					{
+						for ( size_t i = 0; i < boneCount; ++i )
+						{
+							referenceLocals[i] = transforms[i].ToWorldMatrix();
+
+							const int parentIndex = parentIndices[i];
+							referenceGlobals[i] = ( parentIndex == -1 ) ? referenceLocals[i] : referenceLocals[i] * referenceGlobals[parentIndex];
+						}
+					};
+					auto CountMismatches = []( const std::vector<Donya::Vector4x4> &expected, const std::vector<Donya::Vector4x4> &actual )
+					{
+						if ( expected.size() != actual.size() ) { return scast<int>( std::max( expected.size(), actual.size() ) ); }
+						// else
+
+						int count = 0;
+						for ( size_t i = 0; i < expected.size(); ++i )
+						{
+							if ( !( expected[i] == actual[i] ) ) { count++; }
+						}
+						return count;
+					};
+
+					const bool canUseReference = pSkeleton->IsSourceOrder();
+					if ( !canUseReference ) { result.unorderedCount++; }
+
+					animator.SetRepeatRange( clip );
+					for ( int i = 0; i < sampleCount; ++i )
+					{
+						animator.SetInternalElapsedTime( Donya::Random::GenerateFloat( 0.0f, clip.GetWholeSeconds() ) );
+						animator.CalcCurrentPose( clip, &pose );
+
+						if ( canUseReference )
+						{
+							timer.Begin();
+							CalcByReference( pose.GetTransforms() );
+							result.referenceSeconds += timer.End();
+						}
+
+						timer.Begin();
+						pose.UpdateTransformMatrices();
+						result.fullSeconds += timer.End();
+
+						if ( canUseReference )
+						{
+							result.fullMismatch += CountMismatches( referenceGlobals, pose.GetGlobalMatrices() );
+						}
+
+						// Rotate a bone as the procedural animation does, then update only that subtree.
+						const size_t changedBone = scast<size_t>( Donya::Random::GenerateInt( scast<int>( boneCount ) ) );
+						Animation::Transform changedTransform = pose.GetTransforms()[changedBone];
+						changedTransform.rotation = changedTransform.rotation * Donya::Quaternion::Make( Donya::Vector3::Up(), Donya::Random::GenerateFloat( -1.0f, 1.0f ) );
+
+						changedPose = pose;
+						changedPose.SetTransform( changedBone, changedTransform );
+						timer.Begin();
+						changedPose.UpdateChangedTransformMatrices();
+						result.changedSeconds += timer.End();
+
+						pose.SetTransform( changedBone, changedTransform );
+						pose.UpdateTransformMatrices();
+						result.changedMismatch += CountMismatches( pose.GetGlobalMatrices(), changedPose.GetGlobalMatrices() );
+					}
+
+					result.motionCount++;
+					result.sampleCount += sampleCount;
+				}
+			}
+
+			if ( result.motionCount )
+			{
+				ImGui::Text( "%d motions, %d samples", result.motionCount, result.sampleCount );
+				ImGui::Text( "Not source order motions : %d", result.unorderedCount );
+				ImGui::Text( "Mismatched matrices(Full)    : %d", result.fullMismatch );
+				ImGui::Text( "Mismatched matrices(Changed) : %d", result.changedMismatch );
+				ImGui::Text( "Previous : %.3f[ms]", result.referenceSeconds	* 1000.0 );
+				ImGui::Text( "Full     : %.3f[ms]", result.fullSeconds		* 1000.0 );
+				ImGui::Text( "Changed  : %.3f[ms]", result.changedSeconds	* 1000.0 );
+			}
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
 	}
 }
@@ -1,25 +1,35 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "ModelCommon.h"
+#include "ModelCompression.h"
+#include "ModelPose.h"
+#include "ModelSkeleton.h"
 #include "ModelSource.h"
+#include "UseImGui.h"
 
 namespace Donya
 {
 	namespace Model
 	{
 		/// <summary>
-		/// The storage of some motions.
+		/// The storage of some motions. The motions share a Skeleton of the source.
 		/// </summary>
 		class MotionHolder
 		{
 		private:
-			std::vector<Animation::Motion> motions;
+			std::shared_ptr<const Skeleton>	pSkeleton;
+			std::vector<MotionClip>			motions;
 		public:
 			size_t GetMotionCount() const;
 			/// <summary>
+			/// Returns the skeleton of the last appended source, or nullptr if nothing was appended.
+			/// </summary>
+			const std::shared_ptr<const Skeleton> &GetSkeleton() const;
+			/// <summary>
 			/// return ( motionIndex &lt; 0 || GetMotionCount() &lt;= motionIndex );
 			/// </summary>
 			bool IsOutOfRange( int motionIndex ) const;
@@ -27,7 +37,7 @@ namespace Donya
 			/// <summary>
 			/// Returns the motion of specified element.
 			/// </summary>
-			const Animation::Motion &GetMotion( int motionIndex ) const;
+			const MotionClip &GetMotion( int motionIndex ) const;
 			/// <summary>
 			/// Returns the specified motion that found first, or end(== GetMotionCount()) if the specified name is invalid.
 			/// </summary>
@@ -43,15 +53,32 @@ namespace Donya
 			void EraseMotion( const std::string &motionName );
 		public:
 			/// <summary>
-			/// Append all motions that the source has. The consistency with internal motion is not considered.
+			/// Append all motions that the source has. The consistency with internal motion is not considered.<para></para>
+			/// The compressed motions are decoded into the MotionClip.
 			/// </summary>
 			void AppendSource( const Source &source );
 			/// <summary>
-			/// The consistency with internal motion is not considered.
+			/// The consistency with internal motion is not considered.<para></para>
+			/// The motion uses the current skeleton if compatible, otherwise a new skeleton is made from the first key-pose.
 			/// </summary>
 			void AppendMotion( const Animation::Motion &element );
+			/// <summary>
+			/// Decodes the motion by the current skeleton. The motion is not appended if the bone count is different from the current skeleton.
+			/// </summary>
+			void AppendMotion( const Animation::CompressedMotion &element );
 		};
 
+	#if USE_IMGUI
+		/// <summary>
+		/// Compares the pose evaluation of the key-frame representation and the MotionClip at the random times of each motion of the holder.
+		/// </summary>
+		void ShowAnimationBenchmarkNode( const std::string &nodeCaption, const MotionHolder &holder );
+		/// <summary>
+		/// Compares the local to global propagation of Pose with the previous per-bone calculation, and the update of changed bones only with the full update.
+		/// </summary>
+		void ShowPosePropagationBenchmarkNode( const std::string &nodeCaption, const MotionHolder &holder );
+	#endif // USE_IMGUI
+
 		/// <summary>
 		/// This class's role is calculation a motion frame.<para></para>
 		/// This class does not linking to some motion, so if you wanna know the end timing of playback, you should set the play seconds range of a motion.
@@ -88,9 +115,32 @@ namespace Donya
 			/// Returns true if the current time is greater equal than the motion's last time(the repeat range will be ignored).
 			/// </summary>
 			bool IsOverPlaybackTimeOf( const Animation::Motion &motion ) const;
+			/// <summary>
+			/// Returns true if the current time is greater equal than the motion's last time(the repeat range will be ignored).
+			/// </summary>
+			bool IsOverPlaybackTimeOf( const MotionClip &motion ) const;
+			/// <summary>
+			/// Returns true if the current time is greater equal than the motion's last time(the repeat range will be ignored).
+			/// </summary>
+			bool IsOverPlaybackTimeOf( const CompressedClip &motion ) const;
 		public:
 			Animation::KeyFrame CalcCurrentPose( const std::vector<Animation::KeyFrame> &motion ) const;
 			Animation::KeyFrame CalcCurrentPose( const Animation::Motion &motion ) const;
+			/// <summary>
+			/// Writes the current pose into the "pDestination" without the allocation(if the bone count is not changed).<para></para>
+			/// The result is the same as the key-frame version. The "pDestination" is not changed if the motion is empty.
+			/// </summary>
+			void CalcCurrentPose( const MotionClip &motion, Pose *pDestination ) const;
+			/// <summary>
+			/// Decodes the current pose into the "pDestination" without the allocation(if the bone count is not changed).<para></para>
+			/// The "pDestination" is not changed if the motion is empty.
+			/// </summary>
+			void CalcCurrentPose( const CompressedClip &motion, Pose *pDestination ) const;
+			/// <summary>
+			/// Returns the seconds in the motion that CalcCurrentPose() samples at, i.e. the current time that the negative time, the loop and the clamp were applied.<para></para>
+			/// Returns 0.0f if the motion has less than two keys.
+			/// </summary>
+			float CalcPlaybackSeconds( const MotionClip &motion ) const;
 		public:
 			/// <summary>
 			/// If the current time is over some range, the current time will back to a start of some range.
@@ -100,6 +150,7 @@ namespace Donya
 			/// If the current time is over some range, the current time will be a last of some range.
 			/// </summary>
 			void DisableLoop();
+			bool IsEnableLoop() const;
 		public:
 			/// <summary>
 			/// Requirements:<para></para>
@@ -118,6 +169,14 @@ namespace Donya
 			/// </summary>
 			void SetRepeatRange( const Animation::Motion &motion );
 			/// <summary>
+			/// Set the motion's frame range to repeat range.
+			/// </summary>
+			void SetRepeatRange( const MotionClip &motion );
+			/// <summary>
+			/// Set the motion's frame range to repeat range.
+			/// </summary>
+			void SetRepeatRange( const CompressedClip &motion );
+			/// <summary>
 			/// Disable the repeat range.
 			/// </summary>
 			void ResetRepeatRange();
@@ -131,6 +190,12 @@ namespace Donya
 			/// </summary>
 			float GetInternalElapsedTime() const;
 		private:
+			/// <summary>
+			/// Returns the elapsed time that the negative value is converted.
+			/// </summary>
+			float CalcCurrentSeconds() const;
+			template<class Clip>
+			void  CalcCurrentPoseImpl( const Clip &motion, Pose *pDestination ) const;
 			void WrapAround( float minimum, float maximum );
 		};
 	}
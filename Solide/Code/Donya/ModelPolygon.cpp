@@ -1,7 +1,17 @@
 #include "ModelPolygon.h"
 
+#include <algorithm>		// Use std::nth_element.
+#include <atomic>
+#include <cfloat>			// Use FLT_MAX, FLT_MIN.
+#include <cmath>			// Use std::isinf, std::signbit.
+#include <numeric>			// Use std::iota.
+
+#include "Donya/Constant.h"	// Use scast macro.
 #include "Donya/Useful.h"	// Use EPSILON constant.
 
+#undef max
+#undef min
+
 namespace Donya
 {
 	namespace Model
@@ -14,12 +24,53 @@ namespace Donya
 				transformed /= transformed.w;
 				return transformed.XYZ();
 			};
+
+			constexpr int	BVH_LEAF_POLYGON_MAX	= 4;
+			constexpr int	BVH_TRAVERSE_STACK_SIZE	= 64;
+			constexpr float	BVH_BOUNDS_MARGIN		= 0.001f;
+			constexpr int	BATCH_PACKET_SIZE		= 4;	// The lane count of SIMD register.
+
+			std::atomic<int> inversionCount{ 0 };
+
+			bool IsIdentity( const Donya::Vector4x4 &m )
+			{
+				// Compare strictly, because the result of Raycast() should not be changed by skipping the transform.
+				return
+				m._11 == 1.0f && m._12 == 0.0f && m._13 == 0.0f && m._14 == 0.0f &&
+				m._21 == 0.0f && m._22 == 1.0f && m._23 == 0.0f && m._24 == 0.0f &&
+				m._31 == 0.0f && m._32 == 0.0f && m._33 == 1.0f && m._34 == 0.0f &&
+				m._41 == 0.0f && m._42 == 0.0f && m._43 == 0.0f && m._44 == 1.0f;
+			}
+			Donya::Vector4x4 CalcInverse( const Donya::Vector4x4 &m )
+			{
+				inversionCount++;
+				return m.Inverse();
+			}
+		}
+
+		int  PolygonGroup::GetInversionCount()
+		{
+			return inversionCount.load();
+		}
+		void PolygonGroup::ResetInversionCount()
+		{
+			inversionCount.store( 0 );
 		}
 
 		void PolygonGroup::ApplyCullMode( CullMode ignoreDir )
 		{
+			if ( cullMode != ignoreDir )
+			{
+				// Both conversions of Back->Front and Front->Back are the swapping of B and C.
+				const size_t vertexCount = vertices.size();
+				for ( size_t i = 0; i + 2 < vertexCount; i += 3 )
+				{
+					std::swap( vertices[i + 1], vertices[i + 2] );
+				}
+			}
+
 			cullMode = ignoreDir;
-			CalcAllPolygonNormal();
+			BuildPolygonAttributes();
 		}
 
 		void PolygonGroup::ApplyCoordinateConversion( const Donya::Vector4x4 &newConversionMatrix )
@@ -32,93 +83,194 @@ namespace Donya
 
 			// Convert to new coordinate system.
 			ApplyMatrixToAllPolygon( newConversionMatrix );
+
+			BuildBVH();
+		}
+		void PolygonGroup::BakeTransform( const Donya::Vector4x4 &transform )
+		{
+			ApplyMatrixToAllPolygon( transform );
+			BuildBVH();
 		}
 
 		void PolygonGroup::Assign( std::vector<Polygon> &rvSource )
 		{
-			polygons = std::move( rvSource );
+			Assign( scast<const std::vector<Polygon> &>( rvSource ) );
+			rvSource.clear();
 		}
 		void PolygonGroup::Assign( const std::vector<Polygon> &source )
 		{
-			polygons = source;
+			Pack( source );
+			BuildPolygonAttributes();
+			BuildBVH();
+		}
+		void PolygonGroup::AssignPacked( CullMode argCullMode, const Donya::Vector4x4 &argCoordinateConversion, std::vector<Donya::Vector3> &&argVertices, std::vector<int> &&argMaterialIds, std::vector<PolygonMaterial> &&argMaterials )
+		{
+			_ASSERT_EXPR( argVertices.size() == argMaterialIds.size() * 3U, L"Error: The vertex count must be three times of the polygon count!" );
+
+			cullMode				= argCullMode;
+			coordinateConversion	= argCoordinateConversion;
+			vertices				= std::move( argVertices	);
+			materialIds				= std::move( argMaterialIds	);
+			materials				= std::move( argMaterials	);
+
+			BuildPolygonAttributes();
+			BuildBVH();
 		}
 
 		RaycastResult PolygonGroup::Raycast( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd, bool onlyWantIsIntersect ) const
 		{
+			// The BVH is empty if the polygons are empty.
+			if ( bvhNodes.empty() ) { return RaycastBruteForce( rayStart, rayEnd, onlyWantIsIntersect ); }
+			// else
+
 			RaycastResult result;
 
 			const Donya::Vector3 rayVec  = rayEnd - rayStart;
 			const Donya::Vector3 nRayVec = rayVec.Unit();
 
-			float							nearestDistance = rayVec.Length();
-			Donya::Vector3					faceNormal;	// Does not normalized.
-			std::array<Donya::Vector3, 3>	edges;		// CullMode::Back:[0:AB][1:BC][2:CA]. CullMode::Front:[0:AC][1:CB][2:BA].
+			float			nearestDistance	= rayVec.Length();
+			int				nearestIndex	= -1;
+			float			currentDistance	= 0.0f;
+			Donya::Vector3	intersection;
 
-			for ( const auto &it : polygons )
+			const float origin[3]{ rayStart.x, rayStart.y, rayStart.z };
+			const float invDir[3] // May be infinity.
 			{
-				edges		= ExtractPolygonEdges( it.points );
-				faceNormal	= Donya::Cross( edges[0], -edges[2] ); // AB x AC
-
-				// The ray does not intersection to back-face.
-				// (If use '<': allow the horizontal intersection, '<=': disallow the horizontal intersection)
-				if ( 0.0f   < Donya::Vector3::Dot( rayVec, faceNormal ) ) { continue; }
-				// else
+				1.0f / nRayVec.x,
+				1.0f / nRayVec.y,
+				1.0f / nRayVec.z
+			};
+			// Returns false if the ray segment[0, tLimit] does not intersect to the box. Also outputs the entering distance.
+			auto IntersectToNode = [&]( const BVHNode &node, float tLimit, float *pOutputEnter )
+			{
+				const float boxMin[3]{ node.min.x, node.min.y, node.min.z };
+				const float boxMax[3]{ node.max.x, node.max.y, node.max.z };
 
-				// Distance between intersection point and rayStart.
-				float currentDistance{};
+				float tMin = 0.0f;
+				float tMax = tLimit;
+				for ( int i = 0; i < 3; ++i )
 				{
-					const Donya::Vector3 vPV = it.points[0] - rayStart;
+					if ( std::isinf( invDir[i] ) )
+					{
+						// The ray is parallel to this slab.
+						if ( origin[i] < boxMin[i] || boxMax[i] < origin[i] ) { return false; }
+						// else
+						continue;
+					}
+					// else
 
-					float dotPN = Donya::Vector3::Dot( vPV,		faceNormal );
-					float dotRN = Donya::Vector3::Dot( nRayVec,	faceNormal );
+					float t0 = ( boxMin[i] - origin[i] ) * invDir[i];
+					float t1 = ( boxMax[i] - origin[i] ) * invDir[i];
+					if ( t1 < t0 ) { std::swap( t0, t1 ); }
 
-					currentDistance = dotPN / ( dotRN + EPSILON /* Prevent zero-divide */ );
+					tMin = std::max( tMin, t0 );
+					tMax = std::min( tMax, t1 );
+					if ( tMax < tMin ) { return false; }
 				}
 
-				// The intersection point is there inverse side by rayEnd.
-				if ( currentDistance < 0.0f ) { continue; }
-				// else
+				*pOutputEnter = tMin;
+				return true;
+			};
+			// The intersection distance of polygon has a small error, so I allow a little over.
+			auto CalcLimit = [&]()
+			{
+				return nearestDistance + BVH_BOUNDS_MARGIN;
+			};
 
-				// I need the nearest polygon only.
-				if ( nearestDistance <= currentDistance ) { continue; }
-				// else
+			struct Visit
+			{
+				int		nodeIndex;
+				float	enterDistance;
+			};
+			std::array<Visit, BVH_TRAVERSE_STACK_SIZE> stack;
+			int stackCount = 0;
 
-				Donya::Vector3 intersection = rayStart + ( nRayVec * currentDistance );
+			float rootEnter = 0.0f;
+			if ( IntersectToNode( bvhNodes.front(), CalcLimit(), &rootEnter ) )
+			{
+				stack[stackCount++] = Visit{ 0, rootEnter };
+			}
 
-				// Judge the intersection-point is there inside of triangle.
-				bool onOutside = false;
-				for ( size_t i = 0; i < it.points.size()/* 3 */; ++i )
-				{
-					// Requirement: All vector(I->P) must facing right side of the edge vector.
-					Donya::Vector3 vIV		= ArrayAccess( it.points, i ) - intersection;
-					Donya::Vector3 cross	= Donya::Vector3::Cross( vIV, edges[i] );
+			while ( 0 < stackCount )
+			{
+				const Visit visit = stack[--stackCount];
+
+				// The nearest distance may be updated after pushed.
+				if ( CalcLimit() < visit.enterDistance ) { continue; }
+				// else
 
-					float dotCN = Donya::Vector3::Dot( cross, faceNormal );
-					if (  dotCN < 0.0f )
+				const BVHNode &node = bvhNodes[visit.nodeIndex];
+				if ( node.IsLeaf() )
+				{
+					for ( int i = 0; i < node.polygonCount; ++i )
 					{
-						onOutside = true;
-						break;
+						const int polygonIndex = bvhPolygonIndices[node.childOrFirst + i];
+
+						// The brute-force adopts the first polygon in the same distances, so I should choose the lower index.
+						const bool acceptSameDistance = ( 0 <= nearestIndex && polygonIndex < nearestIndex );
+
+						if ( !IntersectPolygon( polygonIndex, rayStart, rayVec, nRayVec, nearestDistance, acceptSameDistance, &currentDistance, &intersection ) ) { continue; }
+						// else
+
+						nearestDistance	= currentDistance;
+						nearestIndex	= polygonIndex;
+
+						result.wasHit		= true;
+						result.distance		= currentDistance;
+						result.intersection	= intersection;
+
+						if ( onlyWantIsIntersect ) { break; }
+						// else
 					}
+
+					if ( onlyWantIsIntersect && result.wasHit ) { break; }
+					// else
+					continue;
 				}
-				if ( onOutside ) { continue; }
 				// else
 
-				nearestDistance = currentDistance;
+				const int	leftIndex	= node.childOrFirst;
+				const int	rightIndex	= leftIndex + 1;
+				float		leftEnter	= 0.0f;
+				float		rightEnter	= 0.0f;
+				const bool	hitLeft		= IntersectToNode( bvhNodes[leftIndex],  CalcLimit(), &leftEnter  );
+				const bool	hitRight	= IntersectToNode( bvhNodes[rightIndex], CalcLimit(), &rightEnter );
 
-				result.wasHit			= true;
-				result.distance			= currentDistance;
-				result.nearestPolygon	= it;
-				result.intersection		= intersection;
+				_ASSERT_EXPR( stackCount + 2 <= BVH_TRAVERSE_STACK_SIZE, L"Error : The BVH is too deep!" );
 
-				if ( onlyWantIsIntersect ) { return result; }
-				// else
+				// Push the far child first, so the near child will be visited first.
+				if ( hitLeft && hitRight )
+				{
+					if ( leftEnter < rightEnter )
+					{
+						stack[stackCount++] = Visit{ rightIndex,	rightEnter	};
+						stack[stackCount++] = Visit{ leftIndex,		leftEnter	};
+					}
+					else
+					{
+						stack[stackCount++] = Visit{ leftIndex,		leftEnter	};
+						stack[stackCount++] = Visit{ rightIndex,	rightEnter	};
+					}
+				}
+				else if ( hitLeft  ) { stack[stackCount++] = Visit{ leftIndex,  leftEnter  }; }
+				else if ( hitRight ) { stack[stackCount++] = Visit{ rightIndex, rightEnter }; }
+			}
+
+			if ( result.wasHit )
+			{
+				result.polygonIndex	= nearestIndex;
+				result.normal		= normals[nearestIndex];
 			}
 
 			return result;
 		}
 		RaycastResult PolygonGroup::RaycastWorldSpace( const Donya::Vector4x4 &transform, const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd, bool onlyWantIsIntersect ) const
 		{
-			const Donya::Vector4x4 invTransform = transform.Inverse();
+			// The polygons are already placed in that space.
+			if ( IsIdentity( transform ) ) { return Raycast( rayStart, rayEnd, onlyWantIsIntersect ); }
+			// else
+
+			const Donya::Vector4x4 invTransform = CalcInverse( transform );
 
 			// Transformed space.
 			const Donya::Vector3 tsRayStart	= Multiply( rayStart,	1.0f, invTransform );
@@ -128,101 +280,528 @@ namespace Donya
 			if ( !result.wasHit ) { return result; }
 			// else
 
-			struct VecFloat
+			TransformResultToWorldSpace( transform, rayStart, &result );
+			return result;
+		}
+		void PolygonGroup::RaycastBatch( const Donya::Vector4x4 &transform, const RaySegment *pRays, size_t rayCount, RaycastResult *pOutputResults, bool onlyWantIsIntersect ) const
+		{
+			if ( !rayCount ) { return; }
+			// else
+			assert( pRays && pOutputResults );
+
+			// The inverse is calculated only once for all rays.
+			const bool				isIdentity		= IsIdentity( transform );
+			const Donya::Vector4x4	invTransform	= ( isIdentity ) ? transform : CalcInverse( transform );
+
+			std::array<RaySegment, BATCH_PACKET_SIZE> tsPacket; // Transformed space.
+			for ( size_t packetFirst = 0; packetFirst < rayCount; packetFirst += BATCH_PACKET_SIZE )
 			{
-				Donya::Vector3 *v = nullptr;
-				float f = 0.0f;
-			};
+				const size_t packetSize = std::min( rayCount - packetFirst, scast<size_t>( BATCH_PACKET_SIZE ) );
+				if ( isIdentity )
+				{
+					RaycastPacket( pRays + packetFirst, scast<int>( packetSize ), pOutputResults + packetFirst, onlyWantIsIntersect );
+					continue;
+				}
+				// else
+
+				for ( size_t i = 0; i < packetSize; ++i )
+				{
+					tsPacket[i].start	= Multiply( pRays[packetFirst + i].start,	1.0f, invTransform );
+					tsPacket[i].end		= Multiply( pRays[packetFirst + i].end,		1.0f, invTransform );
+				}
 
-			VecFloat applyList[]
+				RaycastPacket( tsPacket.data(), scast<int>( packetSize ), pOutputResults + packetFirst, onlyWantIsIntersect );
+
+				for ( size_t i = 0; i < packetSize; ++i )
+				{
+					RaycastResult &result = pOutputResults[packetFirst + i];
+					if ( !result.wasHit ) { continue; }
+					// else
+
+					TransformResultToWorldSpace( transform, pRays[packetFirst + i].start, &result );
+				}
+			}
+		}
+		std::vector<RaycastResult> PolygonGroup::RaycastBatch( const Donya::Vector4x4 &transform, const std::vector<RaySegment> &rays, bool onlyWantIsIntersect ) const
+		{
+			std::vector<RaycastResult> results( rays.size() );
+			RaycastBatch( transform, rays.data(), rays.size(), results.data(), onlyWantIsIntersect );
+			return results;
+		}
+		void PolygonGroup::TransformResultToWorldSpace( const Donya::Vector4x4 &transform, const Donya::Vector3 &wsRayStart, RaycastResult *pResult ) const
+		{
+			RaycastResult &result = *pResult;
+
+			// Recalculate the normal from transformed vertices, because the transform may contain a non-uniform scaling.
+			const size_t	first = scast<size_t>( result.polygonIndex ) * 3U;
+			const auto		a = Multiply( vertices[first + 0], 1.0f, transform );
+			const auto		b = Multiply( vertices[first + 1], 1.0f, transform );
+			const auto		c = Multiply( vertices[first + 2], 1.0f, transform );
+			result.normal		= Donya::Cross( b - a, c - a ).Unit();
+			result.intersection	= Multiply( result.intersection, 1.0f, transform );
+
+			result.distance = Donya::Vector3{ result.intersection - wsRayStart }.Length();
+		}
+
+		void PolygonGroup::RaycastPacket( const RaySegment *pRays, int rayCount, RaycastResult *pOutputResults, bool onlyWantIsIntersect ) const
+		{
+			assert( 0 < rayCount && rayCount <= BATCH_PACKET_SIZE );
+
+			if ( bvhNodes.empty() )
 			{
-				{ &result.intersection,				1.0f },
-				{ &result.nearestPolygon.points[0],	1.0f },
-				{ &result.nearestPolygon.points[1],	1.0f },
-				{ &result.nearestPolygon.points[2],	1.0f }
-			};
+				for ( int i = 0; i < rayCount; ++i )
+				{
+					pOutputResults[i] = RaycastBruteForce( pRays[i].start, pRays[i].end, onlyWantIsIntersect );
+				}
+				return;
+			}
+			// else
+
+			using namespace DirectX;
+
+			constexpr int	LANE_COUNT			= BATCH_PACKET_SIZE;
+			constexpr float	PARALLEL_RECIPROCAL	= 1.0e+30f; // Use a finite value instead of infinity, because "infinity * zero" makes NaN.
 
-			auto ToWorldSpace = [&]( VecFloat *pTarget )
+			Donya::Vector3	rayVecs[LANE_COUNT];
+			Donya::Vector3	nRayVecs[LANE_COUNT];
+			float			nearestDistances[LANE_COUNT];
+			int				nearestIndices[LANE_COUNT];
+			float			origins[3][LANE_COUNT]{};
+			float			invDirs[3][LANE_COUNT]{};
+			unsigned int	activeLanes = 0;
+			for ( int lane = 0; lane < LANE_COUNT; ++lane )
 			{
-				*pTarget->v = Multiply( *pTarget->v, pTarget->f, transform );
+				nearestDistances[lane]	= -1.0f;
+				nearestIndices[lane]	= -1;
+				if ( rayCount <= lane ) { continue; }
+				// else
+
+				pOutputResults[lane] = RaycastResult{};
+
+				rayVecs[lane]			= pRays[lane].end - pRays[lane].start;
+				nRayVecs[lane]			= rayVecs[lane].Unit();
+				nearestDistances[lane]	= rayVecs[lane].Length();
+				for ( size_t axis = 0; axis < 3; ++axis )
+				{
+					const float direction = nRayVecs[lane][axis];
+					origins[axis][lane] = pRays[lane].start[axis];
+					invDirs[axis][lane] = ( std::fabs( direction ) < FLT_MIN )
+										? ( ( std::signbit( direction ) ) ? -PARALLEL_RECIPROCAL : PARALLEL_RECIPROCAL )
+										: 1.0f / direction;
+				}
+
+				activeLanes |= ( 1U << lane );
+			}
+
+			// The ray packet as SoA.
+			const XMVECTOR originX = XMLoadFloat4( reinterpret_cast<const XMFLOAT4 *>( origins[0] ) );
+			const XMVECTOR originY = XMLoadFloat4( reinterpret_cast<const XMFLOAT4 *>( origins[1] ) );
+			const XMVECTOR originZ = XMLoadFloat4( reinterpret_cast<const XMFLOAT4 *>( origins[2] ) );
+			const XMVECTOR invDirX = XMLoadFloat4( reinterpret_cast<const XMFLOAT4 *>( invDirs[0] ) );
+			const XMVECTOR invDirY = XMLoadFloat4( reinterpret_cast<const XMFLOAT4 *>( invDirs[1] ) );
+			const XMVECTOR invDirZ = XMLoadFloat4( reinterpret_cast<const XMFLOAT4 *>( invDirs[2] ) );
+
+			// Returns the bit mask of the lanes that intersect to the node.
+			auto IntersectToNode = [&]( const BVHNode &node )
+			{
+				// The inactive lanes have a negative limit, so those never intersect.
+				float limits[LANE_COUNT];
+				for ( int lane = 0; lane < LANE_COUNT; ++lane )
+				{
+					limits[lane] = ( activeLanes & ( 1U << lane ) ) ? nearestDistances[lane] + BVH_BOUNDS_MARGIN : -1.0f;
+				}
+
+				auto CalcSlab = []( float boxMin, float boxMax, const XMVECTOR &origin, const XMVECTOR &invDir, XMVECTOR *pNear, XMVECTOR *pFar )
+				{
+					const XMVECTOR t0 = XMVectorMultiply( XMVectorSubtract( XMVectorReplicate( boxMin ), origin ), invDir );
+					const XMVECTOR t1 = XMVectorMultiply( XMVectorSubtract( XMVectorReplicate( boxMax ), origin ), invDir );
+					*pNear	= XMVectorMin( t0, t1 );
+					*pFar	= XMVectorMax( t0, t1 );
+				};
+				XMVECTOR nearX, nearY, nearZ, farX, farY, farZ;
+				CalcSlab( node.min.x, node.max.x, originX, invDirX, &nearX, &farX );
+				CalcSlab( node.min.y, node.max.y, originY, invDirY, &nearY, &farY );
+				CalcSlab( node.min.z, node.max.z, originZ, invDirZ, &nearZ, &farZ );
+
+				const XMVECTOR enter = XMVectorMax( XMVectorMax( XMVectorZero(), nearX ), XMVectorMax( nearY, nearZ ) );
+				const XMVECTOR exit  = XMVectorMin( XMVectorMin( XMLoadFloat4( reinterpret_cast<const XMFLOAT4 *>( limits ) ), farX ), XMVectorMin( farY, farZ ) );
+
+				XMUINT4 hits;
+				XMStoreUInt4( &hits, XMVectorLessOrEqual( enter, exit ) );
+
+				unsigned int mask = 0;
+				if ( hits.x ) { mask |= 1U << 0; }
+				if ( hits.y ) { mask |= 1U << 1; }
+				if ( hits.z ) { mask |= 1U << 2; }
+				if ( hits.w ) { mask |= 1U << 3; }
+				return mask;
 			};
-			for ( auto &it : applyList )
+
+			std::array<int, BVH_TRAVERSE_STACK_SIZE> stack;
+			int stackCount = 0;
+			stack[stackCount++] = 0;
+
+			float			currentDistance = 0.0f;
+			Donya::Vector3	intersection;
+			while ( 0 < stackCount && activeLanes )
 			{
-				ToWorldSpace( &it );
+				const BVHNode &node = bvhNodes[stack[--stackCount]];
+
+				const unsigned int hitLanes = IntersectToNode( node );
+				if ( !hitLanes ) { continue; }
+				// else
+
+				if ( !node.IsLeaf() )
+				{
+					// Push the far child first, so the near child will be visited first.
+					// The order is decided by the first lane that intersected, because the rays of packet are expected as similar.
+					int firstLane = 0;
+					while ( !( hitLanes & ( 1U << firstLane ) ) ) { ++firstLane; }
+
+					const int			leftIndex	= node.childOrFirst;
+					const int			rightIndex	= leftIndex + 1;
+					const BVHNode		&left		= bvhNodes[leftIndex];
+					const BVHNode		&right		= bvhNodes[rightIndex];
+					const Donya::Vector3 centerDiff	= ( right.min + right.max ) - ( left.min + left.max );
+					const bool			leftIsNear	= ( 0.0f <= Donya::Vector3::Dot( centerDiff, nRayVecs[firstLane] ) );
+
+					_ASSERT_EXPR( stackCount + 2 <= BVH_TRAVERSE_STACK_SIZE, L"Error : The BVH is too deep!" );
+					stack[stackCount++] = ( leftIsNear ) ? rightIndex : leftIndex;
+					stack[stackCount++] = ( leftIsNear ) ? leftIndex  : rightIndex;
+					continue;
+				}
+				// else
+
+				for ( int i = 0; i < node.polygonCount; ++i )
+				{
+					const int		polygonIndex	= bvhPolygonIndices[node.childOrFirst + i];
+					for ( int lane = 0; lane < rayCount; ++lane )
+					{
+						if ( !( hitLanes & activeLanes & ( 1U << lane ) ) ) { continue; }
+						// else
+
+						// The brute-force adopts the first polygon in the same distances, so I should choose the lower index.
+						const bool acceptSameDistance = ( 0 <= nearestIndices[lane] && polygonIndex < nearestIndices[lane] );
+
+						if ( !IntersectPolygon( polygonIndex, pRays[lane].start, rayVecs[lane], nRayVecs[lane], nearestDistances[lane], acceptSameDistance, &currentDistance, &intersection ) ) { continue; }
+						// else
+
+						nearestDistances[lane]	= currentDistance;
+						nearestIndices[lane]	= polygonIndex;
+
+						RaycastResult &result	= pOutputResults[lane];
+						result.wasHit			= true;
+						result.distance			= currentDistance;
+						result.intersection		= intersection;
+
+						if ( onlyWantIsIntersect ) { activeLanes &= ~( 1U << lane ); }
+					}
+				}
 			}
 
-			const std::array<Donya::Vector3, 3> actualPoints
+			for ( int lane = 0; lane < rayCount; ++lane )
 			{
-				ArrayAccess( result.nearestPolygon.points, 0U ),
-				ArrayAccess( result.nearestPolygon.points, 1U ),
-				ArrayAccess( result.nearestPolygon.points, 2U )
-			};
-			result.nearestPolygon.points = actualPoints;
+				if ( !pOutputResults[lane].wasHit ) { continue; }
+				// else
+				pOutputResults[lane].polygonIndex	= nearestIndices[lane];
+				pOutputResults[lane].normal			= normals[nearestIndices[lane]];
+			}
+		}
 
-			const Donya::Vector3  edgeAB = result.nearestPolygon.points[1] - result.nearestPolygon.points[0];
-			const Donya::Vector3  edgeAC = result.nearestPolygon.points[2] - result.nearestPolygon.points[0];
-			result.nearestPolygon.normal = Donya::Cross( edgeAB, edgeAC ).Unit();
+		RaycastResult PolygonGroup::RaycastBruteForce( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd, bool onlyWantIsIntersect ) const
+		{
+			RaycastResult result;
+
+			const Donya::Vector3 rayVec  = rayEnd - rayStart;
+			const Donya::Vector3 nRayVec = rayVec.Unit();
 
-			result.distance = Donya::Vector3{ result.intersection - rayStart }.Length();
+			float			nearestDistance = rayVec.Length();
+			float			currentDistance = 0.0f;
+			Donya::Vector3	intersection;
+
+			const int polygonCount = scast<int>( GetPolygonCount() );
+			for ( int i = 0; i < polygonCount; ++i )
+			{
+				// I need the nearest polygon only.
+				if ( !IntersectPolygon( i, rayStart, rayVec, nRayVec, nearestDistance, /* acceptSameDistance = */ false, &currentDistance, &intersection ) ) { continue; }
+				// else
+
+				nearestDistance = currentDistance;
+
+				result.wasHit		= true;
+				result.distance		= currentDistance;
+				result.polygonIndex	= i;
+				result.normal		= normals[i];
+				result.intersection	= intersection;
+
+				if ( onlyWantIsIntersect ) { return result; }
+				// else
+			}
 
 			return result;
 		}
 
-		void PolygonGroup::ApplyMatrixToAllPolygon( const Donya::Vector4x4 &transform )
+		void PolygonGroup::BuildBVH()
 		{
-			auto Transform = []( Polygon *pTarget, const Donya::Vector4x4 &m )
+			bvhNodes.clear();
+			bvhPolygonIndices.clear();
+
+			const int polygonCount = scast<int>( GetPolygonCount() );
+			if ( !polygonCount ) { return; }
+			// else
+
+			std::vector<Donya::Vector3> polygonMins;
+			std::vector<Donya::Vector3> polygonMaxs;
+			std::vector<Donya::Vector3> centroids;
+			polygonMins.reserve( polygonCount );
+			polygonMaxs.reserve( polygonCount );
+			centroids.reserve( polygonCount );
+			for ( int i = 0; i < polygonCount; ++i )
 			{
-				pTarget->points[0] = Multiply( pTarget->points[0], 1.0f, m );
-				pTarget->points[1] = Multiply( pTarget->points[1], 1.0f, m );
-				pTarget->points[2] = Multiply( pTarget->points[2], 1.0f, m );
+				const Donya::Vector3 &a = vertices[i * 3 + 0];
+				const Donya::Vector3 &b = vertices[i * 3 + 1];
+				const Donya::Vector3 &c = vertices[i * 3 + 2];
+				polygonMins.emplace_back( std::min( { a.x, b.x, c.x } ), std::min( { a.y, b.y, c.y } ), std::min( { a.z, b.z, c.z } ) );
+				polygonMaxs.emplace_back( std::max( { a.x, b.x, c.x } ), std::max( { a.y, b.y, c.y } ), std::max( { a.z, b.z, c.z } ) );
+				centroids.emplace_back( ( a + b + c ) / 3.0f );
+			}
+
+			bvhPolygonIndices.resize( polygonCount );
+			std::iota( bvhPolygonIndices.begin(), bvhPolygonIndices.end(), 0 );
+
+			// The node count of binary tree is lower than double of leaf count.
+			bvhNodes.reserve( scast<size_t>( polygonCount ) * 2U );
+			bvhNodes.emplace_back();
+
+			struct Range
+			{
+				int nodeIndex;
+				int first;
+				int count;
 			};
+			std::vector<Range> pendings{ Range{ 0, 0, polygonCount } };
+			while ( !pendings.empty() )
+			{
+				const Range range = pendings.back();
+				pendings.pop_back();
+
+				Donya::Vector3 boxMin{ +FLT_MAX, +FLT_MAX, +FLT_MAX };
+				Donya::Vector3 boxMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+				Donya::Vector3 centroidMin = boxMin;
+				Donya::Vector3 centroidMax = boxMax;
+				for ( int i = 0; i < range.count; ++i )
+				{
+					const int index = bvhPolygonIndices[range.first + i];
+					for ( size_t axis = 0; axis < 3; ++axis )
+					{
+						boxMin[axis]		= std::min( boxMin[axis],		polygonMins[index][axis]	);
+						boxMax[axis]		= std::max( boxMax[axis],		polygonMaxs[index][axis]	);
+						centroidMin[axis]	= std::min( centroidMin[axis],	centroids[index][axis]		);
+						centroidMax[axis]	= std::max( centroidMax[axis],	centroids[index][axis]		);
+					}
+				}
 
-			for ( auto &it : polygons )
+				// The intersection point of Raycast() has a small error, so I extend the bounds a little.
+				bvhNodes[range.nodeIndex].min = boxMin - BVH_BOUNDS_MARGIN;
+				bvhNodes[range.nodeIndex].max = boxMax + BVH_BOUNDS_MARGIN;
+
+				if ( range.count <= BVH_LEAF_POLYGON_MAX )
+				{
+					bvhNodes[range.nodeIndex].childOrFirst	= range.first;
+					bvhNodes[range.nodeIndex].polygonCount	= range.count;
+					continue;
+				}
+				// else
+
+				// Split at the median of centroids along the longest axis.
+				const Donya::Vector3 extent = centroidMax - centroidMin;
+				size_t splitAxis = 0;
+				if ( extent[splitAxis] < extent.y ) { splitAxis = 1; }
+				if ( extent[splitAxis] < extent.z ) { splitAxis = 2; }
+
+				const int leftCount = range.count / 2;
+				auto itrFirst = bvhPolygonIndices.begin() + range.first;
+				std::nth_element
+				(
+					itrFirst, itrFirst + leftCount, itrFirst + range.count,
+					[&centroids, &splitAxis]( int lhs, int rhs )
+					{
+						return centroids[lhs][splitAxis] < centroids[rhs][splitAxis];
+					}
+				);
+
+				const int leftIndex = scast<int>( bvhNodes.size() );
+				bvhNodes.emplace_back();
+				bvhNodes.emplace_back();
+				bvhNodes[range.nodeIndex].childOrFirst	= leftIndex;
+				bvhNodes[range.nodeIndex].polygonCount	= 0;
+
+				pendings.emplace_back( Range{ leftIndex,		range.first,				leftCount				} );
+				pendings.emplace_back( Range{ leftIndex + 1,	range.first + leftCount,	range.count - leftCount	} );
+			}
+		}
+
+		bool PolygonGroup::IntersectPolygon( int polygonIndex, const Donya::Vector3 &rayStart, const Donya::Vector3 &rayVec, const Donya::Vector3 &nRayVec, float nearestDistance, bool acceptSameDistance, float *pOutputDistance, Donya::Vector3 *pOutputIntersection ) const
+		{
+			const Donya::Vector3 *pPoints = &vertices[polygonIndex * 3];	// [0:A][1:B][2:C]. Already ordered by cullMode.
+			const Donya::Vector3 *pEdges  = &edges[polygonIndex * 3];		// [0:AB][1:BC][2:CA].
+			const Donya::Vector3 faceNormal = Donya::Cross( pEdges[0], -pEdges[2] ); // AB x AC. Does not normalized.
+
+			// The ray does not intersection to back-face.
+			// (If use '<': allow the horizontal intersection, '<=': disallow the horizontal intersection)
+			if ( 0.0f   < Donya::Vector3::Dot( rayVec, faceNormal ) ) { return false; }
+			// else
+
+			// Distance between intersection point and rayStart.
+			float currentDistance{};
 			{
-				Transform( &it, transform );
+				const Donya::Vector3 vPV = pPoints[0] - rayStart;
+
+				float dotPN = Donya::Vector3::Dot( vPV,		faceNormal );
+				float dotRN = Donya::Vector3::Dot( nRayVec,	faceNormal );
+
+				currentDistance = dotPN / ( dotRN + EPSILON /* Prevent zero-divide */ );
 			}
 
-			CalcAllPolygonNormal();
+			// The intersection point is there inverse side by rayEnd.
+			if ( currentDistance < 0.0f ) { return false; }
+			// else
+
+			// I need the nearest polygon only.
+			if ( acceptSameDistance )
+			{
+				if ( nearestDistance <  currentDistance ) { return false; }
+			}
+			else
+			{
+				if ( nearestDistance <= currentDistance ) { return false; }
+			}
+			// else
+
+			const Donya::Vector3 intersection = rayStart + ( nRayVec * currentDistance );
+
+			// Judge the intersection-point is there inside of triangle.
+			for ( size_t i = 0; i < 3; ++i )
+			{
+				// Requirement: All vector(I->P) must facing right side of the edge vector.
+				Donya::Vector3 vIV		= pPoints[i] - intersection;
+				Donya::Vector3 cross	= Donya::Vector3::Cross( vIV, pEdges[i] );
+
+				float dotCN = Donya::Vector3::Dot( cross, faceNormal );
+				if (  dotCN < 0.0f ) { return false; }
+			}
+
+			*pOutputDistance		= currentDistance;
+			*pOutputIntersection	= intersection;
+			return true;
 		}
 
-		void PolygonGroup::CalcAllPolygonNormal()
+		void PolygonGroup::ApplyMatrixToAllPolygon( const Donya::Vector4x4 &transform )
 		{
-			for ( auto &it : polygons )
+			for ( auto &it : vertices )
 			{
-				it.normal = CalcNormalByOrder( it.points );
+				it = Multiply( it, 1.0f, transform );
 			}
+
+			BuildPolygonAttributes();
 		}
-		Donya::Vector3 PolygonGroup::CalcNormalByOrder( const std::array<Donya::Vector3, 3> &source ) const
+
+		void PolygonGroup::Pack( const std::vector<Polygon> &source )
 		{
-			auto A = [&]() { return ArrayAccess( source, 0U ); };
-			auto B = [&]() { return ArrayAccess( source, 1U ); };
-			auto C = [&]() { return ArrayAccess( source, 2U ); };
-			auto Vector = [&]( auto &from, auto &to )
+			vertices.clear();
+			materialIds.clear();
+			materials.clear();
+
+			vertices.reserve( source.size() * 3U );
+			materialIds.reserve( source.size() );
+
+			auto FindOrAppendMaterial = [&]( const Polygon &polygon )
 			{
-				return to() - from();
+				const int materialCount = scast<int>( materials.size() );
+				for ( int i = 0; i < materialCount; ++i )
+				{
+					if ( materials[i].index == polygon.materialIndex && materials[i].name == polygon.materialName )
+					{
+						return i;
+					}
+				}
+
+				PolygonMaterial material{};
+				material.index	= polygon.materialIndex;
+				material.name	= polygon.materialName;
+				materials.emplace_back( std::move( material ) );
+				return materialCount;
 			};
 
-			const Donya::Vector3 ab = Vector( A, B );
-			const Donya::Vector3 ac = Vector( A, C );
-			return Donya::Cross( ab, ac ).Unit();
-		}
+			int lastId = -1; // The neighboring polygons are likely to have the same material.
+			for ( const auto &it : source )
+			{
+				for ( size_t i = 0; i < 3; ++i )
+				{
+					vertices.emplace_back( ArrayAccess( it.points, i ) );
+				}
 
-		std::array<Donya::Vector3, 3> PolygonGroup::ExtractPolygonEdges( const std::array<Donya::Vector3, 3> &source ) const
+				const bool isSameAsLast = ( 0 <= lastId && materials[lastId].index == it.materialIndex && materials[lastId].name == it.materialName );
+				lastId = ( isSameAsLast ) ? lastId : FindOrAppendMaterial( it );
+				materialIds.emplace_back( lastId );
+			}
+		}
+		void PolygonGroup::BuildPolygonAttributes()
 		{
-			auto A = [&]() { return ArrayAccess( source, 0U ); };
-			auto B = [&]() { return ArrayAccess( source, 1U ); };
-			auto C = [&]() { return ArrayAccess( source, 2U ); };
-			auto Vector = [&]( auto &from, auto &to )
+			const size_t polygonCount = GetPolygonCount();
+			edges.resize( polygonCount * 3U );
+			normals.resize( polygonCount );
+
+			for ( size_t i = 0; i < polygonCount; ++i )
 			{
-				return to() - from();
-			};
+				const Donya::Vector3 &a = vertices[i * 3 + 0];
+				const Donya::Vector3 &b = vertices[i * 3 + 1];
+				const Donya::Vector3 &c = vertices[i * 3 + 2];
+
+				edges[i * 3 + 0] = b - a;
+				edges[i * 3 + 1] = c - b;
+				edges[i * 3 + 2] = a - c;
 
-			return std::array<Donya::Vector3, 3>
+				normals[i] = Donya::Cross( b - a, c - a ).Unit();
+			}
+		}
+
+		Polygon PolygonGroup::GetPolygon( int polygonIndex ) const
+		{
+			Polygon polygon{};
+			if ( polygonIndex < 0 || scast<int>( GetPolygonCount() ) <= polygonIndex ) { return polygon; }
+			// else
+
+			const std::array<Donya::Vector3, 3> ordered
 			{
-				Vector( A, B ),
-				Vector( B, C ),
-				Vector( C, A )
+				vertices[polygonIndex * 3 + 0],
+				vertices[polygonIndex * 3 + 1],
+				vertices[polygonIndex * 3 + 2]
 			};
+			// The ArrayAccess() is an involution, so it restores the definition order also.
+			for ( size_t i = 0; i < 3; ++i )
+			{
+				polygon.points[i] = ArrayAccess( ordered, i );
+			}
+
+			const PolygonMaterial &material = materials[materialIds[polygonIndex]];
+			polygon.materialIndex	= material.index;
+			polygon.materialName	= material.name;
+			polygon.normal			= normals[polygonIndex];
+			return polygon;
+		}
+		const std::string &PolygonGroup::GetMaterialName( int polygonIndex ) const
+		{
+			static const std::string EMPTY{};
+			if ( polygonIndex < 0 || scast<int>( GetPolygonCount() ) <= polygonIndex ) { return EMPTY; }
+			// else
+			return materials[materialIds[polygonIndex]].name;
+		}
+		int PolygonGroup::GetMaterialIndex( int polygonIndex ) const
+		{
+			if ( polygonIndex < 0 || scast<int>( GetPolygonCount() ) <= polygonIndex ) { return -1; }
+			// else
+			return materials[materialIds[polygonIndex]].index;
 		}
 
 		Donya::Vector3 PolygonGroup::ArrayAccess( const std::array<Donya::Vector3, 3> &source, size_t index ) const
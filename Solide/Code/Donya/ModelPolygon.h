@@ -2,11 +2,13 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #undef max
 #undef min
 #include <cereal/types/array.hpp>
 #include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
 
 #include "Donya/Vector.h"
 #include "Donya/Serializer.h"
@@ -43,6 +45,30 @@ namespace Donya
 			}
 		};
 		
+		/// <summary>
+		/// The material of polygons. PolygonGroup shares this between the polygons that have the same material.
+		/// </summary>
+		struct PolygonMaterial
+		{
+			int			index = -1;	// -1 is invalid.
+			std::string	name;
+		private:
+			friend class cereal::access;
+			template<class Archive>
+			void serialize( Archive &archive, std::uint32_t version )
+			{
+				archive
+				(
+					CEREAL_NVP( index ),
+					CEREAL_NVP( name )
+				);
+				if ( 1 <= version )
+				{
+					// archive( CEREAL_NVP( x ) );
+				}
+			}
+		};
+		
 		/// <summary>
 		/// The raycast result of PolygonGroup. Each member is invalid if the "wasHit" is false.
 		/// </summary>
@@ -50,10 +76,20 @@ namespace Donya
 		{
 			bool			wasHit = false;		// This will be true if the ray was hit to some polygon.
 			float			distance = 0.0f;	// The distance between the start position of ray and the point of intersection.
-			Polygon			nearestPolygon;		// The nearest polygon in intersected polygons.
+			int				polygonIndex = -1;	// The index of the nearest polygon in intersected polygons. You can fetch the detail of that polygon from the PolygonGroup.
+			Donya::Vector3	normal;				// The normalized normal of the nearest polygon.
 			Donya::Vector3	intersection;		// The point of intersection to the nearest polygon.
 		};
 
+		/// <summary>
+		/// The ray of PolygonGroup::RaycastBatch().
+		/// </summary>
+		struct RaySegment
+		{
+			Donya::Vector3	start;
+			Donya::Vector3	end;
+		};
+
 		/// <summary>
 		/// PolygonGroup has polygons of a model and provides the Raycast method.
 		/// </summary>
@@ -69,9 +105,30 @@ namespace Donya
 				Front	// I regard as the definition order is CCW. The CW polygon will be ignored.
 			};
 		private:
-			CullMode				cullMode = CullMode::Back;
-			Donya::Vector4x4		coordinateConversion;
-			std::vector<Polygon>	polygons;
+			/// <summary>
+			/// The node of bounding volume hierarchy. That is built from the "vertices", and does not serialize.
+			/// </summary>
+			struct BVHNode
+			{
+				Donya::Vector3	min;					// The minimum corner of AABB that contains all polygons of this node.
+				Donya::Vector3	max;					// The maximum corner of AABB that contains all polygons of this node.
+				int				childOrFirst	= 0;	// Leaf: the first index of "bvhPolygonIndices". Internal: the index of left child, the right child is next to it.
+				int				polygonCount	= 0;	// Zero means the internal node.
+			public:
+				bool IsLeaf() const { return ( 0 < polygonCount ); }
+			};
+		private:
+			// The polygons are packed as structure of arrays. The polygon of index "i" uses the elements of [i * 3 + 0 ~ 2] in the per-vertex buffers.
+
+			CullMode						cullMode = CullMode::Back;
+			Donya::Vector4x4				coordinateConversion;
+			std::vector<Donya::Vector3>		vertices;			// Per-vertex. Model space. These are stored in the order of regarding as CW by the "cullMode".
+			std::vector<int>				materialIds;		// Per-polygon. The index of "materials".
+			std::vector<PolygonMaterial>	materials;			// The unique materials that used by polygons.
+			std::vector<Donya::Vector3>		edges;				// Per-vertex. [0:AB][1:BC][2:CA]. Built from "vertices", and does not serialize.
+			std::vector<Donya::Vector3>		normals;			// Per-polygon. Normalized. Built from "vertices", and does not serialize.
+			std::vector<BVHNode>			bvhNodes;			// [0] is the root if not empty.
+			std::vector<int>				bvhPolygonIndices;	// The indices of polygon that sorted by leaf.
 		private:
 			friend class cereal::access;
 			template<class Archive>
@@ -80,12 +137,34 @@ namespace Donya
 				archive
 				(
 					CEREAL_NVP( cullMode ),
-					CEREAL_NVP( coordinateConversion ),
-					CEREAL_NVP( polygons )
+					CEREAL_NVP( coordinateConversion )
 				);
+				if ( version < 1 )
+				{
+					// The old version have stored the array of Polygon. This is reached only when loading.
+					std::vector<Polygon> polygons;
+					archive( CEREAL_NVP( polygons ) );
+					Pack( polygons );
+				}
 				if ( 1 <= version )
 				{
-					// archive();
+					archive
+					(
+						CEREAL_NVP( vertices ),
+						CEREAL_NVP( materialIds ),
+						CEREAL_NVP( materials )
+					);
+				}
+				if ( 2 <= version )
+				{
+					// archive( CEREAL_NVP( x ) );
+				}
+
+				if ( Archive::is_loading::value )
+				{
+					// The edges, normals and BVH are not serialized, so I should build those from loaded polygons.
+					BuildPolygonAttributes();
+					BuildBVH();
 				}
 			}
 		public:
@@ -99,9 +178,19 @@ namespace Donya
 			/// Apply a coordinate conversion matrix to all polygons. So it is heavy.
 			/// </summary>
 			void ApplyCoordinateConversion( const Donya::Vector4x4 &coordinateConversion );
+			/// <summary>
+			/// Apply the "transform" to all polygons directly, then rebuild the BVH. So it is heavy.<para></para>
+			/// This is useful for baking a static world transform, then you can use the Raycast() without the transform of ray.
+			/// </summary>
+			void BakeTransform( const Donya::Vector4x4 &transform );
 		public:
 			void Assign( std::vector<Polygon> &rvPolygons );
 			void Assign( const std::vector<Polygon> &polygons );
+			/// <summary>
+			/// Assigns the packed data as it is(e.g. that was got by the getters of packed data), then builds the attributes and the BVH.<para></para>
+			/// The "vertices" must have the "materialIds.size() * 3" elements, and those must be in the order of the "cullMode".
+			/// </summary>
+			void AssignPacked( CullMode cullMode, const Donya::Vector4x4 &coordinateConversion, std::vector<Donya::Vector3> &&vertices, std::vector<int> &&materialIds, std::vector<PolygonMaterial> &&materials );
 		public:
 			/// <summary>
 			/// If you set true to "onlyWantIsIntersect", This method will stop as soon if the ray intersects anything. This is a convenience if you just want to know the ray will intersection.
@@ -109,33 +198,99 @@ namespace Donya
 			RaycastResult Raycast( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd, bool onlyWantIsIntersect = false ) const;
 			/// <summary>
 			/// Doing the Raycast in the space that represented by "worldTransform". The belong space of the members of the return value is "worldTransform" also.<para></para>
+			/// The inverse matrix is calculated every time if the "worldTransform" is not identity. If the transform is static, please consider BakeTransform().<para></para>
 			/// If you set true to "onlyWantIsIntersect", This method will stop as soon if the ray intersects anything. This is a convenience if you just want to know the ray will intersection.
 			/// </summary>
 			RaycastResult RaycastWorldSpace( const Donya::Vector4x4 &worldTransformOfPolygon, const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd, bool onlyWantIsIntersect = false ) const;
-		private:
 			/// <summary>
-			/// The points and normal will be reassigned by current cullMode.
+			/// Doing the RaycastWorldSpace() to many rays at once. The inverse of "worldTransformOfPolygon" is calculated only once, and the rays are traversed by the packet of four.<para></para>
+			/// The "pOutputResults" must have the "rayCount" elements at least. Each result is same as the RaycastWorldSpace() of that ray.
 			/// </summary>
-			void ApplyMatrixToAllPolygon( const Donya::Vector4x4 &transform );
+			void RaycastBatch( const Donya::Vector4x4 &worldTransformOfPolygon, const RaySegment *pRays, size_t rayCount, RaycastResult *pOutputResults, bool onlyWantIsIntersect = false ) const;
+			/// <summary>
+			/// Doing the RaycastWorldSpace() to many rays at once. The inverse of "worldTransformOfPolygon" is calculated only once, and the rays are traversed by the packet of four.<para></para>
+			/// Returns the results in the same order as "rays".
+			/// </summary>
+			std::vector<RaycastResult> RaycastBatch( const Donya::Vector4x4 &worldTransformOfPolygon, const std::vector<RaySegment> &rays, bool onlyWantIsIntersect = false ) const;
+			/// <summary>
+			/// Same as Raycast(), but tests all polygons linearly without the BVH. This is slow, please use it only for validation of Raycast().
+			/// </summary>
+			RaycastResult RaycastBruteForce( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd, bool onlyWantIsIntersect = false ) const;
+		public:
+			/// <summary>
+			/// Returns the count of the matrix inversion by RaycastWorldSpace() and RaycastBatch() of all instances, since last reset. This is for profiling.
+			/// </summary>
+			static int  GetInversionCount();
+			static void ResetInversionCount();
+		public:
+			size_t GetPolygonCount() const { return materialIds.size(); }
+			// The packed data as it is. Those are used for storing this by the other way than cereal.
+			const Donya::Vector4x4				&GetCoordinateConversion()	const { return coordinateConversion;	}
+			const std::vector<Donya::Vector3>	&GetPackedVertices()		const { return vertices;				}
+			const std::vector<int>				&GetPackedMaterialIds()		const { return materialIds;				}
+			const std::vector<PolygonMaterial>	&GetMaterials()				const { return materials;				}
+			/// <summary>
+			/// Returns the model space polygon that reconstructed from packed data. So it is slow, please do not use in hot paths.
+			/// </summary>
+			Polygon GetPolygon( int polygonIndex ) const;
+			/// <summary>
+			/// Returns empty if the "polygonIndex" is invalid.
+			/// </summary>
+			const std::string &GetMaterialName( int polygonIndex ) const;
+			/// <summary>
+			/// Returns -1 if the "polygonIndex" is invalid.
+			/// </summary>
+			int GetMaterialIndex( int polygonIndex ) const;
+			size_t GetBVHNodeCount() const { return bvhNodes.size(); }
 			/// <summary>
-			/// Set the normal of all polygon by cullMode.
+			/// Outputs the AABB that contains all polygons. Returns false if the polygons are empty.
 			/// </summary>
-			void CalcAllPolygonNormal();
+			bool GetBoundingBox( Donya::Vector3 *pOutputMin, Donya::Vector3 *pOutputMax ) const
+			{
+				if ( bvhNodes.empty() ) { return false; }
+				// else
+				*pOutputMin = bvhNodes.front().min;
+				*pOutputMax = bvhNodes.front().max;
+				return true;
+			}
 		private:
 			/// <summary>
-			/// Calculate the normal of the points by cullMode.
+			/// Assign the polygons as packed. The order of vertices is converted by current cullMode.
+			/// </summary>
+			void Pack( const std::vector<Polygon> &source );
+			/// <summary>
+			/// Rebuild the edges and normals by current vertices.
+			/// </summary>
+			void BuildPolygonAttributes();
+			/// <summary>
+			/// Rebuild the BVH by current vertices. So heavy.
 			/// </summary>
-			Donya::Vector3 CalcNormalByOrder( const std::array<Donya::Vector3, 3> &source ) const;
+			void BuildBVH();
 			/// <summary>
-			/// Extract by cullMode. Returns [0:AB][1:BC][2:CA].
+			/// Raycast() by the rays up to four at once. The BVH is traversed only once for the packet, and the boxes are tested by SIMD.
 			/// </summary>
-			std::array<Donya::Vector3, 3> ExtractPolygonEdges( const std::array<Donya::Vector3, 3> &source ) const;
+			void RaycastPacket( const RaySegment *pRays, int rayCount, RaycastResult *pOutputResults, bool onlyWantIsIntersect ) const;
+			/// <summary>
+			/// Convert the members of model space result into the space that represented by "transform".
+			/// </summary>
+			void TransformResultToWorldSpace( const Donya::Vector4x4 &transform, const Donya::Vector3 &wsRayStart, RaycastResult *pResult ) const;
+			/// <summary>
+			/// Returns true if the ray intersects to the polygon, then output the distance and the intersection point.
+			/// </summary>
+			bool IntersectPolygon( int polygonIndex, const Donya::Vector3 &rayStart, const Donya::Vector3 &rayVec, const Donya::Vector3 &nRayVec, float nearestDistance, bool acceptSameDistance, float *pOutputDistance, Donya::Vector3 *pOutputIntersection ) const;
+		private:
+			/// <summary>
+			/// Apply the matrix to all vertices, then rebuild the edges and normals.
+			/// </summary>
+			void ApplyMatrixToAllPolygon( const Donya::Vector4x4 &transform );
+		private:
 			/// <summary>
-			/// Access by cullMode.
+			/// Access by cullMode. This converts between the definition order of Polygon and the order of "vertices".
 			/// </summary>
 			Donya::Vector3 ArrayAccess( const std::array<Donya::Vector3, 3> &source, size_t index ) const;
 		};
 	}
 }
-CEREAL_CLASS_VERSION( Donya::Model::Polygon,		1 )
-CEREAL_CLASS_VERSION( Donya::Model::PolygonGroup,	0 )
+CEREAL_CLASS_VERSION( Donya::Model::Polygon,			1 )
+CEREAL_CLASS_VERSION( Donya::Model::PolygonMaterial,	0 )
+CEREAL_CLASS_VERSION( Donya::Model::PolygonGroup,		1 )
@@ -1,81 +1,214 @@
 #include "ModelPose.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#undef max
+#undef min
+
 namespace Donya
 {
 	namespace Model
 	{
-		const std::vector<Animation::Node> &Pose::GetCurrentPose() const { return skeletal; }
-
-		bool Pose::HasCompatibleWith( const std::vector<Animation::Node> &validation ) const
+		namespace
 		{
-			/*
-			Requirements:
-				1. The bone count is the same.
-				2. Each bones name are the same as others.
-			*/
+			constexpr unsigned char CHANGED_LOCAL	= 1 << 0;	// The transform was changed by SetTransform().
+			constexpr unsigned char CHANGED_GLOBAL	= 1 << 1;	// The global matrix was recalculated in the current propagation.
 
-			// No.1
-			if ( validation.size() != skeletal.size() ) { return false; }
-			// else
+			// Shared by all poses, so a version is never used twice. It is atomic because the poses are evaluated in parallel.
+			static std::atomic<std::uint64_t> latestVersion{ 0 };
 
-			// No.2
-			const size_t boneCount = skeletal.size();
-			for ( size_t i = 0;  i < boneCount; ++i )
+			/// <summary>
+			/// Same as Animation::Transform::ToWorldMatrix(), but keeps the result in the register.
+			/// </summary>
+			DirectX::XMMATRIX MakeLocalMatrix( const Animation::Transform &transform )
 			{
-				if ( validation[i].bone.name != skeletal[i].bone.name )
-				{
-					return false;
-				}
+				using namespace DirectX;
+
+				const Donya::Vector4x4 rotation = transform.rotation.MakeRotationMatrix();
+				XMMATRIX m = XMMatrixMultiply
+				(
+					XMMatrixScaling( transform.scale.x, transform.scale.y, transform.scale.z ),
+					XMLoadFloat4x4( &rotation )
+				);
+
+				const XMVECTOR translation = XMVectorSet( transform.translation.x, transform.translation.y, transform.translation.z, 0.0f );
+				m.r[3] = XMVectorSelect( m.r[3], translation, g_XMSelect1110 );
+				return m;
 			}
+		}
+
+		size_t Pose::GetBoneCount() const { return globals.size(); }
+		const std::shared_ptr<const Skeleton>	&Pose::GetSkeleton()		const { return pSkeleton;	}
+		const std::vector<Animation::Transform>	&Pose::GetTransforms()		const { return transforms;	}
+		const std::vector<Donya::Vector4x4>		&Pose::GetLocalMatrices()	const { return locals;		}
+		const std::vector<Donya::Vector4x4>		&Pose::GetGlobalMatrices()	const { return globals;		}
 
-			return true;
+		bool Pose::HasCompatibleWith( const std::vector<Animation::Node> &validation ) const
+		{
+			if ( !pSkeleton ) { return validation.empty(); }
+			// else
+			return pSkeleton->IsCompatibleWith( validation );
 		}
 		bool Pose::HasCompatibleWith( const Animation::KeyFrame &validation ) const
 		{
 			return HasCompatibleWith( validation.keyPose );
 		}
+		bool Pose::HasCompatibleWith( const MotionClip &validation ) const
+		{
+			const auto &pOther = validation.GetSkeleton();
+			if ( pSkeleton == pOther ) { return true; }
+			if ( !pSkeleton || !pOther ) { return false; }
+			// else
+			return pSkeleton->IsCompatibleWith( *pOther );
+		}
 
 		void Pose::AssignSkeletal( const std::vector<Animation::Node> &newPose )
 		{
+			// The skeleton is rebuilt only when the hierarchy was changed.
+			if ( !pSkeleton || !pSkeleton->IsCompatibleWith( newPose ) )
+			{
+				pSkeleton = std::make_shared<const Skeleton>( newPose );
+			}
+
 			const size_t newSize = newPose.size();
-			skeletal.clear();
-			skeletal.resize( newSize );
+			Resize( newSize );
 
 			for ( size_t i = 0; i < newSize; ++i )
 			{
-				skeletal[i] = newPose[i];
+				transforms[i]	= newPose[i].bone.transform;
+				locals[i]		= newPose[i].local;
+				globals[i]		= newPose[i].global;
 			}
+
+			CommitMatrices();
 		}
 		void Pose::AssignSkeletal( const Animation::KeyFrame &newKeyFrame )
 		{
 			AssignSkeletal( newKeyFrame.keyPose );
 		}
+		void Pose::AssignSkeletal( const MotionClip &motion, size_t keyIndex )
+		{
+			AssignSkeleton( motion.GetSkeleton(), motion.GetBoneCount() );
+			motion.Sample( keyIndex, transforms.data(), locals.data(), globals.data() );
+			CommitMatrices();
+		}
+		void Pose::AssignSkeletal( const MotionClip &motion, size_t keyIndexL, size_t keyIndexR, float percent )
+		{
+			AssignSkeleton( motion.GetSkeleton(), motion.GetBoneCount() );
+			motion.Sample( keyIndexL, keyIndexR, percent, transforms.data(), locals.data(), globals.data() );
+			CommitMatrices();
+		}
+		void Pose::AssignSkeletal( const CompressedClip &motion, size_t keyIndex )
+		{
+			AssignSkeleton( motion.GetSkeleton(), motion.GetBoneCount() );
+			motion.Sample( keyIndex, transforms.data(), locals.data(), globals.data() );
+			CommitMatrices();
+		}
+		void Pose::AssignSkeletal( const CompressedClip &motion, size_t keyIndexL, size_t keyIndexR, float percent )
+		{
+			AssignSkeleton( motion.GetSkeleton(), motion.GetBoneCount() );
+			motion.Sample( keyIndexL, keyIndexR, percent, transforms.data(), locals.data(), globals.data() );
+			CommitMatrices();
+		}
+
+		void Pose::SetTransform( size_t boneIndex, const Animation::Transform &transform )
+		{
+			if ( transforms.size() <= boneIndex ) { return; }
+			// else
+
+			transforms[boneIndex]	=  transform;
+			changedFlags[boneIndex]	|= CHANGED_LOCAL;
+		}
 
 		void Pose::UpdateTransformMatrices()
 		{
-			UpdateLocalMatrices();
-			UpdateGlobalMatrices();
+			PropagateMatrices( /* onlyChanged = */ false );
+			CommitMatrices();
+		}
+		void Pose::UpdateChangedTransformMatrices()
+		{
+			PropagateMatrices( /* onlyChanged = */ true );
+			CommitMatrices();
 		}
-		void Pose::UpdateLocalMatrices()
+		void Pose::Resize( size_t boneCount )
 		{
-			for ( auto &it : skeletal )
+			if ( boneCount == globals.size() ) { return; }
+			// else
+
+			transforms.resize( boneCount );
+			locals.resize( boneCount );
+			globals.resize( boneCount );
+			changedFlags.resize( boneCount );
+		}
+		void Pose::AssignSkeleton( const std::shared_ptr<const Skeleton> &pMotionSkeleton, size_t boneCount )
+		{
+			// Sharing the motion's skeleton does not allocate.
+			if ( pSkeleton != pMotionSkeleton )
 			{
-				it.local = it.bone.transform.ToWorldMatrix();
+				pSkeleton = pMotionSkeleton;
 			}
+
+			Resize( boneCount );
+		}
+		void Pose::CommitMatrices()
+		{
+			std::fill( changedFlags.begin(), changedFlags.end(), scast<unsigned char>( 0 ) );
+			version = ++latestVersion;
 		}
-		void Pose::UpdateGlobalMatrices()
+		void Pose::PropagateMatrices( bool onlyChanged )
 		{
-			for ( auto &it : skeletal )
+			if ( !pSkeleton ) { return; }
+			// else
+			using namespace DirectX;
+
+			const size_t boneCount = std::min( globals.size(), pSkeleton->GetBoneCount() );
+			if ( workGlobals.size() < boneCount ) { workGlobals.resize( boneCount ); }
+
+			// The parent is always placed before own children in this order, so the global matrix of the parent has been calculated.
+			const auto &parentIndices	= pSkeleton->GetParentIndices();
+			const auto &evaluationOrder	= pSkeleton->GetEvaluationOrder();
+			for ( const size_t b : evaluationOrder )
 			{
-				if ( it.bone.parentIndex == -1 )
+				if ( boneCount <= b ) { continue; }
+				// else
+
+				const int  parentIndex		= parentIndices[b];
+				const bool hasParent		= ( parentIndex != -1 );
+				const bool localChanged		= !onlyChanged || ( changedFlags[b] & CHANGED_LOCAL );
+				const bool parentChanged	= hasParent && ( !onlyChanged || ( changedFlags[parentIndex] & CHANGED_GLOBAL ) );
+				if ( !localChanged && !parentChanged ) { continue; }
+				// else
+
+				XMMATRIX local{};
+				if ( localChanged )
+				{
+					local = MakeLocalMatrix( transforms[b] );
+					XMStoreFloat4x4( &locals[b], local );
+				}
+				else
+				{
+					local = XMLoadFloat4x4( &locals[b] );
+				}
+
+				XMMATRIX &global = workGlobals[b];
+				if ( !hasParent )
 				{
-					it.global = it.local;
+					global = local;
+				}
+				else if ( parentChanged )
+				{
+					global = XMMatrixMultiply( local, workGlobals[parentIndex] );
 				}
 				else
 				{
-					const auto &parentBone = skeletal[it.bone.parentIndex];
-					it.global = it.local * parentBone.global;
+					global = XMMatrixMultiply( local, XMLoadFloat4x4( &globals[parentIndex] ) );
 				}
+				XMStoreFloat4x4( &globals[b], global );
+
+				changedFlags[b] |= CHANGED_GLOBAL;
 			}
 		}
 	}
@@ -1,22 +1,54 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "Donya/Template.h"	// Use AlignedAllocator.
+
 #include "ModelCommon.h"
+#include "ModelCompression.h"
+#include "ModelSkeleton.h"
 
 namespace Donya
 {
 	namespace Model
 	{
 		/// <summary>
-		/// This class represents a skeletal, and this can update and provide a transform matrices of a skeletal. That matrix transforms space is bone space -> current mesh space.
+		/// This class represents a skeletal, and this can update and provide a transform matrices of a skeletal. That matrix transforms space is bone space -> current mesh space.<para></para>
+		/// The names and the hierarchy are shared by the Skeleton, and this holds only the current transforms of each bone.
+		/// The internal buffers are reused, so the assignment of the same skeleton does not allocate.
 		/// </summary>
 		class Pose
 		{
 		private:
-			std::vector<Animation::Node> skeletal;	// Provides the matrices of the current pose. That transforms space is bone -> mesh.
+			using MatrixBuffer = std::vector<DirectX::XMMATRIX, Donya::AlignedAllocator<DirectX::XMMATRIX>>;
+		private:
+			std::shared_ptr<const Skeleton>		pSkeleton;
+			std::vector<Animation::Transform>	transforms;	// Local transform(bone -> mesh) of each bone.
+			std::vector<Donya::Vector4x4>		locals;		// Transforms bone space -> mesh space.
+			std::vector<Donya::Vector4x4>		globals;	// Transforms bone space -> mesh space of the current pose.
+			MatrixBuffer						workGlobals;// The globals that kept in the registers' format while calculating, so the children do not reload those.
+			std::vector<unsigned char>			changedFlags;
+			std::uint64_t						version = 0;// Renewed whenever the matrices are changed.
 		public:
-			const std::vector<Animation::Node> &GetCurrentPose() const;
+			size_t GetBoneCount() const;
+			/// <summary>
+			/// The version is renewed whenever the matrices are changed, and it is unique between all poses.
+			/// So the same version means the same matrices, even if those are different instances(e.g. the copies).
+			/// Zero means the matrices have never been assigned.
+			/// </summary>
+			std::uint64_t GetVersion() const { return version; }
+			/// <summary>
+			/// Returns nullptr if any skeletal has not assigned.
+			/// </summary>
+			const std::shared_ptr<const Skeleton>	&GetSkeleton() const;
+			const std::vector<Animation::Transform>	&GetTransforms() const;
+			const std::vector<Donya::Vector4x4>		&GetLocalMatrices() const;
+			/// <summary>
+			/// Provides the matrices of the current pose. That transforms space is bone -> mesh.
+			/// </summary>
+			const std::vector<Donya::Vector4x4>		&GetGlobalMatrices() const;
 
 			/// <summary>
 			/// The "compatible" means the argument is associate with internal skeletal.
@@ -28,6 +60,11 @@ namespace Donya
 			/// e.g. the skeletal belong in the same motion, but another timing.
 			/// </summary>
 			bool HasCompatibleWith( const Animation::KeyFrame &validation ) const;
+			/// <summary>
+			/// The "compatible" means the argument is associate with internal skeletal.
+			/// e.g. the skeletal belong in the same motion, but another timing.
+			/// </summary>
+			bool HasCompatibleWith( const MotionClip &validation ) const;
 		public:
 			/// <summary>
 			/// Assign the skeletal by the argument.
@@ -37,14 +74,47 @@ namespace Donya
 			/// Assign the skeletal by key-pose of the argument.
 			/// </summary>
 			void AssignSkeletal( const Animation::KeyFrame &newSkeletal );
+			/// <summary>
+			/// Assign the skeletal by a key of the motion.
+			/// </summary>
+			void AssignSkeletal( const MotionClip &motion, size_t keyIndex );
+			/// <summary>
+			/// Assign the skeletal by the interpolation between two keys of the motion.
+			/// </summary>
+			void AssignSkeletal( const MotionClip &motion, size_t keyIndexL, size_t keyIndexR, float percent );
+			/// <summary>
+			/// Assign the skeletal by decoding a key of the motion.
+			/// </summary>
+			void AssignSkeletal( const CompressedClip &motion, size_t keyIndex );
+			/// <summary>
+			/// Assign the skeletal by decoding the interpolation between two keys of the motion.
+			/// </summary>
+			void AssignSkeletal( const CompressedClip &motion, size_t keyIndexL, size_t keyIndexR, float percent );
+			/// <summary>
+			/// Changes the local transform of a bone. The matrices are not changed until calling UpdateTransformMatrices() or UpdateChangedTransformMatrices().
+			/// </summary>
+			void SetTransform( size_t boneIndex, const Animation::Transform &transform );
 		public:
 			/// <summary>
 			/// Calculate the transform matrix of each node of internal skeletal. So it is heavy,
 			/// </summary>
 			void UpdateTransformMatrices();
+			/// <summary>
+			/// Calculate the transform matrices of the bones that changed by SetTransform() and those descendants only.<para></para>
+			/// The result is the same as UpdateTransformMatrices() if the matrices of the other bones are up to date.
+			/// </summary>
+			void UpdateChangedTransformMatrices();
 		private:
-			void UpdateLocalMatrices();
-			void UpdateGlobalMatrices();
+			void Resize( size_t boneCount );
+			void AssignSkeleton( const std::shared_ptr<const Skeleton> &pMotionSkeleton, size_t boneCount );
+			/// <summary>
+			/// Clears the changed flags, and renews the version. Call this after the matrices are changed.
+			/// </summary>
+			void CommitMatrices();
+			/// <summary>
+			/// Calculates the matrices by the evaluation order of the skeleton. The bones that "onlyChanged" is true and not changed are skipped.
+			/// </summary>
+			void PropagateMatrices( bool onlyChanged );
 		};
 	}
 }
@@ -0,0 +1,168 @@
+#include "ModelPoseCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>		// Use std::hash.
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#include "ModelAnimationBatch.h"
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Model
+	{
+		float PoseCache::Counter::CalcHitRate() const
+		{
+			const size_t sum = hit + miss;
+			return ( sum ) ? scast<float>( hit ) / scast<float>( sum ) : 0.0f;
+		}
+
+		size_t PoseCache::KeyHash::operator()( const Key &key ) const
+		{
+			size_t hash = std::hash<const void *>()( key.pMotion );
+			hash ^= std::hash<float>()( key.sampleSeconds ) + 0x9E3779B9 + ( hash << 6 ) + ( hash >> 2 );
+			hash ^= scast<size_t>( key.enableLoop );
+			return hash;
+		}
+
+		PoseCache::PoseCache( float argQuantizeSeconds )
+		{
+			SetQuantizeSeconds( argQuantizeSeconds );
+		}
+
+		void  PoseCache::SetQuantizeSeconds( float seconds )
+		{
+			quantizeSeconds = std::max( 0.0f, seconds );
+		}
+
+		void PoseCache::BeginFrame()
+		{
+			// The holders release those when they fetch the pose of this frame, then those can be reused.
+			for ( auto &it : entries )
+			{
+				pool.emplace_back( std::move( it.second ) );
+			}
+			entries.clear();
+
+			lastCounter			=  currentCounter;
+			totalCounter.hit	+= currentCounter.hit;
+			totalCounter.miss	+= currentCounter.miss;
+			currentCounter		=  Counter{};
+		}
+
+		std::shared_ptr<const Pose> PoseCache::Fetch( const MotionClip &motion, const Animator &animator, bool *pWasCached )
+		{
+			if ( pWasCached ) { *pWasCached = false; }
+
+			if ( motion.IsEmpty() ) { return nullptr; }
+			// else
+
+			const Key key = MakeKey( motion, animator );
+			const auto found = entries.find( key );
+			if ( found != entries.end() )
+			{
+				currentCounter.hit++;
+				if ( pWasCached ) { *pWasCached = true; }
+				return found->second;
+			}
+			// else
+
+			currentCounter.miss++;
+
+			// Evaluate at the quantized time, so the result does not depend on who evaluates it first.
+			Animator sampler = animator;
+			sampler.SetInternalElapsedTime( key.sampleSeconds );
+
+			std::shared_ptr<Pose> pPose = AcquirePose();
+			if ( pDeferredBatch )
+			{
+				// The entries keep the pose alive until the next BeginFrame().
+				pDeferredBatch->Append( sampler, motion, pPose.get() );
+			}
+			else
+			{
+				sampler.CalcCurrentPose( motion, pPose.get() );
+			}
+
+			entries.emplace( key, pPose );
+			return pPose;
+		}
+
+		void PoseCache::ResetCounters()
+		{
+			currentCounter	= Counter{};
+			lastCounter		= Counter{};
+			totalCounter	= Counter{};
+		}
+
+		PoseCache::Key PoseCache::MakeKey( const MotionClip &motion, const Animator &animator ) const
+		{
+			Key key{};
+			key.pMotion			= &motion;
+			key.sampleSeconds	= animator.CalcPlaybackSeconds( motion );
+			key.enableLoop		= animator.IsEnableLoop();
+
+			// The clamped time is kept, because the last key is sampled only at there.
+			const bool isClamped = ( 2 <= motion.GetKeyCount() && motion.GetWholeSeconds() <= key.sampleSeconds );
+			if ( 0.0f < quantizeSeconds && !isClamped )
+			{
+				key.sampleSeconds = floorf( key.sampleSeconds / quantizeSeconds ) * quantizeSeconds;
+			}
+
+			return key;
+		}
+		std::shared_ptr<Pose> PoseCache::AcquirePose()
+		{
+			// The pose that someone still holds must not be changed.
+			const auto found = std::find_if
+			(
+				pool.begin(), pool.end(),
+				[]( const std::shared_ptr<Pose> &pPose )
+				{
+					return pPose.use_count() == 1;
+				}
+			);
+			if ( found == pool.end() ) { return std::make_shared<Pose>(); }
+			// else
+
+			std::iter_swap( found, pool.end() - 1 );
+			std::shared_ptr<Pose> pPose = std::move( pool.back() );
+			pool.pop_back();
+			return pPose;
+		}
+
+	#if USE_IMGUI
+		void PoseCache::ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			auto ShowCounter = []( const char *caption, const Counter &counter )
+			{
+				ImGui::Text
+				(
+					"%s : Hit[%d], Miss[%d], Rate[%5.1f%%]",
+					caption,
+					scast<int>( counter.hit ),
+					scast<int>( counter.miss ),
+					counter.CalcHitRate() * 100.0f
+				);
+			};
+			ShowCounter( "Last frame",	lastCounter		);
+			ShowCounter( "Total",		totalCounter	);
+			ImGui::Text( "Pooled poses : %d", scast<int>( pool.size() ) );
+
+			if ( ImGui::Button( "Reset counters" ) )
+			{
+				ResetCounters();
+			}
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ModelMotion.h"
+#include "ModelPose.h"
+#include "ModelSkeleton.h"
+#include "UseImGui.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		class AnimationBatch;
+
+		/// <summary>
+		/// Shares the evaluated poses between the users that sample the same motion at the same(quantized) time in a frame.<para></para>
+		/// A fetched pose is not changed while someone holds it, so an user that goes to another time gets another pose(copy-on-divergence).
+		/// The cached poses are valid until the next BeginFrame(). This is not thread-safe.
+		/// </summary>
+		class PoseCache
+		{
+		public:
+			struct Counter
+			{
+				size_t hit	= 0;
+				size_t miss	= 0;
+			public:
+				float CalcHitRate() const;
+			};
+		private:
+			struct Key
+			{
+				const MotionClip	*pMotion		= nullptr;
+				float				sampleSeconds	= 0.0f;
+				bool				enableLoop		= true;	// The sampling at the last key depends on this.
+			public:
+				bool operator == ( const Key &other ) const
+				{
+					return
+						pMotion			== other.pMotion		&&
+						sampleSeconds	== other.sampleSeconds	&&
+						enableLoop		== other.enableLoop		;
+				}
+			};
+			struct KeyHash
+			{
+				size_t operator()( const Key &key ) const;
+			};
+		private:
+			float														quantizeSeconds = 0.0f;	// Zero means the exact time.
+			std::unordered_map<Key, std::shared_ptr<Pose>, KeyHash>		entries;		// The poses that were evaluated in the current frame.
+			std::vector<std::shared_ptr<Pose>>							pool;			// The poses of previous frames. Those are reused after the holders released, for avoiding the allocation.
+			Counter														currentCounter;
+			Counter														lastCounter;	// The result of the previous frame.
+			Counter														totalCounter;
+			AnimationBatch												*pDeferredBatch = nullptr;
+		public:
+			PoseCache() = default;
+			explicit PoseCache( float quantizeSeconds );
+		public:
+			/// <summary>
+			/// Set the step of the sampling time. The users in the same step share the pose that was evaluated at the begin of the step.
+			/// </summary>
+			void  SetQuantizeSeconds( float seconds );
+			float GetQuantizeSeconds() const { return quantizeSeconds; }
+			/// <summary>
+			/// If set, the evaluations of Fetch() are appended to the batch instead of evaluating at there. Then the fetched pose is valid after the batch is evaluated.<para></para>
+			/// Set nullptr for evaluating immediately.
+			/// </summary>
+			void  SetDeferredBatch( AnimationBatch *pBatch ) { pDeferredBatch = pBatch; }
+		public:
+			/// <summary>
+			/// Drops the poses of the previous frame. Please call this once per frame, before fetching the poses.
+			/// </summary>
+			void BeginFrame();
+			/// <summary>
+			/// Returns the pose of "motion" at the current time of "animator". The pose is evaluated only if it was not evaluated in this frame.<para></para>
+			/// Returns nullptr if the motion is empty. The "pWasCached" receives whether the pose was already evaluated in this frame, if it is not nullptr.
+			/// </summary>
+			std::shared_ptr<const Pose> Fetch( const MotionClip &motion, const Animator &animator, bool *pWasCached = nullptr );
+		public:
+			size_t			GetEntryCount()		const { return entries.size();	}
+			const Counter	&GetLastCounter()	const { return lastCounter;		}
+			const Counter	&GetTotalCounter()	const { return totalCounter;	}
+			void ResetCounters();
+		private:
+			Key MakeKey( const MotionClip &motion, const Animator &animator ) const;
+			std::shared_ptr<Pose> AcquirePose();
+		public:
+		#if USE_IMGUI
+			void ShowImGuiNode( const std::string &nodeCaption );
+		#endif // USE_IMGUI
+		};
+	}
+}
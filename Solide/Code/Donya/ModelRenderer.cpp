@@ -1,5 +1,6 @@
 #include "ModelRenderer.h"
 
+#include <algorithm>
 #include <exception>
 #include <tuple>
 
@@ -861,7 +862,7 @@ namespace Donya
 			{
 				const auto &meshes	= model.GetMeshes();
 				const auto &mesh	= meshes[meshIndex];
-				return pose.GetCurrentPose()[mesh.boneIndex].global;
+				return pose.GetGlobalMatrices()[mesh.boneIndex];
 			}
 		}
 
@@ -963,31 +964,38 @@ namespace Donya
 				model.GetCoordinateConversion();
 			return constants;
 		}
-		Constants::PerMesh::Bone   SkinningRenderer::MakeBoneConstants( const Model &model, size_t meshIndex, const Pose &pose ) const
+		void SkinningRenderer::BeginFrame()
+		{
+			paletteCache.BeginFrame();
+		}
+	#if USE_IMGUI
+		void SkinningRenderer::ShowImGuiNode( const std::string &nodeCaption )
+		{
+			paletteCache.ShowImGuiNode( nodeCaption );
+		}
+	#endif // USE_IMGUI
+		Constants::PerMesh::Bone   SkinningRenderer::MakeBoneConstants( const Model &model, size_t meshIndex, const Pose &pose )
 		{
 			const auto &meshes		= model.GetMeshes();
 			const auto &mesh		= meshes[meshIndex];
-			const auto &currentPose	= pose.GetCurrentPose();
+			const auto &currentPose	= pose.GetGlobalMatrices();
 			Constants::PerMesh::Bone constants{};
 
 			if ( mesh.boneIndices.empty() )
 			{
-				constants.boneTransforms[0] = currentPose[mesh.boneIndex].global;
+				constants.boneTransforms[0] = currentPose[mesh.boneIndex];
 				return constants;
 			}
 			// else
 
-			Donya::Vector4x4 meshToBone{}; // So-called "Bone offset matrix".
-			Donya::Vector4x4 boneToMesh{}; // Transform to mesh space of current pose.
-			const size_t boneCount = std::min( mesh.boneIndices.size(), scast<size_t>( Constants::PerMesh::Bone::MAX_BONE_COUNT ) );
-			for ( size_t i = 0; i < boneCount; ++i )
-			{
-				const size_t poseIndex = mesh.boneIndices[i]; // This index was fetched with boneOffset's name.
-				meshToBone = mesh.boneOffsets[i].global;
-				boneToMesh = currentPose[poseIndex].global;
-				
-				constants.boneTransforms[i] = meshToBone * boneToMesh;
-			}
+			// The "bone offset matrix * transform to mesh space of current pose" of each bone. Those are rebuilt only when the pose was changed.
+			const auto &palette = paletteCache.Fetch
+			(
+				&model, meshIndex,
+				mesh.boneOffsets, mesh.boneIndices, pose,
+				scast<size_t>( Constants::PerMesh::Bone::MAX_BONE_COUNT )
+			);
+			std::copy( palette.begin(), palette.end(), constants.boneTransforms.begin() );
 
 			return constants;
 		}
@@ -11,6 +11,8 @@
 #include "ModelCommon.h"
 #include "ModelMotion.h"
 #include "ModelPose.h"
+#include "ModelSkinningPalette.h"
+#include "UseImGui.h"
 
 namespace Donya
 {
@@ -294,7 +296,8 @@ namespace Donya
 		class SkinningRenderer : public Renderer
 		{
 		private:
-			Impl::SkinningMeshConstant CBPerMesh;
+			Impl::SkinningMeshConstant	CBPerMesh;
+			SkinningPaletteCache		paletteCache;
 		public:
 			/// <summary>
 			/// If you set nullptr to "pDevice", use default device.
@@ -315,9 +318,16 @@ namespace Donya
 				const RegisterDesc	&textureMapDiffuse,
 				ID3D11DeviceContext	*pImmediateContext = nullptr
 			);
+			/// <summary>
+			/// Drops the cached bone matrices that were not used in the previous frame. Please call this once per frame, before drawing.
+			/// </summary>
+			void BeginFrame();
+		#if USE_IMGUI
+			void ShowImGuiNode( const std::string &nodeCaption );
+		#endif // USE_IMGUI
 		private:
 			Constants::PerMesh::Common MakeCommonConstantsPerMesh( const Model &model, size_t meshIndex, const Pose &pose ) const;
-			Constants::PerMesh::Bone   MakeBoneConstants( const Model &model, size_t meshIndex, const Pose &pose ) const;
+			Constants::PerMesh::Bone   MakeBoneConstants( const Model &model, size_t meshIndex, const Pose &pose );
 			void UpdateCBPerMesh( const Model &model, size_t meshIndex, const Pose &pose, const RegisterDesc &meshSetting, ID3D11DeviceContext *pImmediateContext );
 			void ActivateCBPerMesh( const RegisterDesc &meshSetting, ID3D11DeviceContext *pImmediateContext );
 			void DeactivateCBPerMesh( ID3D11DeviceContext *pImmediateContext );
@@ -0,0 +1,333 @@
+#include "ModelSkeleton.h"
+
+#include <algorithm>
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#include "ModelCompression.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		Skeleton::Skeleton( const std::vector<Animation::Node> &source )
+		{
+			const size_t boneCount = source.size();
+			names.resize( boneCount );
+			parentIndices.resize( boneCount );
+			bindTransforms.resize( boneCount );
+			bindGlobals.resize( boneCount );
+
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				const auto &node	= source[i];
+				names[i]			= node.bone.name;
+				parentIndices[i]	= node.bone.parentIndex;
+				bindTransforms[i]	= node.bone.transform;
+				bindGlobals[i]		= node.global;
+			}
+
+			BuildEvaluationOrder();
+		}
+		void Skeleton::BuildEvaluationOrder()
+		{
+			const size_t boneCount = parentIndices.size();
+			auto IsValidParent = [&boneCount]( int parentIndex, size_t boneIndex )
+			{
+				return ( 0 <= parentIndex && scast<size_t>( parentIndex ) < boneCount && scast<size_t>( parentIndex ) != boneIndex );
+			};
+
+			evaluationOrder.resize( boneCount );
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				evaluationOrder[i] = i;
+			}
+
+			isSourceOrder = true;
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				const int parentIndex = parentIndices[i];
+				if ( parentIndex == -1 ) { continue; }
+				// else
+
+				if ( !IsValidParent( parentIndex, i ) || i < scast<size_t>( parentIndex ) )
+				{
+					isSourceOrder = false;
+					break;
+				}
+			}
+			if ( isSourceOrder ) { return; }
+			// else
+
+			// Sort by the depth of hierarchy. The ancestors of a bone are always shallower than it.
+			std::vector<size_t> depths( boneCount, 0 );
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				size_t depth	= 0;
+				size_t current	= i;
+				while ( IsValidParent( parentIndices[current], current ) )
+				{
+					current = scast<size_t>( parentIndices[current] );
+					depth++;
+
+					// The cyclic hierarchy is treated as a root.
+					if ( boneCount <= depth ) { depth = 0; break; }
+				}
+				depths[i] = depth;
+			}
+			std::stable_sort
+			(
+				evaluationOrder.begin(), evaluationOrder.end(),
+				[&depths]( size_t lhs, size_t rhs )
+				{
+					return depths[lhs] < depths[rhs];
+				}
+			);
+
+			// Make the invalid parents as root, then the calculations do not need the validation.
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				if ( !IsValidParent( parentIndices[i], i ) || !depths[i] )
+				{
+					_ASSERT_EXPR( parentIndices[i] == -1, L"Error : The skeleton has an invalid parent index!" );
+					parentIndices[i] = -1;
+				}
+			}
+		}
+		int  Skeleton::FindBoneIndex( const std::string &boneName ) const
+		{
+			const size_t boneCount = names.size();
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				if ( names[i] == boneName )
+				{
+					return scast<int>( i );
+				}
+			}
+
+			return -1;
+		}
+		bool Skeleton::IsCompatibleWith( const Skeleton &validation ) const
+		{
+			if ( this == &validation ) { return true; }
+			// else
+			return ( names == validation.names );
+		}
+		bool Skeleton::IsCompatibleWith( const std::vector<Animation::Node> &validation ) const
+		{
+			if ( validation.size() != names.size() ) { return false; }
+			// else
+
+			const size_t boneCount = names.size();
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				if ( validation[i].bone.name != names[i] )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		KeyTimeline::KeyTimeline( const std::vector<float> &keySeconds ) :
+			seconds( keySeconds )
+		{
+			// Keep the same value as the average step that the interpolation between the last and the first used.
+			// That was calculated with the zero-filled steps of the same count, so it is a half of the actual average.
+			const size_t keyCount = seconds.size();
+			if ( 2 <= keyCount )
+			{
+				const size_t stepCount = keyCount - 1;
+				float sum = 0.0f;
+				for ( size_t i = 0; i < stepCount; ++i )
+				{
+					sum += seconds[i + 1] - seconds[i];
+				}
+				loopStepSeconds = sum / scast<float>( stepCount * 2 );
+
+				keyInterval = ( seconds.back() - seconds.front() ) / scast<float>( stepCount );
+				isSortedKeys = std::is_sorted( seconds.begin(), seconds.end() );
+			}
+		}
+		size_t KeyTimeline::FindKeyIndex( float currentSeconds ) const
+		{
+			const size_t keyCount = seconds.size();
+			if ( keyCount < 2 ) { return keyCount; }
+			// else
+
+			// The estimation requires that the found range is unique.
+			if ( !isSortedKeys || !( 0.0f < keyInterval ) ) { return FindKeyIndexLinearly( currentSeconds ); }
+			// else
+
+			const size_t lastRange = keyCount - 2;
+
+			const float estimation = ( currentSeconds - seconds.front() ) / keyInterval;
+			size_t index = 0;
+			if ( 0.0f < estimation ) // This also excludes NaN.
+			{
+				index = ( scast<float>( lastRange ) < estimation ) ? lastRange : scast<size_t>( estimation );
+			}
+
+			// Correct the error of estimation. It moves a few steps only if the keys are sampled by a constant rate.
+			while ( 0 < index			&& currentSeconds < seconds[index]		) { --index; }
+			while ( index < lastRange	&& seconds[index + 1] <= currentSeconds	) { ++index; }
+
+			if ( currentSeconds < seconds[index] || seconds[index + 1] <= currentSeconds ) { return keyCount; }
+			// else
+			return index;
+		}
+		size_t KeyTimeline::FindKeyIndexLinearly( float currentSeconds ) const
+		{
+			const size_t keyCount = seconds.size();
+			if ( keyCount < 2 ) { return keyCount; }
+			// else
+
+			for ( size_t i = 0; i < keyCount - 1; ++i )
+			{
+				if ( currentSeconds < seconds[i] || seconds[i + 1] <= currentSeconds ) { continue; }
+				// else
+				return i;
+			}
+
+			return keyCount;
+		}
+
+		MotionClip::MotionClip( const Animation::Motion &source, const std::shared_ptr<const Skeleton> &pArgSkeleton ) :
+			name( source.name ), pSkeleton( pArgSkeleton ), samplingRate( source.samplingRate ), animSeconds( source.animSeconds )
+		{
+			_ASSERT_EXPR( pSkeleton, L"Error : The skeleton of motion is null!" );
+			boneCount = ( pSkeleton ) ? pSkeleton->GetBoneCount() : 0;
+
+			const size_t keyCount = source.keyFrames.size();
+			std::vector<float> seconds( keyCount );
+			scales.resize( keyCount * boneCount );
+			rotations.resize( keyCount * boneCount );
+			translations.resize( keyCount * boneCount );
+			globals.resize( keyCount * boneCount );
+
+			for ( size_t k = 0; k < keyCount; ++k )
+			{
+				const auto &keyFrame = source.keyFrames[k];
+				_ASSERT_EXPR( pSkeleton && pSkeleton->IsCompatibleWith( keyFrame.keyPose ), L"Error : The key-pose is not compatible with the skeleton!" );
+
+				seconds[k] = keyFrame.seconds;
+
+				const size_t poseCount = std::min( boneCount, keyFrame.keyPose.size() );
+				for ( size_t b = 0; b < poseCount; ++b )
+				{
+					const auto &node		= keyFrame.keyPose[b];
+					const size_t index		= k * boneCount + b;
+					scales[index]			= node.bone.transform.scale;
+					rotations[index]		= node.bone.transform.rotation;
+					translations[index]		= node.bone.transform.translation;
+					globals[index]			= node.global;
+				}
+			}
+
+			timeline = KeyTimeline{ seconds };
+		}
+		MotionClip::MotionClip( const CompressedClip &source ) :
+			name( source.GetName() ), pSkeleton( source.GetSkeleton() ), samplingRate( source.GetSamplingRate() ), animSeconds( source.GetAnimSeconds() ),
+			boneCount( source.GetBoneCount() ), timeline( source.GetTimeline() )
+		{
+			const size_t keyCount = timeline.GetKeyCount();
+			scales.resize( keyCount * boneCount );
+			rotations.resize( keyCount * boneCount );
+			translations.resize( keyCount * boneCount );
+			globals.resize( keyCount * boneCount );
+
+			std::vector<Animation::Transform>	transforms( boneCount );
+			std::vector<Donya::Vector4x4>		locals( boneCount );
+			for ( size_t k = 0; k < keyCount; ++k )
+			{
+				const size_t offset = k * boneCount;
+				source.Sample( k, transforms.data(), locals.data(), globals.data() + offset );
+
+				for ( size_t b = 0; b < boneCount; ++b )
+				{
+					scales[offset + b]			= transforms[b].scale;
+					rotations[offset + b]		= transforms[b].rotation;
+					translations[offset + b]	= transforms[b].translation;
+				}
+			}
+		}
+
+		size_t MotionClip::GetByteSize() const
+		{
+			return
+				timeline.GetKeyCount()	* sizeof( float )				+
+				scales.size()			* sizeof( Donya::Vector3 )		+
+				rotations.size()		* sizeof( Donya::Quaternion )	+
+				translations.size()		* sizeof( Donya::Vector3 )		+
+				globals.size()			* sizeof( Donya::Vector4x4 )	;
+		}
+
+		void MotionClip::Sample( size_t keyIndex, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const
+		{
+			const size_t offset = keyIndex * boneCount;
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				Animation::Transform &transform = pTransforms[b];
+				transform.scale			= scales[offset + b];
+				transform.rotation		= rotations[offset + b];
+				transform.translation	= translations[offset + b];
+
+				pLocals[b]	= transform.ToWorldMatrix();
+				pGlobals[b]	= globals[offset + b];
+			}
+		}
+		void MotionClip::Sample( size_t keyIndexL, size_t keyIndexR, float percent, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const
+		{
+			const size_t offsetL = keyIndexL * boneCount;
+			const size_t offsetR = keyIndexR * boneCount;
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				const size_t L = offsetL + b;
+				const size_t R = offsetR + b;
+
+				// Same as Animation::Transform::Interpolate().
+				Animation::Transform &transform = pTransforms[b];
+				transform.scale			= Donya::Lerp( scales[L], scales[R], percent );
+				transform.rotation		= Donya::Quaternion::Slerp( rotations[L], rotations[R], percent );
+				transform.translation	= Donya::Lerp( translations[L], translations[R], percent );
+
+				pLocals[b]	= transform.ToWorldMatrix();
+				pGlobals[b]	= Donya::Lerp( globals[L], globals[R], percent );
+			}
+		}
+
+		Animation::Motion MotionClip::ToMotion() const
+		{
+			Animation::Motion motion{};
+			motion.name			= name;
+			motion.samplingRate	= samplingRate;
+			motion.animSeconds	= animSeconds;
+
+			const size_t keyCount = GetKeyCount();
+			motion.keyFrames.resize( keyCount );
+			for ( size_t k = 0; k < keyCount; ++k )
+			{
+				auto &keyFrame = motion.keyFrames[k];
+				keyFrame.seconds = timeline.GetKeySeconds( k );
+				keyFrame.keyPose.resize( boneCount );
+
+				for ( size_t b = 0; b < boneCount; ++b )
+				{
+					auto &node				= keyFrame.keyPose[b];
+					const size_t index		= k * boneCount + b;
+					node.bone.name			= pSkeleton->GetName( b );
+					node.bone.parentIndex	= pSkeleton->GetParentIndex( b );
+					node.bone.parentName	= ( node.bone.parentIndex < 0 ) ? "" : pSkeleton->GetName( node.bone.parentIndex );
+					node.bone.transform.scale		= scales[index];
+					node.bone.transform.rotation	= rotations[index];
+					node.bone.transform.translation	= translations[index];
+					node.local				= node.bone.transform.ToWorldMatrix();
+					node.global				= globals[index];
+				}
+			}
+
+			return motion;
+		}
+	}
+}
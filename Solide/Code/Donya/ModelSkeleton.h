@@ -0,0 +1,164 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ModelCommon.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		/// <summary>
+		/// The immutable part of a skeletal, that is shared between the motions and the poses of the same model.<para></para>
+		/// The bones are arranged as the source. The order that a parent is placed before own children is provided by GetEvaluationOrder().
+		/// </summary>
+		class Skeleton
+		{
+		private:
+			std::vector<std::string>			names;
+			std::vector<int>					parentIndices;	// This will be -1 if the bone has not parent.
+			std::vector<size_t>					evaluationOrder;// The bone indices that sorted as the parent is placed before own children.
+			bool								isSourceOrder = true; // True if the evaluation order is the same as the source.
+			std::vector<Animation::Transform>	bindTransforms;	// Local transform(bone -> mesh) of the initial pose.
+			std::vector<Donya::Vector4x4>		bindGlobals;	// Global transform of the initial pose.
+		public:
+			Skeleton() = default;
+			explicit Skeleton( const std::vector<Animation::Node> &sourceSkeletal );
+		public:
+			size_t GetBoneCount() const { return names.size(); }
+			const std::string &GetName( size_t boneIndex ) const { return names[boneIndex]; }
+			int    GetParentIndex( size_t boneIndex ) const { return parentIndices[boneIndex]; }
+			const std::vector<int>					&GetParentIndices()		const { return parentIndices;	}
+			/// <summary>
+			/// The bone indices that sorted as the parent is placed before own children, so the global transforms can be calculated by this order at once.<para></para>
+			/// The bones that have an invalid parent(out of range or cyclic) are treated as roots.
+			/// </summary>
+			const std::vector<size_t>				&GetEvaluationOrder()	const { return evaluationOrder;	}
+			bool									IsSourceOrder()			const { return isSourceOrder;	}
+			const std::vector<Animation::Transform>	&GetBindTransforms()	const { return bindTransforms;	}
+			const std::vector<Donya::Vector4x4>		&GetBindGlobals()		const { return bindGlobals;		}
+			/// <summary>
+			/// Returns the index of the bone that found first, or -1 if the specified name is invalid.
+			/// </summary>
+			int    FindBoneIndex( const std::string &boneName ) const;
+		private:
+			void BuildEvaluationOrder();
+		public:
+			/// <summary>
+			/// The "compatible" means the bone count and each bones name are the same.
+			/// </summary>
+			bool IsCompatibleWith( const Skeleton &validation ) const;
+			/// <summary>
+			/// The "compatible" means the bone count and each bones name are the same.
+			/// </summary>
+			bool IsCompatibleWith( const std::vector<Animation::Node> &validation ) const;
+		};
+
+		class CompressedClip;
+
+		/// <summary>
+		/// The begin seconds of each key of a motion, and the key lookup of it.
+		/// </summary>
+		class KeyTimeline
+		{
+		private:
+			std::vector<float>	seconds;				// The begin seconds of each key.
+			float				loopStepSeconds	= 0.0f;	// The interval between the last key and the first key of next loop.
+			float				keyInterval		= 0.0f;	// The average interval of the keys. Used for estimating the key index.
+			bool				isSortedKeys	= true;	// False if the seconds of keys are not ascending order.
+		public:
+			KeyTimeline() = default;
+			explicit KeyTimeline( const std::vector<float> &keySeconds );
+		public:
+			float						GetLoopStepSeconds()const { return loopStepSeconds;	}
+			size_t						GetKeyCount()		const { return seconds.size();	}
+			bool						IsEmpty()			const { return seconds.empty();	}
+			float						GetKeySeconds( size_t keyIndex ) const { return seconds[keyIndex]; }
+			const std::vector<float>	&GetKeySeconds()	const { return seconds;			}
+			/// <summary>
+			/// Returns the begin seconds of the last key. Requires !IsEmpty().
+			/// </summary>
+			float						GetWholeSeconds()	const { return seconds.back();	}
+		public:
+			/// <summary>
+			/// Returns the index "i" that satisfies "GetKeySeconds( i ) &lt;= seconds &lt; GetKeySeconds( i + 1 )", or GetKeyCount() if not found.<para></para>
+			/// The index is estimated by the average interval, then it is corrected by the neighbor keys. So it is O(1) if the keys are sampled by a constant rate.
+			/// The result is the same as FindKeyIndexLinearly().
+			/// </summary>
+			size_t FindKeyIndex( float seconds ) const;
+			/// <summary>
+			/// Returns the first index "i" that satisfies "GetKeySeconds( i ) &lt;= seconds &lt; GetKeySeconds( i + 1 )", or GetKeyCount() if not found.<para></para>
+			/// This searches from the first key.
+			/// </summary>
+			size_t FindKeyIndexLinearly( float seconds ) const;
+		};
+
+		/// <summary>
+		/// A motion that stores the key-frames as flat arrays of each component, and does not contain the bone names(those are in the Skeleton).<para></para>
+		/// The components of the key "k" and the bone "b" are stored at "k * GetBoneCount() + b".
+		/// </summary>
+		class MotionClip
+		{
+		private:
+			std::string						name;
+			std::shared_ptr<const Skeleton>	pSkeleton;
+			float							samplingRate	= Animation::Motion::DEFAULT_SAMPLING_RATE;
+			float							animSeconds		= 0.0f;
+			size_t							boneCount		= 0;
+			KeyTimeline						timeline;
+			std::vector<Donya::Vector3>		scales;
+			std::vector<Donya::Quaternion>	rotations;
+			std::vector<Donya::Vector3>		translations;
+			std::vector<Donya::Vector4x4>	globals;
+		public:
+			MotionClip() = default;
+			/// <summary>
+			/// The "pSkeleton" must be compatible with the key-poses of "source".
+			/// </summary>
+			MotionClip( const Animation::Motion &source, const std::shared_ptr<const Skeleton> &pSkeleton );
+			/// <summary>
+			/// Decodes all keys of the compressed motion.
+			/// </summary>
+			explicit MotionClip( const CompressedClip &source );
+		public:
+			const std::string						&GetName()			const { return name;			}
+			const std::shared_ptr<const Skeleton>	&GetSkeleton()		const { return pSkeleton;		}
+			float									GetSamplingRate()	const { return samplingRate;	}
+			float									GetAnimSeconds()	const { return animSeconds;		}
+			size_t									GetBoneCount()		const { return boneCount;		}
+			const KeyTimeline						&GetTimeline()		const { return timeline;		}
+			float									GetLoopStepSeconds()const { return timeline.GetLoopStepSeconds();	}
+			size_t									GetKeyCount()		const { return timeline.GetKeyCount();		}
+			bool									IsEmpty()			const { return timeline.IsEmpty();			}
+			float									GetKeySeconds( size_t keyIndex ) const { return timeline.GetKeySeconds( keyIndex ); }
+			const std::vector<float>				&GetKeySeconds()	const { return timeline.GetKeySeconds();	}
+			/// <summary>
+			/// Returns the begin seconds of the last key. Requires !IsEmpty().
+			/// </summary>
+			float									GetWholeSeconds()	const { return timeline.GetWholeSeconds();	}
+			/// <summary>
+			/// Returns the bytes of the internal arrays. The name is not contained.
+			/// </summary>
+			size_t									GetByteSize()		const;
+		public:
+			size_t FindKeyIndex( float seconds )			const { return timeline.FindKeyIndex( seconds );			}
+			size_t FindKeyIndexLinearly( float seconds )	const { return timeline.FindKeyIndexLinearly( seconds );	}
+		public:
+			/// <summary>
+			/// Writes the components of a key into the arrays that have GetBoneCount() elements.
+			/// </summary>
+			void Sample( size_t keyIndex, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const;
+			/// <summary>
+			/// Writes the interpolated components into the arrays that have GetBoneCount() elements.<para></para>
+			/// The result is the same as Animation::KeyFrame::Interpolate().
+			/// </summary>
+			void Sample( size_t keyIndexL, size_t keyIndexR, float percent, Animation::Transform *pTransforms, Donya::Vector4x4 *pLocals, Donya::Vector4x4 *pGlobals ) const;
+			/// <summary>
+			/// Restores the representation of key-frames. It is heavy, so this is for the tools only.
+			/// </summary>
+			Animation::Motion ToMotion() const;
+		};
+	}
+}
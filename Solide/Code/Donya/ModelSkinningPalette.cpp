@@ -0,0 +1,158 @@
+#include "ModelSkinningPalette.h"
+
+#include <algorithm>
+#include <functional>		// Use std::hash.
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Model
+	{
+		size_t BuildSkinningPalette( const std::vector<Animation::Node> &boneOffsets, const std::vector<int> &boneIndices, const std::vector<Donya::Vector4x4> &poseGlobals, Donya::Vector4x4 *pOutput, size_t outputCapacity )
+		{
+			using namespace DirectX;
+
+			const size_t poseCount = poseGlobals.size();
+			const size_t boneCount = std::min( outputCapacity, std::min( boneIndices.size(), boneOffsets.size() ) );
+			for ( size_t i = 0; i < boneCount; ++i )
+			{
+				const int poseIndex = boneIndices[i]; // This index was fetched with boneOffset's name.
+				if ( poseIndex < 0 || poseCount <= scast<size_t>( poseIndex ) )
+				{
+					pOutput[i] = Donya::Vector4x4::Identity();
+					continue;
+				}
+				// else
+
+				// Same as "meshToBone * boneToMesh" of Vector4x4, but does not store the intermediate results.
+				const XMMATRIX meshToBone = XMLoadFloat4x4( &boneOffsets[i].global );
+				const XMMATRIX boneToMesh = XMLoadFloat4x4( &poseGlobals[poseIndex] );
+				XMStoreFloat4x4( &pOutput[i], XMMatrixMultiply( meshToBone, boneToMesh ) );
+			}
+
+			return boneCount;
+		}
+
+		size_t SkinningPaletteCache::KeyHash::operator()( const Key &key ) const
+		{
+			size_t hash = std::hash<const void *>()( key.pOwner );
+			hash ^= std::hash<size_t>()( key.meshIndex )			+ 0x9E3779B9 + ( hash << 6 ) + ( hash >> 2 );
+			hash ^= std::hash<std::uint64_t>()( key.poseVersion )	+ 0x9E3779B9 + ( hash << 6 ) + ( hash >> 2 );
+			return hash;
+		}
+
+		void SkinningPaletteCache::BeginFrame()
+		{
+			for ( auto it = entries.begin(); it != entries.end(); )
+			{
+				if ( it->second.lastUsedFrame == currentFrame )
+				{
+					++it;
+					continue;
+				}
+				// else
+
+				pool.emplace_back( std::move( it->second.palette ) );
+				it = entries.erase( it );
+			}
+
+			currentFrame++;
+
+			lastCounter				=  currentCounter;
+			totalCounter.rebuild	+= currentCounter.rebuild;
+			totalCounter.reuse		+= currentCounter.reuse;
+			currentCounter			=  Counter{};
+		}
+
+		const std::vector<Donya::Vector4x4> &SkinningPaletteCache::Fetch( const void *pOwner, size_t meshIndex, const std::vector<Animation::Node> &boneOffsets, const std::vector<int> &boneIndices, const Pose &pose, size_t maxBoneCount )
+		{
+			Key key{};
+			key.pOwner		= pOwner;
+			key.meshIndex	= meshIndex;
+			// The cache is bypassed by the key that never matches.
+			key.poseVersion	= ( enableCache ) ? pose.GetVersion() : 0;
+
+			const auto found = entries.find( key );
+			if ( found != entries.end() && key.poseVersion )
+			{
+				currentCounter.reuse++;
+				found->second.lastUsedFrame = currentFrame;
+				return found->second.palette;
+			}
+			// else
+
+			currentCounter.rebuild++;
+
+			Entry *pEntry = nullptr;
+			if ( found != entries.end() )
+			{
+				pEntry = &found->second;
+			}
+			else
+			{
+				Entry newEntry{};
+				newEntry.palette = AcquirePalette();
+				pEntry = &entries.emplace( key, std::move( newEntry ) ).first->second;
+			}
+
+			auto &palette = pEntry->palette;
+			palette.resize( std::min( maxBoneCount, std::min( boneIndices.size(), boneOffsets.size() ) ) );
+			BuildSkinningPalette( boneOffsets, boneIndices, pose.GetGlobalMatrices(), palette.data(), palette.size() );
+
+			pEntry->lastUsedFrame = currentFrame;
+			return palette;
+		}
+
+		void SkinningPaletteCache::ResetCounters()
+		{
+			currentCounter	= Counter{};
+			lastCounter		= Counter{};
+			totalCounter	= Counter{};
+		}
+
+		std::vector<Donya::Vector4x4> SkinningPaletteCache::AcquirePalette()
+		{
+			if ( pool.empty() ) { return {}; }
+			// else
+
+			std::vector<Donya::Vector4x4> palette = std::move( pool.back() );
+			pool.pop_back();
+			return palette;
+		}
+
+	#if USE_IMGUI
+		void SkinningPaletteCache::ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			ImGui::Checkbox( "Enable cache", &enableCache );
+
+			auto ShowCounter = []( const char *caption, const Counter &counter )
+			{
+				ImGui::Text
+				(
+					"%s : Rebuild[%d], Reuse[%d]",
+					caption,
+					scast<int>( counter.rebuild ),
+					scast<int>( counter.reuse )
+				);
+			};
+			ShowCounter( "Last frame",	lastCounter		);
+			ShowCounter( "Total",		totalCounter	);
+			ImGui::Text( "Cached palettes : %d, Pooled : %d", scast<int>( entries.size() ), scast<int>( pool.size() ) );
+
+			if ( ImGui::Button( "Reset counters" ) )
+			{
+				ResetCounters();
+			}
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ModelCommon.h"
+#include "ModelPose.h"
+#include "UseImGui.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		/// <summary>
+		/// Writes "boneOffsets[i].global * poseGlobals[boneIndices[i]]" into "pOutput[i]", that is the skinning matrix of a bone. This does not use the GPU.<para></para>
+		/// The bone that has an invalid index of pose is written as identity. Returns the count of written matrices.
+		/// </summary>
+		size_t BuildSkinningPalette( const std::vector<Animation::Node> &boneOffsets, const std::vector<int> &boneIndices, const std::vector<Donya::Vector4x4> &poseGlobals, Donya::Vector4x4 *pOutput, size_t outputCapacity );
+
+		/// <summary>
+		/// Keeps the skinning matrices of each mesh by the version of pose, so the mesh that is drawn with an unchanged pose(e.g. while pausing) does not rebuild those.<para></para>
+		/// The palettes that were not used in the previous frame are dropped at BeginFrame().
+		/// </summary>
+		class SkinningPaletteCache
+		{
+		public:
+			struct Counter
+			{
+				size_t rebuild	= 0;
+				size_t reuse	= 0;
+			};
+		private:
+			struct Key
+			{
+				const void		*pOwner		= nullptr;
+				size_t			meshIndex	= 0;
+				std::uint64_t	poseVersion	= 0;
+			public:
+				bool operator == ( const Key &other ) const
+				{
+					return ( pOwner == other.pOwner && meshIndex == other.meshIndex && poseVersion == other.poseVersion );
+				}
+			};
+			struct KeyHash
+			{
+				size_t operator()( const Key &key ) const;
+			};
+			struct Entry
+			{
+				std::vector<Donya::Vector4x4>	palette;
+				unsigned int					lastUsedFrame = 0;
+			};
+		private:
+			std::unordered_map<Key, Entry, KeyHash>		entries;
+			std::vector<std::vector<Donya::Vector4x4>>	pool;			// The palettes of dropped entries. Reused for avoiding the allocation.
+			unsigned int								currentFrame	= 0;
+			bool										enableCache		= true;
+			Counter										currentCounter;
+			Counter										lastCounter;	// The result of the previous frame.
+			Counter										totalCounter;
+		public:
+			/// <summary>
+			/// Drops the palettes that were not used in the previous frame. Please call this once per frame, before drawing.
+			/// </summary>
+			void BeginFrame();
+			/// <summary>
+			/// Returns the skinning matrices of the mesh at the pose. Those are built only if that has not been built with the same version of pose.<para></para>
+			/// The "pOwner" identifies the bone offsets(e.g. the model). The returned reference is valid until the next BeginFrame().
+			/// </summary>
+			const std::vector<Donya::Vector4x4> &Fetch( const void *pOwner, size_t meshIndex, const std::vector<Animation::Node> &boneOffsets, const std::vector<int> &boneIndices, const Pose &pose, size_t maxBoneCount );
+		public:
+			const Counter &GetLastCounter()		const { return lastCounter;		}
+			const Counter &GetTotalCounter()	const { return totalCounter;	}
+			void ResetCounters();
+		private:
+			std::vector<Donya::Vector4x4> AcquirePalette();
+		public:
+		#if USE_IMGUI
+			void ShowImGuiNode( const std::string &nodeCaption );
+		#endif // USE_IMGUI
+		};
+	}
+}
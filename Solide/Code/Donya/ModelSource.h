@@ -13,6 +13,7 @@
 #include "Donya/Vector.h"
 
 #include "ModelCommon.h"
+#include "ModelCompression.h"
 
 namespace Donya
 {
@@ -124,6 +125,7 @@ namespace Donya
 			std::vector<Animation::Node>	skeletal;	// The model's skeletal of initial pose(so-called "T-pose"). 
 			std::vector<Animation::Motion>	motions;	// Represent animations. The animations contain only animation(i.e. The animation matrix transforms space is bone -> mesh(current pose)).
 			Donya::Vector4x4				coordinateConversion;
+			std::vector<Animation::CompressedMotion> compressedMotions;	// The motions that compressed by Loader::CompressMotions(). Those are compatible with the "skeletal".
 		private:
 			friend class cereal::access;
 			template<class Archive>
@@ -138,6 +140,10 @@ namespace Donya
 				);
 				
 				if ( 1 <= version )
+				{
+					archive( CEREAL_NVP( compressedMotions ) );
+				}
+				if ( 2 <= version )
 				{
 					// archive( CEREAL_NVP( x ) );
 				}
@@ -146,7 +152,7 @@ namespace Donya
 	}
 }
 
-CEREAL_CLASS_VERSION( Donya::Model::Source,				0 )
+CEREAL_CLASS_VERSION( Donya::Model::Source,				1 )
 CEREAL_CLASS_VERSION( Donya::Model::Source::Subset,		0 )
 CEREAL_CLASS_VERSION( Donya::Model::Source::Mesh,		0 )
 CEREAL_CLASS_VERSION( Donya::Model::Source::Material,	0 )
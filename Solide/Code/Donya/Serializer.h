@@ -1,9 +1,13 @@
 #pragma once
 
 #include <assert.h>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <Windows.h>	// Use MoveFileExA().
 
 #undef max
 #undef min
@@ -14,6 +18,11 @@
 
 namespace Donya
 {
+	/// <summary>
+	/// In the streaming mode(default), the archives read from or write to the file stream directly.<para></para>
+	/// Otherwise, the whole file is copied through the std::stringstream. That mode remains for the comparison.<para></para>
+	/// The saves write to a temporary file at first, so the target file remains as before if a save failed.
+	/// </summary>
 	class Serializer
 	{
 	public:
@@ -22,89 +31,216 @@ namespace Donya
 			BINARY = 0,
 			JSON,
 		};
+	private:
+		static constexpr size_t STREAM_BUFFER_SIZE = 64 * 1024;
+		static std::atomic<bool> &StreamingFlag()
+		{
+			static std::atomic<bool> isStreaming{ true };
+			return isStreaming;
+		}
+	public:
+		/// <summary>
+		/// Affects the serializations that begin after calling this, in all threads.
+		/// </summary>
+		static void SetStreamingMode( bool enable )	{ StreamingFlag().store( enable );	}
+		static bool IsStreamingMode()				{ return StreamingFlag().load();	}
+	private:
+		static std::unique_ptr<char[]> MakeStreamBuffer()
+		{
+			return std::make_unique<char[]>( STREAM_BUFFER_SIZE );
+		}
+		/// <summary>
+		/// Returns false if the open failed. The buffer must be alive until the stream is destructed.<para></para>
+		/// The buffer is set after the open and before the first read or write, because the std::basic_filebuf of MSVC ignores the buffer that is set before the open.
+		/// </summary>
+		template<class FileStream>
+		static bool OpenBuffered( FileStream *pStream, char *pBuffer, const char *filePath, std::ios::openmode openMode )
+		{
+			pStream->open( filePath, openMode );
+			if ( !pStream->is_open() ) { return false; }
+			// else
+
+			if ( !pStream->rdbuf()->pubsetbuf( pBuffer, STREAM_BUFFER_SIZE ) )
+			{
+				// The stream keeps its own default buffer. That is slower, but the result is the same.
+			}
+
+			return true;
+		}
+		/// <summary>
+		/// The file is written to this path at first, and replaces the target after it was closed successfully. So a failed save does not break the target.
+		/// </summary>
+		static std::string MakeTemporaryPath( const char *filePath )
+		{
+			return std::string{ filePath } + ".tmp";
+		}
+		/// <summary>
+		/// Replaces the target by the temporary file in one operation, so the target is never lost even if this failed.<para></para>
+		/// The paths are the multibyte strings that the std::ofstream also uses, so this uses the ANSI version. Returns false if the replacement failed, then the temporary file is removed.
+		/// </summary>
+		static bool ReplaceByTemporary( const std::string &temporaryPath, const char *filePath )
+		{
+			const BOOL replaced = MoveFileExA( temporaryPath.c_str(), filePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH );
+			if ( !replaced )
+			{
+				std::remove( temporaryPath.c_str() );
+				return false;
+			}
+			// else
+			return true;
+		}
+		/// <summary>
+		/// Closes the stream of the temporary file, then replaces the target by it if the whole file was written. Returns false if the save failed.
+		/// </summary>
+		static bool FinishTemporary( std::ofstream *pStream, const std::string &temporaryPath, const char *filePath )
+		{
+			pStream->flush();
+			pStream->close();
+			if ( pStream->fail() )
+			{
+				std::remove( temporaryPath.c_str() );
+				return false;
+			}
+			// else
+
+			return ReplaceByTemporary( temporaryPath, filePath );
+		}
 	private:	// Use for Begin() ~ End() process.
 		Extension	ext;
+		std::string	savePath;
+		std::string	temporaryPath;
+		std::unique_ptr<char[]>							pStreamBuffer;
 		std::unique_ptr<std::ifstream>					pIfs;
 		std::unique_ptr<std::ofstream>					pOfs;
-		std::unique_ptr<std::stringstream>				pSS;
+		std::unique_ptr<std::stringstream>				pSS;	// nullptr in the streaming mode.
 		std::unique_ptr<cereal::BinaryInputArchive>		pBinInArc;
 		std::unique_ptr<cereal::JSONInputArchive>		pJsonInArc;
 		std::unique_ptr<cereal::BinaryOutputArchive>	pBinOutArc;
 		std::unique_ptr<cereal::JSONOutputArchive>		pJsonOutArc;
 		bool isValid;	// It will be true while Begin() ~ End(), else false.
 	public:
-		Serializer() : ext( BINARY ), pIfs( nullptr ), pSS( nullptr ), pBinInArc( nullptr ), pJsonInArc( nullptr ), pBinOutArc( nullptr ), pJsonOutArc( nullptr ), isValid( false )
+		Serializer() : ext( BINARY ), savePath(), temporaryPath(), pStreamBuffer( nullptr ), pIfs( nullptr ), pOfs( nullptr ), pSS( nullptr ), pBinInArc( nullptr ), pJsonInArc( nullptr ), pBinOutArc( nullptr ), pJsonOutArc( nullptr ), isValid( false )
 		{}
+		/// <summary>
+		/// Discards the temporary file if the save was not finished by SaveEnd()(e.g. the archive threw an exception).
+		/// </summary>
+		~Serializer()
+		{
+			if ( !pOfs ) { return; }
+			// else
+
+			pOfs->close();
+			std::remove( temporaryPath.c_str() );
+		}
 	public:
 		template<class SerializeObject>
 		bool Load( Extension extension, const char *filePath, const char *objectName, SerializeObject &instance ) const
 		{
 			auto openMode = ( extension == Extension::BINARY ) ? std::ios::in | std::ios::binary : std::ios::in;
-			std::ifstream ifs( filePath, openMode );
-			if ( !ifs.is_open() ) { return false; }
+			const auto buffer = MakeStreamBuffer();
+			std::ifstream ifs{};
+			if ( !OpenBuffered( &ifs, buffer.get(), filePath, openMode ) ) { return false; }
+			// else
+
+			if ( IsStreamingMode() )
+			{
+				return LoadFrom( ifs, extension, objectName, instance );
+			}
 			// else
 
 			std::stringstream ss{};
 			ss << ifs.rdbuf();
+			ifs.close();
+
+			return LoadFrom( ss, extension, objectName, instance );
+		}
+
+		template<class SerializeObject>
+		bool Save( Extension extension, const char *filePath, const char *objectName, SerializeObject &instance ) const
+		{
+			if ( extension != BINARY && extension != JSON ) { return false; }
+			// else
+
+			auto openMode = ( extension == Extension::BINARY ) ? std::ios::out | std::ios::binary : std::ios::out;
+			const std::string temporaryPath = MakeTemporaryPath( filePath );
+			if ( IsStreamingMode() )
+			{
+				const auto buffer = MakeStreamBuffer();
+				std::ofstream ofs{};
+				if ( !OpenBuffered( &ofs, buffer.get(), temporaryPath.c_str(), openMode ) ) { return false; }
+				// else
+
+				try
+				{
+					SaveTo( ofs, extension, objectName, instance );
+				}
+				catch ( ... )
+				{
+					ofs.close();
+					std::remove( temporaryPath.c_str() );
+					throw;
+				}
+
+				return FinishTemporary( &ofs, temporaryPath, filePath );
+			}
+			// else
+
+			std::stringstream ss{};
+			SaveTo( ss, extension, objectName, instance );
+
+			std::ofstream ofs( temporaryPath, openMode );
+			if ( !ofs.is_open() ) { return false; }
+			// else
+
+			ofs << ss.rdbuf();
 
+			return FinishTemporary( &ofs, temporaryPath, filePath );
+		}
+	private:
+		template<class SerializeObject>
+		static bool LoadFrom( std::istream &is, Extension extension, const char *objectName, SerializeObject &instance )
+		{
 			switch ( extension )
 			{
 			case BINARY:
 				{
-					cereal::BinaryInputArchive binInArchive( ss );
+					cereal::BinaryInputArchive binInArchive( is );
 					binInArchive( cereal::make_nvp( objectName, instance ) );
 				}
-				break;
+				return true;
 			case JSON:
 				{
-					cereal::JSONInputArchive jsonInArchive( ss );
+					cereal::JSONInputArchive jsonInArchive( is );
 					jsonInArchive( cereal::make_nvp( objectName, instance ) );
 				}
-				break;
+				return true;
 			default:
 				return false;
 			}
-
-			ifs.close();
-			ss.clear();
-
-			return true;
 		}
-
+		/// <summary>
+		/// The archive is destructed in this, so the JSON is closed.
+		/// </summary>
 		template<class SerializeObject>
-		bool Save( Extension extension, const char *filePath, const char *objectName, SerializeObject &instance ) const
+		static void SaveTo( std::ostream &os, Extension extension, const char *objectName, SerializeObject &instance )
 		{
-			std::stringstream ss{};
-
 			switch ( extension )
 			{
 			case BINARY:
 				{
-					cereal::BinaryOutputArchive binOutArchive( ss );
+					cereal::BinaryOutputArchive binOutArchive( os );
 					binOutArchive( cereal::make_nvp( objectName, instance ) );
 				}
 				break;
 			case JSON:
 				{
-					cereal::JSONOutputArchive jsonOutArchive( ss );
+					cereal::JSONOutputArchive jsonOutArchive( os );
 					jsonOutArchive( cereal::make_nvp( objectName, instance ) );
 				}
 				break;
 			default:
-				return false;
+				break;
 			}
-
-			auto openMode = ( extension == Extension::BINARY ) ? std::ios::out | std::ios::binary : std::ios::out;
-			std::ofstream ofs( filePath, openMode );
-			if ( !ofs.is_open() ) { return false; }
-			// else
-
-			ofs << ss.str();
-
-			ofs.close();
-			ss.clear();
-
-			return true;
 		}
 	public:
 		bool LoadBegin( Extension extension, const char *filePath )
@@ -121,21 +257,28 @@ namespace Donya
 			// else
 
 			auto openMode = ( extension == Extension::BINARY ) ? std::ios::in | std::ios::binary : std::ios::in;
-			pIfs = std::make_unique<std::ifstream>( filePath, openMode );
-			if ( !pIfs->is_open() ) { return false; }
+			pIfs.reset( nullptr );
+			pStreamBuffer = MakeStreamBuffer();
+			pIfs = std::make_unique<std::ifstream>();
+			if ( !OpenBuffered( pIfs.get(), pStreamBuffer.get(), filePath, openMode ) ) { return false; }
 			// else
 
-			pSS = std::make_unique<std::stringstream>();
-			*pSS << pIfs->rdbuf();
+			std::istream *pSource = pIfs.get();
+			if ( !IsStreamingMode() )
+			{
+				pSS = std::make_unique<std::stringstream>();
+				*pSS << pIfs->rdbuf();
+				pSource = pSS.get();
+			}
 
 			ext = extension;
 			switch ( extension )
 			{
 			case BINARY:
-				pBinInArc  = std::make_unique<cereal::BinaryInputArchive>( *pSS );
+				pBinInArc  = std::make_unique<cereal::BinaryInputArchive>( *pSource );
 				break;
 			case JSON:
-				pJsonInArc = std::make_unique<cereal::JSONInputArchive>( *pSS );
+				pJsonInArc = std::make_unique<cereal::JSONInputArchive>( *pSource );
 				break;
 			default:
 				return false;
@@ -189,10 +332,10 @@ namespace Donya
 			}
 
 			pIfs->close();
-			pSS->clear();
 
 			pIfs.reset( nullptr );
 			pSS.reset( nullptr );
+			pStreamBuffer.reset( nullptr );
 
 			isValid  = false;
 		}
@@ -210,26 +353,38 @@ namespace Donya
 			}
 			// else
 
-			pSS = std::make_unique<std::stringstream>();
+			if ( extension != BINARY && extension != JSON ) { return false; }
+			// else
+
+			auto openMode = ( extension == Extension::BINARY ) ? std::ios::out | std::ios::binary : std::ios::out;
+			pOfs.reset( nullptr );
+			pStreamBuffer = MakeStreamBuffer();
+			pOfs = std::make_unique<std::ofstream>();
+			savePath		= filePath;
+			temporaryPath	= MakeTemporaryPath( filePath );
+			if ( !OpenBuffered( pOfs.get(), pStreamBuffer.get(), temporaryPath.c_str(), openMode ) ) { return false; }
+			// else
+
+			std::ostream *pDestination = pOfs.get();
+			if ( !IsStreamingMode() )
+			{
+				pSS = std::make_unique<std::stringstream>();
+				pDestination = pSS.get();
+			}
 
 			ext = extension;
 			switch ( extension )
 			{
 			case BINARY:
-				pBinOutArc  = std::make_unique<cereal::BinaryOutputArchive>( *pSS );
+				pBinOutArc  = std::make_unique<cereal::BinaryOutputArchive>( *pDestination );
 				break;
 			case JSON:
-				pJsonOutArc = std::make_unique<cereal::JSONOutputArchive>( *pSS );
+				pJsonOutArc = std::make_unique<cereal::JSONOutputArchive>( *pDestination );
 				break;
 			default:
 				return false;
 			}
 
-			auto openMode = ( extension == Extension::BINARY ) ? std::ios::out | std::ios::binary : std::ios::out;
-			pOfs = std::make_unique<std::ofstream>( filePath, openMode );
-			if ( !pOfs->is_open() ) { return false; }
-			// else
-
 			isValid = true;
 
 			return true;
@@ -260,9 +415,12 @@ namespace Donya
 			return true;
 		}
 
-		void SaveEnd()
+		/// <summary>
+		/// Returns false if the file could not be written or replaced. The target file remains as before in that case.
+		/// </summary>
+		bool SaveEnd()
 		{
-			if ( !isValid ) { return; }
+			if ( !isValid ) { return false; }
 			// else
 
 			switch ( ext )
@@ -277,15 +435,17 @@ namespace Donya
 				break;
 			}
 
-			*pOfs << pSS->str();
+			if ( pSS ) { *pOfs << pSS->rdbuf(); }
 
-			pOfs->close();
-			pSS->clear();
+			const bool succeeded = FinishTemporary( pOfs.get(), temporaryPath, savePath.c_str() );
 
 			pOfs.reset( nullptr );
 			pSS.reset( nullptr );
+			pStreamBuffer.reset( nullptr );
 
 			isValid = false;
+
+			return succeeded;
 		}
 	public:
 		// Static helper methods.
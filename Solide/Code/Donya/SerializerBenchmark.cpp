@@ -0,0 +1,89 @@
+#include "SerializerBenchmark.h"
+
+#include <algorithm>
+
+#include "Donya/AllocationTracker.h"
+#include "Donya/Benchmark.h"
+#include "Donya/Constant.h"	// Use scast macro.
+#include "Donya/Serializer.h"
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace SerializerBenchmark
+	{
+		namespace
+		{
+			Result MeasureIn( bool streaming, int repeatCount, const std::function<void()> &operation )
+			{
+				Serializer::SetStreamingMode( streaming );
+
+				// The live bytes are counted only while the tracking is enabled.
+				const bool prevTracking = AllocationTracker::IsEnabled();
+				AllocationTracker::SetEnable( true );
+
+				Result result{};
+				Benchmark timer{};
+				for ( int i = 0; i < repeatCount; ++i )
+				{
+					AllocationTracker::ResetPeakLiveBytes();
+					const long long baseBytes = AllocationTracker::GetLiveBytes();
+
+					timer.Begin();
+					operation();
+					result.seconds += timer.End();
+
+					const long long peakBytes = AllocationTracker::GetPeakLiveBytes();
+					if ( baseBytes < peakBytes )
+					{
+						result.peakBytes = std::max( result.peakBytes, scast<size_t>( peakBytes - baseBytes ) );
+					}
+				}
+
+				AllocationTracker::SetEnable( prevTracking );
+
+				result.seconds /= scast<double>( repeatCount );
+				return result;
+			}
+		}
+
+		Comparison Measure( int repeatCount, const std::function<void()> &operation )
+		{
+			repeatCount = std::max( 1, repeatCount );
+			const bool prevMode = Serializer::IsStreamingMode();
+
+			Comparison comparison{};
+			comparison.streaming	= MeasureIn( true,  repeatCount, operation );
+			comparison.buffered		= MeasureIn( false, repeatCount, operation );
+
+			Serializer::SetStreamingMode( prevMode );
+			return comparison;
+		}
+
+	#if USE_IMGUI
+		void ShowComparison( const Comparison &comparison )
+		{
+			auto ToKB = []( size_t bytes )
+			{
+				return scast<float>( bytes ) / 1024.0f;
+			};
+			auto Show = [&ToKB]( const char *caption, const Result &result )
+			{
+				ImGui::Text( "%s : %.3f[ms], Peak %.1f[KB]", caption, result.seconds * 1000.0, ToKB( result.peakBytes ) );
+			};
+			Show( "Streaming", comparison.streaming	);
+			Show( "Buffered ", comparison.buffered	);
+
+			if ( 0.0 < comparison.streaming.seconds )
+			{
+				ImGui::Text( "Speed up : x%.2f", comparison.buffered.seconds / comparison.streaming.seconds );
+			}
+		#if !USE_ALLOCATION_TRACKER
+			ImGui::Text( "The peak requires the USE_ALLOCATION_TRACKER." );
+		#endif // !USE_ALLOCATION_TRACKER
+		}
+	#endif // USE_IMGUI
+	}
+}
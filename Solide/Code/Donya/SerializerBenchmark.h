@@ -0,0 +1,35 @@
+#pragma once
+
+#include <functional>
+
+#include "UseImGui.h"
+
+namespace Donya
+{
+	/// <summary>
+	/// Compares an operation of the Serializer in the streaming mode and in the mode that copies through the std::stringstream.
+	/// </summary>
+	namespace SerializerBenchmark
+	{
+		struct Result
+		{
+			double	seconds		= 0.0;	// Average.
+			size_t	peakBytes	= 0;	// The maximum increase of the heap while the operation. Zero if the USE_ALLOCATION_TRACKER is false.
+		};
+		struct Comparison
+		{
+			Result streaming;
+			Result buffered;
+		};
+
+		/// <summary>
+		/// Runs the "operation" "repeatCount" times in each mode, then restores the mode.<para></para>
+		/// The mode is global, so the serializations of the other threads are also affected while this.
+		/// </summary>
+		Comparison Measure( int repeatCount, const std::function<void()> &operation );
+
+	#if USE_IMGUI
+		void ShowComparison( const Comparison &comparison );
+	#endif // USE_IMGUI
+	}
+}
@@ -0,0 +1,486 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+
+#include "Donya/Constant.h"	// Use scast macro.
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	TaskGraph::TaskGraph( JobSystem *pJobSystem ) :
+		pJobSystem( pJobSystem ),
+		workerCount( ( pJobSystem ) ? pJobSystem->GetWorkerCount() : 0 )
+	{}
+	TaskGraph::~TaskGraph()
+	{
+		// Stops the dispatching, then waits for the submitted tasks because those refer to this.
+		std::unique_lock<std::mutex> lock( mutex );
+		isRunning = false;
+		wakeCondition.wait
+		(
+			lock,
+			[&]()
+			{
+				return !inFlightCount;
+			}
+		);
+	}
+
+	TaskGraph::NodeId TaskGraph::Add( const std::string &name, const Task &task, const std::vector<NodeId> &dependencies, int exclusiveGroup, bool onCallerThread )
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		_ASSERT_EXPR( !wasStarted, L"Error: Adding a task after the start of TaskGraph!" );
+
+		const NodeId id = nodes.size();
+
+		auto pNode = std::make_unique<Node>();
+		pNode->name				= name;
+		pNode->task				= task;
+		pNode->exclusiveGroup	= exclusiveGroup;
+		pNode->onCallerThread	= onCallerThread;
+		for ( const NodeId &dep : dependencies )
+		{
+			// The dependency must be added before, so the graph never has a cycle.
+			if ( id <= dep )
+			{
+				_ASSERT_EXPR( 0, L"Error: The dependency of TaskGraph is invalid!" );
+				continue;
+			}
+			// else
+
+			pNode->dependencies.emplace_back( dep );
+			nodes[dep]->dependents.emplace_back( id );
+		}
+		pNode->remainingDepCount = pNode->dependencies.size();
+
+		nodes.emplace_back( std::move( pNode ) );
+		return id;
+	}
+
+	void TaskGraph::Start()
+	{
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			if ( wasStarted ) { return; }
+			// else
+
+			wasStarted	= true;
+			isRunning	= true;
+			startTime	= Clock::now();
+
+			for ( size_t i = 0; i < nodes.size(); ++i )
+			{
+				if ( nodes[i]->remainingDepCount ) { continue; }
+				// else
+
+				nodes[i]->state = State::Ready;
+				readyNodes.emplace_back( i );
+			}
+
+			Dispatch();
+		}
+	}
+
+	bool TaskGraph::RunOnCallerThread()
+	{
+		NodeId id = 0;
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			if ( !isRunning ) { return false; }
+			// else
+
+			const int readyIndex = FindRunnable( /* onCallerThread = */ true );
+			if ( readyIndex < 0 ) { return false; }
+			// else
+
+			id = Acquire( readyIndex );
+		}
+
+		Run( id, /* fromJobSystem = */ false );
+		return true;
+	}
+
+	bool TaskGraph::IsFinished() const
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		return wasStarted && finishedCount == nodes.size();
+	}
+	bool TaskGraph::IsSucceeded() const
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		if ( !wasStarted || finishedCount != nodes.size() ) { return false; }
+		// else
+
+		for ( const auto &pNode : nodes )
+		{
+			if ( pNode->state != State::Succeeded ) { return false; }
+		}
+		return true;
+	}
+	TaskGraph::State TaskGraph::GetState( NodeId id ) const
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		return ( id < nodes.size() ) ? nodes[id]->state : State::Skipped;
+	}
+	TaskGraph::Timing TaskGraph::GetTiming( NodeId id ) const
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		return ( id < nodes.size() ) ? nodes[id]->timing : Timing{};
+	}
+	float TaskGraph::GetProgress( NodeId id ) const
+	{
+		return ( id < nodes.size() ) ? nodes[id]->progress.load( std::memory_order_relaxed ) : 0.0f;
+	}
+	float TaskGraph::GetTotalProgress() const
+	{
+		if ( nodes.empty() ) { return 1.0f; }
+		// else
+
+		float sum = 0.0f;
+		for ( const auto &pNode : nodes )
+		{
+			sum += pNode->progress.load( std::memory_order_relaxed );
+		}
+		return sum / scast<float>( nodes.size() );
+	}
+
+	std::vector<TaskGraph::NodeId> TaskGraph::CalcCriticalPath() const
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+
+		std::vector<NodeId> path{};
+		if ( nodes.empty() || finishedCount != nodes.size() ) { return path; }
+		// else
+
+		auto FinishedLater = [&]( NodeId lhs, NodeId rhs )
+		{
+			return nodes[rhs]->timing.endSeconds < nodes[lhs]->timing.endSeconds;
+		};
+
+		NodeId current = 0;
+		for ( NodeId i = 1; i < nodes.size(); ++i )
+		{
+			if ( FinishedLater( i, current ) ) { current = i; }
+		}
+
+		while ( true )
+		{
+			path.emplace_back( current );
+
+			const Node &node = *nodes[current];
+			bool	found	= false;
+			NodeId	gate	= 0;
+			auto Consider = [&]( NodeId candidate )
+			{
+				if ( !found || FinishedLater( candidate, gate ) )
+				{
+					gate	= candidate;
+					found	= true;
+				}
+			};
+
+			for ( const NodeId &dep : node.dependencies )
+			{
+				Consider( dep );
+			}
+
+			// The task that held the same group may have kept it waiting after the dependencies.
+			// It must finish strictly earlier than the current one. Otherwise two tasks that finished at the same time select each other forever.
+			// The dependencies can not make a loop, so the tracing always ends.
+			if ( node.exclusiveGroup != NO_GROUP )
+			{
+				for ( NodeId i = 0; i < nodes.size(); ++i )
+				{
+					const Node &other = *nodes[i];
+					if ( i == current || other.exclusiveGroup != node.exclusiveGroup ) { continue; }
+					if ( other.state == State::Skipped ) { continue; }
+					if ( node.timing.startSeconds < other.timing.endSeconds ) { continue; }
+					if ( node.timing.endSeconds <= other.timing.endSeconds ) { continue; }
+					// else
+					Consider( i );
+				}
+			}
+
+			if ( !found ) { break; }
+			// else
+			current = gate;
+		}
+
+		std::reverse( path.begin(), path.end() );
+		return path;
+	}
+
+	double TaskGraph::CalcElapsedSeconds() const
+	{
+		return std::chrono::duration<double>( Clock::now() - startTime ).count();
+	}
+	bool TaskGraph::IsReadyToRun( const Node &node, bool onCallerThread ) const
+	{
+		// The caller thread runs all tasks if there is no worker.
+		const bool threadMatches = ( node.onCallerThread == onCallerThread ) || ( onCallerThread && !workerCount );
+		if ( !threadMatches ) { return false; }
+		// else
+
+		if ( node.exclusiveGroup == NO_GROUP ) { return true; }
+		// else
+
+		const auto found = std::find( busyGroups.begin(), busyGroups.end(), node.exclusiveGroup );
+		return found == busyGroups.end();
+	}
+	int TaskGraph::FindRunnable( bool onCallerThread ) const
+	{
+		const int readyCount = scast<int>( readyNodes.size() );
+		for ( int i = 0; i < readyCount; ++i )
+		{
+			if ( IsReadyToRun( *nodes[readyNodes[i]], onCallerThread ) )
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+	TaskGraph::NodeId TaskGraph::Acquire( int readyIndex )
+	{
+		const NodeId id = readyNodes[readyIndex];
+		readyNodes.erase( readyNodes.begin() + readyIndex );
+
+		Node &node = *nodes[id];
+		node.state = State::Running;
+		if ( node.exclusiveGroup != NO_GROUP )
+		{
+			busyGroups.emplace_back( node.exclusiveGroup );
+		}
+
+		return id;
+	}
+	void TaskGraph::Dispatch()
+	{
+		if ( !pJobSystem || !workerCount ) { return; }
+		// else
+
+		// The count is limited for making the start time of a task close to the submission.
+		while ( inFlightCount < workerCount )
+		{
+			const int readyIndex = FindRunnable( /* onCallerThread = */ false );
+			if ( readyIndex < 0 ) { return; }
+			// else
+
+			const NodeId id = Acquire( readyIndex );
+			inFlightCount++;
+			pJobSystem->Submit
+			(
+				[this, id]()
+				{
+					Run( id, /* fromJobSystem = */ true );
+				}
+			);
+		}
+	}
+	void TaskGraph::Run( NodeId id, bool fromJobSystem )
+	{
+		Node &node = *nodes[id];
+		{
+			// The worker may run the other jobs before this, so the start time is recorded here.
+			std::lock_guard<std::mutex> lock( mutex );
+			node.timing.startSeconds = CalcElapsedSeconds();
+		}
+
+		auto Report = [&node]( float fraction )
+		{
+			node.progress.store( std::max( 0.0f, std::min( 1.0f, fraction ) ), std::memory_order_relaxed );
+		};
+
+		bool succeeded = false;
+		try
+		{
+			succeeded = node.task( Report );
+		}
+		catch ( ... )
+		{
+			// The loading functions may throw. That must not terminate the worker thread.
+			succeeded = false;
+		}
+
+		std::lock_guard<std::mutex> lock( mutex );
+		Finish( id, succeeded );
+		if ( fromJobSystem ) { inFlightCount--; }
+		if ( isRunning ) { Dispatch(); }
+
+		// Notifies while locking, because the destructor that is waiting for it may destroy this right after the unlocking.
+		wakeCondition.notify_all();
+	}
+	void TaskGraph::Finish( NodeId id, bool succeeded )
+	{
+		Node &node = *nodes[id];
+		node.state = ( succeeded ) ? State::Succeeded : State::Failed;
+		node.timing.endSeconds = CalcElapsedSeconds();
+		node.progress.store( 1.0f, std::memory_order_relaxed );
+		finishedCount++;
+
+		if ( node.exclusiveGroup != NO_GROUP )
+		{
+			const auto found = std::find( busyGroups.begin(), busyGroups.end(), node.exclusiveGroup );
+			if ( found != busyGroups.end() ) { busyGroups.erase( found ); }
+		}
+
+		for ( const NodeId &dependent : node.dependents )
+		{
+			if ( !succeeded )
+			{
+				Skip( dependent );
+				continue;
+			}
+			// else
+
+			Node &next = *nodes[dependent];
+			if ( next.state != State::Waiting ) { continue; }
+			// else
+
+			next.remainingDepCount--;
+			if ( next.remainingDepCount ) { continue; }
+			// else
+
+			next.state = State::Ready;
+			next.timing.readySeconds = node.timing.endSeconds;
+			readyNodes.emplace_back( dependent );
+		}
+	}
+	void TaskGraph::Skip( NodeId id )
+	{
+		Node &node = *nodes[id];
+		if ( node.state == State::Skipped ) { return; }
+		// else
+
+		const double now = CalcElapsedSeconds();
+		node.state = State::Skipped;
+		node.timing.readySeconds	= now;
+		node.timing.startSeconds	= now;
+		node.timing.endSeconds		= now;
+		node.progress.store( 1.0f, std::memory_order_relaxed );
+		finishedCount++;
+
+		for ( const NodeId &dependent : node.dependents )
+		{
+			Skip( dependent );
+		}
+	}
+
+#if USE_IMGUI
+	void TaskGraph::ShowImGuiNode( const std::string &nodeCaption ) const
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		auto ToString = []( State state )
+		{
+			switch ( state )
+			{
+			case State::Waiting:	return "Waiting";
+			case State::Ready:		return "Ready";
+			case State::Running:	return "Running";
+			case State::Succeeded:	return "Succeeded";
+			case State::Failed:		return "Failed";
+			case State::Skipped:	return "Skipped";
+			default: break;
+			}
+			return "Unknown";
+		};
+		auto ToMS = []( double seconds )
+		{
+			return seconds * 1000.0;
+		};
+
+		// The copy of the states and the timings, because those are changed by the workers.
+		struct Snapshot
+		{
+			State	state = State::Waiting;
+			Timing	timing;
+		};
+		std::vector<Snapshot> snapshots{};
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			snapshots.resize( nodes.size() );
+			for ( size_t i = 0; i < nodes.size(); ++i )
+			{
+				snapshots[i].state	= nodes[i]->state;
+				snapshots[i].timing	= nodes[i]->timing;
+			}
+		}
+		auto IsDone = []( const Snapshot &snapshot )
+		{
+			return snapshot.state == State::Succeeded || snapshot.state == State::Failed;
+		};
+
+		const bool finished = IsFinished();
+		ImGui::Text( "Workers : %d, Tasks : %d", scast<int>( workerCount ), scast<int>( nodes.size() ) );
+		ImGui::Text( "Total progress : %5.1f[%%]", GetTotalProgress() * 100.0f );
+
+		if ( finished )
+		{
+			double wholeSeconds	= 0.0;
+			double sumSeconds	= 0.0;
+			for ( const auto &snapshot : snapshots )
+			{
+				wholeSeconds	=  std::max( wholeSeconds, snapshot.timing.endSeconds );
+				sumSeconds		+= snapshot.timing.RunSeconds();
+			}
+			ImGui::Text( "Whole : %.3f[ms], Sum of tasks : %.3f[ms]", ToMS( wholeSeconds ), ToMS( sumSeconds ) );
+
+			if ( ImGui::TreeNode( "Critical path" ) )
+			{
+				ImGui::Text( "The wait is the time from ready to start. It is caused by the exclusive group or the shortage of threads." );
+
+				const auto path = CalcCriticalPath();
+				for ( const NodeId &id : path )
+				{
+					const Timing &timing = snapshots[id].timing;
+					ImGui::Text
+					(
+						"%s : Run %.3f[ms], Wait %.3f[ms], End %.3f[ms]",
+						nodes[id]->name.c_str(),
+						ToMS( timing.RunSeconds() ), ToMS( timing.WaitSeconds() ), ToMS( timing.endSeconds )
+					);
+				}
+
+				ImGui::TreePop();
+			}
+		}
+
+		if ( ImGui::TreeNode( "Tasks" ) )
+		{
+			std::vector<NodeId> sorted( nodes.size() );
+			for ( NodeId i = 0; i < nodes.size(); ++i ) { sorted[i] = i; }
+			if ( finished )
+			{
+				// The slowest first.
+				std::sort
+				(
+					sorted.begin(), sorted.end(),
+					[&]( NodeId lhs, NodeId rhs )
+					{
+						return snapshots[rhs].timing.RunSeconds() < snapshots[lhs].timing.RunSeconds();
+					}
+				);
+			}
+
+			for ( const NodeId &id : sorted )
+			{
+				const Snapshot &snapshot = snapshots[id];
+				const double runSeconds = ( IsDone( snapshot ) ) ? snapshot.timing.RunSeconds() : 0.0;
+				ImGui::Text
+				(
+					"%s : %s, Progress %5.1f[%%], Run %.3f[ms]",
+					nodes[id]->name.c_str(), ToString( snapshot.state ),
+					GetProgress( id ) * 100.0f, ToMS( runSeconds )
+				);
+			}
+
+			ImGui::TreePop();
+		}
+
+		ImGui::TreePop();
+	}
+#endif // USE_IMGUI
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "JobSystem.h"
+#include "UseImGui.h"
+
+namespace Donya
+{
+	/// <summary>
+	/// Runs the tasks that have the dependencies on the workers of a JobSystem. A task starts after all of its dependencies succeeded.<para></para>
+	/// The tasks that have the same exclusive group never run at the same time. Please use it for the tasks that use the same cache that is not locked.<para></para>
+	/// The tasks that must run on the thread that created the graph (e.g. the loading of Effekseer) are run by RunOnCallerThread().<para></para>
+	/// Please add all tasks before Start(). The graph can not be restarted.
+	/// </summary>
+	class TaskGraph
+	{
+	public:
+		using NodeId			= size_t;
+		/// <summary>
+		/// The task can report its progress by this. The fraction is clamped to 0.0f ~ 1.0f.
+		/// </summary>
+		using ReportProgress	= std::function<void( float fraction )>;
+		/// <summary>
+		/// Returns false if the task failed. Then the tasks that depend on it are not run, and are regarded as failed.
+		/// </summary>
+		using Task				= std::function<bool( const ReportProgress &report )>;
+
+		static constexpr int NO_GROUP = -1;
+
+		enum class State
+		{
+			Waiting,	// Waiting for the dependencies.
+			Ready,		// Waiting for a thread, or for the exclusive group.
+			Running,
+			Succeeded,
+			Failed,
+			Skipped,	// A dependency failed.
+		};
+		/// <summary>
+		/// The seconds since Start().
+		/// </summary>
+		struct Timing
+		{
+			double readySeconds	= 0.0;	// When all dependencies finished.
+			double startSeconds	= 0.0;
+			double endSeconds	= 0.0;
+		public:
+			double WaitSeconds() const { return startSeconds - readySeconds; }
+			double RunSeconds()  const { return endSeconds - startSeconds; }
+		};
+	private:
+		using Clock = std::chrono::steady_clock;
+		struct Node
+		{
+			std::string				name;
+			Task					task;
+			std::vector<NodeId>		dependencies;
+			std::vector<NodeId>		dependents;
+			int						exclusiveGroup		= NO_GROUP;
+			bool					onCallerThread		= false;
+			size_t					remainingDepCount	= 0;
+			State					state				= State::Waiting;
+			std::atomic<float>		progress{ 0.0f };
+			Timing					timing;
+		};
+	private:
+		std::vector<std::unique_ptr<Node>>	nodes;
+		std::vector<NodeId>					readyNodes;
+		std::vector<int>					busyGroups;
+		JobSystem							*pJobSystem		= nullptr;
+		size_t								workerCount		= 0;
+		size_t								inFlightCount	= 0;	// The tasks that were submitted to the job system and are not finished.
+		size_t								finishedCount	= 0;
+		bool								wasStarted		= false;
+		bool								isRunning		= false;
+		Clock::time_point					startTime;
+		mutable std::mutex					mutex;
+		std::condition_variable				wakeCondition;
+	public:
+		/// <summary>
+		/// The tasks run on the workers of the "pJobSystem", so the tasks can use it for ParallelFor() too. It must be alive until this is destructed.<para></para>
+		/// If it is nullptr or has no worker, all tasks are run by RunOnCallerThread().
+		/// </summary>
+		explicit TaskGraph( JobSystem *pJobSystem );
+		/// <summary>
+		/// Waits for the running tasks. The tasks that are not started are discarded.
+		/// </summary>
+		~TaskGraph();
+		TaskGraph( const TaskGraph & ) = delete;
+		TaskGraph &operator = ( const TaskGraph & ) = delete;
+	public:
+		/// <summary>
+		/// The "dependencies" must be the ids that were returned from this before.
+		/// </summary>
+		NodeId Add( const std::string &name, const Task &task, const std::vector<NodeId> &dependencies = {}, int exclusiveGroup = NO_GROUP, bool onCallerThread = false );
+		void Start();
+		/// <summary>
+		/// Runs a ready task that must run on the caller thread, if it exists. Returns true if a task was run.<para></para>
+		/// Please call this from the thread that created the graph until IsFinished() is true.
+		/// </summary>
+		bool RunOnCallerThread();
+	public:
+		bool	IsFinished() const;
+		/// <summary>
+		/// Returns true if all tasks were finished and succeeded.
+		/// </summary>
+		bool	IsSucceeded() const;
+		size_t	GetNodeCount() const { return nodes.size(); }
+		/// <summary>
+		/// Requires the "id" is less than GetNodeCount().
+		/// </summary>
+		const std::string &GetName( NodeId id ) const { return nodes[id]->name; }
+		State	GetState( NodeId id ) const;
+		Timing	GetTiming( NodeId id ) const;
+		float	GetProgress( NodeId id ) const;
+		/// <summary>
+		/// Returns the average of the progress of all tasks. The finished tasks are 1.0f.
+		/// </summary>
+		float	GetTotalProgress() const;
+		/// <summary>
+		/// Traces back from the task that finished last, through the dependency that finished last, or the task that held the same exclusive group until the start.<para></para>
+		/// The returned ids are ordered from the first. It is valid after IsFinished() is true.
+		/// </summary>
+		std::vector<NodeId> CalcCriticalPath() const;
+	#if USE_IMGUI
+	public:
+		void ShowImGuiNode( const std::string &nodeCaption ) const;
+	#endif // USE_IMGUI
+	private:
+		double	CalcElapsedSeconds() const;
+		bool	IsReadyToRun( const Node &node, bool onCallerThread ) const;
+		/// <summary>
+		/// Requires the lock. Returns the index in "readyNodes", or -1 if not found.
+		/// </summary>
+		int		FindRunnable( bool onCallerThread ) const;
+		/// <summary>
+		/// Requires the lock. Removes it from the "readyNodes", then makes it Running.
+		/// </summary>
+		NodeId	Acquire( int readyIndex );
+		/// <summary>
+		/// Requires the lock. Submits the runnable tasks to the job system, up to the count of its workers.
+		/// </summary>
+		void	Dispatch();
+		void	Run( NodeId id, bool fromJobSystem );
+		/// <summary>
+		/// Requires the lock.
+		/// </summary>
+		void	Finish( NodeId id, bool succeeded );
+		/// <summary>
+		/// Requires the lock. Skips the dependents of a failed task recursively.
+		/// </summary>
+		void	Skip( NodeId id );
+	};
+}
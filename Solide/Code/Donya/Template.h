@@ -1,6 +1,8 @@
 #pragma once
 
+#include <malloc.h>	// Use _aligned_malloc.
 #include <memory>
+#include <new>		// Use std::bad_alloc.
 
 #undef max
 #undef min
@@ -56,4 +58,37 @@ namespace Donya
 	{
 		*v = std::max( min, std::min( max, *v ) );
 	}
+
+	/// <summary>
+	/// The allocator that aligns the elements to "Alignment" bytes. This is for storing the types like DirectX::XMMATRIX to the std::vector,
+	/// because the default allocator does not satisfy those alignment on 32-bit.
+	/// </summary>
+	template<typename T, size_t Alignment = alignof( T )>
+	class AlignedAllocator
+	{
+	public:
+		using value_type = T;
+		template<typename U>
+		struct rebind { using other = AlignedAllocator<U, Alignment>; };
+	public:
+		AlignedAllocator() = default;
+		template<typename U>
+		AlignedAllocator( const AlignedAllocator<U, Alignment> & ) {}
+	public:
+		T *allocate( size_t count )
+		{
+			void *p = _aligned_malloc( count * sizeof( T ), Alignment );
+			if ( !p ) { throw std::bad_alloc{}; }
+			// else
+			return static_cast<T *>( p );
+		}
+		void deallocate( T *p, size_t )
+		{
+			_aligned_free( p );
+		}
+	};
+	template<typename T, typename U, size_t Alignment>
+	bool operator == ( const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> & ) { return true;  }
+	template<typename T, typename U, size_t Alignment>
+	bool operator != ( const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> & ) { return false; }
 }
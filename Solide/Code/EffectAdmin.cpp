@@ -61,12 +61,10 @@ namespace
 }
 CEREAL_CLASS_VERSION( Member, 0 )
 
-class ParamEffect : public ParameterBase<ParamEffect>
+class ParamEffect : public ParameterBase<ParamEffect, Member>
 {
 public:
 	static constexpr const char *ID = "Effect";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -80,7 +78,6 @@ public:
 
 		ResizeVectorIfNeeded();
 	}
-	Member Data() const { return m; }
 private:
 	void ResizeVectorIfNeeded()
 	{
@@ -328,7 +325,7 @@ public:
 	{
 		if ( IsOutOfRange( attr ) ) { return 0.0f; }
 		// else
-		const auto scales = ParamEffect::Get().Data().effectScales;
+		const auto &scales = ParamEffect::Get().Data().effectScales;
 		return scales[scast<size_t>( attr )];
 	}
 	Effekseer::Effect *GetEffectOrNullptr( EffectAttribute attr )
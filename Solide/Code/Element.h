@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>		// Use for std::uint32_t.
 #include <string>		// Use for ShowImGuiNode().
 #include <windows.h>	// Use for enable bitwise operation of enum class.
 
@@ -21,6 +22,15 @@ public:
 
 		_TypeCount
 	};
+	/// <summary>
+	/// The bit set of the combined types, for filtering the collisions by one AND.<para></para>
+	/// The bit of MakeMask( X ) represents the element that is exactly equal to X(e.g. MakeMask( Flame ) does not contain "Oil | Flame").
+	/// </summary>
+	using Mask = std::uint32_t;
+	static constexpr Mask MakeMask( Type exactType )
+	{
+		return Mask( 1 ) << static_cast<int>( exactType );
+	}
 private:
 	Type type; // The type stored by bitwise operation.
 public:
@@ -44,6 +54,10 @@ private:
 	}
 public:
 	constexpr Type Get() const { return type; }
+	/// <summary>
+	/// Returns MakeMask( Get() ). Check the collision filter by: ( GetLayer() & mask ) != 0.
+	/// </summary>
+	constexpr Mask GetLayer() const { return MakeMask( type ); }
 public:
 	bool	Has		( Type validation	) const;
 	Element	Add		( Type addition		);
@@ -54,5 +68,6 @@ public:
 	void ShowImGuiNode( bool useTreeNode, const std::string &nodeCaption );
 #endif // USE_IMGUI
 };
+static_assert( static_cast<int>( Element::Type::Ice ) * 2 <= 32, "The combined types must be fit into the Element::Mask." );
 CEREAL_CLASS_VERSION( Element, 0 )
 DEFINE_ENUM_FLAG_OPERATORS( Element::Type );
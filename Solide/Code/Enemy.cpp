@@ -1,9 +1,13 @@
 #include "Enemy.h"
 
+#include <array>
+#include <unordered_map>
 #include <vector>
 
+#include <cereal/types/unordered_map.hpp>
 #include <cereal/types/vector.hpp>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Color.h"
 #include "Donya/Loader.h"
 #include "Donya/Useful.h"
@@ -11,6 +15,7 @@
 #include "Effect.h"
 #include "FilePath.h"
 #include "Parameter.h"
+#include "StageNumberDefine.h"
 
 namespace
 {
@@ -29,7 +34,7 @@ namespace
 	static std::vector<std::shared_ptr<Enemy::ModelParam>> modelPtrs{};
 	static std::shared_ptr<Enemy::ModelParam> pDefeatModel{};
 
-	bool LoadModels()
+	bool LoadModels( Donya::JobSystem *pJobSystem, const std::function<void( float fraction )> &reportProgress )
 	{
 		// Already has loaded.
 		if ( !modelPtrs.empty() ) { return true; }
@@ -37,15 +42,8 @@ namespace
 
 		modelPtrs.resize( KIND_COUNT );
 
-		Donya::Loader loader{};
-		auto Load = [&loader]( const std::string &filePath, Enemy::ModelParam *pDest )->bool
+		auto Create = []( const Donya::Loader &loader, Enemy::ModelParam *pDest )->bool
 		{
-			loader.ClearData();
-
-			bool  result  = loader.Load( filePath );
-			if ( !result ) { return false; }
-			// else
-
 			const auto &source = loader.GetModelSource();
 			pDest->model = Donya::Model::SkinningModel::Create( source, loader.GetFileDirectory() );
 			pDest->motionHolder.AppendSource( source );
@@ -53,14 +51,12 @@ namespace
 			return pDest->model.WasInitializeSucceeded();
 		};
 
-		bool result		= true;
-		bool succeeded	= true;
-
-		std::string filePath{};
+		std::vector<std::string>							filePaths{};
+		std::vector<std::shared_ptr<Enemy::ModelParam> *>	targets{};
 		const std::string prefix = MODEL_DIRECTORY;
-		auto LoadProcess = [&]( const std::string &modelName, std::shared_ptr<Enemy::ModelParam> &target )
+		auto Reserve = [&]( const std::string &modelName, std::shared_ptr<Enemy::ModelParam> &target )
 		{
-			filePath = prefix + modelName + MODEL_EXTENSION;
+			const std::string filePath = prefix + modelName + MODEL_EXTENSION;
 			if ( !Donya::IsExistFile( filePath ) )
 			{
 				const std::string outputMsgBase{ "Error : The model file does not exist. That is : " };
@@ -69,24 +65,24 @@ namespace
 			}
 			// else
 
-			target = std::make_shared<Enemy::ModelParam>();
-			result = Load( filePath, &( *target ) ); // std::shared_ptr<T> -> T -> T *
-			if ( !result )
-			{
-				const std::wstring errMsgBase{ L"Failed : Loading a model. That is : " };
-				const std::wstring errMsg = errMsgBase + Donya::MultiToWide( filePath );
-				_ASSERT_EXPR( 0, errMsg.c_str() );
-
-				succeeded = false;
-			}
+			filePaths.emplace_back( filePath );
+			targets.emplace_back( &target );
 		};
 
 		for ( size_t i = 0; i < KIND_COUNT; ++i )
 		{
-			LoadProcess( MODEL_NAMES[i], modelPtrs[i] );
+			Reserve( MODEL_NAMES[i], modelPtrs[i] );
 		}
 
-		LoadProcess( DEFEAT_MODEL_NAME, pDefeatModel );
+		Reserve( DEFEAT_MODEL_NAME, pDefeatModel );
+
+		auto CreateTarget = [&]( size_t index, const Donya::Loader &loader )->bool
+		{
+			auto &target = *targets[index];
+			target = std::make_shared<Enemy::ModelParam>();
+			return Create( loader, &( *target ) ); // std::shared_ptr<T> -> T -> T *
+		};
+		const bool succeeded = Donya::Loader::LoadManyThenCreate( filePaths, CreateTarget, pJobSystem, reportProgress );
 
 		if ( !succeeded )
 		{
@@ -121,6 +117,18 @@ namespace
 	{
 		return pDefeatModel;
 	}
+
+	constexpr size_t LOD_COUNT = scast<size_t>( Enemy::AnimationLOD::LODCount );
+	struct AnimationLODCounter
+	{
+		size_t fetched   = 0; // The count of fetching the pose.
+		size_t evaluated = 0; // The count of the fetches that evaluated the pose. The fetches of the same pose are evaluated once by the pose cache.
+		size_t skipped   = 0;
+		std::array<size_t, LOD_COUNT> actorCounts{};
+	};
+	static AnimationLODCounter	currentLODCounter{};
+	static AnimationLODCounter	lastLODCounter{};	// The result of the previous frame.
+	static unsigned int			animationFrame = 0;	// Decides the frame of evaluation at the reduced rate.
 }
 namespace
 {
@@ -138,6 +146,40 @@ namespace
 		RenderingHelper::AdjustColorConstant oilAdjustment;
 
 		float				defeatMotionSpeed = 1.0f;
+
+		float				poseQuantizeSeconds = 1.0f / 120.0f; // The enemies that the playback time is in the same step share a pose.
+
+		struct AnimationLODParam
+		{
+			// The distances from the viewer. The non-positive distance disables that level.
+			float halfDistance		= 40.0f;
+			float quarterDistance	= 80.0f;
+			float stopDistance		= 160.0f;
+
+			bool  stopIfOutOfView	= true;
+			float cullingRadius		= 2.0f; // The radius of the sphere that is tested with the view frustum.
+		private:
+			friend class cereal::access;
+			template<class Archive>
+			void serialize( Archive &archive, std::uint32_t version )
+			{
+				archive
+				(
+					CEREAL_NVP( halfDistance	),
+					CEREAL_NVP( quarterDistance	),
+					CEREAL_NVP( stopDistance	),
+					CEREAL_NVP( stopIfOutOfView	),
+					CEREAL_NVP( cullingRadius	)
+				);
+
+				if ( 1 <= version )
+				{
+					// archive( CEREAL_NVP( x ) );
+				}
+			}
+		};
+		AnimationLODParam							defaultLOD;
+		std::unordered_map<int, AnimationLODParam>	stageLODs; // Overrides the default per stage.
 	private:
 		friend class cereal::access;
 		template<class Archive>
@@ -164,6 +206,18 @@ namespace
 				archive( CEREAL_NVP( defeatMotionSpeed ) );
 			}
 			if ( 3 <= version )
+			{
+				archive( CEREAL_NVP( poseQuantizeSeconds ) );
+			}
+			if ( 4 <= version )
+			{
+				archive
+				(
+					CEREAL_NVP( defaultLOD	),
+					CEREAL_NVP( stageLODs	)
+				);
+			}
+			if ( 5 <= version )
 			{
 				// archive( CEREAL_NVP( x ) );
 			}
@@ -215,6 +269,9 @@ namespace
 		CollisionParam	collider;
 
 		int				removeOilFrame = 1;
+	#if DEBUG_MODE
+		ParameterHelper::CopyCounter copyCounter;
+	#endif // DEBUG_MODE
 	private:
 		friend class cereal::access;
 		template<class Archive>
@@ -240,17 +297,16 @@ namespace
 		}
 	};
 }
-CEREAL_CLASS_VERSION( DrawingParam,				2 )
+CEREAL_CLASS_VERSION( DrawingParam,				4 )
+CEREAL_CLASS_VERSION( DrawingParam::AnimationLODParam, 0 )
 CEREAL_CLASS_VERSION( CollisionParam,			0 )
 CEREAL_CLASS_VERSION( CollisionParam::PerKind,	0 )
 CEREAL_CLASS_VERSION( Member,					2 )
 
-class ParamEnemy : public ParameterBase<ParamEnemy>
+class ParamEnemy : public ParameterBase<ParamEnemy, Member>
 {
 public:
 	static constexpr const char *ID = "Enemy";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -264,7 +320,6 @@ public:
 
 		ResizeKindVectors();
 	}
-	Member Data() const { return m; }
 private:
 	void ResizeKindVectors()
 	{
@@ -336,6 +391,52 @@ public:
 					ImGui::TreePop();
 				}
 
+				ImGui::DragFloat( u8"|[YL鎞Ԃ̍݁ibj", &m.drawer.poseQuantizeSeconds, 0.0001f, 0.0f, 1.0f, "%.4f" );
+				m.drawer.poseQuantizeSeconds = std::max( 0.0f, m.drawer.poseQuantizeSeconds );
+
+				if ( ImGui::TreeNode( u8"Aj[VLOD" ) )
+				{
+					auto ShowLODParam = []( const std::string &nodeCaption, DrawingParam::AnimationLODParam *p )
+					{
+						if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+						// else
+
+						ImGui::DragFloat( u8"1/2ŕ]鋗",	&p->halfDistance,		0.1f );
+						ImGui::DragFloat( u8"1/4ŕ]鋗",	&p->quarterDistance,	0.1f );
+						ImGui::DragFloat( u8"]~߂鋗",	&p->stopDistance,		0.1f );
+						ImGui::Checkbox ( u8"ʊOł͕]~߂",	&p->stopIfOutOfView );
+						ImGui::DragFloat( u8"ʊO̔a",	&p->cullingRadius,		0.01f );
+						p->cullingRadius = std::max( 0.0f, p->cullingRadius );
+
+						ImGui::TreePop();
+					};
+
+					ShowLODParam( u8"l", &m.drawer.defaultLOD );
+
+					static int addStageNo = FIRST_STAGE_NO;
+					ImGui::InputInt( u8"ǉXe[Wԍ", &addStageNo );
+					if ( ImGui::Button( u8"Xe[Wʂ̐ݒǉ" ) && !m.drawer.stageLODs.count( addStageNo ) )
+					{
+						m.drawer.stageLODs.emplace( addStageNo, m.drawer.defaultLOD );
+					}
+
+					for ( auto it = m.drawer.stageLODs.begin(); it != m.drawer.stageLODs.end(); )
+					{
+						const std::string caption = u8"Xe[W[" + std::to_string( it->first ) + u8"]";
+						ShowLODParam( caption, &it->second );
+
+						if ( ImGui::Button( ( caption + u8"폜" ).c_str() ) )
+						{
+							it = m.drawer.stageLODs.erase( it );
+							continue;
+						}
+						// else
+						++it;
+					}
+
+					ImGui::TreePop();
+				}
+
 				if ( ImGui::TreeNode( u8"Ԗ̕`F" ) )
 				{
 					ImGui::ColorEdit4( u8"ICE`F", &m.drawer.oilColor.x );
@@ -369,6 +470,85 @@ public:
 				ImGui::TreePop();
 			}
 
+			if ( ImGui::TreeNode( u8"Aj[V]̔r" ) )
+			{
+				std::string caption{};
+				const size_t modelCount = std::min( KIND_COUNT, modelPtrs.size() );
+				for ( size_t i = 0; i < modelCount; ++i )
+				{
+					if ( !modelPtrs[i] ) { continue; }
+					// else
+					caption = "[" + std::to_string( i ) + ":" + MODEL_NAMES[i] + "]";
+					Donya::Model::ShowAnimationBenchmarkNode( caption, modelPtrs[i]->motionHolder );
+				}
+				if ( pDefeatModel )
+				{
+					caption = "[" + std::string{ DEFEAT_MODEL_NAME } +"]";
+					Donya::Model::ShowAnimationBenchmarkNode( caption, pDefeatModel->motionHolder );
+				}
+
+				if ( ImGui::TreeNode( u8"{[s̓`d" ) )
+				{
+					for ( size_t i = 0; i < modelCount; ++i )
+					{
+						if ( !modelPtrs[i] ) { continue; }
+						// else
+						caption = "[" + std::to_string( i ) + ":" + MODEL_NAMES[i] + "]";
+						Donya::Model::ShowPosePropagationBenchmarkNode( caption, modelPtrs[i]->motionHolder );
+					}
+					if ( pDefeatModel )
+					{
+						caption = "[" + std::string{ DEFEAT_MODEL_NAME } +"]";
+						Donya::Model::ShowPosePropagationBenchmarkNode( caption, pDefeatModel->motionHolder );
+					}
+
+					ImGui::TreePop();
+				}
+
+				std::vector<const Donya::Model::MotionHolder *> holders{};
+				for ( const auto &it : modelPtrs )
+				{
+					if ( it ) { holders.emplace_back( &it->motionHolder ); }
+				}
+				if ( pDefeatModel ) { holders.emplace_back( &pDefeatModel->motionHolder ); }
+				Donya::Model::ShowAnimationScalingBenchmarkNode( u8"]̃XP[O", holders );
+
+				ImGui::TreePop();
+			}
+
+			if ( ImGui::TreeNode( u8"Aj[VLOD̓v" ) )
+			{
+				constexpr std::array<const char *, LOD_COUNT> LOD_NAMES{ "Full", "Half", "Quarter", "Stop" };
+
+				ImGui::Text( "Last frame : Fetched[%d], Evaluated[%d], Skipped[%d]", scast<int>( lastLODCounter.fetched ), scast<int>( lastLODCounter.evaluated ), scast<int>( lastLODCounter.skipped ) );
+				for ( size_t i = 0; i < LOD_COUNT; ++i )
+				{
+					ImGui::Text( "%s : %d actors", LOD_NAMES[i], scast<int>( lastLODCounter.actorCounts[i] ) );
+				}
+
+				ImGui::TreePop();
+			}
+
+			if ( ImGui::TreeNode( u8"|[YL̓v" ) )
+			{
+				std::string caption{};
+				const size_t modelCount = std::min( KIND_COUNT, modelPtrs.size() );
+				for ( size_t i = 0; i < modelCount; ++i )
+				{
+					if ( !modelPtrs[i] ) { continue; }
+					// else
+					caption = "[" + std::to_string( i ) + ":" + MODEL_NAMES[i] + "]";
+					modelPtrs[i]->poseCache.ShowImGuiNode( caption );
+				}
+				if ( pDefeatModel )
+				{
+					caption = "[" + std::string{ DEFEAT_MODEL_NAME } +"]";
+					pDefeatModel->poseCache.ShowImGuiNode( caption );
+				}
+
+				ImGui::TreePop();
+			}
+
 			ShowIONode( m );
 
 			ImGui::TreePop();
@@ -390,7 +570,7 @@ namespace
 
 	static constexpr int RECURSION_RAY_COUNT	= 4;
 
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamEnemy::Get().Data();
 	}
@@ -400,20 +580,112 @@ namespace
 		const float distance = Donya::Vector3{ targetPos - basePos }.Length();
 		return ( distance < searchRadius ) ? true : false;
 	}
+
+	/// <summary>
+	/// Tests the sphere with the planes that are extracted from the view-projection matrix(row-vector, the depth of clip space is 0~1).
+	/// </summary>
+	bool IsInsideFrustum( const Donya::Vector4x4 &VP, const Donya::Vector3 &center, float radius )
+	{
+		const Donya::Vector4 col1{ VP._11, VP._21, VP._31, VP._41 };
+		const Donya::Vector4 col2{ VP._12, VP._22, VP._32, VP._42 };
+		const Donya::Vector4 col3{ VP._13, VP._23, VP._33, VP._43 };
+		const Donya::Vector4 col4{ VP._14, VP._24, VP._34, VP._44 };
+		const std::array<Donya::Vector4, 6> planes
+		{
+			col4 + col1,	// Left.
+			col4 - col1,	// Right.
+			col4 + col2,	// Bottom.
+			col4 - col2,	// Top.
+			col3,			// Near.
+			col4 - col3,	// Far.
+		};
+
+		for ( const auto &plane : planes )
+		{
+			const float normalLength = Donya::Vector3{ plane.x, plane.y, plane.z }.Length();
+			if ( ZeroEqual( normalLength ) ) { continue; }
+			// else
+
+			const float distance = ( plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w ) / normalLength;
+			if ( distance < -radius ) { return false; }
+		}
+
+		return true;
+	}
 }
 
 
 namespace Enemy
 {
-	bool LoadResources()
+	bool LoadResources( Donya::JobSystem *pJobSystem, const std::function<void( float fraction )> &reportProgress )
 	{
 		ParamEnemy::Get().Init();
 
 		bool succeeded = true;
-		if ( !LoadModels() ) { succeeded = false; }
+		if ( !LoadModels( pJobSystem, reportProgress ) ) { succeeded = false; }
 
 		return succeeded;
 	}
+	void BeginAnimationFrame( Donya::Model::AnimationBatch *pDeferredBatch )
+	{
+		animationFrame++;
+		lastLODCounter		= currentLODCounter;
+		currentLODCounter	= AnimationLODCounter{};
+
+		const float quantizeSeconds = FetchMember().drawer.poseQuantizeSeconds;
+		auto Begin = [&quantizeSeconds, &pDeferredBatch]( const std::shared_ptr<ModelParam> &pModel )
+		{
+			if ( !pModel ) { return; }
+			// else
+			pModel->poseCache.SetQuantizeSeconds( quantizeSeconds );
+			pModel->poseCache.SetDeferredBatch( pDeferredBatch );
+			pModel->poseCache.BeginFrame();
+		};
+
+		for ( const auto &it : modelPtrs )
+		{
+			Begin( it );
+		}
+		Begin( pDefeatModel );
+	}
+	void EndAnimationFrame()
+	{
+		auto End = []( const std::shared_ptr<ModelParam> &pModel )
+		{
+			if ( !pModel ) { return; }
+			// else
+			pModel->poseCache.SetDeferredBatch( nullptr );
+		};
+
+		for ( const auto &it : modelPtrs )
+		{
+			End( it );
+		}
+		End( pDefeatModel );
+	}
+	AnimationLOD CalcAnimationLOD( int stageNo, const Donya::Vector3 &wsPos, const AnimationViewer &viewer )
+	{
+		const auto &data  = FetchMember();
+		const auto found = data.drawer.stageLODs.find( stageNo );
+		const auto &lod  = ( found != data.drawer.stageLODs.end() ) ? found->second : data.drawer.defaultLOD;
+
+		if ( lod.stopIfOutOfView && !IsInsideFrustum( viewer.matViewProj, wsPos, lod.cullingRadius ) )
+		{
+			return AnimationLOD::Stop;
+		}
+		// else
+
+		auto IsFar = []( float distance, float threshold )
+		{
+			return ( 0.0f < threshold && threshold <= distance );
+		};
+		const float distance = Donya::Vector3{ wsPos - viewer.wsEyePos }.Length();
+		if ( IsFar( distance, lod.stopDistance		) ) { return AnimationLOD::Stop;	}
+		if ( IsFar( distance, lod.quarterDistance	) ) { return AnimationLOD::Quarter;	}
+		if ( IsFar( distance, lod.halfDistance		) ) { return AnimationLOD::Half;	}
+		// else
+		return AnimationLOD::Full;
+	}
 
 #if USE_IMGUI
 	std::string GetKindName( Kind kind )
@@ -505,13 +777,7 @@ namespace Enemy
 		{
 			const auto &initialMotion = pModelParam->motionHolder.GetMotion( 0 );
 			animator.SetRepeatRange( initialMotion );
-			pose.AssignSkeletal
-			(
-				animator.CalcCurrentPose
-				(
-					initialMotion
-				)
-			);
+			UpdatePose( initialMotion );
 		}
 	}
 	void Base::Uninit()
@@ -524,10 +790,10 @@ namespace Enemy
 	}
 	void Base::Draw( RenderingHelper *pRenderer )
 	{
-		if ( !pModelParam ) { return; }
+		if ( !pModelParam || !pPose ) { return; }
 		// else
 
-		const auto drawData = FetchMember().drawer;
+		const auto &drawData = FetchMember().drawer;
 		Donya::Model::Constants::PerModel::Common modelConstant{};
 		modelConstant.drawColor		= CalcDrawColor();
 		modelConstant.worldMatrix	= CalcWorldMatrix( /* useForHitBox = */ false, /* useForHurtBox = */ false, /* useForDrawing = */ true );
@@ -540,7 +806,7 @@ namespace Enemy
 		pRenderer->ActivateConstantModel();
 		pRenderer->ActivateConstantAdjustColor();
 
-		pRenderer->Render( pModelParam->model, pose );
+		pRenderer->Render( pModelParam->model, *pPose );
 
 		pRenderer->DeactivateConstantAdjustColor();
 		pRenderer->DeactivateConstantModel();
@@ -581,9 +847,13 @@ namespace Enemy
 
 		pAppendDest->emplace_back( std::move( AcquireHurtBox( /* wantWorldSpace = */ true ) ) );
 	}
+	Donya::AABB Base::CalcSweptRegion() const
+	{
+		return Donya::AABBGrid::MakeSweptRegion( AcquireHitBox( /* wantWorldSpace = */ true ), GetVelocity() );
+	}
 	Donya::AABB Base::AcquireHitBox( bool wantWorldSpace ) const
 	{
-		const auto	data		= FetchMember();
+		const auto	&data		= FetchMember();
 		const auto	&collisions	= data.collider.collisions;
 		const int	intKind		= scast<int>( GetKind() );
 
@@ -602,7 +872,7 @@ namespace Enemy
 	}
 	Donya::AABB Base::AcquireHurtBox( bool wantWorldSpace ) const
 	{
-		const auto	data		= FetchMember();
+		const auto	&data		= FetchMember();
 		const auto	&collisions	= data.collider.collisions;
 		const int	intKind		= scast<int>( GetKind() );
 
@@ -653,7 +923,7 @@ namespace Enemy
 	}
 	void Base::UpdateMotion( float elapsedTime, int useMotionIndex )
 	{
-		const auto data			= FetchMember();
+		const auto &data			= FetchMember();
 		const auto &speedSource = data.drawer.accelerations;
 
 		const size_t intKind	= scast<size_t>( GetKind() );
@@ -662,9 +932,52 @@ namespace Enemy
 
 		if ( pModelParam )
 		{
-			pose.AssignSkeletal( animator.CalcCurrentPose( pModelParam->motionHolder.GetMotion( useMotionIndex ) ) );
+			UpdatePoseByLOD( pModelParam->motionHolder.GetMotion( useMotionIndex ) );
 		}
 	}
+	void Base::UpdatePose( const Donya::Model::MotionClip &motion )
+	{
+		if ( !pModelParam ) { return; }
+		// else
+		bool wasCached = false;
+		pPose			= pModelParam->poseCache.Fetch( motion, animator, &wasCached );
+		pPosedMotion	= &motion;
+		currentLODCounter.fetched++;
+		if ( !wasCached ) { currentLODCounter.evaluated++; }
+	}
+	void Base::UpdatePoseByLOD( const Donya::Model::MotionClip &motion )
+	{
+		// The pose must follow the change of motion immediately.
+		const bool mustEvaluate = ( !pPose || pPosedMotion != &motion );
+
+		unsigned int interval = 1;
+		switch ( animationLOD )
+		{
+		case AnimationLOD::Full:	interval = 1; break;
+		case AnimationLOD::Half:	interval = 2; break;
+		case AnimationLOD::Quarter:	interval = 4; break;
+		case AnimationLOD::Stop:	interval = 0; break;
+		default: break;
+		}
+
+		// The animator has accumulated the elapsed time of the skipped frames, so the evaluated pose is at the same time as the full rate.
+		const bool isEvaluatingFrame = ( interval && ( animationFrame + lodPhase ) % interval == 0 );
+		if ( !mustEvaluate && !isEvaluatingFrame )
+		{
+			currentLODCounter.skipped++;
+			return;
+		}
+		// else
+		UpdatePose( motion );
+	}
+	void Base::SetAnimationLOD( AnimationLOD lod, unsigned int phase )
+	{
+		animationLOD	= lod;
+		lodPhase		= phase;
+
+		const size_t index = scast<size_t>( lod );
+		if ( index < LOD_COUNT ) { currentLODCounter.actorCounts[index]++; }
+	}
 	void Base::AssignDieState()
 	{
 		nowDead = true;
@@ -684,7 +997,7 @@ namespace Enemy
 		animator.SetRepeatRange( motion );
 		animator.ResetTimer();
 		animator.DisableLoop();
-		pose.AssignSkeletal( animator.CalcCurrentPose( motion ) );
+		UpdatePose( motion );
 	}
 	void Base::UpdateDieMotion( float elapsedTime )
 	{
@@ -694,7 +1007,7 @@ namespace Enemy
 		if ( !pModelParam ) { return; }
 		// else
 		
-		pose.AssignSkeletal( animator.CalcCurrentPose( pModelParam->motionHolder.GetMotion( MOTION_INDEX_DEFEAT ) ) );
+		UpdatePoseByLOD( pModelParam->motionHolder.GetMotion( MOTION_INDEX_DEFEAT ) );
 	}
 	bool Base::WasEndedDieMotion() const
 	{
@@ -702,7 +1015,7 @@ namespace Enemy
 	}
 	Donya::Vector4			Base::CalcDrawColor() const
 	{
-		const auto data = FetchMember();
+		const auto &data = FetchMember();
 		Donya::Vector4 baseColor{ 1.0f, 1.0f, 1.0f, 1.0f };
 
 		if ( element.Has( Element::Type::Oil	) ) { baseColor.Product( data.drawer.oilColor	); }
@@ -722,7 +1035,7 @@ namespace Enemy
 			W._42 = pos.y;
 			W._43 = pos.z;
 
-			const auto	data		= FetchMember();
+			const auto	&data		= FetchMember();
 			const auto	&collisions	= data.collider.collisions;
 			const int	intKind		= scast<int>( GetKind() );
 
@@ -745,7 +1058,7 @@ namespace Enemy
 
 		if ( useForDrawing )
 		{
-			const auto data = FetchMember();
+			const auto &data = FetchMember();
 			W._11 = data.drawer.drawScale;
 			W._22 = data.drawer.drawScale;
 			W._33 = data.drawer.drawScale;
@@ -758,7 +1071,7 @@ namespace Enemy
 		W *= orientation.MakeRotationMatrix();
 		if ( useForDrawing )
 		{
-			const auto data = FetchMember();
+			const auto &data = FetchMember();
 			W *= data.drawer.drawRotation.MakeRotationMatrix();
 		}
 
@@ -768,7 +1081,7 @@ namespace Enemy
 
 		if ( useForDrawing )
 		{
-			const auto data = FetchMember();
+			const auto &data = FetchMember();
 			W._41 += data.drawer.drawOffset.x;
 			W._42 += data.drawer.drawOffset.y;
 			W._43 += data.drawer.drawOffset.z;
@@ -999,7 +1312,7 @@ namespace Enemy
 		// else
 
 		const Donya::Vector3 internalVec	=  wsRayEnd - currentResult.intersection;
-		const Donya::Vector3 wsFaceNormal	=  currentResult.nearestPolygon.normal;
+		const Donya::Vector3 wsFaceNormal	=  currentResult.normal;
 		const Donya::Vector3 projVelocity	= -wsFaceNormal * Dot( internalVec, -wsFaceNormal );
 
 		constexpr float ERROR_MAGNI = 1.0f + ERROR_ADJUST;
@@ -1242,7 +1555,7 @@ namespace Enemy
 		{
 			const auto &initialMotion = target.pModelParam->motionHolder.GetMotion( AcquireMotionIndex() );
 			target.animator.SetRepeatRange( initialMotion );
-			target.pose.AssignSkeletal( target.animator.CalcCurrentPose( initialMotion ) );
+			target.UpdatePose( initialMotion );
 		}
 	}
 	void Archer::MoverBase::LookToTarget( Archer &target, const Donya::Vector3 &targetPos )
@@ -1501,7 +1814,7 @@ namespace Enemy
 		{
 			const auto &initialMotion = target.pModelParam->motionHolder.GetMotion( AcquireMotionIndex() );
 			target.animator.SetRepeatRange( initialMotion );
-			target.pose.AssignSkeletal( target.animator.CalcCurrentPose( initialMotion ) );
+			target.UpdatePose( initialMotion );
 		}
 	}
 
@@ -1699,7 +2012,7 @@ namespace Enemy
 		{
 			const auto &initialMotion = target.pModelParam->motionHolder.GetMotion( AcquireMotionIndex( target ) );
 			target.animator.SetRepeatRange( initialMotion );
-			target.pose.AssignSkeletal( target.animator.CalcCurrentPose( initialMotion ) );
+			target.UpdatePose( initialMotion );
 		}
 	}
 	bool Chaser::MoverBase::IsTargetClose( Chaser &target, const Donya::Vector3 &targetPos ) const
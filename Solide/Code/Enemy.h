@@ -9,8 +9,10 @@
 #include <cereal/types/polymorphic.hpp>
 
 #include "Donya/Model.h"
+#include "Donya/ModelAnimationBatch.h"
 #include "Donya/ModelMotion.h"
 #include "Donya/ModelPose.h"
+#include "Donya/ModelPoseCache.h"
 #include "Donya/Quaternion.h"
 #include "Donya/Serializer.h"
 #include "Donya/UseImGui.h"
@@ -34,7 +36,45 @@ namespace Enemy
 		KindCount
 	};
 
-	bool LoadResources();
+	/// <summary>
+	/// The rate of evaluating the pose of an enemy. The time of motion advances every frame regardless of this, so the skipped frames are caught up at the next evaluation.
+	/// </summary>
+	enum class AnimationLOD
+	{
+		Full,		// Every frame.
+		Half,		// Once per 2 frames.
+		Quarter,	// Once per 4 frames.
+		Stop,		// Keeps the current pose.
+
+		LODCount
+	};
+	/// <summary>
+	/// The viewpoint that decides the animation LOD.
+	/// </summary>
+	struct AnimationViewer
+	{
+		Donya::Vector3		wsEyePos;
+		Donya::Vector4x4	matViewProj;
+	};
+
+	/// <summary>
+	/// The files of models are loaded in parallel on the "pJobSystem" if it is not nullptr.<para></para>
+	/// The "reportProgress" receives the fraction of the loaded models. It can be nullptr.
+	/// </summary>
+	bool LoadResources( Donya::JobSystem *pJobSystem = nullptr, const std::function<void( float fraction )> &reportProgress = nullptr );
+	/// <summary>
+	/// Drops the shared poses of the previous frame. Please call this once per frame, before updating the enemies.<para></para>
+	/// If the "pDeferredBatch" is not nullptr, the poses are not evaluated at the update but appended to it, so please evaluate it before using the poses.
+	/// </summary>
+	void BeginAnimationFrame( Donya::Model::AnimationBatch *pDeferredBatch = nullptr );
+	/// <summary>
+	/// Stops appending the evaluations to the batch that is specified at BeginAnimationFrame().
+	/// </summary>
+	void EndAnimationFrame();
+	/// <summary>
+	/// Decides the LOD of the enemy at "wsPos" by the distance from the viewer and the view frustum. The thresholds are chosen by the stage number.
+	/// </summary>
+	AnimationLOD CalcAnimationLOD( int stageNo, const Donya::Vector3 &wsPos, const AnimationViewer &viewer );
 #if USE_IMGUI
 	std::string GetKindName( Kind kind );
 	void UseImGui();
@@ -114,6 +154,7 @@ namespace Enemy
 	{
 		Donya::Model::SkinningModel	model;
 		Donya::Model::MotionHolder	motionHolder;
+		Donya::Model::PoseCache		poseCache;	// Shares the evaluated poses between the enemies that use this model.
 	};
 
 	struct HurtDesc
@@ -130,8 +171,11 @@ namespace Enemy
 		Donya::Vector3					pos;
 		Donya::Quaternion				orientation;
 		std::shared_ptr<ModelParam>		pModelParam;
-		Donya::Model::Pose				pose;
+		std::shared_ptr<const Donya::Model::Pose> pPose; // Shared between the enemies that are at the same time of the same motion.
 		Donya::Model::Animator			animator;
+		const Donya::Model::MotionClip	*pPosedMotion	= nullptr;				// The motion of the current pose.
+		AnimationLOD					animationLOD	= AnimationLOD::Full;
+		unsigned int					lodPhase		= 0;					// Staggers the evaluating frame between the enemies.
 
 		// Will changes by const method.
 		mutable Element					element;
@@ -177,16 +221,34 @@ namespace Enemy
 		virtual Element			GetElement()		const { return element;		}
 		const	InitializeParam	&GetInitializer()	const { return initializer;	}
 		const	Donya::Vector3	&GetPosition()		const { return pos;			}
+		AnimationLOD			GetAnimationLOD()	const { return animationLOD;	}
+		/// <summary>
+		/// The "phase" shifts the frame of evaluation at the reduced rate, so the enemies of the same LOD are not evaluated at the same frame.
+		/// </summary>
+		void SetAnimationLOD( AnimationLOD lod, unsigned int phase );
 		virtual void MakeDamage( const Element &effect ) const;
 		virtual void AcquireHitBoxes ( std::vector<Donya::AABB> *pAppendDest ) const;
 		virtual void AcquireHurtBoxes( std::vector<Donya::AABB> *pAppendDest ) const;
+		/// <summary>
+		/// Returns the world-space region that my hit-box may reach by the PhysicUpdate() of this frame. It is used for querying the solids.
+		/// </summary>
+		Donya::AABB CalcSweptRegion() const;
 	protected: // Hit/Hurt box acquisition method of open to outside is only whole hit/hurt boxes.
 		virtual Donya::AABB AcquireHitBox( bool wantWorldSpace ) const;
 		virtual Donya::AABB AcquireHurtBox( bool wantWorldSpace ) const;
+		/// <summary>
+		/// Returns the movement of a frame. The enemies that do not move by PhysicUpdate() return zero.
+		/// </summary>
+		virtual Donya::Vector3 GetVelocity() const { return Donya::Vector3::Zero(); }
 	protected:
 		virtual void OiledUpdate();
 		virtual void BurningUpdate();
 		virtual void UpdateMotion( float elapsedTime, int useMotionIndex );
+		void UpdatePose( const Donya::Model::MotionClip &motion );
+		/// <summary>
+		/// Calls UpdatePose() if the current LOD evaluates at this frame, or the motion was changed.
+		/// </summary>
+		void UpdatePoseByLOD( const Donya::Model::MotionClip &motion );
 		virtual void AssignDieState();
 		virtual void AssignDieMotion();
 		virtual void UpdateDieMotion( float elapsedTime );
@@ -256,6 +318,8 @@ namespace Enemy
 	public:
 		bool ShouldRemove()	const override;
 		Kind GetKind()		const override;
+	protected:
+		Donya::Vector3 GetVelocity() const override { return velocity; }
 	private:
 		/// <summary>
 		/// This may return not a unit vector.
@@ -574,6 +638,8 @@ namespace Enemy
 	public:
 		bool ShouldRemove()	const override;
 		Kind GetKind()		const override;
+	protected:
+		Donya::Vector3 GetVelocity() const override { return velocity; }
 	private:
 		template<class Mover>
 		void AssignMover()
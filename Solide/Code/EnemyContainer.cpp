@@ -3,6 +3,7 @@
 #include <algorithm>		// Use std::sort().
 
 #if USE_IMGUI
+#include "Donya/SerializerBenchmark.h"
 #include "Donya/Useful.h"	// Convert the character codes.
 #endif // USE_IMGUI
 
@@ -47,16 +48,23 @@ namespace Enemy
 		}
 	}
 
-	void Container::Update( float elapsedTime, const Donya::Vector3 &targetPos )
+	void Container::Update( float elapsedTime, const Donya::Vector3 &targetPos, Donya::Model::AnimationBatch *pDeferredAnimations, const AnimationViewer *pViewer )
 	{
 	#if USE_IMGUI
 		if ( wantPauseUpdates ) { EraseEnemiesIfNeeded(); return; }
 	#endif // USE_IMGUI
 
+		BeginAnimationFrame( pDeferredAnimations );
+
+		unsigned int phase = 0;
 		for ( auto &pIt : enemyPtrs )
 		{
 			if ( !pIt ) { continue; }
 			// else
+
+			const AnimationLOD lod = ( pViewer ) ? CalcAnimationLOD( stageNo, pIt->GetPosition(), *pViewer ) : AnimationLOD::Full;
+			pIt->SetAnimationLOD( lod, phase++ );
+
 			pIt->Update( elapsedTime, targetPos );
 			if ( pIt->ShouldRemove() )
 			{
@@ -65,9 +73,11 @@ namespace Enemy
 			}
 		}
 
+		EndAnimationFrame();
+
 		EraseEnemiesIfNeeded();
 	}
-	void Container::PhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
+	void Container::PhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
 	{
 	#if USE_IMGUI
 		if ( wantPauseUpdates ) { return; }
@@ -77,7 +87,12 @@ namespace Enemy
 		{
 			if ( !pIt ) { continue; }
 			// else
-			pIt->PhysicUpdate( solids, pTerrain, pTerrainMatrix );
+
+			pIt->PhysicUpdate
+			(
+				( querySolids ) ? querySolids( pIt->CalcSweptRegion() ) : std::vector<Donya::AABB>{},
+				pTerrain, pTerrainMatrix
+			);
 		}
 	}
 
@@ -279,6 +294,25 @@ namespace Enemy
 				for ( auto &pIt : enemyPtrs ) { if ( pIt ) { pIt->Init( pIt->GetInitializer() ); } }
 			}
 
+			static Donya::SerializerBenchmark::Comparison binaryComparison{};
+			static Donya::SerializerBenchmark::Comparison jsonComparison{};
+			static bool measured = false;
+			if ( ImGui::Button( ( u8"[ȟv" + strIndex ).c_str() ) )
+			{
+				constexpr int REPEAT_COUNT = 10;
+				const int measureStageNo = stageNo;
+				binaryComparison	= Donya::SerializerBenchmark::Measure( REPEAT_COUNT, [measureStageNo]() { Container tmp{}; tmp.LoadBin ( measureStageNo ); } );
+				jsonComparison		= Donya::SerializerBenchmark::Measure( REPEAT_COUNT, [measureStageNo]() { Container tmp{}; tmp.LoadJson( measureStageNo ); } );
+				measured = true;
+			}
+			if ( measured )
+			{
+				ImGui::Text( "Binary :" );
+				Donya::SerializerBenchmark::ShowComparison( binaryComparison );
+				ImGui::Text( "Json :" );
+				Donya::SerializerBenchmark::ShowComparison( jsonComparison );
+			}
+
 			ImGui::TreePop();
 		};
 		ShowIONode();
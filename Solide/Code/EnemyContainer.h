@@ -9,6 +9,7 @@
 #include <cereal/types/memory.hpp>
 #include <cereal/types/vector.hpp>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Collision.h"
 #include "Donya/ModelPolygon.h"
 #include "Donya/Serializer.h"
@@ -47,8 +48,15 @@ namespace Enemy
 		void Init( int stageNo );
 		void Uninit();
 
-		void Update( float elapsedTime, const Donya::Vector3 &targetPosition );
-		void PhysicUpdate( const std::vector<Donya::AABB> &solids = {}, const Donya::Model::PolygonGroup *pTerrain = nullptr, const Donya::Vector4x4 *pTerrainWorldMatrix = nullptr );
+		/// <summary>
+		/// If the "pDeferredAnimations" is not nullptr, the poses of enemies are appended to it instead of evaluating at here.<para></para>
+		/// If the "pViewer" is not nullptr, the poses of enemies that are far from it or out of its view are evaluated at the reduced rate.
+		/// </summary>
+		void Update( float elapsedTime, const Donya::Vector3 &targetPosition, Donya::Model::AnimationBatch *pDeferredAnimations = nullptr, const AnimationViewer *pViewer = nullptr );
+		/// <summary>
+		/// Each enemy collides to the solids that were queried by its swept region.
+		/// </summary>
+		void PhysicUpdate( const Donya::AABBQuery &querySolids = {}, const Donya::Model::PolygonGroup *pTerrain = nullptr, const Donya::Vector4x4 *pTerrainWorldMatrix = nullptr );
 
 		void Draw( RenderingHelper *pRenderer );
 		void DrawHitBoxes( RenderingHelper *pRenderer, const Donya::Vector4x4 &VP );
@@ -2,6 +2,7 @@
 
 #include <array>
 
+#include "Donya/AllocationTracker.h"
 #include "Donya/Blend.h"
 #include "Donya/Constant.h"
 #include "Donya/Donya.h"
@@ -17,6 +18,7 @@
 #include "EffectAdmin.h"
 #include "EffectAttribute.h"
 #include "Music.h"
+#include "StageAssetCache.h"
 
 using namespace DirectX;
 
@@ -42,10 +44,16 @@ bool Framework::Init()
 void Framework::Uninit()
 {
 	pSceneMng->Uninit();
+
+	// The title scene also uses the cache, so releases it before the device is released.
+	StageAssetCache::Get().Clear();
 }
 
 void Framework::Update( float elapsedTime/*Elapsed seconds from last frame*/ )
 {
+	Donya::AllocationTracker::BeginFrame();
+	Donya::AllocationTracker::Scope allocationScope{ "Framework::Update" };
+
 #if DEBUG_MODE
 	if ( Donya::Keyboard::Press( VK_MENU ) )
 	{
@@ -75,6 +83,8 @@ void Framework::Update( float elapsedTime/*Elapsed seconds from last frame*/ )
 
 void Framework::Draw( float elapsedTime/*Elapsed seconds from last frame*/ )
 {
+	Donya::AllocationTracker::Scope allocationScope{ "Framework::Draw" };
+
 	Donya::Blend::Activate( Donya::Blend::Mode::ALPHA_NO_ATC );
 
 	pSceneMng->Draw( elapsedTime );
@@ -151,6 +161,8 @@ void Framework::DebugShowInformation()
 		ImGui::TreePop();
 	}
 
+	Donya::AllocationTracker::ShowImGuiNode( u8"mۂ̌v" );
+
 	if ( ImGui::TreeNode( u8"}EX" ) )
 	{
 		int x = 0, y = 0;
@@ -1,5 +1,6 @@
 #include "ObjectBase.h"
 
+#include <array>
 #include <memory>
 
 #include "Donya/Constant.h"
@@ -7,6 +8,11 @@
 #include "Donya/StaticMesh.h"
 #include "Donya/Useful.h"
 
+#if USE_IMGUI
+#include "Donya/Benchmark.h"
+#include "Donya/Random.h"
+#endif // USE_IMGUI
+
 #undef max
 #undef min
 
@@ -134,7 +140,7 @@ Actor::MoveResult Actor::Move( const Donya::Vector3 &movement, const std::vector
 			const Donya::Vector3 footPos = pos + hitBox.pos - verticalSize;
 			const Donya::Vector3 diff = resultV.raycastResult.intersection - footPos;
 			pos.y += diff.y;
-			result.lastNormal = resultV.raycastResult.nearestPolygon.normal;
+			result.lastNormal = resultV.raycastResult.normal;
 		}
 	}
 
@@ -147,8 +153,11 @@ Actor::AABBResult		Actor::CalcCorrectedVector( const Donya::Vector3 &vector, con
 	defaultResult.correctedVector	= vector;
 	defaultResult.wasHit			= false;
 
-	return	( solids.empty() )
-			? defaultResult
+	if ( solids.empty() ) { return defaultResult; }
+	// else
+
+	return	( GetResolveMode() == ResolveMode::Sweep )
+			? CalcSweptVectorImpl( vector, solids )
 			: CalcCorrectedVectorImpl( vector, solids );
 }
 Actor::RecursionResult	Actor::CalcCorrectedVector( int recursionLimit, const Donya::Vector3 &vector, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix ) const
@@ -185,33 +194,55 @@ Actor::AABBResult		Actor::CalcCorrectedVectorImpl( const Donya::Vector3 &vector,
 	Donya::AABB movedBody = GetHitBox();
 	movedBody.pos += vector;
 
-	Donya::AABB *pOther{};
+	const Donya::AABB *pOther{};
 
-	// Will control the exist flag.
-	std::vector<Donya::AABB> currSolids = solids;
+	// The candidates are the existing solids around the moving body, these keep the order of "solids".
+	// The correction moves the body inside the search region in most cases, so re-collect only when the body went out of the region.
+	// The first colliding candidate is the same as the first colliding one of all solids, because the body is inside the region.
+	const Donya::Vector3 searchMargin = movedBody.size + Donya::Vector3{ fabsf( vector.x ), fabsf( vector.y ), fabsf( vector.z ) };
+	Donya::AABB searchRegion{};
+	std::vector<const Donya::AABB *> candidates{};
+	auto CollectCandidates	= [&]( const Donya::AABB &center )
 	{
-		// Remove a solids that is not exist.
-		auto itr = std::remove_if
-		(
-			currSolids.begin(), currSolids.end(),
-			[]( Donya::AABB &elem )
+		searchRegion.pos	= center.pos;
+		searchRegion.size	= center.size + searchMargin;
+		searchRegion.exist	= true;
+
+		candidates.clear();
+		for ( const auto &it : solids )
+		{
+			if ( Donya::AABB::IsHitAABB( searchRegion, it ) )
 			{
-				return !elem.exist;
+				candidates.emplace_back( &it );
 			}
-		);
-		currSolids.erase( itr, currSolids.end() );
-	}
+		}
+	};
+	auto IsInsideOfRegion	= [&]( const Donya::AABB &body )
+	{
+		for ( int i = 0; i < 3; ++i )
+		{
+			if ( body.pos[i] - body.size[i] < searchRegion.pos[i] - searchRegion.size[i] ) { return false; }
+			if ( searchRegion.pos[i] + searchRegion.size[i] < body.pos[i] + body.size[i] ) { return false; }
+		}
+		return true;
+	};
+	CollectCandidates( movedBody );
 
-	auto FindCollidingAABB	= [&]( const Donya::AABB &myself, const std::vector<Donya::AABB> &solids, bool exceptMyself = true )->Donya::AABB *
+	auto FindCollidingAABB	= [&]( const Donya::AABB &myself, bool exceptMyself = true )->const Donya::AABB *
 	{
-		for ( auto &it : currSolids )
+		if ( !IsInsideOfRegion( myself ) )
+		{
+			CollectCandidates( myself );
+		}
+
+		for ( const auto &pIt : candidates )
 		{
-			if ( exceptMyself && it == myself ) { continue; }
+			if ( exceptMyself && *pIt == myself ) { continue; }
 			// else
 
-			if ( Donya::AABB::IsHitAABB( myself, it ) )
+			if ( Donya::AABB::IsHitAABB( myself, *pIt ) )
 			{
-				return &it;
+				return pIt;
 			}
 		}
 
@@ -249,8 +280,7 @@ Actor::AABBResult		Actor::CalcCorrectedVectorImpl( const Donya::Vector3 &vector,
 	};
 	auto CalcResolver		= []( const Donya::Vector3 &penetration, const Donya::Vector3 &myMoveSign )
 	{
-		// Prevent the two edges onto same place(the collision detective allows same(equal) value).
-		constexpr float ERROR_MARGIN = 0.001f;
+		constexpr float ERROR_MARGIN = Donya::AABB::RESOLVE_MARGIN;
 
 		Donya::Vector3 resolver
 		{
@@ -265,7 +295,7 @@ Actor::AABBResult		Actor::CalcCorrectedVectorImpl( const Donya::Vector3 &vector,
 	unsigned int loopCount{};
 	while ( ++loopCount < MAX_LOOP_COUNT )
 	{
-		pOther = FindCollidingAABB( movedBody, solids );
+		pOther = FindCollidingAABB( movedBody );
 		if ( !pOther ) { break; } // Does not detected a collision.
 		// else
 
@@ -282,6 +312,7 @@ Actor::AABBResult		Actor::CalcCorrectedVectorImpl( const Donya::Vector3 &vector,
 			// Bury. For prevent resolving as long distance.
 			result.correctedVector = Donya::Vector3::Zero();
 			result.wasHit = true;
+			result.loopCount = loopCount;
 			return result;
 		}
 		// else
@@ -350,14 +381,30 @@ Actor::AABBResult		Actor::CalcCorrectedVectorImpl( const Donya::Vector3 &vector,
 		result.wasHit		= true;
 
 		if ( moveSign.IsZero()  ) { break; }
-		// else
-
-		for ( auto &it : currSolids ) { it.exist = true; }
 	}
 
 	const Donya::Vector3 &destination = movedBody.pos - hitBox.pos/* Except the offset of hitBox */;
 		
 	result.correctedVector = destination - pos;
+	result.loopCount = loopCount;
+	return result;
+}
+Actor::AABBResult		Actor::CalcSweptVectorImpl( const Donya::Vector3 &vector, const std::vector<Donya::AABB> &solids ) const
+{
+	const auto slid = Donya::AABB::CalcSlidMovement( GetHitBox(), vector, solids );
+	if ( slid.wasBuried )
+	{
+		// I was already buried at the start. The sweep can not resolve it, so I entrust it to the push-out way.
+		AABBResult pushed = CalcCorrectedVectorImpl( vector, solids );
+		pushed.loopCount += slid.loopCount;
+		return pushed;
+	}
+	// else
+
+	AABBResult result{};
+	result.correctedVector	= slid.movement;
+	result.wasHit			= slid.wasHit;
+	result.loopCount		= slid.loopCount;
 	return result;
 }
 Actor::RecursionResult	Actor::CalcCorrectedVectorImpl( const Donya::Vector3 &wsRayStart,int recursionLimit, int recursionCount, RecursionResult inheritedResult, const Donya::Model::PolygonGroup &terrain, const Donya::Vector4x4 &terrainMatrix ) const
@@ -381,7 +428,7 @@ Actor::RecursionResult	Actor::CalcCorrectedVectorImpl( const Donya::Vector3 &wsR
 	// else
 
 	const Donya::Vector3 internalVec	=  wsRayEnd - currentResult.intersection;
-	const Donya::Vector3 wsFaceNormal	=  currentResult.nearestPolygon.normal;
+	const Donya::Vector3 wsFaceNormal	=  currentResult.normal;
 	const Donya::Vector3 projVelocity	= -wsFaceNormal * Dot( internalVec, -wsFaceNormal );
 
 	constexpr float ERROR_MAGNI = 1.0f + ERROR_ADJUST;
@@ -464,7 +511,7 @@ void Actor::MoveXZImpl( const Donya::Vector3 &xzMovement, const std::vector<Dony
 		{
 			constexpr float normLength		= 6.0f;
 			const Donya::Vector3 normStart	= result.raycastResult.intersection;
-			const Donya::Vector3 normEnd	= normStart + result.raycastResult.nearestPolygon.normal * normLength;
+			const Donya::Vector3 normEnd	= normStart + result.raycastResult.normal * normLength;
 			ReserveLine( normStart, normEnd, { 0.2f, 1.0f, 0.0f, 0.8f } );
 		}
 	#endif // DEBUG_MODE
@@ -548,7 +595,7 @@ Actor::MoveResult Actor::MoveYImpl( const Donya::Vector3 &yMovement, const std::
 		if ( rayResult.correctedVector.IsZero() )
 		{
 			MoveResult result;
-			result.lastNormal = rayResult.raycastResult.nearestPolygon.normal;
+			result.lastNormal = rayResult.raycastResult.normal;
 			result.lastResult = rayResult.raycastResult;
 			return result;
 		}
@@ -592,7 +639,7 @@ Actor::MoveResult Actor::MoveYImpl( const Donya::Vector3 &yMovement, const std::
 	pos += aabbResult.correctedVector;
 
 	MoveResult result;
-	result.lastNormal = rayResult.raycastResult.nearestPolygon.normal;
+	result.lastNormal = rayResult.raycastResult.normal;
 	result.lastResult = rayResult.raycastResult;
 
 	// If the position corrected by AABB, We should return the AABB's normal.
@@ -643,16 +690,38 @@ Donya::Vector3 Actor::CalcCorrectedVectorByMyHitBox( const Donya::Vector3 &veloc
 		// { -1.0f, 0.0f, +1.0f },
 	};
 
-	Donya::Vector3 movedPos = ( pos + hitBox.pos ) + velocity;
-
-	for ( const auto &sign : directions )
+	constexpr size_t directionCount = sizeof( directions ) / sizeof( directions[0] );
+	auto MakeVelocityDirection = [&]( const Donya::Vector3 &sign )
 	{
-		const Donya::Vector3 velocityDirection
+		return Donya::Vector3
 		{
 			horizontalSize.x * sign.x,
 			horizontalSize.y * sign.y,
 			horizontalSize.z * sign.z,
 		};
+	};
+
+	Donya::Vector3 movedPos = ( pos + hitBox.pos ) + velocity;
+
+	// The "movedPos" does not change until some direction collides, so the first rays of all directions can be tested at once.
+	// A direction that the first ray does not collide is never corrected.
+	std::array<Donya::Model::RaycastResult, directionCount> firstResults{};
+	if ( pTerrain && pTerrainMatrix )
+	{
+		std::array<Donya::Model::RaySegment, directionCount> firstRays{};
+		for ( size_t i = 0; i < directionCount; ++i )
+		{
+			firstRays[i].start	= movedPos;
+			firstRays[i].end	= movedPos + MakeVelocityDirection( directions[i] );
+		}
+
+		constexpr bool onlyWantIsIntersect = true;
+		pTerrain->RaycastBatch( *pTerrainMatrix, firstRays.data(), directionCount, firstResults.data(), onlyWantIsIntersect );
+	}
+
+	for ( size_t i = 0; i < directionCount; ++i )
+	{
+		const Donya::Vector3 velocityDirection = MakeVelocityDirection( directions[i] );
 
 	#if DEBUG_MODE
 		{
@@ -661,6 +730,9 @@ Donya::Vector3 Actor::CalcCorrectedVectorByMyHitBox( const Donya::Vector3 &veloc
 		}
 	#endif // DEBUG_MODE
 
+		if ( !firstResults[i].wasHit ) { continue; }
+		// else
+
 		constexpr int RECURSIVE_COUNT = 4;	// Prevent the corrected velocity to be zero that recursion method will return the zero if the recursion count arrived to limit.
 		auto sideResult = CalcCorrectedVector( movedPos, RECURSIVE_COUNT, velocityDirection, pTerrain, pTerrainMatrix );
 		if ( sideResult.raycastResult.wasHit )
@@ -713,3 +785,180 @@ void Actor::DrawHitBox( RenderingHelper *pRenderer, const Donya::Vector4x4 &VP,
 	const auto body = GetHitBox();
 	DrawCube( pRenderer, MakeWorldMatrix( body.pos, body.size, rotation ), VP, color );
 }
+
+#if USE_IMGUI
+void Actor::ShowResolverBenchmarkNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	class Mover : public Actor
+	{
+	public:
+		ResolveMode mode = ResolveMode::PushOut;
+	public:
+		Mover( const Donya::Vector3 &wsPos, const Donya::AABB &body )
+		{
+			pos		= wsPos;
+			hitBox	= body;
+		}
+	protected:
+		ResolveMode GetResolveMode() const override { return mode; }
+	};
+	struct Result
+	{
+		int				moveCount		= 0;
+		int				hitCount		= 0;
+		int				passedCount		= 0;	// The count of moves that went through the first wall of the straight movement.
+		unsigned int	maxLoopCount	= 0;
+		double			averageLoop		= 0.0;
+		double			seconds			= 0.0;
+	};
+	constexpr std::array<ResolveMode, 2> MODES{ ResolveMode::PushOut, ResolveMode::Sweep };
+	constexpr std::array<const char *, 2> MODE_NAMES{ "PushOut", "Sweep" };
+	static std::array<Result, MODES.size()> results{};
+	static int		moveCount		= 1000;
+	static int		wallCount		= 64;
+	static float	fieldRange		= 16.0f;	// Half size.
+	static float	wallThickness	= 0.1f;		// Half size.
+	static float	maxSpeed		= 4.0f;
+
+	ImGui::DragInt  ( "Move count",		&moveCount,		10.0f,	1, 100000	);
+	ImGui::DragInt  ( "Wall count",		&wallCount,		1.0f,	1, 10000	);
+	ImGui::DragFloat( "Field range",	&fieldRange,	0.1f,	1.0f		);
+	ImGui::DragFloat( "Wall thickness",	&wallThickness,	0.01f,	0.01f		);
+	ImGui::DragFloat( "Max speed",		&maxSpeed,		0.1f,	0.1f		);
+	moveCount		= std::max( 1,		moveCount		);
+	wallCount		= std::max( 1,		wallCount		);
+	fieldRange		= std::max( 1.0f,	fieldRange		);
+	wallThickness	= std::max( 0.01f,	wallThickness	);
+	maxSpeed		= std::max( 0.1f,	maxSpeed		);
+
+	if ( ImGui::Button( "Measure" ) )
+	{
+		auto RandomInField = [&]()
+		{
+			return Donya::Vector3
+			{
+				Donya::Random::GenerateFloat( -fieldRange, fieldRange ),
+				Donya::Random::GenerateFloat( -fieldRange, fieldRange ),
+				Donya::Random::GenerateFloat( -fieldRange, fieldRange )
+			};
+		};
+
+		// The walls are thin along the X or Z axis.
+		std::vector<Donya::AABB> walls( wallCount );
+		for ( auto &it : walls )
+		{
+			const bool thinX = ( Donya::Random::GenerateInt( 0, 2 ) == 0 );
+			it.pos		= RandomInField();
+			it.size.x	= ( thinX ) ? wallThickness : Donya::Random::GenerateFloat( 1.0f, 4.0f );
+			it.size.y	= Donya::Random::GenerateFloat( 1.0f, 4.0f );
+			it.size.z	= ( thinX ) ? Donya::Random::GenerateFloat( 1.0f, 4.0f ) : wallThickness;
+			it.exist	= true;
+		}
+
+		struct Move
+		{
+			Donya::Vector3 start;
+			Donya::Vector3 movement;
+		};
+		const Donya::AABB body{ Donya::Vector3::Zero(), Donya::Vector3{ 0.5f, 0.5f, 0.5f }, true };
+		auto IsBuried = [&]( const Donya::Vector3 &wsPos )
+		{
+			Donya::AABB tmp = body;
+			tmp.pos += wsPos;
+			for ( const auto &it : walls )
+			{
+				if ( Donya::AABB::IsHitAABB( tmp, it ) ) { return true; }
+			}
+			return false;
+		};
+		std::vector<Move> moves{};
+		moves.reserve( moveCount );
+		while ( scast<int>( moves.size() ) < moveCount )
+		{
+			Move tmp{};
+			tmp.start		= RandomInField();
+			tmp.movement	= Donya::Vector3
+			{
+				Donya::Random::GenerateFloat( -maxSpeed, maxSpeed ),
+				0.0f,
+				Donya::Random::GenerateFloat( -maxSpeed, maxSpeed )
+			};
+			if ( IsBuried( tmp.start ) ) { continue; }
+			// else
+			moves.emplace_back( tmp );
+		}
+
+		// The first wall of the straight movement is the reference of the pass-through.
+		auto HasPassedThrough = [&]( const Move &move, const Donya::Vector3 &corrected )
+		{
+			Donya::AABB start = body;
+			start.pos += move.start;
+
+			Donya::AABB::SweepResult nearest{};
+			for ( const auto &it : walls )
+			{
+				const auto sweep = Donya::AABB::CalcSweptHit( start, move.movement, it );
+				if ( sweep.wasHit && ( !nearest.wasHit || sweep.time < nearest.time ) )
+				{
+					nearest = sweep;
+				}
+			}
+			if ( !nearest.wasHit ) { return false; }
+			// else
+
+			constexpr float ALLOWANCE = 0.01f;
+			const Donya::Vector3 contact = start.pos + move.movement * nearest.time;
+			const Donya::Vector3 goal    = start.pos + corrected;
+			return ( Dot( goal - contact, nearest.normal ) < -ALLOWANCE );
+		};
+
+		Benchmark timer{};
+		std::vector<AABBResult> corrections( moves.size() );
+		for ( size_t m = 0; m < MODES.size(); ++m )
+		{
+			timer.Begin();
+			for ( size_t i = 0; i < moves.size(); ++i )
+			{
+				Mover mover{ moves[i].start, body };
+				mover.mode = MODES[m];
+				corrections[i] = mover.CalcCorrectedVector( moves[i].movement, walls );
+			}
+
+			Result &result		= results[m];
+			result.seconds		= timer.End();
+			result.moveCount	= scast<int>( moves.size() );
+			result.hitCount		= 0;
+			result.passedCount	= 0;
+			result.maxLoopCount	= 0;
+
+			unsigned long long loopSum = 0;
+			for ( size_t i = 0; i < moves.size(); ++i )
+			{
+				const AABBResult &correction = corrections[i];
+				if ( correction.wasHit ) { result.hitCount++; }
+				if ( HasPassedThrough( moves[i], correction.correctedVector ) ) { result.passedCount++; }
+				result.maxLoopCount = std::max( result.maxLoopCount, correction.loopCount );
+				loopSum += correction.loopCount;
+			}
+			result.averageLoop = scast<double>( loopSum ) / scast<double>( moves.size() );
+		}
+	}
+
+	for ( size_t m = 0; m < MODES.size(); ++m )
+	{
+		const Result &result = results[m];
+		if ( !result.moveCount ) { continue; }
+		// else
+
+		ImGui::Text( "%s : %d moves, %d hits", MODE_NAMES[m], result.moveCount, result.hitCount );
+		ImGui::Text( "  Iteration : average %.2f, max %u", result.averageLoop, result.maxLoopCount );
+		ImGui::Text( "  Passed through : %d", result.passedCount );
+		ImGui::Text( "  Time : %.3f[ms]", result.seconds * 1000.0 );
+	}
+
+	ImGui::TreePop();
+}
+#endif // USE_IMGUI
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "Donya/Collision.h"
 #include "Donya/ModelPolygon.h"
+#include "Donya/UseImGui.h"
 #include "Donya/Vector.h"
 
 #include "Renderer.h"
@@ -57,10 +59,19 @@ public:
 	};
 	virtual MoveResult Move( const Donya::Vector3 &wsMovement, const std::vector<Donya::Vector3> &wsRayOffsets, const std::vector<Donya::AABB> &solids = {}, const Donya::Model::PolygonGroup *pTerrain = nullptr, const Donya::Vector4x4 *pTerrainWorldMatrix = nullptr, bool onGround = true );
 public:
+	/// <summary>
+	/// The way of resolving the collision between my hit-box and the solids.
+	/// </summary>
+	enum class ResolveMode
+	{
+		PushOut,	// Pushes out the moved hit-box to the shallowest side, iteratively. The thin solids may be passed through by a fast movement.
+		Sweep,		// Stops the hit-box at the time of impact and slides along the hit face. This never passes through, and the iteration count is up to three.
+	};
 	struct AABBResult
 	{
 		Donya::Vector3 correctedVector;
 		bool wasHit = false;
+		unsigned int loopCount = 0; // The iteration count of the resolving, for profiling.
 	};
 	struct RecursionResult
 	{
@@ -72,6 +83,7 @@ public:
 	RecursionResult	CalcCorrectedVector( const Donya::Vector3 &wsRayStartPos, int recursionLimit, const Donya::Vector3 &targetVector, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainWorldMatrix ) const;
 private:
 	AABBResult		CalcCorrectedVectorImpl( const Donya::Vector3 &targetVector, const std::vector<Donya::AABB> &solids ) const;
+	AABBResult		CalcSweptVectorImpl( const Donya::Vector3 &targetVector, const std::vector<Donya::AABB> &solids ) const;
 	RecursionResult	CalcCorrectedVectorImpl( const Donya::Vector3 &wsRayStartPos, int recursionLimit, int recursionCount, RecursionResult prevResult, const Donya::Model::PolygonGroup &terrain, const Donya::Vector4x4 &terrainWorldMatrix ) const;
 private:
 	void MoveXZImpl( const Donya::Vector3 &xzMovement, const std::vector<Donya::Vector3> &wsRayOffsets, int recursionCount, const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainWorldMatrix = nullptr );
@@ -81,6 +93,11 @@ private:
 	/// Returns corrected velocity.
 	/// </summary>
 	Donya::Vector3 CalcCorrectedVectorByMyHitBox( const Donya::Vector3 &velocity, const std::vector<Donya::Vector3> &wsRayOriginOffsets, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainWorldMatrix );
+protected:
+	/// <summary>
+	/// The resolve mode of CalcCorrectedVector() of AABB version. The derived class can switch it by the state.
+	/// </summary>
+	virtual ResolveMode GetResolveMode() const { return ResolveMode::PushOut; }
 public:
 	virtual bool IsRiding( const Solid &onto ) const;
 	/// <summary>
@@ -93,4 +110,11 @@ public:
 	virtual Donya::Vector4x4 GetWorldMatrix() const;
 public:
 	virtual void DrawHitBox( RenderingHelper *pRenderer, const Donya::Vector4x4 &matVP, const Donya::Quaternion &rotation = Donya::Quaternion::Identity(), const Donya::Vector4 &color = { 1.0f, 1.0f, 1.0f, 1.0f } ) const;
+public:
+#if USE_IMGUI
+	/// <summary>
+	/// Compares the iteration counts and the pass-through counts of each resolve mode, by the random moves among thin walls.
+	/// </summary>
+	static void ShowResolverBenchmarkNode( const std::string &nodeCaption );
+#endif // USE_IMGUI
 };
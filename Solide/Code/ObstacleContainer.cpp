@@ -3,6 +3,8 @@
 #include <algorithm>	// For sort by depth.
 
 #if USE_IMGUI
+#include "Donya/Benchmark.h"
+#include "Donya/Random.h"
 #include "Donya/Useful.h" // Convert the character codes.
 #endif // USE_IMGUI
 
@@ -24,6 +26,8 @@ void ObstacleContainer::Init( int stageNumber )
 		// else
 		pIt->Init( pIt->GetPosition() );
 	}
+
+	RebuildSolidGrid();
 }
 void ObstacleContainer::Uninit()
 {
@@ -37,8 +41,16 @@ void ObstacleContainer::Uninit()
 
 void ObstacleContainer::Update( float elapsedTime, const Donya::Vector3 &wsTargetPos )
 {
-	for ( auto &pIt : pObstacles )
+	// The container may be edited without the grid(e.g. by ImGui).
+	if ( isSolidGridDirty || solidIDs.size() != pObstacles.size() )
+	{
+		RebuildSolidGrid();
+	}
+
+	const size_t count = pObstacles.size();
+	for ( size_t i = 0; i < count; ++i )
 	{
+		auto &pIt = pObstacles[i];
 		if ( !pIt ) { continue; }
 		// else
 
@@ -47,18 +59,35 @@ void ObstacleContainer::Update( float elapsedTime, const Donya::Vector3 &wsTarge
 		{
 			// This element will be removed at below process
 			pIt->Uninit();
+			continue;
 		}
+		// else
+
+		// The cells are re-assigned only when the hit-box moved over a cell border.
+		solidGrid.Update( solidIDs[i], pIt->GetHitBox() );
 	}
 
-	auto result = std::remove_if
-	(
-		pObstacles.begin(), pObstacles.end(),
-		[]( std::shared_ptr<ObstacleBase> &pElement )
+	// Remove with keeping the order, and the correspondence to the solidIDs.
+	size_t aliveCount = 0;
+	for ( size_t i = 0; i < count; ++i )
+	{
+		const bool shouldRemove = ( !pObstacles[i] ) ? true : pObstacles[i]->ShouldRemove();
+		if ( shouldRemove )
 		{
-			return ( !pElement ) ? true : pElement->ShouldRemove();
+			solidGrid.Remove( solidIDs[i] );
+			continue;
 		}
-	);
-	pObstacles.erase( result, pObstacles.end() );
+		// else
+
+		if ( aliveCount != i )
+		{
+			pObstacles[aliveCount]	= std::move( pObstacles[i] );
+			solidIDs[aliveCount]	= solidIDs[i];
+		}
+		aliveCount++;
+	}
+	pObstacles.resize( aliveCount );
+	solidIDs.resize( aliveCount );
 }
 
 void ObstacleContainer::Draw( RenderingHelper *pRenderer, const Donya::Vector4 &color )
@@ -91,6 +120,9 @@ void ObstacleContainer::SortByDepth()
 	};
 
 	std::sort( pObstacles.begin(), pObstacles.end(), IsGreaterDepth );
+
+	// The ids of the grid must be arranged in the order of pObstacles.
+	RebuildSolidGrid();
 }
 
 void ObstacleContainer::GenerateHardenedBlock( const Donya::Vector3 &wsGenPos )
@@ -108,12 +140,25 @@ void ObstacleContainer::GenerateHardenedBlock( const Donya::Vector3 &wsGenPos )
 		{
 			pObstacles.push_back( std::move( tmp ) );
 			pObstacles.back()->Init( wsGenPos );
+
+			const auto &pAdded = pObstacles.back();
+			solidIDs.emplace_back
+			(
+				( IsSolid( pAdded ) )
+				? solidGrid.Add( pAdded->GetHitBox() )
+				: Donya::AABBGrid::INVALID_ID
+			);
 		}
 
 		break;
 	}
 }
 
+void ObstacleContainer::MarkSolidGridDirty()
+{
+	isSolidGridDirty = true;
+}
+
 size_t	ObstacleContainer::GetObstacleCount() const
 {
 	return pObstacles.size();
@@ -145,6 +190,41 @@ std::vector<Donya::AABB> ObstacleContainer::GetHitBoxes() const
 
 	return hitBoxes;
 }
+std::vector<Donya::AABB> ObstacleContainer::GetHitBoxes( const Donya::AABB &wsRegion ) const
+{
+	// The grid is not synchronized with pObstacles, so fallback to the linear search.
+	if ( isSolidGridDirty || solidIDs.size() != pObstacles.size() ) { return GetHitBoxesBruteForce( wsRegion ); }
+	// else
+
+	// The ids are issued in the order of pObstacles, so the ascending order of ids is the same as GetHitBoxes().
+	const auto ids = solidGrid.QueryRegion( wsRegion );
+
+	std::vector<Donya::AABB> hitBoxes{};
+	hitBoxes.reserve( ids.size() );
+	for ( const auto &id : ids )
+	{
+		hitBoxes.emplace_back( solidGrid.GetBox( id ) );
+	}
+	return hitBoxes;
+}
+std::vector<Donya::AABB> ObstacleContainer::GetHitBoxesBruteForce( const Donya::AABB &wsRegion ) const
+{
+	std::vector<Donya::AABB> hitBoxes = GetHitBoxes();
+	auto result = std::remove_if
+	(
+		hitBoxes.begin(), hitBoxes.end(),
+		[&wsRegion]( const Donya::AABB &elem )
+		{
+			return !Donya::AABB::IsHitAABB( wsRegion, elem, /* ignoreExistFlag = */ true );
+		}
+	);
+	hitBoxes.erase( result, hitBoxes.end() );
+	return hitBoxes;
+}
+const Donya::AABBGrid &ObstacleContainer::GetSolidGrid() const
+{
+	return solidGrid;
+}
 std::vector<Donya::AABB> ObstacleContainer::GetWaterHitBoxes() const
 {
 	std::vector<Donya::AABB> hitBoxes{};
@@ -178,6 +258,31 @@ std::vector<Donya::AABB> ObstacleContainer::GetJumpStandHitBoxes() const
 	return hitBoxes;
 }
 
+bool ObstacleContainer::IsSolid( const std::shared_ptr<ObstacleBase> &pObstacle ) const
+{
+	if ( !pObstacle ) { return false; }
+	// else
+	return !ObstacleBase::IsWaterKind( pObstacle->GetKind() );
+}
+void ObstacleContainer::RebuildSolidGrid()
+{
+	solidGrid.Reset( solidGridCellSize );
+	solidIDs.clear();
+	solidIDs.reserve( pObstacles.size() );
+
+	for ( const auto &pIt : pObstacles )
+	{
+		solidIDs.emplace_back
+		(
+			( IsSolid( pIt ) )
+			? solidGrid.Add( pIt->GetHitBox() )
+			: Donya::AABBGrid::INVALID_ID
+		);
+	}
+
+	isSolidGridDirty = false;
+}
+
 void ObstacleContainer::LoadBin ( int stageNumber )
 {
 	constexpr bool fromBinary = true;
@@ -226,11 +331,13 @@ void ObstacleContainer::ShowImGuiNode( const std::string &nodeCaption )
 		if ( tmp )
 		{
 			data.push_back( std::move( tmp ) );
+			MarkSolidGridDirty();
 		}
 	}
 	if ( 1 <= data.size() && ImGui::Button( u8"폜" ) )
 	{
 		data.pop_back();
+		MarkSolidGridDirty();
 	}
 	
 	ImGui::Text( "" );
@@ -240,6 +347,21 @@ void ObstacleContainer::ShowImGuiNode( const std::string &nodeCaption )
 		SortByDepth();
 	}
 
+	if ( ImGui::TreeNode( u8"u[htF[Y" ) )
+	{
+		if ( ImGui::DragFloat( u8"Z̑傫", &solidGridCellSize, 0.1f, 0.1f ) )
+		{
+			solidGridCellSize = std::max( 0.1f, solidGridCellSize );
+			RebuildSolidGrid();
+		}
+		ImGui::Text( u8"o^F%d",		scast<int>( solidGrid.GetBoxCount()  ) );
+		ImGui::Text( u8"gpZF%d",	scast<int>( solidGrid.GetCellCount() ) );
+
+		ShowQueryValidationNode( u8"Ƃ̏ƍ" );
+
+		ImGui::TreePop();
+	}
+
 	if ( ImGui::TreeNode( u8"̂" ) )
 	{
 		const size_t count = data.size();
@@ -254,6 +376,9 @@ void ObstacleContainer::ShowImGuiNode( const std::string &nodeCaption )
 			data[i]->ShowImGuiNode( caption ) ;
 		}
 
+		// The nodes can move or change the obstacles, and do not tell it.
+		MarkSolidGridDirty();
+
 		ImGui::TreePop();
 	}
 
@@ -286,6 +411,7 @@ void ObstacleContainer::ShowImGuiNode( const std::string &nodeCaption )
 			pObstacles.clear();
 
 			( isBinary ) ? LoadBin( stageNo ) : LoadJson( stageNo );
+			RebuildSolidGrid();
 		}
 
 		ImGui::TreePop();
@@ -294,4 +420,105 @@ void ObstacleContainer::ShowImGuiNode( const std::string &nodeCaption )
 
 	ImGui::TreePop();
 }
+void ObstacleContainer::ShowQueryValidationNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	struct Result
+	{
+		int		queryCount		= 0;
+		int		hitCount		= 0;
+		int		mismatchCount	= 0;
+		double	secondsGrid		= 0.0;
+		double	secondsBrute	= 0.0;
+	};
+	static Result	result{};
+	static int		queryCount	= 1000;
+	static float	maxHalfSize	= 4.0f;
+	ImGui::DragInt  ( u8"₢킹",		&queryCount,	1.0f, 1, 100000	);
+	ImGui::DragFloat( u8"͈͂̑傫̍ő",	&maxHalfSize,	0.01f, 0.01f	);
+	queryCount	= std::max( 1,     queryCount	);
+	maxHalfSize	= std::max( 0.01f, maxHalfSize	);
+
+	if ( ImGui::Button( u8"ƍ" ) )
+	{
+		// Scatter the regions around the solids, like the swept regions of the actors.
+		const auto solids = GetHitBoxes();
+		Donya::Vector3 boxMin{ -1.0f, -1.0f, -1.0f };
+		Donya::Vector3 boxMax{ +1.0f, +1.0f, +1.0f };
+		if ( !solids.empty() )
+		{
+			boxMin = solids.front().pos - solids.front().size;
+			boxMax = solids.front().pos + solids.front().size;
+			for ( const auto &it : solids )
+			{
+				const Donya::Vector3 min = it.pos - it.size;
+				const Donya::Vector3 max = it.pos + it.size;
+				boxMin.x = std::min( boxMin.x, min.x ); boxMax.x = std::max( boxMax.x, max.x );
+				boxMin.y = std::min( boxMin.y, min.y ); boxMax.y = std::max( boxMax.y, max.y );
+				boxMin.z = std::min( boxMin.z, min.z ); boxMax.z = std::max( boxMax.z, max.z );
+			}
+		}
+
+		std::vector<Donya::AABB> regions( queryCount );
+		for ( auto &it : regions )
+		{
+			it.pos = Donya::Vector3
+			{
+				Donya::Random::GenerateFloat( boxMin.x, boxMax.x ),
+				Donya::Random::GenerateFloat( boxMin.y, boxMax.y ),
+				Donya::Random::GenerateFloat( boxMin.z, boxMax.z )
+			};
+			it.size = Donya::Vector3
+			{
+				Donya::Random::GenerateFloat( 0.01f, maxHalfSize ),
+				Donya::Random::GenerateFloat( 0.01f, maxHalfSize ),
+				Donya::Random::GenerateFloat( 0.01f, maxHalfSize )
+			};
+			it.exist = true;
+		}
+
+		std::vector<std::vector<Donya::AABB>> resultsGrid ( queryCount );
+		std::vector<std::vector<Donya::AABB>> resultsBrute( queryCount );
+
+		Benchmark timer{};
+		timer.Begin();
+		for ( int i = 0; i < queryCount; ++i )
+		{
+			resultsGrid[i] = GetHitBoxes( regions[i] );
+		}
+		result.secondsGrid = timer.End();
+
+		timer.Begin();
+		for ( int i = 0; i < queryCount; ++i )
+		{
+			resultsBrute[i] = GetHitBoxesBruteForce( regions[i] );
+		}
+		result.secondsBrute = timer.End();
+
+		result.queryCount		= queryCount;
+		result.hitCount			= 0;
+		result.mismatchCount	= 0;
+		for ( int i = 0; i < queryCount; ++i )
+		{
+			result.hitCount += scast<int>( resultsBrute[i].size() );
+			if ( resultsGrid[i] != resultsBrute[i] ) { result.mismatchCount++; }
+		}
+	}
+
+	if ( result.queryCount )
+	{
+		ImGui::Text( u8"񐔁F%dC␔̍vF%d", result.queryCount, result.hitCount );
+		ImGui::Text( u8"ObhF%.3f[ms]", result.secondsGrid  * 1000.0 );
+		ImGui::Text( u8"F%.3f[ms]", result.secondsBrute * 1000.0 );
+		if ( 0.0 < result.secondsGrid )
+		{
+			ImGui::Text( u8"xF%.2f{", result.secondsBrute / result.secondsGrid );
+		}
+		ImGui::Text( u8"ʂ̕svF%d", result.mismatchCount );
+	}
+
+	ImGui::TreePop();
+}
 #endif // USE_IMGUI
@@ -9,6 +9,7 @@
 #include <cereal/types/memory.hpp>
 #include <cereal/types/vector.hpp>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Collision.h"
 #include "Donya/Serializer.h"
 #include "Donya/Vector.h"
@@ -21,6 +22,12 @@ class ObstacleContainer
 private:
 	int stageNo = 0;
 	std::vector<std::shared_ptr<ObstacleBase>> pObstacles;
+
+	// The broadphase of the solid hit-boxes. These are not serialized, rebuilt from pObstacles.
+	Donya::AABBGrid						solidGrid;
+	std::vector<Donya::AABBGrid::ID>	solidIDs;	// Parallel to pObstacles. Stores INVALID_ID if that is not solid(e.g. water).
+	float								solidGridCellSize = 4.0f;
+	bool								isSolidGridDirty = false;	// An obstacle was edited without the grid. The grid is rebuilt at the next Update().
 private:
 	friend class cereal::access;
 	template<class Archive>
@@ -48,13 +55,30 @@ public:
 public:
 	void SortByDepth();
 	void GenerateHardenedBlock( const Donya::Vector3 &wsGeneratePos );
+	/// <summary>
+	/// Requests the rebuilding of the grid at the next Update(). Please call this when an obstacle was edited directly(e.g. by ImGui).<para></para>
+	/// GetHitBoxes( wsRegion ) checks all solids until the rebuilding.
+	/// </summary>
+	void MarkSolidGridDirty();
 public:
 	size_t	GetObstacleCount() const;
 	bool	IsOutOfRange( size_t index ) const;
 	std::shared_ptr<ObstacleBase>	GetObstaclePtrOrNullptr( size_t index ) const;
 	std::vector<Donya::AABB>		GetHitBoxes() const;
+	/// <summary>
+	/// Returns the solid hit-boxes that overlap with the region. The order is the same as GetHitBoxes().
+	/// </summary>
+	std::vector<Donya::AABB>		GetHitBoxes( const Donya::AABB &wsRegion ) const;
+	/// <summary>
+	/// Returns the same result as GetHitBoxes( wsRegion ) by checking all solids, without the grid.
+	/// </summary>
+	std::vector<Donya::AABB>		GetHitBoxesBruteForce( const Donya::AABB &wsRegion ) const;
+	const Donya::AABBGrid			&GetSolidGrid() const;
 	std::vector<Donya::AABB>		GetWaterHitBoxes() const;
 	std::vector<Donya::AABB>		GetJumpStandHitBoxes() const;
+private:
+	bool IsSolid( const std::shared_ptr<ObstacleBase> &pObstacle ) const;
+	void RebuildSolidGrid();
 private:
 	void LoadBin ( int stageNo );
 	void LoadJson( int stageNo );
@@ -63,6 +87,8 @@ private:
 	void SaveJson( int stageNo );
 public:
 	void ShowImGuiNode( const std::string &nodeCaption );
+private:
+	void ShowQueryValidationNode( const std::string &nodeCaption );
 #endif // USE_IMGUI
 };
 CEREAL_CLASS_VERSION( ObstacleContainer, 0 )
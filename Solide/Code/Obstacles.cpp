@@ -56,20 +56,10 @@ namespace
 	};
 	static std::array<std::shared_ptr<ModelData>, KIND_COUNT> models{};
 
-	bool LoadModels()
+	bool LoadModels( Donya::JobSystem *pJobSystem, const std::function<void( float fraction )> &reportProgress )
 	{
-		bool result		= true;
-		bool succeeded	= true;
-
-		Donya::Loader loader{};
-		auto Load = [&loader]( const std::string &filePath, ModelData *pDest )->bool
+		auto Create = []( const Donya::Loader &loader, ModelData *pDest )->bool
 		{
-			loader.ClearData();
-
-			bool result = loader.Load( filePath );
-			if ( !result ) { return false; }
-			// else
-
 			const auto &source = loader.GetModelSource();
 			pDest->model = Donya::Model::StaticModel::Create( source, loader.GetFileDirectory() );
 			pDest->pose.AssignSkeletal( source.skeletal );
@@ -77,11 +67,12 @@ namespace
 			return pDest->model.WasInitializeSucceeded();
 		};
 
-		std::string filePath{};
+		std::vector<std::string>	filePaths{};
+		std::vector<size_t>			kinds{};
 		const std::string prefix = MODEL_DIRECTORY;
 		for ( size_t i = 0; i < KIND_COUNT; ++i )
 		{
-			filePath = prefix + MODEL_NAMES[i] + EXTENSION;
+			const std::string filePath = prefix + MODEL_NAMES[i] + EXTENSION;
 			if ( !Donya::IsExistFile( filePath ) )
 			{
 				const std::string outputMsgBase{ "Error : The model file does not exist. That is : " };
@@ -90,19 +81,17 @@ namespace
 			}
 			// else
 
-			models[i] = std::make_shared<ModelData>();
-			result = Load( filePath, &( *models[i] ) ); // std::shared_ptr<T> -> T -> T *
-			if ( !result )
-			{
-				const std::wstring errMsgBase{ L"Failed : Loading a model. That is : " };
-				const std::wstring errMsg = errMsgBase + Donya::MultiToWide( filePath );
-				_ASSERT_EXPR( 0, errMsg.c_str() );
-
-				succeeded = false;
-			}
+			filePaths.emplace_back( filePath );
+			kinds.emplace_back( i );
 		}
 
-		return succeeded;
+		auto CreateModel = [&]( size_t index, const Donya::Loader &loader )->bool
+		{
+			auto &pModel = models[kinds[index]];
+			pModel = std::make_shared<ModelData>();
+			return Create( loader, &( *pModel ) ); // std::shared_ptr<T> -> T -> T *
+		};
+		return Donya::Loader::LoadManyThenCreate( filePaths, CreateModel, pJobSystem, reportProgress );
 	}
 
 	bool IsOutOfRange( Kind kind )
@@ -258,12 +247,10 @@ namespace
 }
 CEREAL_CLASS_VERSION( Member, 5 )
 
-class ParamObstacle : public ParameterBase<ParamObstacle>
+class ParamObstacle : public ParameterBase<ParamObstacle, Member>
 {
 public:
 	static constexpr const char *ID = "Obstacle";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -277,7 +264,6 @@ public:
 
 		ResizeVectorIfNeeded();
 	}
-	Member Data() const { return m; }
 private:
 	void ResizeVectorIfNeeded()
 	{
@@ -387,9 +373,9 @@ public:
 #endif // USE_IMGUI
 };
 
-bool ObstacleBase::LoadModels()
+bool ObstacleBase::LoadModels( Donya::JobSystem *pJobSystem, const std::function<void( float fraction )> &reportProgress )
 {
-	return ::LoadModels();
+	return ::LoadModels( pJobSystem, reportProgress );
 }
 void ObstacleBase::ParameterInit()
 {
@@ -964,7 +950,7 @@ void Hardened::Init( const Donya::Vector3 &wsInitialPos )
 }
 void Hardened::Update( float elapsedTime, const Donya::Vector3 &wsTargetPos )
 {
-	const auto data = ParamObstacle::Get().Data();
+	const auto &data = ParamObstacle::Get().Data();
 
 	hitBox = GetModelHitBox( Kind::Hardened, data );
 
@@ -1022,7 +1008,7 @@ float JumpStand::GetJumpPower()
 }
 void JumpStand::Update( float elapsedTime, const Donya::Vector3 &wsTargetPos )
 {
-	const auto data = ParamObstacle::Get().Data();
+	const auto &data = ParamObstacle::Get().Data();
 	hitBox = GetModelHitBox( Kind::JumpStand, data );
 }
 void JumpStand::Draw( RenderingHelper *pRenderer, const Donya::Vector4 &color )
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,10 @@
 
 class EffectHandle;
 class RenderingHelper;
+namespace Donya
+{
+	class JobSystem;
+}
 
 class ObstacleBase : protected Solid
 {
@@ -26,7 +31,11 @@ protected:
 	bool wantRemoveByGui = false;
 #endif // USE_IMGUI
 public:
-	static bool LoadModels();
+	/// <summary>
+	/// The files of models are loaded in parallel on the "pJobSystem" if it is not nullptr.<para></para>
+	/// The "reportProgress" receives the fraction of the loaded models. It can be nullptr.
+	/// </summary>
+	static bool LoadModels( Donya::JobSystem *pJobSystem = nullptr, const std::function<void( float fraction )> &reportProgress = nullptr );
 	static void ParameterInit();
 	static void ParameterUninit();
 public:
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -8,12 +9,19 @@
 #include "Donya/Template.h"
 #include "Donya/UseImGui.h"
 
-template<typename DerivedClass>
+/// <summary>
+/// The parameters are held as the "MemberType", and are exposed only by the const reference of Data(). Please bind it by "const auto &", because the "MemberType" may have the containers and copying it allocates.
+/// </summary>
+template<typename DerivedClass, typename MemberType>
 class ParameterBase : public Donya::Singleton<DerivedClass>
 {
+protected:
+	MemberType m;
 public:
 	virtual void Init()     = 0;
 	virtual void Uninit() {}
+public:
+	const MemberType &Data() const { return m; }
 protected:
 	virtual std::string GetSerializeIdentifier() = 0;
 	virtual std::string GetSerializePath( bool isBinary ) = 0;
@@ -73,6 +81,34 @@ public:
 #endif // USE_IMGUI
 };
 
+#if DEBUG_MODE
+namespace ParameterHelper
+{
+	/// <summary>
+	/// Counts the copies of the Member that has this as a member. The count is shared by all Members.<para></para>
+	/// The Member is exposed by the const reference of ParameterBase::Data(), so the count should not increase at the updates.
+	/// </summary>
+	class CopyCounter
+	{
+	public:
+		static size_t GetCount()	{ return Count().load( std::memory_order_relaxed ); }
+		static void   ResetCount()	{ Count().store( 0, std::memory_order_relaxed ); }
+	private:
+		static std::atomic<size_t> &Count()
+		{
+			static std::atomic<size_t> count{ 0 };
+			return count;
+		}
+	public:
+		CopyCounter() = default;
+		CopyCounter( const CopyCounter & )					{ Count()++; }
+		CopyCounter( CopyCounter && )						= default;
+		CopyCounter &operator = ( const CopyCounter & )	{ Count()++; return *this; }
+		CopyCounter &operator = ( CopyCounter && )			= default;
+	};
+}
+#endif // DEBUG_MODE
+
 #if USE_IMGUI
 #include <functional>
 #include <vector>
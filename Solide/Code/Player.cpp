@@ -250,6 +250,9 @@ namespace
 		Donya::Vector4 drawDeadColor{ 1.0f, 1.0f, 1.0f, 1.0f };
 
 		std::string iceMaterialName;
+	#if DEBUG_MODE
+		ParameterHelper::CopyCounter copyCounter;
+	#endif // DEBUG_MODE
 	private:
 		friend class cereal::access;
 		template<class Archive>
@@ -319,12 +322,10 @@ CEREAL_CLASS_VERSION( Member,				11 )
 CEREAL_CLASS_VERSION( Member::BasicMember,	4 )
 CEREAL_CLASS_VERSION( Member::OilMember,	2 )
 
-class ParamPlayer : public ParameterBase<ParamPlayer>
+class ParamPlayer : public ParameterBase<ParamPlayer, Member>
 {
 public:
 	static constexpr const char *ID = "Player";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -338,7 +339,6 @@ public:
 
 		ResizeMotionVector();
 	}
-	Member Data() const { return m; }
 private:
 	void ResizeMotionVector()
 	{
@@ -481,7 +481,7 @@ public:
 				{
 					for ( size_t i = 0; i < motionCount; ++i )
 					{
-						ImGui::Text( u8"[%d]:%s", i, motionHolder.GetMotion( i ).name.c_str() );
+						ImGui::Text( u8"[%d]:%s", i, motionHolder.GetMotion( i ).GetName().c_str() );
 					}
 					ImGui::TreePop();
 				}
@@ -494,7 +494,7 @@ public:
 					for ( size_t i = 0; i < motionCount; ++i )
 					{
 						arrayIndex		= "[" + std::to_string( i ) + "]";
-						nowLinkMotion	= motionHolder.GetMotion( m.useMotionIndices[i] ).name;
+						nowLinkMotion	= motionHolder.GetMotion( m.useMotionIndices[i] ).GetName();
 						caption			= arrayIndex + u8":" + nowLinkMotion;
 						ImGui::SliderInt( caption.c_str(), &m.useMotionIndices[i], 0, motionCount - 1 );
 					}
@@ -634,7 +634,7 @@ bool Player::LoadModels()
 // Internal utility.
 namespace
 {
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamPlayer::Get().Data();
 	}
@@ -673,13 +673,17 @@ void Player::MotionManager::Update( Player &player, float elapsedTime )
 	? animator.EnableLoop()
 	: animator.DisableLoop();
 
-	const auto	data			= FetchMember();
+	const auto	&data			= FetchMember();
 	const int	nowMotion		= data.useMotionIndices[currKind];
 	const float	acceleration	= data.motionAccelerations[nowMotion];
 
 	animator.Update( elapsedTime * acceleration );
 	AssignPose( nowMotion );
 }
+void Player::MotionManager::SetDeferredBatch( Donya::Model::AnimationBatch *pBatch )
+{
+	pDeferredBatch = pBatch;
+}
 const Donya::Model::Pose &Player::MotionManager::GetPose() const
 {
 	return pose;
@@ -712,7 +716,15 @@ void Player::MotionManager::AssignPose( int motionIndex )
 
 	const auto &currentMotion = motionHolder.GetMotion( motionIndex );
 	animator.SetRepeatRange( currentMotion );
-	pose.AssignSkeletal( animator.CalcCurrentPose( currentMotion ) );
+
+	if ( pDeferredBatch )
+	{
+		pDeferredBatch->Append( animator, currentMotion, &pose );
+		return;
+	}
+	// else
+
+	animator.CalcCurrentPose( currentMotion, &pose );
 }
 int  Player::MotionManager::CalcNowKind( Player &player ) const
 {
@@ -823,7 +835,7 @@ bool Player::InputManager::ShouldTrans() const
 	if ( !IsPressOil() || keepingPressAfterTrans ) { return false; }
 	// else
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	return ( data.transTriggerFrame <= oilTimer );
 }
 bool Player::InputManager::IsTriggerOil() const
@@ -843,14 +855,14 @@ void Player::NormalMover::Init( Player &player )
 {
 	player.element.Subtract( Element::Type::Oil );
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	player.hitBox = data.normal.hitBoxStage;
 }
 void Player::NormalMover::Uninit( Player &player ) {}
 void Player::NormalMover::Update( Player &player, float elapsedTime ) {}
 void Player::NormalMover::Move( Player &player, float elapsedTime, Input input )
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	Donya::Vector2 velocityXZ = ToXZVector( player.velocity );
 
@@ -886,12 +898,12 @@ void Player::NormalMover::Move( Player &player, float elapsedTime, Input input )
 }
 void Player::NormalMover::Jump( Player &player, float elapsedTime )
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	player.velocity.y = data.normal.jumpStrength * elapsedTime;
 }
 void Player::NormalMover::Fall( Player &player, float elapsedTime )
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	player.velocity.y -= data.normal.gravity * elapsedTime;
 }
 
@@ -902,7 +914,7 @@ void Player::OilMover::Init( Player &player )
 	player.StartHopping();
 	player.element.Add( Element::Type::Oil );
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	player.hitBox = data.oiled.basic.hitBoxStage;
 
 	const Donya::Vector3 initVelocity = player.orientation.LocalFront() * data.oiled.basic.maxSpeed;
@@ -944,7 +956,7 @@ void Player::OilMover::Move( Player &player, float elapsedTime, Input input )
 {
 	input.moveVectorXZ.Normalize();
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	float betweenCross{};
 	float betweenRadian{};
@@ -1047,12 +1059,12 @@ void Player::OilMover::Move( Player &player, float elapsedTime, Input input )
 }
 void Player::OilMover::Jump( Player &player, float elapsedTime )
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	player.velocity.y = data.oiled.basic.jumpStrength * elapsedTime;
 }
 void Player::OilMover::Fall( Player &player, float elapsedTime )
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	player.velocity.y -= data.oiled.basic.gravity * elapsedTime;
 }
 Donya::Quaternion Player::OilMover::GetExtraRotation( Player &player ) const
@@ -1075,7 +1087,7 @@ void Player::DeadMover::Fall( Player &player, float elapsedTime ) {}
 void Player::Init( const PlayerInitializer &param )
 {
 	ParamPlayer::Get().Init();
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	burnTimer	= 0;
 	pos			= param.GetInitialPos();
@@ -1164,7 +1176,7 @@ void Player::PhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::
 	// For judge that to: "was landing?".
 	const Donya::Vector3 oldPos = pos;
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	std::vector<Donya::Vector3> rotatedOffsets = data.raypickOffsets;
 	for ( auto &it : rotatedOffsets )
 	{
@@ -1205,7 +1217,7 @@ void Player::PhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::
 		KillMe();
 	}
 
-	if ( onGround && result.lastResult.nearestPolygon.materialName == data.iceMaterialName )
+	if ( onGround && pTerrain && pTerrain->GetMaterialName( result.lastResult.polygonIndex ) == data.iceMaterialName )
 	{
 		onIce = true;
 	}
@@ -1220,7 +1232,7 @@ void Player::Draw( RenderingHelper *pRenderer )
 	if ( !pRenderer ) { return; }
 	// else
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	const Donya::Quaternion pitchRotation		= Donya::Quaternion::Make( orientation.LocalRight(), hopPitching );
 	const Donya::Quaternion actualOrientation	= // Rotation: First:My Orientatoin, Then:Pitching, Last:Extra(actually that is tilting)
 		orientation.Rotated
@@ -1270,6 +1282,10 @@ void Player::DrawHitBox( RenderingHelper *pRenderer, const Donya::Vector4x4 &mat
 #endif // DEBUG_MODE
 }
 
+void Player::SetDeferredAnimationBatch( Donya::Model::AnimationBatch *pBatch )
+{
+	motionManager.SetDeferredBatch( pBatch );
+}
 void Player::MakeDamage( const Element &effect )
 {
 	if ( effect.Has( Element::Type::Ice ) )
@@ -1298,10 +1314,11 @@ void Player::KillMe()
 	canUseOil = false;
 }
 
-std::vector<Element::Type> Player::GetUncollidableTypes() const
+Element::Mask Player::GetUncollidableMask() const
 {
 	// Only once type.
-	return std::vector<Element::Type>{ Element::Type::Oil };
+	constexpr Element::Mask mask = Element::MakeMask( Element::Type::Oil );
+	return mask;
 }
 
 void Player::LookToInput( float elapsedTime, Input input )
@@ -1331,7 +1348,7 @@ void Player::Fall( float elapsedTime )
 }
 bool Player::IsUnderFalloutBorder() const
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	return ( pos.y < data.falloutBorderPosY ) ? true : false;
 }
 
@@ -1368,7 +1385,7 @@ void Player::AssignLanding()
 
 void Player::Shot( float elapsedTime )
 {
-	const auto data	= FetchMember();
+	const auto &data	= FetchMember();
 	auto useParam	= ( IsOiled() )
 					? data.oiled.basic.shotDesc
 					: data.normal.shotDesc;
@@ -1395,7 +1412,7 @@ void Player::Shot( float elapsedTime )
 
 bool Player::WillDie() const
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	if ( element.Has( Element::Type::Flame ) )
 	{
@@ -1411,7 +1428,7 @@ bool Player::WillDie() const
 
 Donya::Vector4 Player::CalcDrawColor() const
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	if ( pMover->IsDead() ) { return data.drawDeadColor; }
 	// else
 
@@ -1423,7 +1440,7 @@ Donya::Vector4 Player::CalcDrawColor() const
 
 void Player::StartHopping()
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	hopPitching = ToRadian( -data.oiled.hopRotation );
 	velocity.y = data.oiled.hopStrength;
@@ -1433,7 +1450,7 @@ void Player::UpdateHopping( float elapsedTime )
 	if ( 0.0f <= hopPitching ) { return; }
 	// else
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	hopPitching += ToRadian( data.oiled.hopRotationDegree ) * elapsedTime;
 	hopPitching = std::min( 0.0f, hopPitching );
 }
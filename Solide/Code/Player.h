@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 
+#include "Donya/ModelAnimationBatch.h"
 #include "Donya/ModelMotion.h"
 #include "Donya/ModelPolygon.h"
 #include "Donya/ModelPose.h"
@@ -76,12 +77,14 @@ private:
 	private:
 		int prevKind = 0;
 		int currKind = 0;
-		Donya::Model::Animator	animator;
-		Donya::Model::Pose		pose;
+		Donya::Model::Animator			animator;
+		Donya::Model::Pose				pose;
+		Donya::Model::AnimationBatch	*pDeferredBatch = nullptr;	// The pose is evaluated by this if it is not nullptr.
 	public:
 		void Init();
 		void Update( Player &player, float elapsedTime );
 	public:
+		void SetDeferredBatch( Donya::Model::AnimationBatch *pBatch );
 		const Donya::Model::Pose &GetPose() const;
 	private:
 		bool ShouldEnableLoop( int kind ) const;
@@ -193,11 +196,18 @@ public:
 	void Draw( RenderingHelper *pRenderer );
 	void DrawHitBox( RenderingHelper *pRenderer, const Donya::Vector4x4 &matVP );
 public:
+	/// <summary>
+	/// The pose is appended to the "pBatch" at the update instead of evaluating at there. Pass nullptr to evaluate at the update.
+	/// </summary>
+	void SetDeferredAnimationBatch( Donya::Model::AnimationBatch *pBatch );
 	void MakeDamage( const Element &effect );
 	void JumpByStand();
 	void KillMe();
 public:
-	std::vector<Element::Type> GetUncollidableTypes() const;
+	/// <summary>
+	/// The bullets that have the element in this mask do not collide to me.
+	/// </summary>
+	Element::Mask GetUncollidableMask() const;
 	bool IsDead()		const
 	{
 		return pMover->IsDead();
@@ -214,6 +214,20 @@ bool RenderingHelper::Init()
 	if ( succeeded ) { wasCreated = true; }
 	return succeeded;
 }
+void RenderingHelper::BeginFrame()
+{
+	if ( !wasCreated ) { return; }
+	// else
+	pRenderer->pSkinning->BeginFrame();
+}
+#if USE_IMGUI
+void RenderingHelper::ShowImGuiNode( const std::string &nodeCaption )
+{
+	if ( !wasCreated ) { return; }
+	// else
+	pRenderer->pSkinning->ShowImGuiNode( nodeCaption );
+}
+#endif // USE_IMGUI
 
 void RenderingHelper::UpdateConstant( const TransConstant &constant )
 {
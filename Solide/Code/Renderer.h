@@ -11,6 +11,7 @@
 #include "Donya/ModelPose.h"
 #include "Donya/ModelPrimitive.h"
 #include "Donya/ModelRenderer.h"
+#include "Donya/UseImGui.h"
 
 class RenderingHelper
 {
@@ -92,6 +93,13 @@ private:
 	bool wasCreated = false;
 public:
 	bool Init();
+	/// <summary>
+	/// Please call this once per frame, before drawing. This drops the caches of previous frame.
+	/// </summary>
+	void BeginFrame();
+#if USE_IMGUI
+	void ShowImGuiNode( const std::string &nodeCaption );
+#endif // USE_IMGUI
 public:
 	void UpdateConstant( const TransConstant &constant );
 	void UpdateConstant( const AdjustColorConstant &constant );
@@ -1,13 +1,19 @@
 #include "SceneGame.h"
 
+#include <algorithm>
+#include <array>
+#include <string>
 #include <vector>
 
 #undef max
 #undef min
 #include <cereal/types/vector.hpp>
 
+#include "Donya/AllocationTracker.h"
+#include "Donya/Benchmark.h"
 #include "Donya/Blend.h"
 #include "Donya/Camera.h"
+#include "Donya/CollisionBatch.h"
 #include "Donya/Constant.h"
 #include "Donya/Donya.h"		// Use GetFPS().
 #include "Donya/Keyboard.h"
@@ -31,6 +37,7 @@
 #include "Obstacles.h"
 #include "Parameter.h"
 #include "SaveData.h"
+#include "StageAssetCache.h"
 #include "StageNumberDefine.h"
 
 namespace
@@ -197,12 +204,10 @@ namespace
 }
 CEREAL_CLASS_VERSION( Member, 9 )
 
-class ParamGame : public ParameterBase<ParamGame>
+class ParamGame : public ParameterBase<ParamGame, Member>
 {
 public:
 	static constexpr const char *ID = "Game";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -214,7 +219,6 @@ public:
 
 		Load( m, fromBinary );
 	}
-	Member Data() const { return m; }
 private:
 	std::string GetSerializeIdentifier()			override { return ID; }
 	std::string GetSerializePath( bool isBinary )	override { return GenerateSerializePath( ID, isBinary ); }
@@ -315,10 +319,41 @@ namespace
 		return ( nextStageNo < 0 ) ? true : false;
 	}
 
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamGame::Get().Data();
 	}
+
+#if USE_ALLOCATION_TRACKER
+	struct AllocationCeiling
+	{
+		const char	*tagName;
+		size_t		maxCountPerFrame;
+	};
+	/// <summary>
+	/// The maximum allocation counts per frame of the phases of SceneGame.<para></para>
+	/// These are the ceilings for detecting a regression, not the goals. The physics queries the solids per actor, bullet and shadow-ray, so that has the largest one.<para></para>
+	/// The budgets of the phases of UpdateWorld() are replaced by the counts that are measured by the self-check in debug mode.
+	/// </summary>
+	constexpr AllocationCeiling ALLOCATION_CEILINGS[]
+	{
+		{ "SceneGame::Update::Actors",		64U		},
+		{ "SceneGame::Update::Animation",	16U		},
+		{ "SceneGame::Update::Physics",		512U	},
+		{ "SceneGame::Update::Collision",	64U		},
+		{ "SceneGame::Update::Others",		32U		},
+		{ "SceneGame::Draw",				128U	},
+	};
+	constexpr size_t WORLD_PHASE_COUNT = 4U; // The first elements of ALLOCATION_CEILINGS are the phases of UpdateWorld().
+
+	void RegisterAllocationBudgets()
+	{
+		for ( const auto &it : ALLOCATION_CEILINGS )
+		{
+			Donya::AllocationTracker::SetBudget( it.tagName, it.maxCountPerFrame );
+		}
+	}
+#endif // USE_ALLOCATION_TRACKER
 }
 
 void SceneGame::Init()
@@ -364,6 +399,12 @@ void SceneGame::Init()
 	result = sprRemains.LoadSprite( GetSpritePath( SpriteAttribute::PlayerRemains ), 4U );
 	assert( result );
 
+	pJobSystem = std::make_unique<Donya::JobSystem>( Donya::JobSystem::CalcDefaultWorkerCount() );
+
+#if USE_ALLOCATION_TRACKER
+	RegisterAllocationBudgets();
+#endif // USE_ALLOCATION_TRACKER
+
 	const SaveData nowData = SaveDataAdmin::Get().GetNowData();
 #if 0 // ENABLE_RESTART_FROM_LAST_STATUS
 	stageNumber = ( nowData.isEmpty ) ? SELECT_STAGE_NO : nowData.currentStageNumber;
@@ -378,6 +419,10 @@ void SceneGame::Init()
 
 	// I must call this after initialize the warp objects.
 	ExploreBossContainStageNumbers();
+
+#if DEBUG_MODE
+	RunAllocationSelfCheck();
+#endif // DEBUG_MODE
 }
 void SceneGame::Uninit()
 {
@@ -387,6 +432,10 @@ void SceneGame::Uninit()
 	pShadow.reset();
 	pInfoDrawer.reset();
 	pTerrainDrawState.reset();
+	pJobSystem.reset();
+
+	// Releases the cached models and waits for the prefetches here, because the destruction of the singleton is after the release of the device.
+	StageAssetCache::Get().Clear();
 
 	ObstacleBase::ParameterUninit();
 	ParamGame::Get().Uninit();
@@ -456,8 +505,14 @@ Scene::Result SceneGame::Update( float elapsedTime )
 		}
 		else
 		{
+			// Measures the time-to-playable of the transition.
+			Benchmark transitionTimer{};
+			transitionTimer.Begin();
+
 			UninitStage();
 			InitStage( stageNumber, /* useSaveDataIfValid = */ false );
+
+			StageAssetCache::Get().RecordTransition( stageNumber, transitionTimer.End() );
 	
 			WriteSaveData( stageNumber );
 			SaveDataAdmin::Get().Save();
@@ -492,6 +547,47 @@ Scene::Result SceneGame::Update( float elapsedTime )
 
 	pTerrain->BuildWorldMatrix();
 
+	UpdateWorld( elapsedTime );
+
+	Donya::AllocationTracker::Scope allocationScope{ "SceneGame::Update::Others" };
+
+	if ( NowGoalMoment() )
+	{
+		SaveData::ClearData clearData{};
+		clearData.clearRank = Rank::Calculate( currentTime, borderTimes );
+		clearData.clearTime = currentTime;
+		SaveDataAdmin::Get().RegisterIfFastOrNew( stageNumber, clearData );
+
+		if ( pGoal )
+		{
+			const std::vector<int> unlockStageNumbers = pGoal->GetUnlockStageNumbers();
+			for ( const auto &it : unlockStageNumbers )
+			{
+				SaveDataAdmin::Get().UnlockStage( it );
+			}
+
+			SaveDataAdmin::Get().Save();
+		}
+
+		ClearInit();
+		Donya::Sound::Play( Music::UI_Goal );
+	}
+
+	ClearUpdate( elapsedTime );
+	TutorialUpdate( elapsedTime );
+
+	CameraUpdate();
+	EffectAdmin::Get().SetViewMatrix( iCamera.CalcViewMatrix() );
+	EffectAdmin::Get().SetProjectionMatrix( iCamera.GetProjectionMatrix() );
+
+	return ReturnResult();
+}
+
+void SceneGame::UpdateWorld( float elapsedTime )
+{
+	// Tags the allocations by the phases of update. The allocations before here are counted by the caller's tag.
+	Donya::AllocationTracker::Scope allocationScope{ "SceneGame::Update::Actors" };
+
 	EnemyUpdate( elapsedTime );
 
 	// Update obstacles.
@@ -511,69 +607,54 @@ Scene::Result SceneGame::Update( float elapsedTime )
 
 	PlayerVSJumpStand();
 
+	// Evaluate the poses that are appended at the updates in parallel. The poses are not used until the drawing.
+	allocationScope.Change( "SceneGame::Update::Animation" );
+	animationBatch.Evaluate( pJobSystem.get() );
+
 	// Physic updates.
+	allocationScope.Change( "SceneGame::Update::Physics" );
 	{
-		const auto solids  = pObstacles->GetHitBoxes();
+		// Each actor, bullet and shadow-ray queries the solids around itself, instead of the list of all solids.
+		const Donya::AABBQuery querySolids = [&]( const Donya::AABB &wsRegion )
+		{
+			return ( pObstacles ) ? pObstacles->GetHitBoxes( wsRegion ) : std::vector<Donya::AABB>{};
+		};
 		const auto terrain = pTerrain->GetCollisionModel();
-		const Donya::Vector4x4 &terrainMatrix = pTerrain->GetWorldMatrix();
+		const Donya::Vector4x4 &terrainMatrix = pTerrain->GetCollisionMatrix();
 
-		PlayerPhysicUpdate( solids, terrain.get(), &terrainMatrix );
-		Bullet::BulletAdmin::Get().PhysicUpdate( solids, terrain.get(), &terrainMatrix );
-		EnemyPhysicUpdate( solids, terrain.get(), &terrainMatrix );
-		BossPhysicUpdate( solids, terrain.get(), &terrainMatrix );
+		PlayerPhysicUpdate( querySolids, terrain.get(), &terrainMatrix );
+		Bullet::BulletAdmin::Get().PhysicUpdate( querySolids, terrain.get(), &terrainMatrix );
+		EnemyPhysicUpdate( querySolids, terrain.get(), &terrainMatrix );
+		BossPhysicUpdate( querySolids, terrain.get(), &terrainMatrix );
 
-		MakeShadows( solids, terrain.get(), &terrainMatrix );
+		MakeShadows( querySolids, terrain.get(), &terrainMatrix );
 	}
 
+	allocationScope.Change( "SceneGame::Update::Collision" );
+
 	PlayerVSTutorialGenerator();
 
 	ProcessWarpCollision();
 	ProcessCheckPointCollision();
 	ProcessBulletCollision();
+	BuildCollisionWorld(); // Gather after the bullets exchanged the elements.
 	ProcessEnemyCollision();
 	ProcessBossCollision();
 	ProcessPlayerCollision();
-
-	if ( NowGoalMoment() )
-	{
-		SaveData::ClearData clearData{};
-		clearData.clearRank = Rank::Calculate( currentTime, borderTimes );
-		clearData.clearTime = currentTime;
-		SaveDataAdmin::Get().RegisterIfFastOrNew( stageNumber, clearData );
-
-		if ( pGoal )
-		{
-			const std::vector<int> unlockStageNumbers = pGoal->GetUnlockStageNumbers();
-			for ( const auto &it : unlockStageNumbers )
-			{
-				SaveDataAdmin::Get().UnlockStage( it );
-			}
-
-			SaveDataAdmin::Get().Save();
-		}
-
-		ClearInit();
-		Donya::Sound::Play( Music::UI_Goal );
-	}
-
-	ClearUpdate( elapsedTime );
-	TutorialUpdate( elapsedTime );
-
-	CameraUpdate();
-	EffectAdmin::Get().SetViewMatrix( iCamera.CalcViewMatrix() );
-	EffectAdmin::Get().SetProjectionMatrix( iCamera.GetProjectionMatrix() );
-
-	return ReturnResult();
 }
 
 void SceneGame::Draw( float elapsedTime )
 {
 	elapsedTime = 1.0f; // Disable
 
+	Donya::AllocationTracker::Scope allocationScope{ "SceneGame::Draw" };
+
 	ClearBackGround();
 
+	pRenderer->BeginFrame();
+
 	const Donya::Vector4x4 VP{ iCamera.CalcViewMatrix() * iCamera.GetProjectionMatrix() };
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 #if DEBUG_MODE
 	if ( nowDebugMode )
@@ -888,6 +969,20 @@ void SceneGame::InitStage( int stageNo, bool useSaveDataIfValid )
 	pWarps = std::make_unique<WarpContainer>();
 	pWarps->Init( stageNo );
 
+	// The player can go to the unlocked destinations or back to the selection stage from here, so those terrains are loaded on background.
+	const size_t warpCount = pWarps->GetWarpCount();
+	for ( size_t i = 0; i < warpCount; ++i )
+	{
+		const auto pWarp = pWarps->GetWarpPtrOrNullptr( i );
+		if ( !pWarp || !pWarp->IsUnlocked() ) { continue; }
+		// else
+		StageAssetCache::Get().Prefetch( pWarp->GetDestinationStageNo() );
+	}
+	if ( stageNo != SELECT_STAGE_NO )
+	{
+		StageAssetCache::Get().Prefetch( SELECT_STAGE_NO );
+	}
+
 	pPlayerIniter = std::make_unique<PlayerInitializer>();
 	if ( useSaveDataIfValid && !nowData.isEmpty && nowData.pCurrentIntializer )
 	{
@@ -949,6 +1044,9 @@ void SceneGame::InitStage( int stageNo, bool useSaveDataIfValid )
 }
 void SceneGame::UninitStage()
 {
+	// The requests refer to the poses of the actors that will be released.
+	animationBatch.Clear();
+
 	if ( pCameraOption		) { pCameraOption->Uninit();		}
 	if ( pCheckPoint		) { pCheckPoint->Uninit();			}
 	if ( pEnemies			) { pEnemies->Uninit();				}
@@ -1119,6 +1217,78 @@ void SceneGame::DebugUpdate( float elapsedTime )
 	}
 }
 
+void SceneGame::RunAllocationSelfCheck()
+{
+#if USE_ALLOCATION_TRACKER
+	namespace Tracker = Donya::AllocationTracker;
+
+	// The containers grow in the first frames, so those are not measured.
+	constexpr int WARM_UP_FRAME_COUNT	= 30;
+	constexpr int MEASURE_FRAME_COUNT	= 240;
+	constexpr int ACTION_INTERVAL		= 60;
+	constexpr int OIL_FRAME_COUNT		= 10;
+	constexpr float TURN_DEGREE			= 9.0f; // Per frame. The player walks around the start position.
+
+	Player::Input input{};
+	pScriptedPlayerInput = &input;
+
+	const bool wasEnabled = Tracker::IsEnabled();
+	Tracker::SetEnable( true );
+	Tracker::BeginFrame(); // Drops the counts of before.
+
+	// Counts the copies of the parameters of the enemies, the player and the boss. Those have the containers, so a copy allocates every time.
+	ParameterHelper::CopyCounter::ResetCount();
+
+	std::array<size_t, WORLD_PHASE_COUNT> peakCounts{};
+	for ( int frame = 0; frame < WARM_UP_FRAME_COUNT + MEASURE_FRAME_COUNT; ++frame )
+	{
+		const float radian = Donya::ToRadian( TURN_DEGREE * scast<float>( frame ) );
+		input.moveVectorXZ	= Donya::Vector2{ cosf( radian ), sinf( radian ) };
+		input.useJump		= ( frame % ACTION_INTERVAL == 0 );
+		input.useOil		= ( frame % ACTION_INTERVAL < OIL_FRAME_COUNT );
+
+		UpdateWorld( 1.0f );
+		Tracker::BeginFrame();
+
+		if ( frame < WARM_UP_FRAME_COUNT ) { continue; }
+		// else
+
+		for ( size_t i = 0; i < WORLD_PHASE_COUNT; ++i )
+		{
+			const size_t count = Tracker::GetLastFrameCounter( ALLOCATION_CEILINGS[i].tagName ).count;
+			peakCounts[i] = std::max( peakCounts[i], count );
+		}
+	}
+
+	pScriptedPlayerInput = nullptr;
+	Tracker::SetEnable( wasEnabled );
+
+	const size_t parameterCopyCount = ParameterHelper::CopyCounter::GetCount();
+	_ASSERT_EXPR( !parameterCopyCount, L"Error: The parameters of the actors were copied at the update!" );
+
+	std::string report{ "Allocation self-check of SceneGame, the peak counts per frame:\n" };
+	for ( size_t i = 0; i < WORLD_PHASE_COUNT; ++i )
+	{
+		const auto &ceiling = ALLOCATION_CEILINGS[i];
+		_ASSERT_EXPR( peakCounts[i] <= ceiling.maxCountPerFrame, L"Error: The allocation count of SceneGame exceeded the ceiling!" );
+
+		// The budget has a margin for the actions that the script does not do.
+		const size_t budget = peakCounts[i] + peakCounts[i] / 2U + 4U;
+		Tracker::SetBudget( ceiling.tagName, std::min( budget, ceiling.maxCountPerFrame ) );
+
+		report += "\t" + std::string{ ceiling.tagName } + " : " + std::to_string( peakCounts[i] ) + "\n";
+	}
+	report += "\tThe copies of the parameters of the actors : " + std::to_string( parameterCopyCount ) + "\n";
+	Donya::OutputDebugStr( report.c_str() );
+
+	// The exceeded frames of the script are not the regressions of the game.
+	Tracker::ResetExceededFrameCount();
+
+	// Restarts the stage, so the scripted frames do not affect the game.
+	UninitStage();
+	InitStage( stageNumber, /* useSaveDataIfValid = */ false );
+#endif // USE_ALLOCATION_TRACKER
+}
 void SceneGame::ChoiceObject( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd )
 {
 	switch ( choiceType )
@@ -1260,7 +1430,7 @@ void SceneGame::CameraInit()
 	iCamera.SetFOV( ToRadian( 30.0f ) );
 	iCamera.SetScreenSize( { Common::ScreenWidthF(), Common::ScreenHeightF() } );
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	AssignCameraPos( data.camera.offsetPos, data.camera.offsetFocus );
 	iCamera.SetProjectionPerspective();
 
@@ -1288,7 +1458,7 @@ void SceneGame::AssignCameraPos( const Donya::Vector3 &offsetPos, const Donya::V
 
 	if ( pBoss )
 	{
-		const auto data = FetchMember().cameraBoss;
+		const auto &data = FetchMember().cameraBoss;
 
 		const Donya::Vector3 targetPos = pBoss->GetPosition();
 		const Donya::Vector3 targetVec
@@ -1347,7 +1517,7 @@ void SceneGame::AssignCameraPos( const Donya::Vector3 &offsetPos, const Donya::V
 }
 void SceneGame::CameraUpdate()
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	Donya::ICamera::Controller input{};
 	input.SetNoOperation();
@@ -1445,6 +1615,7 @@ void SceneGame::PlayerInit( int stageNo )
 
 	pPlayer = std::make_unique<Player>();
 	pPlayer->Init( *pPlayerIniter );
+	pPlayer->SetDeferredAnimationBatch( &animationBatch );
 }
 void SceneGame::PlayerUpdate( float elapsedTime )
 {
@@ -1488,6 +1659,15 @@ void SceneGame::PlayerUpdate( float elapsedTime )
 		RevivePlayerRemains();
 	}
 
+#if DEBUG_MODE
+	if ( pScriptedPlayerInput )
+	{
+		pPlayer->Update( elapsedTime, *pScriptedPlayerInput );
+		return;
+	}
+	// else
+#endif // DEBUG_MODE
+
 	Donya::Vector2		moveVector{};
 	bool useJump		= false;
 	bool useOil			= false;
@@ -1557,11 +1737,18 @@ void SceneGame::PlayerUpdate( float elapsedTime )
 
 	pPlayer->Update( elapsedTime, input );
 }
-void SceneGame::PlayerPhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
+void SceneGame::PlayerPhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
 {
 	if ( !pPlayer ) { return; }
-	
-	pPlayer->PhysicUpdate( solids, pTerrain, pTerrainMatrix );
+	// else
+
+	// The player can collide only to the solids around the moving range.
+	const Donya::AABB region = Donya::AABBGrid::MakeSweptRegion( pPlayer->GetHitBox(), pPlayer->GetVelocity() );
+	pPlayer->PhysicUpdate
+	(
+		( querySolids ) ? querySolids( region ) : std::vector<Donya::AABB>{},
+		pTerrain, pTerrainMatrix
+	);
 }
 void SceneGame::PlayerDraw()
 {
@@ -1631,6 +1818,7 @@ void SceneGame::BossInit( int stageNo )
 
 	BossBase::AssignDerivedClass( &pBoss, pBossIniter->GetType() );
 	pBoss->Init( *pBossIniter );
+	pBoss->SetDeferredAnimationBatch( &animationBatch );
 }
 void SceneGame::BossUpdate( float elapsedTime )
 {
@@ -1640,11 +1828,15 @@ void SceneGame::BossUpdate( float elapsedTime )
 	const Donya::Vector3 target = ( pPlayer ) ? pPlayer->GetPosition() : Donya::Vector3::Zero() /* Fail safe */;
 	pBoss->Update( elapsedTime, target );
 }
-void SceneGame::BossPhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
+void SceneGame::BossPhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
 {
 	if ( !pBoss ) { return; }
 	// else
-	pBoss->PhysicUpdate( solids, pTerrain, pTerrainMatrix );
+	pBoss->PhysicUpdate
+	(
+		( querySolids ) ? querySolids( pBoss->CalcSweptRegion() ) : std::vector<Donya::AABB>{},
+		pTerrain, pTerrainMatrix
+	);
 }
 void SceneGame::BossDraw()
 {
@@ -1672,14 +1864,18 @@ void SceneGame::EnemyUpdate( float elapsedTime )
 	// else
 	
 	const Donya::Vector3 target = ( pPlayer ) ? pPlayer->GetPosition() : Donya::Vector3::Zero() /* Fail safe */;
-	pEnemies->Update( elapsedTime, target );
+
+	Enemy::AnimationViewer viewer{};
+	viewer.wsEyePos		= iCamera.GetPosition();
+	viewer.matViewProj	= iCamera.CalcViewMatrix() * iCamera.GetProjectionMatrix();
+	pEnemies->Update( elapsedTime, target, &animationBatch, &viewer );
 }
-void SceneGame::EnemyPhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
+void SceneGame::EnemyPhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
 {
 	if ( !pEnemies ) { return; }
 	// else
 
-	pEnemies->PhysicUpdate( solids, pTerrain, pTerrainMatrix );
+	pEnemies->PhysicUpdate( querySolids, pTerrain, pTerrainMatrix );
 }
 
 void SceneGame::GridControl()
@@ -1708,7 +1904,7 @@ void SceneGame::GridControl()
 void SceneGame::DrawCurrentTime()
 {
 	constexpr float drawDepth = 0.1f; // < pauseDrawDepth
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	numberDrawer.DrawTime
 	(
 		currentTime,
@@ -1721,7 +1917,7 @@ void SceneGame::DrawCurrentTime()
 void SceneGame::DrawPlayerRemains()
 {
 	constexpr float drawDepth = 0.1f; // < pauseDrawDepth
-	const auto data = FetchMember().remainsDraw;
+	const auto &data = FetchMember().remainsDraw;
 
 	sprRemains.drawScale	= data.UIScale;
 	sprRemains.pos			= data.ssUIPos;
@@ -1940,62 +2136,96 @@ void SceneGame::PlayerVSTutorialGenerator()
 	}
 }
 
-std::shared_ptr<Bullet::BulletBase> SceneGame::FindCollidedBulletOrNullptr( const Donya::AABB &other, const std::vector<Element::Type> &exceptTypes ) const
+void SceneGame::BuildCollisionWorld()
 {
-	auto IsExceptType = [&exceptTypes]( const Element &element )
-	{
-		for ( const auto &it : exceptTypes )
-		{
-			if ( element.Get() == it )
-			{
-				return true;
-			}
-		}
+	// Register in the order of each container, for keeping the order of the collision processes.
 
-		return false;
-	};
+	collisionWorld.Clear();
 
 	const auto		&bullet		= Bullet::BulletAdmin::Get();
 	const size_t	bulletCount	= bullet.GetBulletCount();
-
-	Donya::AABB		bulletAABB{};
-	Donya::Sphere	bulletSphere{};
-	std::shared_ptr<Bullet::BulletBase> pBullet = nullptr;
-
 	for ( size_t i = 0; i < bulletCount; ++i )
 	{
-		pBullet = bullet.GetBulletPtrOrNull( i );
+		const auto pBullet = bullet.GetBulletPtrOrNull( i );
 		if ( !pBullet ) { continue; }
-		if ( IsExceptType( pBullet->GetElement() ) ) { continue; }
 		// else
 
 		// The bullets hit-box is either an AABB or a Sphere.
 
-		bulletSphere = pBullet->GetHitBoxSphere();
-		if ( bulletSphere != Donya::Sphere::Nil() )
+		const Element		element	= pBullet->GetElement();
+		const Donya::Sphere	sphere	= pBullet->GetHitBoxSphere();
+		if ( sphere != Donya::Sphere::Nil() )
 		{
-			if ( Donya::Sphere::IsHitAABB( bulletSphere, other ) )
-			{
-				return pBullet;
-			}
-			// else
+			collisionWorld.Add( CollisionWorld::Category::BulletHitBox, i, sphere, element );
 			continue;
 		}
-		else
-		bulletAABB = pBullet->GetHitBoxAABB();
-		if ( bulletAABB != Donya::AABB::Nil() )
+		// else
+
+		const Donya::AABB	aabb	= pBullet->GetHitBoxAABB();
+		if ( aabb != Donya::AABB::Nil() )
 		{
-			if ( Donya::AABB::IsHitAABB( bulletAABB, other ) )
-			{
-				return pBullet;
-			}
-			// else
+			collisionWorld.Add( CollisionWorld::Category::BulletHitBox, i, aabb, element );
 			continue;
 		}
 		// else
 	}
 
-	return nullptr;
+	if ( pEnemies )
+	{
+		std::vector<Donya::AABB> boxes{};
+		const size_t enemyCount = pEnemies->GetEnemyCount();
+		for ( size_t i = 0; i < enemyCount; ++i )
+		{
+			const auto pEnemy = pEnemies->GetEnemyPtrOrNull( i );
+			if ( !pEnemy ) { continue; }
+			// else
+
+			boxes.clear();
+			pEnemy->AcquireHitBoxes( &boxes );
+			for ( const auto &it : boxes )
+			{
+				collisionWorld.Add( CollisionWorld::Category::EnemyHitBox, i, it );
+			}
+
+			boxes.clear();
+			pEnemy->AcquireHurtBoxes( &boxes );
+			for ( const auto &it : boxes )
+			{
+				collisionWorld.Add( CollisionWorld::Category::EnemyHurtBox, i, it );
+			}
+		}
+	}
+
+	if ( pBoss )
+	{
+		for ( const auto &it : pBoss->AcquireHitBoxes() )
+		{
+			collisionWorld.Add( CollisionWorld::Category::BossHitBox, 0, it );
+		}
+		for ( const auto &it : pBoss->AcquireHurtBoxes() )
+		{
+			collisionWorld.Add( CollisionWorld::Category::BossHurtBox, 0, it );
+		}
+	}
+
+	if ( pObstacles )
+	{
+		const auto waters = pObstacles->GetWaterHitBoxes();
+		const size_t waterCount = waters.size();
+		for ( size_t i = 0; i < waterCount; ++i )
+		{
+			collisionWorld.Add( CollisionWorld::Category::Water, i, waters[i] );
+		}
+	}
+
+	collisionWorld.Build();
+}
+std::shared_ptr<Bullet::BulletBase> SceneGame::FindCollidedBulletOrNullptr( const Donya::AABB &other, Element::Mask exceptMask ) const
+{
+	const auto found = collisionWorld.FindFirstOverlap( other, CollisionWorld::Category::BulletHitBox, exceptMask );
+	if ( found == CollisionWorld::INVALID_ID ) { return nullptr; }
+	// else
+	return Bullet::BulletAdmin::Get().GetBulletPtrOrNull( collisionWorld.GetOwnerIndex( found ) );
 }
 void SceneGame::ProcessPlayerCollision()
 {
@@ -2005,22 +2235,13 @@ void SceneGame::ProcessPlayerCollision()
 	// else
 
 	const Donya::AABB playerBody = pPlayer->GetHitBox();
-	const auto exceptTypes = pPlayer->GetUncollidableTypes();
+	const Element::Mask exceptMask = pPlayer->GetUncollidableMask();
 
 	// VS. enemies body.
-	if ( pEnemies )
+	if ( collisionWorld.FindFirstOverlap( playerBody, CollisionWorld::Category::EnemyHitBox ) != CollisionWorld::INVALID_ID )
 	{
-		std::vector<Donya::AABB>    enemyBodies{};
-		pEnemies->AcquireHitBoxes( &enemyBodies );
-
-		for ( const auto &it : enemyBodies )
-		{
-			if ( Donya::AABB::IsHitAABB( playerBody, it ) )
-			{
-				pPlayer->KillMe();
-				return;
-			}
-		}
+		pPlayer->KillMe();
+		return;
 	}
 
 	if ( pPlayer->IsDead() ) { return; }
@@ -2028,7 +2249,7 @@ void SceneGame::ProcessPlayerCollision()
 
 	// VS. bullets.
 	{
-		const auto pCollidedBullet = FindCollidedBulletOrNullptr( playerBody, exceptTypes );
+		const auto pCollidedBullet = FindCollidedBulletOrNullptr( playerBody, exceptMask );
 		if ( pCollidedBullet )
 		{
 			pPlayer->MakeDamage( pCollidedBullet->GetElement() );
@@ -2040,34 +2261,19 @@ void SceneGame::ProcessPlayerCollision()
 	// else
 
 	// VS. Waters of obstacle.
-	if ( pObstacles )
+	if ( collisionWorld.FindFirstOverlap( playerBody, CollisionWorld::Category::Water ) != CollisionWorld::INVALID_ID )
 	{
-		const auto waters = pObstacles->GetWaterHitBoxes();
-		for ( const auto &it : waters )
-		{
-			if ( Donya::AABB::IsHitAABB( playerBody, it ) )
-			{
-				pPlayer->KillMe();
-				break;
-			}
-		}
+		pPlayer->KillMe();
 	}
 
 	if ( pPlayer->IsDead() ) { return; }
 	// else
 
 	// VS. boss body.
-	if ( pBoss )
+	if ( collisionWorld.FindFirstOverlap( playerBody, CollisionWorld::Category::BossHitBox ) != CollisionWorld::INVALID_ID )
 	{
-		const std::vector<Donya::AABB> bodies = pBoss->AcquireHitBoxes();
-		for ( const auto &it : bodies )
-		{
-			if ( Donya::AABB::IsHitAABB( playerBody, it ) )
-			{
-				pPlayer->KillMe();
-				return;
-			}
-		}
+		pPlayer->KillMe();
+		return;
 	}
 }
 void SceneGame::ProcessEnemyCollision()
@@ -2076,28 +2282,30 @@ void SceneGame::ProcessEnemyCollision()
 	if ( !pEnemies	) { return; }	// Do only enemy related collision.
 	// else
 
-	std::vector<Donya::AABB> enemyBodies{};
+	// The hurt-boxes are registered in the order of enemies.
+	std::vector<CollisionWorld::ID> hurtBoxIDs{};
+	collisionWorld.CollectIDs( CollisionWorld::Category::EnemyHurtBox, &hurtBoxIDs );
+
 	std::shared_ptr<Enemy::Base> pEnemy = nullptr;
+	size_t damagedIndex = CollisionWorld::INVALID_ID;
 
-	const size_t enemyCount = pEnemies->GetEnemyCount();
-	for ( size_t i = 0; i < enemyCount; ++i )
+	for ( const auto &id : hurtBoxIDs )
 	{
-		pEnemy = pEnemies->GetEnemyPtrOrNull( i );
-		if ( !pEnemy ) { continue; }
+		// An enemy takes a damage only once.
+		const size_t enemyIndex = collisionWorld.GetOwnerIndex( id );
+		if ( enemyIndex == damagedIndex ) { continue; }
 		// else
 
-		enemyBodies.clear();
-		pEnemy->AcquireHurtBoxes( &enemyBodies );
+		pEnemy = pEnemies->GetEnemyPtrOrNull( enemyIndex );
+		if ( !pEnemy ) { continue; }
+		// else
 
-		for ( const auto &it : enemyBodies )
+		const auto pCollidedBullet = FindCollidedBulletOrNullptr( collisionWorld.GetAABB( id ) );
+		if ( pCollidedBullet )
 		{
-			const auto pCollidedBullet = FindCollidedBulletOrNullptr( it );
-			if ( pCollidedBullet )
-			{
-				pEnemy->MakeDamage( pCollidedBullet->GetElement() );
-				pCollidedBullet->HitToObject();
-				break;
-			}
+			pEnemy->MakeDamage( pCollidedBullet->GetElement() );
+			pCollidedBullet->HitToObject();
+			damagedIndex = enemyIndex;
 		}
 	}
 }
@@ -2158,7 +2366,7 @@ void SceneGame::ProcessBulletCollision()
 		return false;
 	};
 
-	const auto		&bullet		= Bullet::BulletAdmin::Get();
+	auto			&bullet		= Bullet::BulletAdmin::Get();
 	const size_t	bulletCount	= bullet.GetBulletCount();
 
 	Donya::AABB		hitBoxAABB{};
@@ -2191,15 +2399,24 @@ void SceneGame::ProcessBulletCollision()
 		return false;
 	};
 
-	// Check a collision in all combination of bullets.
+	// Check a collision in the combinations of bullets that their bounds are overlapping.
+	// The pairs are sorted as the same order as checking all combination.
 	// e.g.
 	// 0vs1, 0vs2, 0vs3, ...
 	// 1vs2, 1vs3, ...
 	// 2vs3, ...
 	// ...
 
+	std::vector<Bullet::BulletAdmin::CandidatePair> pairs{};
+	bullet.FindCandidatePairs( &pairs );
+	const size_t pairCount = pairs.size();
+	size_t pairIndex = 0;
+
 	for ( size_t i = 0; i < bulletCount; ++i )
 	{
+		// Skip the remaining pairs of previous bullets.
+		while ( pairIndex < pairCount && pairs[pairIndex].lhs < i ) { ++pairIndex; }
+
 		pLhs = bullet.GetBulletPtrOrNull( i );
 		if ( !pLhs ) { continue; }
 		// else
@@ -2215,9 +2432,9 @@ void SceneGame::ProcessBulletCollision()
 		}
 		// else
 
-		for ( size_t j = i + 1/* Except collide to myself */; j < bulletCount; ++j )
+		for ( ; pairIndex < pairCount && pairs[pairIndex].lhs == i; ++pairIndex )
 		{
-			pRhs = bullet.GetBulletPtrOrNull( j );
+			pRhs = bullet.GetBulletPtrOrNull( pairs[pairIndex].rhs );
 			if ( !pRhs ) { continue; }
 			// else
 
@@ -2337,12 +2554,13 @@ void SceneGame::ProcessBossCollision()
 	if ( !pBoss ) { return; }
 	// else
 
-	const std::vector<Donya::AABB> bodies = pBoss->AcquireHurtBoxes();
-	const std::vector<Element::Type> exceptTypes = pBoss->GetUncollidableTypes();
+	std::vector<CollisionWorld::ID> hurtBoxIDs{};
+	collisionWorld.CollectIDs( CollisionWorld::Category::BossHurtBox, &hurtBoxIDs );
+	const Element::Mask exceptMask = pBoss->GetUncollidableMask();
 
-	for ( const auto &it : bodies )
+	for ( const auto &id : hurtBoxIDs )
 	{
-		const auto pCollidedBullet = FindCollidedBulletOrNullptr( it, exceptTypes );
+		const auto pCollidedBullet = FindCollidedBulletOrNullptr( collisionWorld.GetAABB( id ), exceptMask );
 		if ( pCollidedBullet )
 		{
 			pBoss->MakeDamage( pCollidedBullet->GetElement(), pCollidedBullet->GetVelocity() );
@@ -2352,7 +2570,7 @@ void SceneGame::ProcessBossCollision()
 	}
 }
 
-void SceneGame::MakeShadows( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
+void SceneGame::MakeShadows( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix )
 {
 	if ( !pShadow ) { return; }
 	// else
@@ -2391,7 +2609,7 @@ void SceneGame::MakeShadows( const std::vector<Donya::AABB> &solids, const Donya
 		}
 	}
 
-	pShadow->CalcIntersectionPoints( solids, pTerrain, pTerrainMatrix );
+	pShadow->CalcIntersectionPoints( querySolids, pTerrain, pTerrainMatrix );
 }
 
 bool SceneGame::NowGoalMoment() const
@@ -2486,7 +2704,7 @@ void SceneGame::UseImGui()
 	if ( !ImGui::BeginIfAllowed() ) { return; }
 	// else
 	
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	if ( ImGui::TreeNode( u8"Q[Eo[̒" ) )
 	{
@@ -2619,6 +2837,11 @@ void SceneGame::UseImGui()
 		{ pBG->ShowImGuiNode( u8"af" ); }
 		if ( pTerrain )
 		{ pTerrain->ShowImGuiNode( u8"n`" ); }
+		StageAssetCache::Get().ShowImGuiNode( u8"Xe[WỸLbV" );
+		Donya::Batch::ShowBenchmarkNode( u8"蔻̈ꊇ" );
+		Actor::ShowResolverBenchmarkNode( u8"߂̔r" );
+		if ( pRenderer )
+		{ pRenderer->ShowImGuiNode( u8"XLjOs̃LbV" ); }
 		ImGui::Text( "" );
 
 		// if ( pTutorialSentence )
@@ -2646,7 +2869,7 @@ void SceneGame::UseDebugImGui()
 	if ( !ImGui::BeginIfAllowed( u8"yfobO[hz" ) ) { return; }
 	// else
 	
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	ImGui::Text( u8"ueTL[vƁC" );
 	ImGui::Text( u8"wi̐FςfobO[hƂȂ܂B" );
@@ -2771,6 +2994,8 @@ void SceneGame::UseChosenImGui()
 		{
 			pChosenObstacle->ShowImGuiNode( "", /* useTreeNode = */ false );
 			ImGui::End();
+
+			if ( pObstacles ) { pObstacles->MarkSolidGridDirty(); }
 		}
 
 		if ( pChosenObstacle->ShouldRemove() )
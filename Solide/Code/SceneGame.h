@@ -2,11 +2,14 @@
 
 #include <memory>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Camera.h"
 #include "Donya/Collision.h"
 #include "Donya/ModelCommon.h"
 #include "Donya/ModelRenderer.h"
 #include "Donya/GamepadXInput.h"
+#include "Donya/JobSystem.h"
+#include "Donya/ModelAnimationBatch.h"
 #include "Donya/Shader.h"
 #include "Donya/UseImGui.h"
 #include "Donya/Vector.h"
@@ -16,6 +19,7 @@
 #include "CameraOption.h"
 #include "CheckPoint.h"
 #include "ClearPerformance.h"
+#include "CollisionWorld.h"
 #include "EnemyContainer.h"
 #include "Goal.h"
 #include "InfoDisplayer.h"
@@ -67,6 +71,11 @@ private:
 	std::unique_ptr<ClearSentence>		pClearSentence;
 	std::unique_ptr<ClearPerformance>	pClearPerformance;
 
+	CollisionWorld						collisionWorld; // Rebuilt every frame.
+
+	std::unique_ptr<Donya::JobSystem>	pJobSystem;
+	Donya::Model::AnimationBatch		animationBatch; // Gathers the poses of the actors, and evaluates those before the physic updates.
+
 	Timer								currentTime;
 	std::vector<Timer>					borderTimes;
 	NumberDrawer						numberDrawer;
@@ -106,6 +115,8 @@ private:
 	ChoiceType choiceType = ChoiceType::Enemy;
 	std::shared_ptr<Enemy::Base>	pChosenEnemy	= nullptr;
 	std::shared_ptr<ObstacleBase>	pChosenObstacle	= nullptr;
+
+	const Player::Input *pScriptedPlayerInput = nullptr; // Used instead of the controller if it is not nullptr.
 #endif // DEBUG_MODE
 public:
 	SceneGame() : Scene() {}
@@ -127,7 +138,17 @@ private:
 	void	WriteSaveData( int stageNo ) const;
 
 	Donya::Vector4x4 MakeScreenTransformMatrix() const;
+
+	/// <summary>
+	/// Updates the actors, the physics and the collisions. The allocations are tagged by those phases.
+	/// </summary>
+	void	UpdateWorld( float elapsedTime );
 #if DEBUG_MODE
+	/// <summary>
+	/// Updates the world some frames by a fixed input of the player, then asserts the allocation counts per frame of the phases of UpdateWorld() with the ceilings.<para></para>
+	/// The budgets of those phases are derived from the measured counts. The stage is restarted after that.
+	/// </summary>
+	void	RunAllocationSelfCheck();
 	void	DebugUpdate( float elapsedTime );
 	void	ChoiceObject( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd);
 	void	ChoiceEnemy( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd );
@@ -140,7 +161,7 @@ private:
 
 	void	PlayerInit( int stageNo );
 	void	PlayerUpdate( float elapsedTime );
-	void	PlayerPhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
+	void	PlayerPhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
 	void	PlayerDraw();
 	void	PlayerDrawHitBox( const Donya::Vector4x4 &matVP );
 	void	PlayerUninit();
@@ -149,13 +170,13 @@ private:
 	void	ExploreBossContainStageNumbers();
 	void	BossInit( int stageNo );
 	void	BossUpdate( float elapsedTime );
-	void	BossPhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
+	void	BossPhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
 	void	BossDraw();
 	void	BossDrawHitBox( const Donya::Vector4x4 &matVP );
 	void	BossUninit();
 
 	void	EnemyUpdate( float elapsedTime );
-	void	EnemyPhysicUpdate( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
+	void	EnemyPhysicUpdate( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
 
 	void	GridControl();
 
@@ -172,7 +193,8 @@ private:
 	void	PlayerVSJumpStand();
 	void	PlayerVSTutorialGenerator();
 
-	std::shared_ptr<Bullet::BulletBase> FindCollidedBulletOrNullptr( const Donya::AABB &other, const std::vector<Element::Type> &exceptTypes = {} ) const;
+	void	BuildCollisionWorld();
+	std::shared_ptr<Bullet::BulletBase> FindCollidedBulletOrNullptr( const Donya::AABB &other, Element::Mask exceptMask = 0 ) const;
 	void	ProcessPlayerCollision();
 	void	ProcessEnemyCollision();
 	void	ProcessBulletCollision();
@@ -180,7 +202,7 @@ private:
 	void	ProcessCheckPointCollision();
 	void	ProcessBossCollision();
 
-	void	MakeShadows( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
+	void	MakeShadows( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix );
 
 	bool	NowGoalMoment() const;
 
@@ -1,5 +1,7 @@
 #include "SceneLoad.h"
 
+#include <functional>
+#include <string>
 #include <vector>
 
 #undef max
@@ -10,6 +12,8 @@
 #include "Donya/Color.h"
 #include "Donya/Constant.h"
 #include "Donya/Donya.h"
+#include "Donya/JobSystem.h"
+#include "Donya/Loader.h"
 #include "Donya/Serializer.h"
 #include "Donya/Sound.h"
 #include "Donya/Sprite.h"
@@ -52,6 +56,8 @@ namespace
 		float sprLoadMinAlpha			= 0.0f;
 		Donya::Vector2 sprIconPos{ 960.0f, 540.0f };
 		Donya::Vector2 sprLoadPos{ 960.0f, 540.0f };
+		Donya::Vector2 progressBarPos{ 960.0f, 720.0f };	// Center.
+		Donya::Vector2 progressBarSize{ 640.0f, 16.0f };	// Whole size.
 	private:
 		friend class cereal::access;
 		template<class Archive>
@@ -70,20 +76,26 @@ namespace
 			);
 
 			if ( 1 <= version )
+			{
+				archive
+				(
+					CEREAL_NVP( progressBarPos	),
+					CEREAL_NVP( progressBarSize	)
+				);
+			}
+			if ( 2 <= version )
 			{
 				// archive( CEREAL_NVP( x ) );
 			}
 		}
 	};
 }
-CEREAL_CLASS_VERSION( Member, 0 )
+CEREAL_CLASS_VERSION( Member, 1 )
 
-class ParamLoad : public ParameterBase<ParamLoad>
+class ParamLoad : public ParameterBase<ParamLoad, Member>
 {
 public:
 	static constexpr const char *ID = "Loading";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -95,7 +107,6 @@ public:
 
 		Load( m, fromBinary );
 	}
-	Member Data() const { return m; }
 private:
 	std::string GetSerializeIdentifier()			override { return ID; }
 	std::string GetSerializePath( bool isBinary )	override { return GenerateSerializePath( ID, isBinary ); }
@@ -137,6 +148,13 @@ public:
 
 					ImGui::TreePop();
 				}
+				if ( ImGui::TreeNode( u8"io[" ) )
+				{
+					ImGui::DragFloat2( u8"S̃XN[W",	&m.progressBarPos.x );
+					ImGui::DragFloat2( u8"Ŝ̃TCY",			&m.progressBarSize.x );
+
+					ImGui::TreePop();
+				}
 
 				ImGui::TreePop();
 			}
@@ -153,34 +171,82 @@ public:
 
 namespace
 {
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamLoad::Get().Data();
 	}
 }
 
 
+namespace
+{
+	// The tasks that use the same cache must be in the same group, because the caches are not locked.
+	enum LoadingGroup
+	{
+		ModelGroup,		// The models share the caches of textures and shaders.
+		SpriteGroup,
+		SoundGroup,
+	};
+
+	using LoadFunction = std::function<bool( const Donya::TaskGraph::ReportProgress &report )>;
+
+	/// <summary>
+	/// Wraps the loading by CoInitializeEx(), because the threads of the task graph are not initialized for COM. The progress of the loading is forwarded to the graph.
+	/// </summary>
+	Donya::TaskGraph::Task MakeLoadingTask( const std::string &name, const LoadFunction &load )
+	{
+		return [name, load]( const Donya::TaskGraph::ReportProgress &report )->bool
+		{
+			constexpr auto CoInitValue = COINIT_MULTITHREADED | COINIT_DISABLE_OLE1DDE;
+			HRESULT hr = CoInitializeEx( NULL, CoInitValue );
+			if ( FAILED( hr ) ) { return false; }
+			// else
+
+			const bool succeeded = load( report );
+
+			const std::wstring errMsg = L"Failed: Loading a resource is failed. That is : " + Donya::UTF8ToWide( name );
+			_ASSERT_EXPR( succeeded, errMsg.c_str() );
+
+			CoUninitialize();
+			return succeeded;
+		};
+	}
+}
+
 void SceneLoad::Init()
 {
 	ParamLoad::Get().Init();
 
-	constexpr auto CoInitValue = COINIT_MULTITHREADED | COINIT_DISABLE_OLE1DDE;
-	auto LoadingEffects	= [&CoInitValue]( bool *pFinishFlag, bool *pSucceedFlag, std::mutex *pSucceedMutex )
+	// The sprites of this scene are loaded before the start of the graph, because the sprite cache is not locked.
+	if ( !SpritesInit() )
 	{
-		if ( !pFinishFlag || !pSucceedFlag ) { assert( !"Error: Flag ptr is null!" ); return; }
-		// else
+		_ASSERT_EXPR( 0, L"Error: Loading sprites does not works!" );
+	}
 
-		HRESULT hr = CoInitializeEx( NULL, CoInitValue );
-		if ( FAILED( hr ) )
-		{
-			std::lock_guard<std::mutex> lock( *pSucceedMutex );
+	BuildTaskGraph();
+	pTaskGraph->Start();
+}
+void SceneLoad::BuildTaskGraph()
+{
+	using Donya::TaskGraph;
 
-			*pFinishFlag  = true;
-			*pSucceedFlag = false;
-			return;
-		}
-		// else
+	// The tasks and the parallel loading of files in those share this pool, so the count of threads does not exceed the count of cores.
+	pJobSystem = std::make_unique<Donya::JobSystem>( Donya::JobSystem::CalcDefaultWorkerCount() );
+	pTaskGraph = std::make_unique<TaskGraph>( pJobSystem.get() );
+	Donya::JobSystem *pPool = pJobSystem.get();
+
+	auto AddReporting = [&]( const std::string &name, const LoadFunction &load, int group, bool onCallerThread = false )
+	{
+		return pTaskGraph->Add( name, MakeLoadingTask( name, load ), /* dependencies = */ {}, group, onCallerThread );
+	};
+	// For the loadings that have only one step. Their progress becomes 1.0f when finished.
+	auto Add = [&]( const std::string &name, const std::function<bool()> &load, int group, bool onCallerThread = false )
+	{
+		return AddReporting( name, [load]( const TaskGraph::ReportProgress & ) { return load(); }, group, onCallerThread );
+	};
 
+	// Effects.
+	{
 		constexpr size_t attrCount = scast<size_t>( EffectAttribute::AttributeCount );
 		constexpr std::array<EffectAttribute, attrCount> attributes
 		{
@@ -191,126 +257,72 @@ void SceneLoad::Init()
 			EffectAttribute::PlayerSliding,
 		};
 
-		bool succeeded = true;
+		// Note: Maybe Effekseer is not supported to async load? I can not found this way.
+		// So those are loaded on the main thread by RunOnCallerThread().
 		for ( const auto &it : attributes )
 		{
-			if ( !EffectAdmin::Get().LoadEffect( it ) )
-			{
-				succeeded = false;
-			}
+			const std::string name = "Effect[" + std::to_string( scast<int>( it ) ) + "]";
+			Add( name, [it]() { return EffectAdmin::Get().LoadEffect( it ); }, TaskGraph::NO_GROUP, /* onCallerThread = */ true );
 		}
-		
-		_ASSERT_EXPR( succeeded, L"Failed: Effects load is failed." );
-
-		std::lock_guard<std::mutex> lock( *pSucceedMutex );
-		*pFinishFlag  = true;
-		*pSucceedFlag = succeeded;
+	}
 
-		CoUninitialize();
-	};
-	auto LoadingModels	= [&CoInitValue]( bool *pFinishFlag, bool *pSucceedFlag, std::mutex *pSucceedMutex )
+	// Models.
 	{
-		if ( !pFinishFlag || !pSucceedFlag ) { assert( !"Error: Flag ptr is null!" ); return; }
-		// else
-
-		HRESULT hr = CoInitializeEx( NULL, CoInitValue );
-		if ( FAILED( hr ) )
-		{
-			std::lock_guard<std::mutex> lock( *pSucceedMutex );
-
-			*pFinishFlag  = true;
-			*pSucceedFlag = false;
-			return;
-		}
-		// else
-
-		bool succeeded = true;
-
-		if ( !Bullet::LoadBulletsResource()	) { succeeded = false; }
-		if ( !Enemy::LoadResources()		) { succeeded = false; }
-		if ( !Goal::LoadResource()			) { succeeded = false; }
-		if ( !ObstacleBase::LoadModels()	) { succeeded = false; }
-		if ( !Player::LoadModels()			) { succeeded = false; }
-		if ( !BossBase::LoadModels()		) { succeeded = false; }
-		if ( !WarpContainer::LoadResource()	) { succeeded = false; }
-		ClearPerformance::LoadParameter();
-
-		_ASSERT_EXPR( succeeded, L"Failed: Models load is failed." );
-
-		std::lock_guard<std::mutex> lock( *pSucceedMutex );
-		*pFinishFlag  = true;
-		*pSucceedFlag = succeeded;
+		// The loadings of several models report the progress.
+		AddReporting( "Bullet",		[pPool]( const TaskGraph::ReportProgress &report ) { return Bullet::LoadBulletsResource( pPool, report );	}, ModelGroup );
+		AddReporting( "Enemy",		[pPool]( const TaskGraph::ReportProgress &report ) { return Enemy::LoadResources( pPool, report );			}, ModelGroup );
+		Add( "Goal",		[]() { return Goal::LoadResource();				}, ModelGroup );
+		AddReporting( "Obstacle",	[pPool]( const TaskGraph::ReportProgress &report ) { return ObstacleBase::LoadModels( pPool, report );	}, ModelGroup );
+		Add( "Player",		[]() { return Player::LoadModels();				}, ModelGroup );
+		Add( "Boss",		[]() { return BossBase::LoadModels();			}, ModelGroup );
+		Add( "Warp",		[]() { return WarpContainer::LoadResource();	}, ModelGroup );
+
+		// This is a parameter only, so it does not use any cache.
+		Add
+		(
+			"ClearPerformance",
+			[]() { ClearPerformance::LoadParameter(); return true; },
+			TaskGraph::NO_GROUP
+		);
+	}
 
-		CoUninitialize();
-	};
-	auto LoadingSprites	= [&CoInitValue]( bool *pFinishFlag, bool *pSucceedFlag, std::mutex *pSucceedMutex )
+	// Sprites.
 	{
-		if ( !pFinishFlag || !pSucceedFlag ) { assert( !"Error: Flag ptr is null!" ); return; }
-		// else
-
-		HRESULT hr = CoInitializeEx( NULL, CoInitValue );
-		if ( FAILED( hr ) )
-		{
-			std::lock_guard<std::mutex> lock( *pSucceedMutex );
-
-			*pFinishFlag  = true;
-			*pSucceedFlag = false;
-			return;
-		}
-		// else
-
 		using Attr = SpriteAttribute;
 
-		auto MakeTextureCache = []( Attr attr, size_t maxInstanceCount )->bool
+		auto AddSprite = [&]( Attr attr, size_t maxInstanceCount )
 		{
-			const auto handle = Donya::Sprite::Load( GetSpritePath( attr ), maxInstanceCount );
-			return  (  handle == NULL ) ? false : true;
+			const std::string name = Donya::WideToUTF8( GetSpritePath( attr ) );
+			auto MakeTextureCache = [attr, maxInstanceCount]()->bool
+			{
+				const auto handle = Donya::Sprite::Load( GetSpritePath( attr ), maxInstanceCount );
+				return  (  handle == NULL ) ? false : true;
+			};
+			Add( name, MakeTextureCache, SpriteGroup );
 		};
 
-		bool succeeded = true;
-		if ( !MakeTextureCache( Attr::BackGround,		2U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::BossStage,	   32U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::CircleShadow,		1U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::ClearDescription,	8U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::ClearFrame,		2U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::ClearRank,	  128U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::ClearSentence,	4U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::Cloud,			2U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::LockedStage,	   64U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::Number,		 1024U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::Pause,			8U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::PlayerRemains,	4U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::StageInfoFrame,  32U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::TutorialFrame,	2U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::TutorialSentence,	4U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::TitleItems,	   16U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::TitleLogo,		2U ) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::TitlePrompt,		2U ) ) { succeeded = false; }
-
-		_ASSERT_EXPR( succeeded, L"Failed: Sprites load is failed." );
-
-		std::lock_guard<std::mutex> lock( *pSucceedMutex );
-		*pFinishFlag  = true;
-		*pSucceedFlag = succeeded;
-
-		CoUninitialize();
-	};
-	auto LoadingSounds	= [&CoInitValue]( bool *pFinishFlag, bool *pSucceedFlag, std::mutex *pSucceedMutex )
-	{
-		if ( !pFinishFlag || !pSucceedFlag ) { assert( !"Error: Flag ptr is null!" ); return; }
-		// else
-
-		HRESULT hr = CoInitializeEx( NULL, CoInitValue );
-		if ( FAILED( hr ) )
-		{
-			std::lock_guard<std::mutex> lock( *pSucceedMutex );
-
-			*pFinishFlag  = true;
-			*pSucceedFlag = false;
-			return;
-		}
-		// else
+		AddSprite( Attr::BackGround,		2U );
+		AddSprite( Attr::BossStage,		   32U );
+		AddSprite( Attr::CircleShadow,		1U );
+		AddSprite( Attr::ClearDescription,	8U );
+		AddSprite( Attr::ClearFrame,		2U );
+		AddSprite( Attr::ClearRank,		  128U );
+		AddSprite( Attr::ClearSentence,		4U );
+		AddSprite( Attr::Cloud,				2U );
+		AddSprite( Attr::LockedStage,	   64U );
+		AddSprite( Attr::Number,		 1024U );
+		AddSprite( Attr::Pause,				8U );
+		AddSprite( Attr::PlayerRemains,		4U );
+		AddSprite( Attr::StageInfoFrame,   32U );
+		AddSprite( Attr::TutorialFrame,		2U );
+		AddSprite( Attr::TutorialSentence,	4U );
+		AddSprite( Attr::TitleItems,	   16U );
+		AddSprite( Attr::TitleLogo,			2U );
+		AddSprite( Attr::TitlePrompt,		2U );
+	}
 
+	// Sounds.
+	{
 		using Music::ID;
 
 		struct Bundle
@@ -353,49 +365,19 @@ void SceneLoad::Init()
 			Bundle{ ID::ItemDecision,		"./Data/Sounds/SE/UI/DecisionItem.wav",			false	},
 		};
 
-		bool succeeded = true;
-		for ( size_t i = 0; i < ID::MUSIC_COUNT; ++i )
+		for ( const auto &it : bundles )
 		{
-			bool result = Donya::Sound::Load
-			(
-				bundles[i].id,
-				bundles[i].filePath,
-				bundles[i].isEnableLoop
-			);
-			if ( !result ) { succeeded = false; }
+			auto LoadSound = [it]()->bool
+			{
+				return Donya::Sound::Load( it.id, it.filePath, it.isEnableLoop );
+			};
+			Add( it.filePath, LoadSound, SoundGroup );
 		}
-
-		_ASSERT_EXPR( succeeded, L"Failed: Sounds load is failed." );
-
-		std::lock_guard<std::mutex> lock( *pSucceedMutex );
-		*pFinishFlag  = true;
-		*pSucceedFlag = succeeded;
-
-		CoUninitialize();
-	};
-
-	finishEffects	= false;
-	finishModels	= false;
-	finishSprites	= false;
-	finishSounds	= false;
-	allSucceeded	= true;
-
-	pThreadModels	= std::make_unique<std::thread>( LoadingModels,		&finishModels,	&allSucceeded, &succeedMutex );
-	pThreadSounds	= std::make_unique<std::thread>( LoadingSounds,		&finishSounds,	&allSucceeded, &succeedMutex );
-	pThreadSprites	= std::make_unique<std::thread>( LoadingSprites,	&finishSprites,	&allSucceeded, &succeedMutex );
-
-	// Note: Maybe Effekseer is not supported to async load? I can not found this way.
-	// pThreadEffects = std::make_unique<std::thread>( LoadingEffects,	&finishEffects,	&allSucceeded, &succeedMutex );
-	LoadingEffects( &finishEffects,	&allSucceeded, &succeedMutex );
-
-	if ( !SpritesInit() )
-	{
-		_ASSERT_EXPR( 0, L"Error: Loading sprites does not works!" );
 	}
 }
 void SceneLoad::Uninit()
 {
-	ReleaseAllThread();
+	ReleaseTaskGraph();
 
 	ParamLoad::Get().Uninit();
 }
@@ -413,10 +395,20 @@ Scene::Result SceneLoad::Update( float elapsedTime )
 
 	SpritesUpdate( elapsedTime );
 
+	// The tasks that must run on the main thread are run one per frame, so the loading screen keeps moving.
+	if ( pTaskGraph )
+	{
+		pTaskGraph->RunOnCallerThread();
+	}
+
 	if ( !Fader::Get().IsExist() && IsFinished() )
 	{
-		if ( allSucceeded )
+		if ( IsSucceeded() )
 		{
+		#if DEBUG_MODE
+			OutputCriticalPath();
+		#endif // DEBUG_MODE
+
 			StartFade();
 		}
 		else
@@ -432,13 +424,8 @@ Scene::Result SceneLoad::Update( float elapsedTime )
 
 			PostMessage( hWnd, WM_CLOSE, 0, 0 );
 
-			ReleaseAllThread();
-
 			// Prevent a true being returned by IsFinished().
-			finishEffects	= false;
-			finishModels	= false;
-			finishSprites	= false;
-			finishSounds	= false;
+			ReleaseTaskGraph();
 		}
 	}
 
@@ -451,32 +438,39 @@ void SceneLoad::Draw( float elapsedTime )
 
 	sprIcon.Draw();
 	sprNowLoading.Draw();
+	DrawProgress();
 }
 
-void SceneLoad::ReleaseAllThread()
+void SceneLoad::ReleaseTaskGraph()
 {
-	auto JoinThenRelease = []( std::unique_ptr<std::thread> &p )
-	{
-		if ( p )
-		{ 
-			if ( p->joinable() )
-			{
-				p->join();
-			}
+	// The destructor waits for the running tasks, so the pool is released after that.
+	pTaskGraph.reset();
+	pJobSystem.reset();
+}
+#if DEBUG_MODE
+void SceneLoad::OutputCriticalPath() const
+{
+	if ( !pTaskGraph ) { return; }
+	// else
 
-			p.reset();
-		}
-	};
+	std::string report = "[Loading critical path]\n";
+	const auto path = pTaskGraph->CalcCriticalPath();
+	for ( const auto &id : path )
+	{
+		const auto timing = pTaskGraph->GetTiming( id );
+		report += pTaskGraph->GetName( id );
+		report += " : Run " + std::to_string( timing.RunSeconds() * 1000.0 ) + "[ms]";
+		report += ", Wait " + std::to_string( timing.WaitSeconds() * 1000.0 ) + "[ms]";
+		report += ", End " + std::to_string( timing.endSeconds * 1000.0 ) + "[ms]\n";
+	}
 
-	JoinThenRelease( pThreadEffects	);
-	JoinThenRelease( pThreadModels	);
-	JoinThenRelease( pThreadSprites	);
-	JoinThenRelease( pThreadSounds	);
+	Donya::OutputDebugStr( Donya::UTF8ToWide( report ).c_str() );
 }
+#endif // DEBUG_MODE
 
 bool SceneLoad::SpritesInit()
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	bool succeeded = true;
 
@@ -499,7 +493,7 @@ bool SceneLoad::SpritesInit()
 }
 void SceneLoad::SpritesUpdate( float elapsedTime )
 {
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	sprIcon.degree += data.sprIconRotateSpeed * elapsedTime;
 
@@ -518,7 +512,11 @@ void SceneLoad::SpritesUpdate( float elapsedTime )
 
 bool SceneLoad::IsFinished() const
 {
-	return ( finishEffects && finishModels && finishSprites && finishSounds );
+	return ( pTaskGraph && pTaskGraph->IsFinished() );
+}
+bool SceneLoad::IsSucceeded() const
+{
+	return ( pTaskGraph && pTaskGraph->IsSucceeded() );
 }
 
 void SceneLoad::ClearBackGround() const
@@ -528,6 +526,35 @@ void SceneLoad::ClearBackGround() const
 	Donya::ClearViews( BG_COLOR );
 }
 
+void SceneLoad::DrawProgress() const
+{
+	const float progress = ( pTaskGraph ) ? pTaskGraph->GetTotalProgress() : 0.0f;
+	const auto &data     = FetchMember();
+	const auto &pos      = data.progressBarPos;
+	const auto &size     = data.progressBarSize;
+
+	const float prevDepth = Donya::Sprite::GetDrawDepth();
+	Donya::Sprite::SetDrawDepth( 0.0f );
+
+	Donya::Sprite::DrawRect
+	(
+		pos.x, pos.y,
+		size.x, size.y,
+		Donya::Color::Code::DARK_GRAY, 1.0f
+	);
+
+	// Extends from the left side.
+	const float filledWidth = size.x * progress;
+	Donya::Sprite::DrawRect
+	(
+		pos.x - ( size.x * 0.5f ) + ( filledWidth * 0.5f ), pos.y,
+		filledWidth, size.y,
+		Donya::Color::Code::WHITE, 1.0f
+	);
+
+	Donya::Sprite::SetDrawDepth( prevDepth );
+}
+
 void SceneLoad::StartFade() const
 {
 	Fader::Configuration config{};
@@ -568,10 +595,8 @@ void SceneLoad::UseImGui()
 				return ( v ) ? "True" : "False";
 			};
 
-			ImGui::Text( u8"ItOEGtFNg[%s]",	GetBoolStr( finishEffects	).c_str() );
-			ImGui::Text( u8"ItOEf[%s]",		GetBoolStr( finishModels	).c_str() );
-			ImGui::Text( u8"ItOEXvCg[%s]",	GetBoolStr( finishSprites	).c_str() );
-			ImGui::Text( u8"ItOETEh[%s]",	GetBoolStr( finishSounds	).c_str() );
+			ImGui::Text( u8"ItO[%s]",	GetBoolStr( IsFinished()	).c_str() );
+			ImGui::Text( u8"tO[%s]",	GetBoolStr( IsSucceeded()	).c_str() );
 			
 			ImGui::Text( u8"oߎԁF[%6.3f]", elapsedTimer );
 
@@ -581,6 +606,16 @@ void SceneLoad::UseImGui()
 			ImGui::TreePop();
 		}
 
+		if ( pTaskGraph )
+		{
+			pTaskGraph->ShowImGuiNode( u8"[h^XN̐iƌv" );
+		}
+
+		Donya::Loader::ShowMotionCompressionNode( u8"[Vǩv" );
+		Donya::Loader::ShowContainerBenchmarkNode( u8"fReǐv" );
+		Donya::Loader::ShowLoadManyBenchmarkNode( u8"f̕ǂݍ݂̌v" );
+		Donya::Loader::ShowSerializerBenchmarkNode( u8"f̃VACY̌v" );
+
 		ImGui::End();
 	}
 }
@@ -1,9 +1,9 @@
 #pragma once
 
 #include <memory>
-#include <mutex>
-#include <thread>
 
+#include "Donya/JobSystem.h"
+#include "Donya/TaskGraph.h"
 #include "Donya/UseImGui.h"
 
 #include "Scene.h"
@@ -12,18 +12,8 @@
 class SceneLoad : public Scene
 {
 private:
-	bool finishEffects	= false;
-	bool finishModels	= false;
-	bool finishSprites	= false;
-	bool finishSounds	= false;
-
-	bool allSucceeded	= true;
-	std::mutex succeedMutex;
-
-	std::unique_ptr<std::thread> pThreadEffects = nullptr;
-	std::unique_ptr<std::thread> pThreadModels  = nullptr;
-	std::unique_ptr<std::thread> pThreadSprites = nullptr;
-	std::unique_ptr<std::thread> pThreadSounds  = nullptr;
+	std::unique_ptr<Donya::JobSystem> pJobSystem = nullptr;	// Shared by the tasks of graph and the loading in those. Must be released after the graph.
+	std::unique_ptr<Donya::TaskGraph> pTaskGraph = nullptr;
 
 	UIObject	sprIcon;
 	UIObject	sprNowLoading;
@@ -36,7 +26,7 @@ public:
 	SceneLoad() : Scene() {}
 	~SceneLoad()
 	{
-		ReleaseAllThread();
+		ReleaseTaskGraph();
 	}
 public:
 	void	Init() override;
@@ -46,14 +36,23 @@ public:
 
 	void	Draw( float elapsedTime ) override;
 private:
-	void	ReleaseAllThread();
+	/// <summary>
+	/// Builds the graph of the loading tasks. Each resource is a node.
+	/// </summary>
+	void	BuildTaskGraph();
+	void	ReleaseTaskGraph();
+#if DEBUG_MODE
+	void	OutputCriticalPath() const;
+#endif // DEBUG_MODE
 private:
 	bool	SpritesInit();
 	void	SpritesUpdate( float elapsedTime );
 private:
 	bool	IsFinished() const;
+	bool	IsSucceeded() const;
 private:
 	void	ClearBackGround() const;
+	void	DrawProgress() const;
 	void	StartFade() const;
 private:
 	Result	ReturnResult();
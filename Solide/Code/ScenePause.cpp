@@ -99,12 +99,10 @@ namespace
 CEREAL_CLASS_VERSION( Member,		0 )
 CEREAL_CLASS_VERSION( Member::Item,	0 )
 
-class ParamPause : public ParameterBase<ParamPause>
+class ParamPause : public ParameterBase<ParamPause, Member>
 {
 public:
 	static constexpr const char *ID = "Pause";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -118,7 +116,6 @@ public:
 
 		ResizeVectorIfNeeded();
 	}
-	Member Data() const { return m; }
 private:
 	void ResizeVectorIfNeeded()
 	{
@@ -187,7 +184,7 @@ public:
 
 namespace
 {
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamPause::Get().Data();
 	}
@@ -246,7 +243,7 @@ void ScenePause::Draw( float elapsedTime )
 	constexpr float defaultDepth = 0.03f;
 	constexpr float chosenDepth  = defaultDepth * 0.5f;
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	DrawItem( data.pause, 1.0f, defaultDepth );
 
@@ -141,12 +141,10 @@ namespace
 }
 CEREAL_CLASS_VERSION( Member, 3 )
 
-class ParamTitle : public ParameterBase<ParamTitle>
+class ParamTitle : public ParameterBase<ParamTitle, Member>
 {
 public:
 	static constexpr const char *ID = "Title";
-private:
-	Member m;
 public:
 	void Init() override
 	{
@@ -160,7 +158,6 @@ public:
 
 		ResizeVectorIfNeeded();
 	}
-	Member Data() const { return m; }
 private:
 	void ResizeVectorIfNeeded()
 	{
@@ -253,7 +250,7 @@ public:
 
 namespace
 {
-	Member FetchMember()
+	const Member &FetchMember()
 	{
 		return ParamTitle::Get().Data();
 	}
@@ -282,7 +279,7 @@ void SceneTitle::Init()
 	assert( result );
 
 	ParamTitle::Get().Init();
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	pBG = std::make_unique<BG>();
 	result = pBG->LoadSprites( GetSpritePath( Spr::BackGround ), GetSpritePath( Spr::Cloud ) );
@@ -368,7 +365,11 @@ Scene::Result SceneTitle::Update( float elapsedTime )
 
 	PlayerUpdate( elapsedTime );
 
-	PlayerPhysicUpdate( pObstacles->GetHitBoxes(), &pTerrain );
+	const Donya::AABBQuery querySolids = [&]( const Donya::AABB &wsRegion )
+	{
+		return pObstacles->GetHitBoxes( wsRegion );
+	};
+	PlayerPhysicUpdate( querySolids, &pTerrain );
 
 	CameraUpdate();
 	EffectAdmin::Get().SetViewMatrix( iCamera.CalcViewMatrix() );
@@ -385,8 +386,10 @@ void SceneTitle::Draw( float elapsedTime )
 
 	ClearBackGround();
 
+	pRenderer->BeginFrame();
+
 	const Donya::Vector4x4 VP{ iCamera.CalcViewMatrix() * iCamera.GetProjectionMatrix() };
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	
 	{
 		Donya::Model::Constants::PerScene::Common constant{};
@@ -503,7 +506,7 @@ void SceneTitle::AssignCameraPos()
 	if ( !pPlayer ) { return; }
 	// else
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 	const Donya::Vector3   playerPos = pPlayer->GetPosition();
 
 	iCamera.SetPosition  ( playerPos + data.camera.offsetPos   );
@@ -630,7 +633,7 @@ void SceneTitle::PlayerUpdate( float elapsedTime )
 
 	pPlayer->Update( elapsedTime, input );
 }
-void SceneTitle::PlayerPhysicUpdate( const std::vector<Donya::AABB> &solids, const std::unique_ptr<Terrain> *ppTerrain )
+void SceneTitle::PlayerPhysicUpdate( const Donya::AABBQuery &querySolids, const std::unique_ptr<Terrain> *ppTerrain )
 {
 	if ( !pPlayer   ) { return; }
 	if ( !ppTerrain ) { return; }
@@ -640,8 +643,13 @@ void SceneTitle::PlayerPhysicUpdate( const std::vector<Donya::AABB> &solids, con
 	if ( !pTerrain ) { return; }
 	// else
 
-	const Donya::Vector4x4 &terrainMatrix = pTerrain->GetWorldMatrix();
-	pPlayer->PhysicUpdate( solids, pTerrain->GetCollisionModel().get(), &terrainMatrix );
+	const Donya::AABB region = Donya::AABBGrid::MakeSweptRegion( pPlayer->GetHitBox(), pPlayer->GetVelocity() );
+	const Donya::Vector4x4 &terrainMatrix = pTerrain->GetCollisionMatrix();
+	pPlayer->PhysicUpdate
+	(
+		( querySolids ) ? querySolids( region ) : std::vector<Donya::AABB>{},
+		pTerrain->GetCollisionModel().get(), &terrainMatrix
+	);
 }
 void SceneTitle::PlayerDraw()
 {
@@ -784,7 +792,7 @@ void SceneTitle::SelectUpdate( float elapsedTime )
 	};
 	auto UpdateWaiting	= [&]()
 	{
-		const auto data = FetchMember();
+		const auto &data = FetchMember();
 
 		timer++;
 		if ( timer == data.waitFrameUntilFade )
@@ -852,7 +860,7 @@ void SceneTitle::SelectDraw( float elapsedTime )
 	constexpr float defaultDepth = 0.1f;
 	constexpr float chosenDepth  = defaultDepth * 0.5f;
 
-	const auto data = FetchMember();
+	const auto &data = FetchMember();
 
 	const int chosenIndex = scast<int>( chooseItem );
 	for ( int i = 0; i < ItemCount; ++i )
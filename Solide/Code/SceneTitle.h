@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Camera.h"
 #include "Donya/Collision.h"
 #include "Donya/Constant.h"
@@ -79,7 +80,7 @@ private:
 
 	void	PlayerInit();
 	void	PlayerUpdate( float elapsedTime );
-	void	PlayerPhysicUpdate( const std::vector<Donya::AABB> &solids, const std::unique_ptr<Terrain> *ppTerrain );
+	void	PlayerPhysicUpdate( const Donya::AABBQuery &querySolids, const std::unique_ptr<Terrain> *ppTerrain );
 	void	PlayerDraw();
 	void	PlayerDrawHitBox( const Donya::Vector4x4 &matVP );
 	void	PlayerUninit();
@@ -43,7 +43,7 @@ void Shadow::Register( const Donya::Vector3 &rayStart, float rayLength )
 	shadows.emplace_back( std::move( tmp ) );
 }
 
-void Shadow::CalcIntersectionPoints( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix, const Donya::Vector3 &rayDir )
+void Shadow::CalcIntersectionPoints( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainMatrix, const Donya::Vector3 &rayDir )
 {
 	auto CalcNearestIntersectionAABB	= [&]( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd )
 	{
@@ -51,6 +51,17 @@ void Shadow::CalcIntersectionPoints( const std::vector<Donya::AABB> &solids, con
 		result.isIntersect = false;
 		result.normal = Donya::Vector3::Up();
 
+		if ( !querySolids ) { return result; }
+		// else
+
+		// The region that covers the ray segment.
+		const Donya::Vector3 halfRay = ( rayEnd - rayStart ) * 0.5f;
+		Donya::AABB rayRegion{};
+		rayRegion.pos	= rayStart + halfRay;
+		rayRegion.size	= Donya::Vector3{ fabsf( halfRay.x ), fabsf( halfRay.y ), fabsf( halfRay.z ) };
+		rayRegion.exist	= true;
+
+		const auto solids = querySolids( rayRegion );
 		if ( solids.empty() ) { return result; }
 		// else
 
@@ -84,24 +95,26 @@ void Shadow::CalcIntersectionPoints( const std::vector<Donya::AABB> &solids, con
 		result.intersection = nearestPoint;
 		return result;
 	};
-	auto CalcNearestIntersectionTerrain	= [&]( const Donya::Vector3 &rayStart, const Donya::Vector3 &rayEnd )
+	// The rays to the terrain are tested at once.
+	std::vector<Donya::Model::RaycastResult> terrainResults( shadows.size() );
+	if ( pTerrain && pTerrainMatrix )
 	{
-		Donya::Model::RaycastResult result{};
-		result.wasHit = false;
+		std::vector<Donya::Model::RaySegment> rays{};
+		rays.reserve( shadows.size() );
+		for ( const auto &it : shadows )
+		{
+			rays.emplace_back( Donya::Model::RaySegment{ it.origin, it.origin + ( rayDir * it.rayLength ) } );
+		}
 
-		if ( !pTerrain || !pTerrainMatrix ) { return result; }
-		// else
+		pTerrain->RaycastBatch( *pTerrainMatrix, rays.data(), rays.size(), terrainResults.data() );
+	}
 
-		result = pTerrain->RaycastWorldSpace( *pTerrainMatrix, rayStart, rayEnd );
-		return result;
-	};
-	auto CalcIntersectionPoint			= [&]( Instance &element )
+	auto CalcIntersectionPoint			= [&]( Instance &element, const Donya::Model::RaycastResult &vsTerrain )
 	{
 		const Donya::Vector3 rayStart	= element.origin;
 		const Donya::Vector3 rayEnd		= rayStart + ( rayDir * element.rayLength );
 
 		const auto vsAABB		= CalcNearestIntersectionAABB( rayStart, rayEnd );
-		const auto vsTerrain	= CalcNearestIntersectionTerrain( rayStart, rayEnd );
 
 		element.exist = false;
 		if ( !vsAABB.isIntersect && !vsTerrain.wasHit ) { return; }
@@ -119,7 +132,7 @@ void Shadow::CalcIntersectionPoints( const std::vector<Donya::AABB> &solids, con
 		auto ApplyTerrain	= [&]()
 		{
 			element.intersection	= pointTerrain;
-			element.normal			= vsTerrain.nearestPolygon.normal;
+			element.normal			= vsTerrain.normal;
 		};
 
 		if ( !vsAABB.isIntersect	) { ApplyTerrain();	return; }
@@ -140,10 +153,11 @@ void Shadow::CalcIntersectionPoints( const std::vector<Donya::AABB> &solids, con
 	};
 
 	constexpr Donya::Vector3 smallOffset{ 0.0f, 0.01f, 0.0f }; // Prevent a z-fighting on a terrain.
-	for ( auto &it : shadows )
+	const size_t shadowCount = shadows.size();
+	for ( size_t i = 0; i < shadowCount; ++i )
 	{
-		CalcIntersectionPoint( it );
-		it.intersection += smallOffset;
+		CalcIntersectionPoint( shadows[i], terrainResults[i] );
+		shadows[i].intersection += smallOffset;
 	}
 
 	auto itr = std::remove_if
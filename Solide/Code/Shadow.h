@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 
+#include "Donya/AABBGrid.h"
 #include "Donya/Collision.h"
 #include "Donya/ModelPolygon.h"
 #include "Donya/Vector.h"
@@ -47,8 +48,9 @@ public:
 public:
 	void Register( const Donya::Vector3 &wsRayStartPos, float rayLength = 10.0f );
 	/// <summary>
-	/// You can set empty or nullptr to argument(except "rayDirection"). That argument will be ignored.
+	/// You can set empty or nullptr to argument(except "rayDirection"). That argument will be ignored.<para></para>
+	/// The solids are queried by the region of each ray.
 	/// </summary>
-	void CalcIntersectionPoints( const std::vector<Donya::AABB> &solids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainWorldMatrix, const Donya::Vector3 &rayDirection = { 0.0f, -1.0f, 0.0f } );
+	void CalcIntersectionPoints( const Donya::AABBQuery &querySolids, const Donya::Model::PolygonGroup *pTerrain, const Donya::Vector4x4 *pTerrainWorldMatrix, const Donya::Vector3 &rayDirection = { 0.0f, -1.0f, 0.0f } );
 	void Draw( const Donya::Vector4x4 &matVP );
 };
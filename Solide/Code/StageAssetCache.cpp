@@ -0,0 +1,354 @@
+#include "StageAssetCache.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Donya/Useful.h"
+
+#include "FilePath.h"
+
+#undef max
+#undef min
+
+namespace
+{
+	size_t EstimateBytes( const Donya::Model::Source &source )
+	{
+		size_t bytes = 0;
+		for ( const auto &mesh : source.meshes )
+		{
+			bytes += mesh.positions.size()		* sizeof( Donya::Model::Vertex::Pos  );
+			bytes += mesh.texCoords.size()		* sizeof( Donya::Model::Vertex::Tex  );
+			bytes += mesh.boneInfluences.size()	* sizeof( Donya::Model::Vertex::Bone );
+			bytes += mesh.indices.size()		* sizeof( unsigned int );
+		}
+		return bytes;
+	}
+	size_t EstimateBytes( const Donya::Model::PolygonGroup &polygons )
+	{
+		constexpr size_t BVH_NODE_BYTES = sizeof( Donya::Vector3 ) * 2 + sizeof( int ) * 2; // Approximate. The node is private.
+		return	polygons.GetPackedVertices().size()		* sizeof( Donya::Vector3 ) +
+				polygons.GetPackedMaterialIds().size()	* sizeof( int ) +
+				polygons.GetBVHNodeCount()				* BVH_NODE_BYTES;
+	}
+
+	template<typename T>
+	bool IsReady( const std::future<T> &future )
+	{
+		return future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+	}
+}
+
+StageAssetCache::~StageAssetCache()
+{
+	Clear();
+}
+
+std::shared_ptr<const StageAssetCache::TerrainAssets> StageAssetCache::FetchTerrain( int stageNo )
+{
+	if ( enableCache )
+	{
+		auto found = std::find_if
+		(
+			entries.begin(), entries.end(),
+			[&stageNo]( const Entry &entry ) { return entry.stageNo == stageNo; }
+		);
+		if ( found != entries.end() )
+		{
+			entries.splice( entries.begin(), entries, found );
+			counter.hit++;
+			lastResult = FetchResult::Hit;
+			return entries.front().pAssets;
+		}
+		// else
+
+		auto pending = pendings.find( stageNo );
+		if ( pending != pendings.end() )
+		{
+			const auto pFiles = pending->second.get();
+			pendings.erase( pending );
+
+			if ( pFiles && pFiles->succeeded )
+			{
+				const auto pAssets = CreateAssets( *pFiles );
+				if ( pAssets )
+				{
+					Insert( stageNo, pAssets );
+					counter.prefetchHit++;
+					lastResult = FetchResult::PrefetchHit;
+					return pAssets;
+				}
+			}
+			// else fallback to the synchronous loading.
+		}
+	}
+
+	const auto pFiles = LoadFiles( stageNo );
+	const auto pAssets = ( pFiles && pFiles->succeeded ) ? CreateAssets( *pFiles ) : nullptr;
+	if ( !pAssets )
+	{
+		lastResult = FetchResult::Failed;
+		return nullptr;
+	}
+	// else
+
+	if ( enableCache )
+	{
+		Insert( stageNo, pAssets );
+	}
+	counter.miss++;
+	lastResult = FetchResult::Miss;
+	return pAssets;
+}
+
+void StageAssetCache::Prefetch( int stageNo )
+{
+	if ( !enableCache ) { return; }
+	// else
+
+	CollectFinishedPrefetches();
+
+	if ( IsCached( stageNo ) || pendings.find( stageNo ) != pendings.end() ) { return; }
+	if ( MAX_PENDING_COUNT <= pendings.size() ) { return; }
+	// else
+
+	if ( !Donya::IsExistFile( MakeTerrainModelPath( "Display",   stageNo ) ) ) { return; }
+	if ( !Donya::IsExistFile( MakeTerrainModelPath( "Collision", stageNo ) ) ) { return; }
+	// else
+
+	pendings.emplace( stageNo, std::async( std::launch::async, &StageAssetCache::LoadFiles, stageNo ) );
+}
+
+void StageAssetCache::Clear()
+{
+	// The destructor of the future that was made by std::async() waits for the thread.
+	pendings.clear();
+	entries.clear();
+	usedBytes = 0;
+}
+
+void StageAssetCache::SetBudget( size_t bytes )
+{
+	budgetBytes = bytes;
+	EvictIfOverBudget();
+}
+void StageAssetCache::SetEnable( bool enable )
+{
+	enableCache = enable;
+	if ( !enableCache )
+	{
+		Clear();
+	}
+}
+bool StageAssetCache::IsCached( int stageNo ) const
+{
+	for ( const auto &entry : entries )
+	{
+		if ( entry.stageNo == stageNo ) { return true; }
+	}
+	return false;
+}
+
+void StageAssetCache::RecordTransition( int stageNo, double seconds )
+{
+	TransitionRecord record{};
+	record.stageNo			= stageNo;
+	record.seconds			= seconds;
+	record.result			= lastResult;
+	record.cacheWasEnabled	= enableCache;
+
+	if ( MAX_TRANSITION_RECORDS <= transitions.size() )
+	{
+		transitions.erase( transitions.begin() );
+	}
+	transitions.emplace_back( std::move( record ) );
+
+	lastResult = FetchResult::None;
+}
+
+std::unique_ptr<StageAssetCache::LoadedFiles> StageAssetCache::LoadFiles( int stageNo )
+{
+	auto pFiles = std::make_unique<LoadedFiles>();
+
+	const std::string drawModelPath			= MakeTerrainModelPath( "Display",   stageNo );
+	const std::string collisionModelPath	= MakeTerrainModelPath( "Collision", stageNo );
+	if ( !Donya::IsExistFile( drawModelPath ) || !Donya::IsExistFile( collisionModelPath ) )
+	{
+		return pFiles;
+	}
+	// else
+
+	pFiles->succeeded =
+		pFiles->drawLoader.Load( drawModelPath ) &&
+		pFiles->collisionLoader.Load( collisionModelPath );
+
+	return pFiles;
+}
+std::shared_ptr<StageAssetCache::TerrainAssets> StageAssetCache::CreateAssets( const LoadedFiles &files )
+{
+	const auto &drawLoader		= files.drawLoader;
+	const auto &collisionLoader	= files.collisionLoader;
+
+	auto pAssets = std::make_shared<TerrainAssets>();
+
+	const auto drawModel = Donya::Model::StaticModel::Create( drawLoader.GetModelSource(), drawLoader.GetFileDirectory() );
+	if ( !drawModel.WasInitializeSucceeded() ) { return nullptr; }
+	// else
+	pAssets->pDrawModel = std::make_shared<Donya::Model::StaticModel>( drawModel );
+
+	pAssets->pPose = std::make_shared<Donya::Model::Pose>();
+	pAssets->pPose->AssignSkeletal( drawLoader.GetModelSource().skeletal );
+	pAssets->pPose->UpdateTransformMatrices();
+
+	pAssets->pPolygons = std::make_shared<Donya::Model::PolygonGroup>
+	(
+		collisionLoader.GetPolygonGroup()
+	);
+
+	pAssets->byteSize =
+		EstimateBytes( drawLoader.GetModelSource() ) +
+		EstimateBytes( *pAssets->pPolygons );
+
+#if DEBUG_MODE
+	pAssets->pDrawingPolygons = std::make_shared<Donya::Model::PolygonGroup>
+	(
+		drawLoader.GetPolygonGroup()
+	);
+
+	const auto collisionModel = Donya::Model::StaticModel::Create( collisionLoader.GetModelSource(), collisionLoader.GetFileDirectory() );
+	_ASSERT_EXPR( collisionModel.WasInitializeSucceeded(), L"Debug.Failed : The collision model creation of Terrain." );
+	pAssets->pCollisionModel = std::make_shared<Donya::Model::StaticModel>( collisionModel );
+	pAssets->pCollisionPose = std::make_shared<Donya::Model::Pose>();
+	pAssets->pCollisionPose->AssignSkeletal( collisionLoader.GetModelSource().skeletal );
+	pAssets->pCollisionPose->UpdateTransformMatrices();
+
+	pAssets->byteSize +=
+		EstimateBytes( *pAssets->pDrawingPolygons ) +
+		EstimateBytes( collisionLoader.GetModelSource() );
+#endif // DEBUG_MODE
+
+	return pAssets;
+}
+
+void StageAssetCache::Insert( int stageNo, const std::shared_ptr<TerrainAssets> &pAssets )
+{
+	Entry entry{};
+	entry.stageNo	= stageNo;
+	entry.pAssets	= pAssets;
+	entries.emplace_front( std::move( entry ) );
+	usedBytes += pAssets->byteSize;
+
+	EvictIfOverBudget();
+}
+void StageAssetCache::EvictIfOverBudget()
+{
+	// Keeps the most recently used one even if it exceeds the budget by itself.
+	// The evicted assets are alive while the Terrain that uses those is alive.
+	while ( budgetBytes < usedBytes && 1 < entries.size() )
+	{
+		usedBytes -= entries.back().pAssets->byteSize;
+		entries.pop_back();
+		counter.evict++;
+	}
+}
+void StageAssetCache::CollectFinishedPrefetches()
+{
+	for ( auto it = pendings.begin(); it != pendings.end(); )
+	{
+		if ( !IsReady( it->second ) ) { ++it; continue; }
+		// else
+
+		const int	stageNo	= it->first;
+		const auto	pFiles	= it->second.get();
+		it = pendings.erase( it );
+
+		if ( !pFiles || !pFiles->succeeded ) { continue; }
+		// else
+
+		const auto pAssets = CreateAssets( *pFiles );
+		if ( !pAssets ) { continue; }
+		// else
+
+		// Inserts it as the most recently used one as the loading path does. If it were the least recently used one, the eviction would discard it first.
+		Insert( stageNo, pAssets );
+	}
+}
+
+#if USE_IMGUI
+void StageAssetCache::ShowImGuiNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	bool enable = enableCache;
+	if ( ImGui::Checkbox( "Enable cache", &enable ) )
+	{
+		SetEnable( enable );
+	}
+
+	int budgetMB = scast<int>( budgetBytes / ( 1024U * 1024U ) );
+	if ( ImGui::DragInt( "Budget[MB]", &budgetMB, 1.0f, 0, 4096 ) )
+	{
+		SetBudget( scast<size_t>( std::max( 0, budgetMB ) ) * 1024U * 1024U );
+	}
+
+	auto ToKB = []( size_t bytes )
+	{
+		return scast<float>( bytes ) / 1024.0f;
+	};
+	ImGui::Text( "Used : %.1f[KB] / %.1f[KB]", ToKB( usedBytes ), ToKB( budgetBytes ) );
+	ImGui::Text( "Hit[%d], Prefetch hit[%d], Miss[%d], Evict[%d]", scast<int>( counter.hit ), scast<int>( counter.prefetchHit ), scast<int>( counter.miss ), scast<int>( counter.evict ) );
+	ImGui::Text( "Pending prefetches : %d", scast<int>( pendings.size() ) );
+
+	if ( ImGui::TreeNode( "Entries" ) )
+	{
+		ImGui::Text( "The front is the most recently used." );
+		for ( const auto &entry : entries )
+		{
+			ImGui::Text( "Stage[%d] : %.1f[KB]", entry.stageNo, ToKB( entry.pAssets->byteSize ) );
+		}
+		ImGui::TreePop();
+	}
+
+	if ( ImGui::Button( "Clear" ) )
+	{
+		Clear();
+	}
+
+	if ( ImGui::TreeNode( "Time to playable" ) )
+	{
+		auto ToString = []( FetchResult result )
+		{
+			switch ( result )
+			{
+			case FetchResult::Hit:			return "Hit";
+			case FetchResult::PrefetchHit:	return "Prefetch hit";
+			case FetchResult::Miss:			return "Miss";
+			case FetchResult::Failed:		return "Failed";
+			default: break;
+			}
+			return "None";
+		};
+
+		// Newest first.
+		for ( auto it = transitions.rbegin(); it != transitions.rend(); ++it )
+		{
+			ImGui::Text
+			(
+				"Stage[%d] : %.3f[ms], %s, %s",
+				it->stageNo, it->seconds * 1000.0, ToString( it->result ),
+				( it->cacheWasEnabled ) ? "Cache on" : "Cache off"
+			);
+		}
+
+		if ( ImGui::Button( "Clear records" ) )
+		{
+			transitions.clear();
+		}
+
+		ImGui::TreePop();
+	}
+
+	ImGui::TreePop();
+}
+#endif // USE_IMGUI
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <future>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Donya/Constant.h"
+#include "Donya/Loader.h"
+#include "Donya/Model.h"
+#include "Donya/ModelPolygon.h"
+#include "Donya/ModelPose.h"
+#include "Donya/Template.h"
+#include "Donya/UseImGui.h"
+
+/// <summary>
+/// Keeps the terrain assets of recently used stages within the memory budget, and evicts the least recently used one if it is over.<para></para>
+/// Prefetch() loads the files of a stage on a background thread. The models are created by the thread that calls FetchTerrain() or Prefetch(), because the resource caches are not locked.<para></para>
+/// Please use this from the main thread only.
+/// </summary>
+class StageAssetCache final : public Donya::Singleton<StageAssetCache>
+{
+	friend class Donya::Singleton<StageAssetCache>;
+public:
+	struct TerrainAssets
+	{
+		std::shared_ptr<Donya::Model::StaticModel>	pDrawModel;
+		std::shared_ptr<Donya::Model::Pose>			pPose;
+		std::shared_ptr<Donya::Model::PolygonGroup>	pPolygons;			// Model space.
+	#if DEBUG_MODE
+		std::shared_ptr<Donya::Model::PolygonGroup>	pDrawingPolygons;
+		std::shared_ptr<Donya::Model::StaticModel>	pCollisionModel;
+		std::shared_ptr<Donya::Model::Pose>			pCollisionPose;
+	#endif // DEBUG_MODE
+		size_t byteSize = 0;	// Estimated from the vertices, the indices and the polygons. The GPU buffers are counted as the same size as the vertices and indices.
+	};
+	enum class FetchResult
+	{
+		None,			// Not fetched yet.
+		Hit,			// Found in the cache.
+		PrefetchHit,	// Loaded by Prefetch(). Waited for it if it was not finished.
+		Miss,			// Loaded synchronously.
+		Failed,
+	};
+	/// <summary>
+	/// A time-to-playable of a stage transition.
+	/// </summary>
+	struct TransitionRecord
+	{
+		int			stageNo	= 0;
+		double		seconds	= 0.0;
+		FetchResult	result	= FetchResult::None;
+		bool		cacheWasEnabled = true;
+	};
+private:
+	/// <summary>
+	/// The files of a stage that were loaded on a background thread. This does not have any GPU resource.
+	/// </summary>
+	struct LoadedFiles
+	{
+		Donya::Loader	drawLoader;
+		Donya::Loader	collisionLoader;
+		bool			succeeded = false;
+	};
+	struct Entry
+	{
+		int								stageNo = 0;
+		std::shared_ptr<TerrainAssets>	pAssets;
+	};
+	struct Counter
+	{
+		size_t hit			= 0;
+		size_t prefetchHit	= 0;
+		size_t miss			= 0;
+		size_t evict		= 0;
+	};
+private:
+	static constexpr size_t MAX_PENDING_COUNT		= 4;	// The files of pending prefetches are not counted in the budget, so I limit the count of those.
+	static constexpr size_t MAX_TRANSITION_RECORDS	= 32;
+private:
+	bool			enableCache	= true;
+	size_t			budgetBytes	= 256U * 1024U * 1024U;
+	size_t			usedBytes	= 0;
+	std::list<Entry>	entries;	// The front is the most recently used.
+	std::unordered_map<int, std::future<std::unique_ptr<LoadedFiles>>> pendings;
+	Counter			counter;
+	FetchResult		lastResult	= FetchResult::None;
+	std::vector<TransitionRecord> transitions;
+private:
+	StageAssetCache() = default;
+public:
+	~StageAssetCache();
+public:
+	/// <summary>
+	/// Returns nullptr if the files of the stage do not exist or the loading failed.<para></para>
+	/// Waits for the prefetch of the stage if it is running.
+	/// </summary>
+	std::shared_ptr<const TerrainAssets> FetchTerrain( int stageNo );
+	/// <summary>
+	/// Starts loading the files of the stage on a background thread if it is not cached, not loading, and the pending count is under the limit.<para></para>
+	/// Also makes the finished prefetches into the cache.
+	/// </summary>
+	void Prefetch( int stageNo );
+	/// <summary>
+	/// Releases all cached assets. Waits for the running prefetches.
+	/// </summary>
+	void Clear();
+public:
+	/// <summary>
+	/// Evicts the entries immediately if the used bytes exceed the new budget.
+	/// </summary>
+	void SetBudget( size_t bytes );
+	/// <summary>
+	/// If false, FetchTerrain() always loads synchronously and does not cache. This is for comparing the time-to-playable.
+	/// </summary>
+	void SetEnable( bool enable );
+	bool IsEnabled() const { return enableCache; }
+	bool IsCached( int stageNo ) const;
+	size_t GetUsedBytes() const { return usedBytes; }
+public:
+	/// <summary>
+	/// Records the elapsed seconds of a stage transition. The result of the last FetchTerrain() is recorded together.
+	/// </summary>
+	void RecordTransition( int stageNo, double seconds );
+#if USE_IMGUI
+	void ShowImGuiNode( const std::string &nodeCaption );
+#endif // USE_IMGUI
+private:
+	static std::unique_ptr<LoadedFiles>		LoadFiles( int stageNo );
+	static std::shared_ptr<TerrainAssets>	CreateAssets( const LoadedFiles &files );
+	void Insert( int stageNo, const std::shared_ptr<TerrainAssets> &pAssets );
+	void EvictIfOverBudget();
+	/// <summary>
+	/// Makes the finished prefetches into the cache. Does not wait for the running ones.
+	/// </summary>
+	void CollectFinishedPrefetches();
+};
@@ -2,15 +2,20 @@
 
 #include <exception>
 
-#include "Donya/Loader.h"
 #include "Donya/Useful.h"
 
+#if USE_IMGUI
+#include "Donya/Benchmark.h"
+#include "Donya/Random.h"
+#endif // USE_IMGUI
+
 #include "FilePath.h"
+#include "StageAssetCache.h"
 
 Terrain::Terrain( int stageNo ) :
 	scale( 1.0f, 1.0f, 1.0f ), translation(),
-	matWorld( Donya::Vector4x4::Identity() ),
-	pDrawModel( nullptr ), pPose( nullptr ), pPolygons( nullptr )
+	matWorld( Donya::Vector4x4::Identity() ), matCollision( Donya::Vector4x4::Identity() ),
+	pDrawModel( nullptr ), pPose( nullptr ), pPolygons( nullptr ), pBakedPolygons( nullptr )
 {
 	const std::string drawModelPath			= MakeTerrainModelPath( "Display",   stageNo );
 	const std::string collisionModelPath	= MakeTerrainModelPath( "Collision", stageNo );
@@ -20,61 +25,52 @@ Terrain::Terrain( int stageNo ) :
 	}
 	// else
 
-	auto Load = []( Donya::Loader *pLoader, const std::string &filePath )
+	// The assets are shared with the cache, so those must not be changed.
+	const auto pAssets = StageAssetCache::Get().FetchTerrain( stageNo );
+	if ( !pAssets )
 	{
-		pLoader->ClearData();
-		if ( !pLoader->Load( filePath ) )
-		{
-			const std::wstring errMsgBase{ L"Failed : Loading a model. That is : " };
-			const std::wstring errMsg = errMsgBase + Donya::MultiToWide( filePath );
-			_ASSERT_EXPR( 0, errMsg.c_str() );
-
-			throw std::runtime_error{ "Loading Error" };
-		}
-	};
-
-	Donya::Loader loader{};
-	Load( &loader, drawModelPath );
-
-	const auto drawModel = Donya::Model::StaticModel::Create( loader.GetModelSource(), loader.GetFileDirectory() );
-	pDrawModel = std::make_shared<Donya::Model::StaticModel>( drawModel );
-	_ASSERT_EXPR( pDrawModel->WasInitializeSucceeded(), L"Failed : The model creation of Terrain." );
-
-	pPose = std::make_shared<Donya::Model::Pose>();
-	pPose->AssignSkeletal( loader.GetModelSource().skeletal );
-	pPose->UpdateTransformMatrices();
+		const std::wstring errMsgBase{ L"Failed : Loading a model. That is : " };
+		const std::wstring errMsg = errMsgBase + Donya::MultiToWide( drawModelPath ) + L" or " + Donya::MultiToWide( collisionModelPath );
+		_ASSERT_EXPR( 0, errMsg.c_str() );
 
-#if DEBUG_MODE
-	pDrawingPolygons = std::make_shared<Donya::Model::PolygonGroup>
-	(
-		loader.GetPolygonGroup()
-	);
-#endif // DEBUG_MODE
-
-	Load( &loader, collisionModelPath );
+		throw std::runtime_error{ "Loading Error" };
+	}
+	// else
 
+	pDrawModel	= pAssets->pDrawModel;
+	pPose		= pAssets->pPose;
+	pPolygons	= pAssets->pPolygons;
 #if DEBUG_MODE
-	const auto collisionModel = Donya::Model::StaticModel::Create( loader.GetModelSource(), loader.GetFileDirectory() );
-	pCollisionModel = std::make_shared<Donya::Model::StaticModel>( collisionModel );
-	_ASSERT_EXPR( pCollisionModel->WasInitializeSucceeded(), L"Debug.Failed : The collision model creation of Terrain." );
-	pCollisionPose = std::make_shared<Donya::Model::Pose>();
-	pCollisionPose->AssignSkeletal( loader.GetModelSource().skeletal );
-	pCollisionPose->UpdateTransformMatrices();
+	pDrawingPolygons	= pAssets->pDrawingPolygons;
+	pCollisionModel		= pAssets->pCollisionModel;
+	pCollisionPose		= pAssets->pCollisionPose;
 #endif // DEBUG_MODE
-
-	pPolygons = std::make_shared<Donya::Model::PolygonGroup>
-	(
-		loader.GetPolygonGroup()
-	);
 }
 
 void Terrain::SetWorldConfig( const Donya::Vector3 &scaling, const Donya::Vector3 &translate )
 {
+	if ( scale.x != scaling.x || scale.y != scaling.y || scale.z != scaling.z ||
+		translation.x != translate.x || translation.y != translate.y || translation.z != translate.z )
+	{
+		worldWasChanged = true;
+	}
+
 	scale		= scaling;
 	translation	= translate;
 }
 void Terrain::BuildWorldMatrix()
 {
+#if USE_IMGUI
+	// This is called once per frame, so the count since last call is the count of a frame.
+	inversionCountPerFrame = Donya::Model::PolygonGroup::GetInversionCount();
+	Donya::Model::PolygonGroup::ResetInversionCount();
+#endif // USE_IMGUI
+
+	// The terrain is static in almost case, so I should not rebuild it every frame.
+	if ( !worldWasChanged ) { return; }
+	// else
+	worldWasChanged = false;
+
 	// matWorld =
 	// Donya::Vector4x4::MakeScaling( scale ) *
 	// Donya::Vector4x4::MakeTranslation( translation );
@@ -85,6 +81,27 @@ void Terrain::BuildWorldMatrix()
 	matWorld._41 = translation.x;
 	matWorld._42 = translation.y;
 	matWorld._43 = translation.z;
+
+	BakeCollision();
+}
+
+std::shared_ptr<Donya::Model::PolygonGroup> Terrain::GetCollisionModel() const
+{
+	return ( useBakedCollision && pBakedPolygons ) ? pBakedPolygons : pPolygons;
+}
+void Terrain::BakeCollision()
+{
+	if ( !pPolygons || !useBakedCollision )
+	{
+		pBakedPolygons.reset();
+		matCollision = matWorld;
+		return;
+	}
+	// else
+
+	pBakedPolygons = std::make_shared<Donya::Model::PolygonGroup>( *pPolygons );
+	pBakedPolygons->BakeTransform( matWorld );
+	matCollision = Donya::Vector4x4::Identity();
 }
 
 void Terrain::Draw( RenderingHelper *pRenderer, const Donya::Vector4 &color )
@@ -116,8 +133,115 @@ void Terrain::ShowImGuiNode( const std::string &nodeCaption )
 	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
 	// else
 
-	ImGui::DragFloat3( u8"XP[", &scale.x,		0.01f );
-	ImGui::DragFloat3( u8"sړ", &translation.x,	0.1f  );
+	if ( ImGui::DragFloat3( u8"XP[", &scale.x,		0.01f ) ) { worldWasChanged = true; }
+	if ( ImGui::DragFloat3( u8"sړ", &translation.x,	0.1f  ) ) { worldWasChanged = true; }
+
+	if ( ImGui::Checkbox( u8"蔻[hԂɏĂ", &useBakedCollision ) ) { worldWasChanged = true; }
+	ImGui::Text( u8"Ot[̋tšvZ񐔁F%d", inversionCountPerFrame );
+
+	ShowRaycastBenchmarkNode( u8"CLXǧv" );
+
+	ImGui::TreePop();
+}
+void Terrain::ShowRaycastBenchmarkNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	struct Result
+	{
+		int		rayCount		= 0;
+		int		hitCount		= 0;
+		int		mismatchCount	= 0;
+		double	secondsBVH		= 0.0;
+		double	secondsBrute	= 0.0;
+	};
+	static int		rayCount = 1000;
+	static Result	result{};
+
+	if ( !pPolygons )
+	{
+		ImGui::Text( u8"蔻p̃|S܂" );
+		ImGui::TreePop();
+		return;
+	}
+	// else
+
+	ImGui::Text( u8"|SF%d",	scast<int>( pPolygons->GetPolygonCount() ) );
+	ImGui::Text( u8"BVHm[hF%d",	scast<int>( pPolygons->GetBVHNodeCount() ) );
+	ImGui::DragInt( u8"C̖{", &rayCount, 10.0f, 1, 100000 );
+
+	Donya::Vector3 boxMin, boxMax;
+	if ( ImGui::Button( u8"v" ) && pPolygons->GetBoundingBox( &boxMin, &boxMax ) )
+	{
+		// Fire the rays that pass through the random points in the bounding box, toward the random directions.
+		const float diagonal = ( boxMax - boxMin ).Length();
+		auto RandomPoint = [&]()
+		{
+			return Donya::Vector3
+			{
+				Donya::Random::GenerateFloat( boxMin.x, boxMax.x ),
+				Donya::Random::GenerateFloat( boxMin.y, boxMax.y ),
+				Donya::Random::GenerateFloat( boxMin.z, boxMax.z )
+			};
+		};
+		std::vector<Donya::Vector3> rayStarts{};
+		std::vector<Donya::Vector3> rayEnds{};
+		rayStarts.reserve( rayCount );
+		rayEnds.reserve( rayCount );
+		for ( int i = 0; i < rayCount; ++i )
+		{
+			const Donya::Vector3 through	= RandomPoint();
+			const Donya::Vector3 direction	= ( RandomPoint() - through ).Unit();
+			rayStarts.emplace_back( through - direction * diagonal );
+			rayEnds.emplace_back( through + direction * diagonal );
+		}
+
+		std::vector<Donya::Model::RaycastResult> resultsBVH  ( rayCount );
+		std::vector<Donya::Model::RaycastResult> resultsBrute( rayCount );
+
+		Benchmark timer{};
+		timer.Begin();
+		for ( int i = 0; i < rayCount; ++i )
+		{
+			resultsBVH[i] = pPolygons->Raycast( rayStarts[i], rayEnds[i] );
+		}
+		result.secondsBVH = timer.End();
+
+		timer.Begin();
+		for ( int i = 0; i < rayCount; ++i )
+		{
+			resultsBrute[i] = pPolygons->RaycastBruteForce( rayStarts[i], rayEnds[i] );
+		}
+		result.secondsBrute = timer.End();
+
+		result.rayCount			= rayCount;
+		result.hitCount			= 0;
+		result.mismatchCount	= 0;
+		for ( int i = 0; i < rayCount; ++i )
+		{
+			const auto &bvh   = resultsBVH[i];
+			const auto &brute = resultsBrute[i];
+			if ( brute.wasHit ) { result.hitCount++; }
+
+			const bool isSame =
+				( bvh.wasHit == brute.wasHit ) &&
+				( !bvh.wasHit || ( bvh.distance == brute.distance && bvh.polygonIndex == brute.polygonIndex ) );
+			if ( !isSame ) { result.mismatchCount++; }
+		}
+	}
+
+	if ( result.rayCount )
+	{
+		ImGui::Text( u8"{F%dCF%d", result.rayCount, result.hitCount );
+		ImGui::Text( u8"BVH@@F%.3f[ms]", result.secondsBVH   * 1000.0 );
+		ImGui::Text( u8"F%.3f[ms]", result.secondsBrute * 1000.0 );
+		if ( 0.0 < result.secondsBVH )
+		{
+			ImGui::Text( u8"xF%.2f{", result.secondsBrute / result.secondsBVH );
+		}
+		ImGui::Text( u8"ʂ̕svF%d", result.mismatchCount );
+	}
 
 	ImGui::TreePop();
 }
@@ -18,9 +18,16 @@ private:
 	Donya::Vector3		scale;
 	Donya::Vector3		translation;
 	Donya::Vector4x4	matWorld;
+	Donya::Vector4x4	matCollision;				// The world matrix of the collision model that returned by GetCollisionModel(). This is identity if the collision is baked.
+	bool				worldWasChanged = true;		// The dirty flag of the world matrix.
+	bool				useBakedCollision = true;	// If true, the collision polygons are transformed to world space beforehand. So the Raycast() does not need the matrix inversion.
 	std::shared_ptr<Donya::Model::StaticModel>	pDrawModel;
 	std::shared_ptr<Donya::Model::Pose>			pPose;
-	std::shared_ptr<Donya::Model::PolygonGroup>	pPolygons;
+	std::shared_ptr<Donya::Model::PolygonGroup>	pPolygons;			// Model space.
+	std::shared_ptr<Donya::Model::PolygonGroup>	pBakedPolygons;		// World space. Rebuilt when the world config was changed.
+#if USE_IMGUI
+	int		inversionCountPerFrame = 0;
+#endif // USE_IMGUI
 #if DEBUG_MODE
 	std::shared_ptr<Donya::Model::PolygonGroup>	pDrawingPolygons;
 	std::shared_ptr<Donya::Model::StaticModel>	pCollisionModel;
@@ -30,18 +37,35 @@ public:
 	Terrain( int stageNumber );
 public:
 	void SetWorldConfig( const Donya::Vector3 &scaling, const Donya::Vector3 &translate );
+	/// <summary>
+	/// Rebuild the world matrix and the baked collision only if the world config was changed. Please call this every frame.
+	/// </summary>
 	void BuildWorldMatrix();
 public:
 	const Donya::Vector4x4 &GetWorldMatrix() const { return matWorld; }
-	std::shared_ptr<Donya::Model::PolygonGroup> GetCollisionModel() const { return pPolygons; }
+	/// <summary>
+	/// Please use this with GetCollisionMatrix().
+	/// </summary>
+	std::shared_ptr<Donya::Model::PolygonGroup> GetCollisionModel() const;
+	/// <summary>
+	/// Returns the world matrix for the collision model. This is identity if the collision is baked into world space.
+	/// </summary>
+	const Donya::Vector4x4 &GetCollisionMatrix() const { return matCollision; }
 #if DEBUG_MODE
 	std::shared_ptr<Donya::Model::PolygonGroup> GetDrawModel() const { return pDrawingPolygons; }
 #endif // DEBUG_MODE
+private:
+	void BakeCollision();
 public:
 	void Draw( RenderingHelper *pRenderer, const Donya::Vector4 &color );
 public:
 #if USE_IMGUI
 	void ShowImGuiNode( const std::string &nodeCaption );
+private:
+	/// <summary>
+	/// Compare the Raycast() of collision model between using the BVH and the brute-force.
+	/// </summary>
+	void ShowRaycastBenchmarkNode( const std::string &nodeCaption );
 #endif // USE_IMGUI
 };
 